@@ -0,0 +1,79 @@
+/**
+ * @file benchmarks/ann_benchmarks.cpp
+ *
+ * Benchmarks of the forward and backward passes of a feedforward network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
+#include <mlpack/methods/ann/init_rules/random_init.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::ann;
+
+//! The size of the minibatches passed through the network.
+static const size_t batchSize = 64;
+
+//! The network type used by the benchmarks.
+typedef FFN<NegativeLogLikelihood<>, RandomInitialization> NetworkType;
+
+/**
+ * Build a multilayer perceptron with two hidden layers of 256 units for the
+ * given dimensionality and number of classes.
+ */
+static void BuildNetwork(NetworkType& model,
+                         const size_t dimensionality,
+                         const size_t classes)
+{
+  model.Add<Linear<>>(dimensionality, 256);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(256, 256);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(256, classes);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+}
+
+MLPACK_BENCHMARK(FFNForward)
+{
+  const arma::mat dataset = SyntheticData(100, state.Scaled(20000));
+  NetworkType model;
+  BuildNetwork(model, dataset.n_rows, 10);
+
+  arma::mat output;
+  state.Measure([&]()
+      {
+        for (size_t i = 0; i + batchSize <= dataset.n_cols; i += batchSize)
+          model.Forward(dataset.cols(i, i + batchSize - 1), output);
+      }, dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(FFNForwardBackward)
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = SyntheticData(100, state.Scaled(20000), labels);
+  // NegativeLogLikelihood expects labels starting from 1.
+  const arma::mat targets = arma::conv_to<arma::rowvec>::from(labels) + 1;
+
+  NetworkType model;
+  BuildNetwork(model, dataset.n_rows, 10);
+
+  arma::mat output, gradient;
+  state.Measure([&]()
+      {
+        for (size_t i = 0; i + batchSize <= dataset.n_cols; i += batchSize)
+        {
+          model.Forward(dataset.cols(i, i + batchSize - 1), output);
+          model.Backward(dataset.cols(i, i + batchSize - 1),
+              targets.cols(i, i + batchSize - 1), gradient);
+        }
+      }, dataset.n_cols);
+}
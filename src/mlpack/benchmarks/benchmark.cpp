@@ -0,0 +1,303 @@
+/**
+ * @file benchmarks/benchmark.cpp
+ *
+ * Implementation of the benchmark harness: registration, running, JSON output
+ * and comparison against a baseline.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+// The registry of benchmarks.  A function-local static is used so that the
+// registry exists before the static registration objects are initialized.
+static std::map<std::string, BenchmarkFunction>& Registry()
+{
+  static std::map<std::string, BenchmarkFunction> registry;
+  return registry;
+}
+
+bool mlpack::benchmark::RegisterBenchmark(const std::string& name,
+                                          BenchmarkFunction function)
+{
+  Registry()[name] = function;
+  return true;
+}
+
+std::vector<std::pair<std::string, BenchmarkFunction>>
+mlpack::benchmark::Benchmarks()
+{
+  return std::vector<std::pair<std::string, BenchmarkFunction>>(
+      Registry().begin(), Registry().end());
+}
+
+double BenchmarkResult::MedianLatency() const
+{
+  if (latencies.empty())
+    return 0.0;
+
+  std::vector<double> sorted(latencies);
+  std::sort(sorted.begin(), sorted.end());
+  return (sorted.size() % 2 == 1) ? sorted[sorted.size() / 2] :
+      (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+}
+
+double BenchmarkResult::Throughput() const
+{
+  const double median = MedianLatency();
+  return (median > 0.0) ? items / median : 0.0;
+}
+
+// Run the given benchmark in the calling process.  The peak RSS is not set.
+static BenchmarkResult RunInProcess(const std::string& name,
+                                    BenchmarkFunction function,
+                                    const BenchmarkOptions& options)
+{
+  // Every benchmark sees the same random numbers, no matter which other
+  // benchmarks were run before it.
+  math::RandomSeed(options.seed);
+
+  BenchmarkState state(options);
+  function(state);
+
+  BenchmarkResult result;
+  result.name = name;
+  result.items = state.Items();
+  result.latencies = state.Latencies();
+  result.peakRSS = 0;
+  if (options.counters && options.repetitions > 0)
+  {
+    result.counters = IO::GetSingleton().counters.GetAllCounters();
+    for (std::pair<const std::string, double>& c : result.counters)
+      c.second /= options.repetitions;
+  }
+  Counter::ResetAll();
+
+  return result;
+}
+
+BenchmarkResult mlpack::benchmark::RunBenchmark(
+    const std::string& name,
+    BenchmarkFunction function,
+    const BenchmarkOptions& options)
+{
+#ifdef _WIN32
+  // There is no fork() and no per-process peak RSS to read.
+  return RunInProcess(name, function, options);
+#else
+  // The peak RSS of a process never goes down, so the benchmark runs in its
+  // own child process and the peak RSS of that child is reported.  The harness
+  // itself never runs any OpenMP code, so the children can use OpenMP freely.
+  int fds[2];
+  if (pipe(fds) != 0)
+    Log::Fatal << "Cannot create a pipe to run " << name << "!" << std::endl;
+
+  std::cout.flush();
+  std::cerr.flush();
+  const pid_t pid = fork();
+  if (pid < 0)
+    Log::Fatal << "Cannot fork to run " << name << "!" << std::endl;
+
+  if (pid == 0)
+  {
+    // Run the benchmark and send the result to the parent.
+    close(fds[0]);
+    const BenchmarkResult result = RunInProcess(name, function, options);
+
+    std::ostringstream oss;
+    oss << std::setprecision(17) << result.items << " "
+        << result.latencies.size();
+    for (const double latency : result.latencies)
+      oss << " " << latency;
+    oss << " " << result.counters.size();
+    for (const std::pair<const std::string, double>& c : result.counters)
+      oss << " " << c.first << " " << c.second;
+
+    const std::string message = oss.str();
+    size_t written = 0;
+    while (written < message.size())
+    {
+      const ssize_t n = write(fds[1], message.data() + written,
+          message.size() - written);
+      if (n <= 0)
+        break;
+      written += n;
+    }
+    close(fds[1]);
+
+    std::cout.flush();
+    std::cerr.flush();
+    _exit(written == message.size() ? 0 : 1);
+  }
+
+  close(fds[1]);
+  std::string message;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+    message.append(buffer, n);
+  close(fds[0]);
+
+  // wait4() gives the resource usage of this child alone.
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0)
+  {
+    Log::Fatal << "Benchmark " << name << " did not finish successfully!"
+        << std::endl;
+  }
+
+  BenchmarkResult result;
+  result.name = name;
+  #ifdef __APPLE__
+  result.peakRSS = size_t(usage.ru_maxrss); // Bytes on macOS.
+  #else
+  result.peakRSS = size_t(usage.ru_maxrss) * 1024; // Kilobytes on Linux.
+  #endif
+
+  std::istringstream iss(message);
+  size_t numLatencies = 0, numCounters = 0;
+  iss >> result.items >> numLatencies;
+  result.latencies.resize(numLatencies);
+  for (size_t i = 0; i < numLatencies; ++i)
+    iss >> result.latencies[i];
+  iss >> numCounters;
+  for (size_t i = 0; i < numCounters; ++i)
+  {
+    std::string counter;
+    double value;
+    iss >> counter >> value;
+    result.counters[counter] = value;
+  }
+
+  if (iss.fail())
+  {
+    Log::Fatal << "Cannot read the result of benchmark " << name << "!"
+        << std::endl;
+  }
+
+  return result;
+#endif
+}
+
+void mlpack::benchmark::WriteJSON(std::ostream& stream,
+                                  const std::vector<BenchmarkResult>& results,
+                                  const BenchmarkOptions& options)
+{
+  stream << std::setprecision(10);
+  stream << "{\n"
+      << "  \"mlpack_version\": \"" << util::GetVersion() << "\",\n"
+      << "  \"armadillo_version\": \"" << arma::arma_version::as_string()
+      << "\",\n"
+      << "  \"scale\": " << options.scale << ",\n"
+      << "  \"repetitions\": " << options.repetitions << ",\n"
+      << "  \"seed\": " << options.seed << ",\n"
+      << "  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchmarkResult& r = results[i];
+    const double minLatency = r.latencies.empty() ? 0.0 :
+        *std::min_element(r.latencies.begin(), r.latencies.end());
+    const double meanLatency = r.latencies.empty() ? 0.0 :
+        std::accumulate(r.latencies.begin(), r.latencies.end(), 0.0) /
+        r.latencies.size();
+
+    stream << (i == 0 ? "\n" : ",\n")
+        << "    {\n"
+        << "      \"name\": \"" << r.name << "\",\n"
+        << "      \"items\": " << r.items << ",\n"
+        << "      \"latency_median\": " << r.MedianLatency() << ",\n"
+        << "      \"latency_min\": " << minLatency << ",\n"
+        << "      \"latency_mean\": " << meanLatency << ",\n"
+        << "      \"throughput\": " << r.Throughput() << ",\n"
+        << "      \"peak_rss\": " << r.peakRSS;
+
+    if (!r.counters.empty())
+    {
+      stream << ",\n      \"counters\": {";
+      bool first = true;
+      for (const std::pair<const std::string, double>& c : r.counters)
+      {
+        stream << (first ? "\n" : ",\n") << "        \"" << c.first << "\": "
+            << c.second;
+        first = false;
+      }
+      stream << "\n      }";
+    }
+
+    stream << "\n    }";
+  }
+
+  stream << (results.empty() ? "]" : "\n  ]") << "\n}\n";
+}
+
+size_t mlpack::benchmark::CompareToBaseline(
+    const std::string& baselineFile,
+    const std::vector<BenchmarkResult>& results,
+    const double tolerance)
+{
+  boost::property_tree::ptree baseline;
+  try
+  {
+    boost::property_tree::read_json(baselineFile, baseline);
+  }
+  catch (const boost::property_tree::json_parser_error& e)
+  {
+    Log::Fatal << "Cannot read baseline '" << baselineFile << "': " << e.what()
+        << std::endl;
+  }
+
+  std::map<std::string, double> baselineLatencies;
+  const boost::property_tree::ptree empty;
+  for (const boost::property_tree::ptree::value_type& b :
+       baseline.get_child("benchmarks", empty))
+  {
+    baselineLatencies[b.second.get<std::string>("name")] =
+        b.second.get<double>("latency_median");
+  }
+
+  size_t regressions = 0;
+  for (const BenchmarkResult& r : results)
+  {
+    std::map<std::string, double>::const_iterator it =
+        baselineLatencies.find(r.name);
+    if (it == baselineLatencies.end() || it->second <= 0.0)
+      continue;
+
+    const double ratio = r.MedianLatency() / it->second;
+    if (ratio > 1.0 + tolerance)
+    {
+      Log::Warn << r.name << ": median latency " << r.MedianLatency()
+          << "s vs. " << it->second << "s in the baseline (" << ratio
+          << "x)." << std::endl;
+      ++regressions;
+    }
+    else
+    {
+      Log::Info << r.name << ": " << ratio << "x the baseline latency."
+          << std::endl;
+    }
+  }
+
+  return regressions;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file benchmarks/benchmark.hpp
+ *
+ * A small harness for the mlpack benchmark suite.  Benchmarks are registered
+ * with the MLPACK_BENCHMARK() macro, generate their own synthetic data, and
+ * time a workload with BenchmarkState::Measure().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace benchmark {
+
+/**
+ * The options that control how benchmarks are run.
+ */
+struct BenchmarkOptions
+{
+  //! Factor that problem sizes are multiplied with.
+  double scale = 1.0;
+  //! Number of timed runs of each benchmark (after one warm-up run).
+  size_t repetitions = 5;
+  //! Random seed set before each benchmark.
+  size_t seed = 42;
+  //! Whether to collect performance counters during the timed runs.
+  bool counters = false;
+};
+
+/**
+ * The state passed to each benchmark.  It gives access to the options, and
+ * times the workload of the benchmark.
+ */
+class BenchmarkState
+{
+ public:
+  /**
+   * Create the state for a benchmark run with the given options.
+   */
+  BenchmarkState(const BenchmarkOptions& options) :
+      options(options),
+      items(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Return the given problem size multiplied by the scale factor.
+   */
+  size_t Scaled(const size_t size) const
+  {
+    return std::max(size_t(1), size_t(size * options.scale));
+  }
+
+  /**
+   * Run the given workload once to warm up, then time it the requested number
+   * of times.  Only the workload is timed, so setup (such as generating data or
+   * building a model to query) should happen before calling Measure().
+   *
+   * @param workload Function running the workload.
+   * @param workloadItems Number of items (points, queries, ...) processed by
+   *     one run of the workload; used to compute the throughput.
+   */
+  template<typename FunctionType>
+  void Measure(FunctionType&& workload, const size_t workloadItems)
+  {
+    workload();
+
+    // Only the timed runs contribute to the counters.
+    Counter::ResetAll();
+    if (options.counters)
+      Counter::EnableCounting();
+
+    latencies.clear();
+    for (size_t i = 0; i < options.repetitions; ++i)
+    {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      workload();
+      latencies.push_back(std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count());
+    }
+
+    Counter::DisableCounting();
+    items = workloadItems;
+  }
+
+  //! Get the options of the run.
+  const BenchmarkOptions& Options() const { return options; }
+  //! Get the latency of each timed run, in seconds.
+  const std::vector<double>& Latencies() const { return latencies; }
+  //! Get the number of items processed by one run.
+  size_t Items() const { return items; }
+
+ private:
+  //! The options of the run.
+  const BenchmarkOptions& options;
+  //! The latency of each timed run, in seconds.
+  std::vector<double> latencies;
+  //! The number of items processed by one run.
+  size_t items;
+};
+
+//! The signature of a benchmark.
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+/**
+ * The result of running a single benchmark.
+ */
+struct BenchmarkResult
+{
+  //! Name of the benchmark.
+  std::string name;
+  //! Number of items processed by one run.
+  size_t items;
+  //! Latency of each timed run, in seconds.
+  std::vector<double> latencies;
+  //! Peak resident set size of the benchmark, in bytes.  Each benchmark runs
+  //! in its own child process, so this does not depend on earlier benchmarks
+  //! (0 where the peak can't be measured, such as on Windows).
+  size_t peakRSS;
+  //! Performance counters, per run.
+  std::map<std::string, double> counters;
+
+  //! Get the median latency, in seconds.
+  double MedianLatency() const;
+  //! Get the throughput, in items per second, based on the median latency.
+  double Throughput() const;
+};
+
+/**
+ * Return all registered benchmarks, sorted by name.
+ */
+std::vector<std::pair<std::string, BenchmarkFunction>> Benchmarks();
+
+/**
+ * Register the given benchmark.  This is called by MLPACK_BENCHMARK().
+ *
+ * @param name Name of the benchmark.
+ * @param function Function running the benchmark.
+ */
+bool RegisterBenchmark(const std::string& name, BenchmarkFunction function);
+
+/**
+ * Run the given benchmark with the given options.  Where fork() is available,
+ * the benchmark runs in a child process, so that its peak resident set size
+ * can be measured on its own.
+ *
+ * @param name Name of the benchmark.
+ * @param function Function running the benchmark.
+ * @param options Options of the run.
+ */
+BenchmarkResult RunBenchmark(const std::string& name,
+                             BenchmarkFunction function,
+                             const BenchmarkOptions& options);
+
+/**
+ * Write the given results as a JSON document.
+ *
+ * @param stream Stream to write to.
+ * @param results Results to write.
+ * @param options Options the results were obtained with.
+ */
+void WriteJSON(std::ostream& stream,
+               const std::vector<BenchmarkResult>& results,
+               const BenchmarkOptions& options);
+
+/**
+ * Compare the given results against a baseline JSON document written by an
+ * earlier run, and report every benchmark whose median latency grew by more
+ * than the given tolerance.
+ *
+ * @param baselineFile JSON file of the baseline run.
+ * @param results Results of the current run.
+ * @param tolerance Allowed relative slowdown (0.1 is 10%).
+ * @return The number of regressions.
+ */
+size_t CompareToBaseline(const std::string& baselineFile,
+                         const std::vector<BenchmarkResult>& results,
+                         const double tolerance);
+
+/**
+ * Generate a synthetic dataset: a mixture of Gaussians with unit variance
+ * around the given number of centers, drawn from the mlpack random number
+ * generator so that it only depends on the seed.
+ *
+ * @param dimensionality Dimensionality of the points.
+ * @param points Number of points.
+ * @param labels Index of the center of each point.
+ * @param centers Number of centers.
+ */
+inline arma::mat SyntheticData(const size_t dimensionality,
+                               const size_t points,
+                               arma::Row<size_t>& labels,
+                               const size_t centers = 10)
+{
+  arma::mat means(dimensionality, centers);
+  for (size_t i = 0; i < means.n_elem; ++i)
+    means[i] = math::Random(-10.0, 10.0);
+
+  arma::mat dataset(dimensionality, points);
+  labels.set_size(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = math::RandInt(centers);
+    for (size_t d = 0; d < dimensionality; ++d)
+      dataset(d, i) = means(d, labels[i]) + math::RandNormal();
+  }
+
+  return dataset;
+}
+
+/**
+ * Generate a synthetic dataset without labels.
+ */
+inline arma::mat SyntheticData(const size_t dimensionality,
+                               const size_t points,
+                               const size_t centers = 10)
+{
+  arma::Row<size_t> labels;
+  return SyntheticData(dimensionality, points, labels, centers);
+}
+
+} // namespace benchmark
+} // namespace mlpack
+
+/**
+ * Define and register a benchmark with the given name.  The body of the
+ * benchmark follows the macro, and has access to a BenchmarkState named
+ * `state`.
+ */
+#define MLPACK_BENCHMARK(NAME) \
+    static void NAME(mlpack::benchmark::BenchmarkState& state); \
+    static const bool NAME##Registered = \
+        mlpack::benchmark::RegisterBenchmark(#NAME, NAME); \
+    static void NAME(mlpack::benchmark::BenchmarkState& state)
+
+#endif
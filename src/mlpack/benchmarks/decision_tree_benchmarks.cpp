@@ -0,0 +1,47 @@
+/**
+ * @file benchmarks/decision_tree_benchmarks.cpp
+ *
+ * Benchmarks of decision tree and random forest training and classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/random_forest/random_forest.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+MLPACK_BENCHMARK(DecisionTreeTrain)
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = SyntheticData(20, state.Scaled(50000), labels);
+
+  state.Measure([&]() { DecisionTree<> tree(dataset, labels, 10, 5); },
+      dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(RandomForestTrain)
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = SyntheticData(20, state.Scaled(20000), labels);
+
+  state.Measure([&]() { RandomForest<> forest(dataset, labels, 10, 20, 5); },
+      dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(RandomForestClassify)
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = SyntheticData(20, state.Scaled(20000), labels);
+  RandomForest<> forest(dataset, labels, 10, 20, 5);
+
+  arma::Row<size_t> predictions;
+  state.Measure([&]() { forest.Classify(dataset, predictions); },
+      dataset.n_cols);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file benchmarks/io_benchmarks.cpp
+ *
+ * Benchmarks of loading datasets and of (de)serializing models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/methods/random_forest/random_forest.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+MLPACK_BENCHMARK(CSVLoad)
+{
+  const arma::mat dataset = SyntheticData(20, state.Scaled(100000));
+  const std::string filename = "mlpack_benchmark_dataset.csv";
+  data::Save(filename, dataset, true);
+
+  arma::mat loaded;
+  state.Measure([&]() { data::Load(filename, loaded, true); },
+      dataset.n_cols);
+
+  std::remove(filename.c_str());
+}
+
+/**
+ * Train the random forest that the serialization benchmarks use.
+ */
+static RandomForest<> TrainForest(BenchmarkState& state)
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = SyntheticData(20, state.Scaled(20000), labels);
+  return RandomForest<>(dataset, labels, 10, 20, 1);
+}
+
+MLPACK_BENCHMARK(RandomForestSerialize)
+{
+  RandomForest<> forest = TrainForest(state);
+  const std::string filename = "mlpack_benchmark_model.bin";
+
+  state.Measure([&]() { data::Save(filename, "model", forest, true); }, 1);
+
+  std::remove(filename.c_str());
+}
+
+MLPACK_BENCHMARK(RandomForestDeserialize)
+{
+  RandomForest<> forest = TrainForest(state);
+  const std::string filename = "mlpack_benchmark_model.bin";
+  data::Save(filename, "model", forest, true);
+
+  RandomForest<> loaded;
+  state.Measure([&]() { data::Load(filename, "model", loaded, true); }, 1);
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,68 @@
+/**
+ * @file benchmarks/kmeans_benchmarks.cpp
+ *
+ * Benchmarks of k-means clustering with each of the Lloyd step types.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/kmeans/elkan_kmeans.hpp>
+#include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
+#include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::kmeans;
+using namespace mlpack::metric;
+
+/**
+ * Time ten iterations of k-means (k = 20) with the given Lloyd step type.  The
+ * initial centroids are fixed, so every run does the same work.
+ */
+template<template<class, class> class LloydStepType>
+static void KMeansIterations(BenchmarkState& state)
+{
+  const arma::mat dataset = SyntheticData(5, state.Scaled(100000), 20);
+  const arma::mat initialCentroids = dataset.cols(0, 19);
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      LloydStepType> kmeans(10);
+
+  arma::mat centroids;
+  state.Measure([&]()
+      {
+        centroids = initialCentroids;
+        kmeans.Cluster(dataset, 20, centroids, true);
+      }, dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(KMeansNaive)
+{
+  KMeansIterations<NaiveKMeans>(state);
+}
+
+MLPACK_BENCHMARK(KMeansElkan)
+{
+  KMeansIterations<ElkanKMeans>(state);
+}
+
+MLPACK_BENCHMARK(KMeansHamerly)
+{
+  KMeansIterations<HamerlyKMeans>(state);
+}
+
+MLPACK_BENCHMARK(KMeansPellegMoore)
+{
+  KMeansIterations<PellegMooreKMeans>(state);
+}
+
+MLPACK_BENCHMARK(KMeansDualTree)
+{
+  KMeansIterations<DefaultDualTreeKMeans>(state);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file benchmarks/main.cpp
+ *
+ * Entry point of mlpack_benchmarks, which runs the registered benchmarks and
+ * writes their results as JSON.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <fstream>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+static void PrintUsage()
+{
+  std::cout << "Usage: mlpack_benchmarks [options]\n"
+      << "\n"
+      << "Runs the mlpack benchmark suite on synthetic data and writes the\n"
+      << "results (latency, throughput and peak RSS of every benchmark) as\n"
+      << "JSON.\n"
+      << "\n"
+      << "  --list              List the benchmarks and exit.\n"
+      << "  --filter <str>      Only run benchmarks whose name contains "
+      << "<str>.\n"
+      << "  --repetitions <n>   Number of timed runs per benchmark "
+      << "(default 5).\n"
+      << "  --scale <x>         Multiply all problem sizes by <x> "
+      << "(default 1).\n"
+      << "  --seed <n>          Random seed (default 42).\n"
+      << "  --counters          Also collect performance counters.\n"
+      << "  --output <file>     Write the JSON results to <file> instead of "
+      << "stdout.\n"
+      << "  --baseline <file>   Compare against the results of an earlier "
+      << "run, and\n"
+      << "                      exit with an error on regressions.\n"
+      << "  --tolerance <x>     Allowed relative slowdown against the baseline "
+      << "(default\n"
+      << "                      0.1).\n"
+      << "  --verbose           Print progress information.\n";
+}
+
+int main(int argc, char** argv)
+{
+  BenchmarkOptions options;
+  std::string filter, output, baseline;
+  double tolerance = 0.1;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      PrintUsage();
+      return 0;
+    }
+    else if (arg == "--list")
+      list = true;
+    else if (arg == "--counters")
+      options.counters = true;
+    else if (arg == "--verbose" || arg == "-v")
+      Log::Info.ignoreInput = false;
+    else if (arg == "--filter" && hasValue)
+      filter = argv[++i];
+    else if (arg == "--repetitions" && hasValue)
+      options.repetitions = std::stoul(argv[++i]);
+    else if (arg == "--scale" && hasValue)
+      options.scale = std::stod(argv[++i]);
+    else if (arg == "--seed" && hasValue)
+      options.seed = std::stoul(argv[++i]);
+    else if (arg == "--output" && hasValue)
+      output = argv[++i];
+    else if (arg == "--baseline" && hasValue)
+      baseline = argv[++i];
+    else if (arg == "--tolerance" && hasValue)
+      tolerance = std::stod(argv[++i]);
+    else
+    {
+      std::cerr << "Unknown or incomplete option '" << arg << "'." << std::endl;
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  if (options.repetitions == 0)
+  {
+    std::cerr << "--repetitions must be positive." << std::endl;
+    return 1;
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (const std::pair<std::string, BenchmarkFunction>& b : Benchmarks())
+  {
+    if (b.first.find(filter) == std::string::npos)
+      continue;
+
+    if (list)
+    {
+      std::cout << b.first << std::endl;
+      continue;
+    }
+
+    Log::Info << "Running " << b.first << "..." << std::endl;
+    results.push_back(RunBenchmark(b.first, b.second, options));
+    Log::Info << "  median latency " << results.back().MedianLatency()
+        << "s, throughput " << results.back().Throughput() << " items/s."
+        << std::endl;
+  }
+
+  if (list)
+    return 0;
+
+  if (output.empty())
+  {
+    WriteJSON(std::cout, results, options);
+  }
+  else
+  {
+    std::ofstream stream(output);
+    if (!stream.is_open())
+    {
+      std::cerr << "Cannot open '" << output << "' for writing." << std::endl;
+      return 1;
+    }
+    WriteJSON(stream, results, options);
+  }
+
+  if (!baseline.empty())
+  {
+    const size_t regressions = CompareToBaseline(baseline, results, tolerance);
+    if (regressions > 0)
+    {
+      std::cerr << regressions << " benchmark(s) regressed by more than "
+          << (100 * tolerance) << "% against the baseline." << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
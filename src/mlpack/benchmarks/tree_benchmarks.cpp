@@ -0,0 +1,123 @@
+/**
+ * @file benchmarks/tree_benchmarks.cpp
+ *
+ * Benchmarks of tree construction and of the tree-based algorithms: kNN, range
+ * search, EMST and KDE.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+#include <mlpack/methods/kde/kde.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+using namespace mlpack::metric;
+using namespace mlpack::neighbor;
+using namespace mlpack::range;
+
+/**
+ * Time the construction of the given tree type on a 10-dimensional dataset.
+ */
+template<typename TreeType>
+static void TreeBuild(BenchmarkState& state)
+{
+  const arma::mat dataset = SyntheticData(10, state.Scaled(100000));
+  state.Measure([&]() { TreeType tree(dataset); }, dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(KDTreeBuild)
+{
+  TreeBuild<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>>(state);
+}
+
+MLPACK_BENCHMARK(BallTreeBuild)
+{
+  TreeBuild<BallTree<EuclideanDistance, EmptyStatistic, arma::mat>>(state);
+}
+
+MLPACK_BENCHMARK(CoverTreeBuild)
+{
+  TreeBuild<StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>>(
+      state);
+}
+
+/**
+ * Time an all-kNN search (k = 5) with the given tree type and search mode; the
+ * reference tree is built before timing.
+ */
+template<template<typename, typename, typename> class TreeType>
+static void KNNSearch(BenchmarkState& state, const NeighborSearchMode mode)
+{
+  const arma::mat dataset = SyntheticData(10, state.Scaled(50000));
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      knn(dataset, mode);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  state.Measure([&]() { knn.Search(5, neighbors, distances); },
+      dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(KDTreeKNNDualTree)
+{
+  KNNSearch<KDTree>(state, DUAL_TREE_MODE);
+}
+
+MLPACK_BENCHMARK(KDTreeKNNSingleTree)
+{
+  KNNSearch<KDTree>(state, SINGLE_TREE_MODE);
+}
+
+MLPACK_BENCHMARK(BallTreeKNNDualTree)
+{
+  KNNSearch<BallTree>(state, DUAL_TREE_MODE);
+}
+
+MLPACK_BENCHMARK(CoverTreeKNNDualTree)
+{
+  KNNSearch<StandardCoverTree>(state, DUAL_TREE_MODE);
+}
+
+MLPACK_BENCHMARK(KDTreeRangeSearch)
+{
+  const arma::mat dataset = SyntheticData(5, state.Scaled(30000));
+  RangeSearch<> rs(dataset);
+
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  state.Measure([&]() { rs.Search(math::Range(0.0, 1.0), neighbors,
+      distances); }, dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(DualTreeBoruvkaEMST)
+{
+  const arma::mat dataset = SyntheticData(3, state.Scaled(50000));
+
+  arma::mat results;
+  state.Measure([&]()
+      {
+        emst::DualTreeBoruvka<> dtb(dataset);
+        dtb.ComputeMST(results);
+      }, dataset.n_cols);
+}
+
+MLPACK_BENCHMARK(KDTreeKDE)
+{
+  const arma::mat reference = SyntheticData(3, state.Scaled(50000));
+  const arma::mat query = SyntheticData(3, state.Scaled(10000));
+  kde::KDE<> kde(0.05, 0.0);
+  kde.Train(reference);
+
+  arma::vec estimations;
+  state.Measure([&]() { kde.Evaluate(query, estimations); }, query.n_cols);
+}
@@ -3,7 +3,8 @@
  * @author Ryan Curtin
  * @author Matthew Amidon
  *
- * Terminate the program; handle --verbose option; print output parameters.
+ * Terminate the program; handle --verbose and --counters_file options; print
+ * output parameters.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -14,6 +15,7 @@
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
 #include <mlpack/core/util/io.hpp>
+#include <fstream>
 
 namespace mlpack {
 namespace bindings {
@@ -64,6 +66,32 @@ inline void EndProgram()
       Log::Info << "  " << it2.first << ": ";
       IO::GetSingleton().timer.PrintTimer(it2.first);
     }
+
+    const std::map<std::string, double> counters =
+        IO::GetSingleton().counters.GetAllCounters();
+    if (!counters.empty())
+    {
+      Log::Info << "Program counters:" << std::endl;
+      for (auto& it2 : counters)
+        Log::Info << "  " << it2.first << ": " << it2.second << std::endl;
+    }
+  }
+
+  // Write the timers and counters, if requested.
+  if (IO::HasParam("counters_file"))
+  {
+    const std::string filename = IO::GetParam<std::string>("counters_file");
+    std::ofstream stream(filename);
+    if (!stream.is_open())
+    {
+      Log::Warn << "Cannot open file '" << filename << "' to write the "
+          << "performance counters." << std::endl;
+    }
+    else
+    {
+      IO::GetSingleton().counters.WriteJSON(stream,
+          IO::GetSingleton().timer.GetAllTimers());
+    }
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
@@ -28,6 +28,8 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("counters_file", "If specified, the timers and performance "
+    "counters of the run are written to the given file as JSON.", "", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -129,6 +131,10 @@ void ParseCommandLine(int argc, char** argv)
     Log::Info.ignoreInput = false;
   }
 
+  // Collect performance counters if they will be printed or written.
+  if (IO::HasParam("verbose") || IO::HasParam("counters_file"))
+    Counter::EnableCounting();
+
   // Now, issue an error if we forgot any required options.
   for (std::map<std::string, util::ParamData>::const_iterator iter =
        parameters.begin(); iter != parameters.end(); ++iter)
@@ -165,10 +165,11 @@ std::string PrintTypeDoc(
     const typename boost::disable_if<arma::is_arma_type<T>>::type*,
     const typename boost::enable_if<data::HasSerialize<T>>::type*)
 {
-  return "A filename containing an mlpack model.  These can have one of three "
-      "formats: binary (.bin), text (.txt), and XML (.xml).  The XML format "
-      "produces the largest (but most human-readable) files, while the binary "
-      "format can be significantly more compact and quicker to load and save.";
+  return "A filename containing an mlpack model.  These can have one of four "
+      "formats: binary (.bin), text (.txt), XML (.xml), and flat binary "
+      "(.flat).  The XML format produces the largest (but most human-readable) "
+      "files, while the binary formats can be significantly more compact and "
+      "quicker to load and save; the flat binary format is the fastest.";
 }
 
 } // namespace cli
@@ -62,7 +62,8 @@ class MDOption
     data.loaded = false;
     // Several options from Python and CLI bindings are persistent.
     if (identifier == "verbose" || identifier == "copy_all_inputs" ||
-        identifier == "help" || identifier == "info" || identifier == "version")
+        identifier == "help" || identifier == "info" ||
+        identifier == "version" || identifier == "counters_file")
       data.persistent = true;
     else
       data.persistent = false;
@@ -96,7 +97,8 @@ class MDOption
     // Add the option.
     IO::Add(std::move(data));
     if (identifier != "verbose" && identifier != "copy_all_inputs" &&
-        identifier != "help" && identifier != "info" && identifier != "version")
+        identifier != "help" && identifier != "info" &&
+        identifier != "version" && identifier != "counters_file")
       IO::StoreSettings(bindingName);
     IO::ClearSettings();
   }
@@ -122,7 +122,8 @@ void PrintDocs(const std::string& bindingName,
         continue;
       if (languages[i] != "cli" &&
           (it->second.name == "help" || it->second.name == "info" ||
-           it->second.name == "version"))
+           it->second.name == "version" ||
+           it->second.name == "counters_file"))
         continue;
 
       // Print name, type, description, default.
@@ -151,7 +152,8 @@ void PrintDocs(const std::string& bindingName,
       cout << desc; // just a string
       // Print whether or not it's a "special" language-only parameter.
       if (it->second.name == "copy_all_inputs" || it->second.name == "help" ||
-          it->second.name == "info" || it->second.name == "version")
+          it->second.name == "info" || it->second.name == "version" ||
+          it->second.name == "counters_file")
       {
         cout << "  <span class=\"special\">Only exists in "
             << PrintLanguage(languages[i]) << " binding.</span>";
@@ -199,7 +201,8 @@ void PrintDocs(const std::string& bindingName,
       cout << it->second.desc;
       // Print whether or not it's a "special" language-only parameter.
       if (it->second.name == "copy_all_inputs" || it->second.name == "help" ||
-          it->second.name == "info" || it->second.name == "version")
+          it->second.name == "info" || it->second.name == "version" ||
+          it->second.name == "counters_file")
       {
         cout << "  <span class=\"special\">Only exists in "
             << PrintLanguage(languages[i]) << " binding.</span>";
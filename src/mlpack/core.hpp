@@ -81,6 +81,7 @@
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/math/round.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/core/math/gather_columns.hpp>
 #include <mlpack/core/math/ccov.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/dists/discrete_distribution.hpp>
@@ -12,6 +12,21 @@
 template<typename Archive>
 void serialize(Archive& ar, const unsigned int version);
 
+//! Get the elements from an archive that can map them (see serialize()).
+template<typename Archive>
+auto serialize_mapped_memory(Archive& ar, int)
+    -> decltype(ar.template MapArray<eT>(size_t(0)))
+{
+  return ar.template MapArray<eT>(n_elem);
+}
+
+//! Other archives give nothing, so that the elements are copied.
+template<typename Archive>
+const eT* serialize_mapped_memory(Archive& /* ar */, long)
+{
+  return NULL;
+}
+
 /**
  * These will help us refer the proper vector / column types, only with
  * specifying the matrix type we want to use.
@@ -36,6 +36,35 @@ void Mat<eT>::serialize(Archive& ar, const unsigned int /* version */)
 
     access::rw(mem_state) = 0;
 
+    // Archives that can map the elements from their storage (such as
+    // mlpack::data::FlatInputArchive on a memory-mapped file) give them to us,
+    // and then the matrix uses that memory instead of a copy.
+    const eT* mapped = serialize_mapped_memory(ar, 0);
+    if (mapped != NULL)
+    {
+      const uword mappedRows = n_rows;
+      const uword mappedCols = n_cols;
+      const uword mappedElem = n_elem;
+
+      // Reset the allocation of the matrix before using the memory.
+      access::rw(n_rows) = 0;
+      access::rw(n_cols) = 0;
+      access::rw(n_elem) = 0;
+      init_cold();
+
+      access::rw(n_rows) = mappedRows;
+      access::rw(n_cols) = mappedCols;
+      access::rw(n_elem) = mappedElem;
+#if ((ARMA_VERSION_MAJOR >= 11) || \
+    ((ARMA_VERSION_MAJOR == 10) && (ARMA_VERSION_MINOR >= 5)))
+      // Armadillo 10.5+ tracks the size of the allocation separately.
+      access::rw(n_alloc) = 0;
+#endif
+      access::rw(mem) = mapped;
+      access::rw(mem_state) = 1;
+      return;
+    }
+
     // We also need to allocate the memory we're using.
     init_cold();
   }
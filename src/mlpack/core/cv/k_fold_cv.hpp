@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/cv_base.hpp>
+#include <exception>
 
 namespace mlpack {
 namespace cv {
@@ -44,6 +45,12 @@ namespace cv {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * The k models can be trained concurrently by setting @c NumThreads() to a
+ * value other than 1 (0 means the OpenMP default).  Each fold is passed to
+ * the machine learning algorithm as a view of the stored data, so no data is
+ * copied during evaluation; the algorithm itself must then be safe to train
+ * from several threads at once.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -168,6 +175,14 @@ class KFoldCV
           const WeightsType& weights,
           const bool shuffle = true);
 
+  /**
+   * Copy the data and the settings of the given KFoldCV object.  The model
+   * from the last run of the given object is not copied.
+   *
+   * @param other KFoldCV object to copy.
+   */
+  KFoldCV(const KFoldCV& other);
+
   /**
    * Run k-fold cross-validation.
    *
@@ -180,6 +195,12 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the number of threads used to train the folds (0 means the default).
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads used to train the folds (0 means the
+  //! default).
+  size_t& NumThreads() { return numThreads; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +246,9 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The number of threads used to train the folds.
+  size_t numThreads;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -254,7 +278,19 @@ class KFoldCV
   void InitKFoldCVMat(const DataType& source, DataType& destination);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Permute the original columns of a matrix initialized by InitKFoldCVMat()
+   * in place with the given ordering, and update the repeated columns
+   * accordingly.
+   *
+   * @param ordering The new order of the original columns.
+   * @param data The matrix to permute.
+   */
+  template<typename DataType>
+  void PermuteKFoldCVMat(const arma::uvec& ordering, DataType& data);
+
+  /**
+   * Train and run evaluation in the case of non-weighted learning.  The folds
+   * are processed in parallel when more than one thread is used.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
@@ -262,7 +298,8 @@ class KFoldCV
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
-   * Train and run evaluation in the case of supporting weighted learning.
+   * Train and run evaluation in the case of supporting weighted learning.  The
+   * folds are processed in parallel when more than one thread is used.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = Base::MIE::SupportsWeights,
@@ -270,6 +307,16 @@ class KFoldCV
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
+  /**
+   * Train a model for each fold with the given function (which should return
+   * the model trained on the ith training subset), evaluate it on the ith
+   * validation subset, and return the mean of the evaluations.  The model of
+   * the last fold is kept.  If training throws for any fold, the exception is
+   * rethrown after all folds have been processed.
+   */
+  template<typename TrainFunction>
+  double EvaluateFolds(const TrainFunction& train);
+
   /**
    * Calculate the index of the first column of the ith validation subset.
    *
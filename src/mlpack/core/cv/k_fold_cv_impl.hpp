@@ -135,7 +135,8 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    numThreads(1)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +167,8 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    numThreads(1)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -179,6 +181,26 @@ KFoldCV<MLAlgorithm,
     Shuffle();
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+KFoldCV<MLAlgorithm,
+        Metric,
+        MatType,
+        PredictionsType,
+        WeightsType>::KFoldCV(const KFoldCV& other) :
+    base(other.base),
+    k(other.k),
+    xs(other.xs),
+    ys(other.ys),
+    weights(other.weights),
+    lastBinSize(other.lastBinSize),
+    binSize(other.binSize),
+    numThreads(other.numThreads)
+{ /* Nothing left to do. */ }
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -232,6 +254,50 @@ void KFoldCV<MLAlgorithm,
       source.cols(0, source.n_cols - lastBinSize - 1));
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename DataType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::PermuteKFoldCVMat(const arma::uvec& ordering,
+                                             DataType& data)
+{
+  // Follow the cycles of the permutation, so that only one column has to be
+  // buffered at a time.
+  const size_t n = ordering.n_elem;
+  std::vector<bool> visited(n, false);
+  for (size_t start = 0; start < n; ++start)
+  {
+    if (visited[start])
+      continue;
+
+    DataType buffer = data.col(start);
+    size_t i = start;
+    while (true)
+    {
+      visited[i] = true;
+      const size_t next = ordering[i];
+      if (next == start)
+      {
+        data.col(i) = buffer;
+        break;
+      }
+
+      data.col(i) = data.col(next);
+      i = next;
+    }
+  }
+
+  // Refresh the repeated columns at the end (see InitKFoldCVMat()).
+  if (data.n_cols > n)
+    data.cols(n, data.n_cols - 1) = data.cols(0, data.n_cols - n - 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -244,19 +310,11 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  return EvaluateFolds([&](const size_t i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
-
-  return arma::mean(evaluations);
+    return base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+        args...);
+  });
 }
 
 template<typename MLAlgorithm,
@@ -271,21 +329,57 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  return EvaluateFolds([&](const size_t i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
+    return (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             GetTrainingSubset(weights, i), args...) :
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  });
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TrainFunction>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateFolds(const TrainFunction& train)
+{
+  arma::vec evaluations(k);
+  std::exception_ptr exception;
+
+  // The folds are independent: every model is trained on a view of the stored
+  // data, and only the thread handling the last fold writes modelPtr.
+  #pragma omp parallel for schedule(dynamic) \
+      num_threads(numThreads == 0 ? omp_get_max_threads() : numThreads)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
+  {
+    try
+    {
+      MLAlgorithm model = train(i);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      // Exceptions cannot leave an OpenMP region, so keep the first one.
+      #pragma omp critical
+      if (!exception)
+        exception = std::current_exception();
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return arma::mean(evaluations);
 }
 
@@ -301,14 +395,11 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+  const arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      (k - 1) * binSize + lastBinSize - 1, (k - 1) * binSize + lastBinSize));
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  PermuteKFoldCVMat(ordering, xs);
+  PermuteKFoldCVMat(ordering, ys);
 }
 
 template<typename MLAlgorithm,
@@ -323,22 +414,13 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
-  if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
-  else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+  const arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      (k - 1) * binSize + lastBinSize - 1, (k - 1) * binSize + lastBinSize));
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  PermuteKFoldCVMat(ordering, xs);
+  PermuteKFoldCVMat(ordering, ys);
   if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+    PermuteKFoldCVMat(ordering, weights);
 }
 
 template<typename MLAlgorithm,
@@ -0,0 +1,125 @@
+/**
+ * @file core/data/chunked_loader.hpp
+ *
+ * Definition of the ChunkedLoader class, which reads a dataset from disk a
+ * block of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_LOADER_HPP
+#define MLPACK_CORE_DATA_CHUNKED_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "flat_archive.hpp"
+
+namespace mlpack {
+namespace data /** Functions to load and save matrices and models. */ {
+
+/**
+ * The ChunkedLoader reads a dataset from disk in blocks of points, so that
+ * learners with an incremental training algorithm can be trained on datasets
+ * that do not fit in memory.  The file is mapped read-only into memory (see
+ * MappedFile), so its pages are only read from the disk when a block uses
+ * them and can be dropped again afterwards, and only one block is copied into
+ * a matrix at a time.
+ *
+ * Like data::Load(), the file is expected to hold one point per row, and every
+ * block is returned with one point per column.  The following formats are
+ * supported, chosen from the extension of the file:
+ *
+ *  - csv, tsv, txt: one point per line, with values separated by commas or
+ *    whitespace.
+ *  - bin: Armadillo binary format, as written by data::Save().  The points of
+ *    a block are copied with one contiguous copy per dimension.
+ *
+ * @code
+ * data::ChunkedLoader<> loader("dataset.csv", 10000);
+ * arma::mat chunk;
+ * while (loader.Next(chunk))
+ *   model.Train(chunk, ...);
+ * @endcode
+ *
+ * @tparam eT Element type of the returned blocks.
+ */
+template<typename eT = double>
+class ChunkedLoader
+{
+ public:
+  /**
+   * Open the given file and read its dimensionality.  A std::runtime_error is
+   * thrown if the file can't be opened or mapped, or has an unsupported
+   * format.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Maximum number of points in each block.
+   */
+  ChunkedLoader(const std::string& filename, const size_t chunkSize = 10000);
+
+  /**
+   * Read the next block of points.  Returns false (and leaves the block empty)
+   * if every point of the file has already been read.
+   *
+   * @param chunk Matrix to store the block in, with one point per column.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  /**
+   * Go back to the first point of the file, so that the dataset can be read
+   * again.
+   */
+  void Reset();
+
+  //! Get the name of the file.
+  const std::string& Filename() const { return filename; }
+  //! Get the number of dimensions of the points.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the maximum number of points in each block.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Modify the maximum number of points in each block.
+  size_t& ChunkSize() { return chunkSize; }
+
+ private:
+  //! Read the next block of a text file.
+  bool NextText(arma::Mat<eT>& chunk);
+  //! Read the next block of an Armadillo binary file.
+  bool NextBinary(arma::Mat<eT>& chunk);
+
+  //! Get the next line of a text file.  Returns false at the end of the file.
+  bool NextLine(std::string& line);
+
+  //! Split a line of a text file into values.  Returns false if the line is
+  //! empty.
+  bool ParseLine(const std::string& line, std::vector<eT>& values) const;
+
+  //! The name of the file.
+  std::string filename;
+  //! The mapping of the file.
+  MappedFile file;
+  //! Whether the file is in Armadillo binary format.
+  bool binary;
+  //! The number of dimensions of the points.
+  size_t dimensionality;
+  //! The maximum number of points in each block.
+  size_t chunkSize;
+  //! The number of points of a binary file.
+  size_t numPoints;
+  //! The offset of the first line of a text file, or of the first value of a
+  //! binary file.
+  size_t dataOffset;
+  //! The offset of the next line of a text file.
+  size_t offset;
+  //! The index of the next point to read.
+  size_t position;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * @file core/data/chunked_loader_impl.hpp
+ *
+ * Implementation of the ChunkedLoader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_LOADER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_loader.hpp"
+#include "extension.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ChunkedLoader<eT>::ChunkedLoader(const std::string& filename,
+                                 const size_t chunkSize) :
+    filename(filename),
+    binary(false),
+    dimensionality(0),
+    chunkSize(chunkSize),
+    numPoints(0),
+    dataOffset(0),
+    offset(0),
+    position(0)
+{
+  if (chunkSize == 0)
+  {
+    throw std::invalid_argument("ChunkedLoader::ChunkedLoader(): the chunk "
+        "size must be positive!");
+  }
+
+  const std::string extension = Extension(filename);
+  if (extension == "bin")
+  {
+    binary = true;
+  }
+  else if (extension != "csv" && extension != "tsv" && extension != "txt")
+  {
+    std::ostringstream oss;
+    oss << "ChunkedLoader::ChunkedLoader(): unsupported extension '"
+        << extension << "' of file '" << filename << "'!";
+    throw std::runtime_error(oss.str());
+  }
+
+  // The file is only read, so it is mapped read-only: the mapping is then
+  // backed by the file, and doesn't need as much memory as the file.
+  if (!file.Map(filename, true))
+  {
+    std::ostringstream oss;
+    oss << "ChunkedLoader::ChunkedLoader(): cannot open or map file '"
+        << filename << "'!";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (binary)
+  {
+    // The header is the type of the matrix, followed by its size.  The file
+    // holds one point per row, so each dimension is a contiguous column.
+    std::string header, size;
+    NextLine(header);
+    if (header != arma::diskio::gen_bin_header(arma::Mat<eT>()))
+    {
+      std::ostringstream oss;
+      oss << "ChunkedLoader::ChunkedLoader(): file '" << filename << "' does "
+          << "not hold a matrix of the requested element type!";
+      throw std::runtime_error(oss.str());
+    }
+
+    std::istringstream sizeStream;
+    if (NextLine(size))
+      sizeStream.str(size);
+    sizeStream >> numPoints >> dimensionality;
+    dataOffset = offset;
+    if (sizeStream.fail() || dataOffset + numPoints * dimensionality *
+        sizeof(eT) > file.Size())
+    {
+      std::ostringstream oss;
+      oss << "ChunkedLoader::ChunkedLoader(): cannot read the size of the "
+          << "matrix in file '" << filename << "', or the file is truncated!";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  else
+  {
+    // The dimensionality is the number of values of the first point.
+    std::string line;
+    std::vector<eT> values;
+    while (NextLine(line))
+    {
+      if (ParseLine(line, values))
+      {
+        dimensionality = values.size();
+        break;
+      }
+    }
+
+    Reset();
+  }
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::Next(arma::Mat<eT>& chunk)
+{
+  return binary ? NextBinary(chunk) : NextText(chunk);
+}
+
+template<typename eT>
+void ChunkedLoader<eT>::Reset()
+{
+  offset = dataOffset;
+  position = 0;
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::NextText(arma::Mat<eT>& chunk)
+{
+  chunk.set_size(dimensionality, chunkSize);
+
+  std::string line;
+  std::vector<eT> values;
+  size_t points = 0;
+  while (points < chunkSize && NextLine(line))
+  {
+    if (!ParseLine(line, values))
+      continue;
+
+    if (values.size() != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "ChunkedLoader::Next(): point " << position << " of file '"
+          << filename << "' has " << values.size() << " dimensions, but "
+          << "the first point has " << dimensionality << " dimensions!";
+      throw std::runtime_error(oss.str());
+    }
+
+    std::copy(values.begin(), values.end(), chunk.colptr(points));
+    ++points;
+    ++position;
+  }
+
+  chunk.resize(dimensionality, points);
+  return (points > 0);
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::NextBinary(arma::Mat<eT>& chunk)
+{
+  const size_t points = std::min(chunkSize, numPoints - position);
+  if (points == 0)
+  {
+    chunk.reset();
+    return false;
+  }
+
+  // Copy the values of the block one dimension at a time, and then transpose
+  // them into one point per column.  The size of the file was checked when it
+  // was opened.
+  arma::Mat<eT> values(points, dimensionality);
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    std::memcpy(values.colptr(d), file.Data() + dataOffset +
+        (d * numPoints + position) * sizeof(eT), points * sizeof(eT));
+  }
+
+  chunk = values.t();
+  position += points;
+  return true;
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::NextLine(std::string& line)
+{
+  if (offset >= file.Size())
+    return false;
+
+  // The mapping isn't terminated, so the line is copied to be parsed.
+  const char* begin = file.Data() + offset;
+  const char* end = (const char*) std::memchr(begin, '\n',
+      file.Size() - offset);
+  if (end == NULL)
+    end = file.Data() + file.Size();
+
+  line.assign(begin, end);
+  offset = (end - file.Data()) + 1;
+  return true;
+}
+
+template<typename eT>
+bool ChunkedLoader<eT>::ParseLine(const std::string& line,
+                                  std::vector<eT>& values) const
+{
+  values.clear();
+
+  // Values may be separated by commas, with or without whitespace.  strtod()
+  // also reads "nan" and "inf".
+  const char* current = line.c_str();
+  while (true)
+  {
+    while (*current == ',' || std::isspace((unsigned char) *current))
+      ++current;
+    if (*current == '\0')
+      break;
+
+    char* next;
+    const double value = std::strtod(current, &next);
+    if (next == current || (*next != '\0' && *next != ',' &&
+        !std::isspace((unsigned char) *next)))
+    {
+      const size_t length = std::strcspn(current, ", \t\r\n");
+      std::ostringstream oss;
+      oss << "ChunkedLoader::Next(): cannot parse value '"
+          << std::string(current, length) << "' of file '" << filename
+          << "'!";
+      throw std::runtime_error(oss.str());
+    }
+
+    values.push_back((eT) value);
+    current = next;
+  }
+
+  return !values.empty();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file core/data/flat_archive.cpp
+ *
+ * Implementation of the non-templated parts of FlatOutputArchive and
+ * FlatInputArchive, and of MappedFile.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "flat_archive.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+const uint32_t FlatArchive::FormatVersion;
+const unsigned int FlatArchive::LibraryVersion;
+const size_t FlatArchive::HeaderSize;
+
+//! The magic bytes at the start of every flat archive.
+static const char flatMagic[8] = { 'M', 'L', 'P', 'K', 'F', 'L', 'A', 'T' };
+
+//! The byte order mark, as written on the machine that wrote the archive.
+static const uint32_t flatByteOrder = 0x01020304;
+
+void FlatArchive::WriteHeader(char* header)
+{
+  const uint32_t fields[4] = { FormatVersion, flatByteOrder,
+      (uint32_t) sizeof(size_t), (uint32_t) sizeof(arma::uword) };
+
+  std::memcpy(header, flatMagic, sizeof(flatMagic));
+  std::memcpy(header + sizeof(flatMagic), fields, sizeof(fields));
+}
+
+void FlatArchive::CheckHeader(const char* header)
+{
+  if (std::memcmp(header, flatMagic, sizeof(flatMagic)) != 0)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::invalid_signature);
+  }
+
+  uint32_t fields[4];
+  std::memcpy(fields, header + sizeof(flatMagic), sizeof(fields));
+  if (fields[0] > FormatVersion)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::unsupported_version);
+  }
+
+  if (fields[1] != flatByteOrder || fields[2] != sizeof(size_t) ||
+      fields[3] != sizeof(arma::uword))
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::incompatible_native_format);
+  }
+}
+
+FlatOutputArchive::FlatOutputArchive(std::ostream& stream) :
+    stream(stream),
+    position(0)
+{
+  char header[FlatArchive::HeaderSize];
+  FlatArchive::WriteHeader(header);
+  Write(header, FlatArchive::HeaderSize);
+}
+
+void FlatOutputArchive::save_binary(const void* address,
+                                    const std::size_t count)
+{
+  Write(address, count);
+}
+
+void FlatOutputArchive::Save(const std::string& s)
+{
+  const uint64_t length = s.size();
+  Write(&length, sizeof(uint64_t));
+  Write(s.data(), s.size());
+}
+
+void FlatOutputArchive::SaveArray(const void* address, const size_t bytes)
+{
+  static const char zeros[64] = { 0 };
+
+  const size_t alignment = FlatArchive::ArrayAlignment(bytes);
+  Write(zeros, (alignment - position % alignment) % alignment);
+  Write(address, bytes);
+}
+
+void FlatOutputArchive::Write(const void* address, const size_t bytes)
+{
+  if (bytes == 0)
+    return;
+
+  // Going through the stream buffer avoids the cost of a sentry per value.
+  if (stream.rdbuf()->sputn((const char*) address, bytes) !=
+      (std::streamsize) bytes)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::output_stream_error);
+  }
+
+  position += bytes;
+}
+
+FlatInputArchive::FlatInputArchive(std::istream& stream) :
+    stream(&stream),
+    data(NULL),
+    size(0),
+    mapArrays(false),
+    position(0)
+{
+  char header[FlatArchive::HeaderSize];
+  Read(header, FlatArchive::HeaderSize);
+  FlatArchive::CheckHeader(header);
+}
+
+FlatInputArchive::FlatInputArchive(const char* data,
+                                   const size_t size,
+                                   const bool mapArrays) :
+    stream(NULL),
+    data(data),
+    size(size),
+    mapArrays(mapArrays),
+    position(0)
+{
+  char header[FlatArchive::HeaderSize];
+  Read(header, FlatArchive::HeaderSize);
+  FlatArchive::CheckHeader(header);
+}
+
+void FlatInputArchive::load_binary(void* address, const std::size_t count)
+{
+  Read(address, count);
+}
+
+void FlatInputArchive::Load(std::string& s)
+{
+  uint64_t length;
+  Read(&length, sizeof(uint64_t));
+  if (data != NULL && length > size - position)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::input_stream_error);
+  }
+
+  s.resize(length);
+  if (length > 0)
+    Read(&s[0], length);
+}
+
+void FlatInputArchive::SkipPadding(const size_t bytes)
+{
+  const size_t alignment = FlatArchive::ArrayAlignment(bytes);
+  const size_t padding = (alignment - position % alignment) % alignment;
+
+  char skipped[64];
+  Read(skipped, padding);
+}
+
+void FlatInputArchive::LoadArray(void* address, const size_t bytes)
+{
+  SkipPadding(bytes);
+  Read(address, bytes);
+}
+
+void FlatInputArchive::Read(void* address, const size_t bytes)
+{
+  if (bytes == 0)
+    return;
+
+  if (stream != NULL)
+  {
+    if (stream->rdbuf()->sgetn((char*) address, bytes) !=
+        (std::streamsize) bytes)
+    {
+      throw boost::archive::archive_exception(
+          boost::archive::archive_exception::input_stream_error);
+    }
+  }
+  else
+  {
+    if (bytes > size - position)
+    {
+      throw boost::archive::archive_exception(
+          boost::archive::archive_exception::input_stream_error);
+    }
+
+    std::memcpy(address, data + position, bytes);
+  }
+
+  position += bytes;
+}
+
+MappedFile::MappedFile() : data(NULL), size(0), readOnly(false)
+{
+  // Nothing to do.
+}
+
+MappedFile::MappedFile(const std::string& filename, const bool readOnly) :
+    data(NULL),
+    size(0),
+    readOnly(false)
+{
+  Map(filename, readOnly);
+}
+
+MappedFile::MappedFile(MappedFile&& other) :
+    data(other.data),
+    size(other.size),
+    readOnly(other.readOnly)
+{
+  other.data = NULL;
+  other.size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+  if (this != &other)
+  {
+    Unmap();
+    data = other.data;
+    size = other.size;
+    readOnly = other.readOnly;
+    other.data = NULL;
+    other.size = 0;
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+bool MappedFile::Map(const std::string& filename, const bool readOnly)
+{
+  Unmap();
+  this->readOnly = readOnly;
+
+#ifdef _WIN32
+  if (readOnly)
+  {
+    HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ,
+        FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+      return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+      CloseHandle(fileHandle);
+      return false;
+    }
+    else if (fileSize.QuadPart == 0)
+    {
+      CloseHandle(fileHandle);
+      return true;
+    }
+
+    // The view keeps the file and the mapping open, so their handles can be
+    // closed right away.
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY,
+        0, 0, NULL);
+    CloseHandle(fileHandle);
+    if (mappingHandle == NULL)
+      return false;
+
+    void* address = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mappingHandle);
+    if (address == NULL)
+      return false;
+
+    data = (char*) address;
+    size = (size_t) fileSize.QuadPart;
+    return true;
+  }
+
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (!ifs.is_open())
+    return false;
+
+  ifs.seekg(0, std::ios::end);
+  const size_t fileSize = (size_t) ifs.tellg();
+  ifs.seekg(0, std::ios::beg);
+  if (fileSize == 0)
+    return true;
+
+  char* buffer = new char[fileSize];
+  if (!ifs.read(buffer, fileSize))
+  {
+    delete[] buffer;
+    return false;
+  }
+
+  data = buffer;
+  size = fileSize;
+  return true;
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0)
+  {
+    close(fd);
+    return false;
+  }
+  else if (fileStat.st_size == 0)
+  {
+    close(fd);
+    return true;
+  }
+  const size_t fileSize = (size_t) fileStat.st_size;
+
+  // A private writable mapping lets objects modify the mapped memory without
+  // changing the file, but it is committed memory.  A shared read-only mapping
+  // is backed by the file itself.
+  void* address = readOnly ?
+      mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0) :
+      mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED)
+    return false;
+
+  data = (char*) address;
+  size = fileSize;
+  return true;
+#endif
+}
+
+void MappedFile::Unmap()
+{
+  if (data == NULL)
+    return;
+
+#ifdef _WIN32
+  if (readOnly)
+    UnmapViewOfFile(data);
+  else
+    delete[] data;
+#else
+  munmap(data, size);
+#endif
+
+  data = NULL;
+  size = 0;
+}
@@ -0,0 +1,451 @@
+/**
+ * @file core/data/flat_archive.hpp
+ *
+ * A compact binary archive for models.  It can be used with the serialize()
+ * functions of all mlpack objects, but unlike boost::archive::binary_oarchive,
+ * it keeps no per-object tracking or class information: objects are written
+ * in the order they are visited, arrays of numbers (such as the memory of
+ * Armadillo matrices) are written as aligned raw blocks, and loading can map
+ * those blocks directly from a memory-mapped file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FLAT_ARCHIVE_HPP
+#define MLPACK_CORE_DATA_FLAT_ARCHIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/basic_archive.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/version.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Properties of the flat binary format that are shared by FlatOutputArchive
+ * and FlatInputArchive.
+ *
+ * A flat archive starts with a 24-byte header: the 8 magic bytes "MLPKFLAT",
+ * the format version, a byte order mark, and the sizes of size_t and
+ * arma::uword, each as a 32-bit integer.  Numbers are stored in the byte order
+ * of the machine that wrote the archive (little-endian on every platform
+ * mlpack supports); an archive written with a different byte order or word
+ * size cannot be loaded.
+ *
+ * The rest of the archive is the objects themselves, in the order that
+ * serialize() visits them:
+ *
+ *  - numbers are stored as raw bytes, and enums as 32-bit integers;
+ *  - strings are stored as their length followed by their characters;
+ *  - arrays of numbers (from boost::serialization::make_array(), which is
+ *    what Armadillo objects and std::vector use) are stored as a raw block,
+ *    aligned to 64 bytes if it is at least a page long and to 8 bytes
+ *    otherwise;
+ *  - the version of each class is stored once, before its first object;
+ *  - pointers are stored as an identifier; the object pointed to follows the
+ *    first occurrence of each identifier, so objects that are shared between
+ *    several pointers (like the dataset of a tree) are only stored once.
+ */
+class FlatArchive
+{
+ public:
+  //! The format version written by this version of mlpack.
+  static const uint32_t FormatVersion = 1;
+
+  //! The library version reported to boost::serialization.
+  static const unsigned int LibraryVersion = 12;
+
+  //! The size of the header, in bytes.
+  static const size_t HeaderSize = 24;
+
+  /**
+   * Return the alignment of an array of the given size, in bytes.
+   */
+  static size_t ArrayAlignment(const size_t bytes)
+  {
+    return (bytes >= 4096) ? 64 : 8;
+  }
+
+  /**
+   * Fill the given buffer with the header of the archive.
+   */
+  static void WriteHeader(char* header);
+
+  /**
+   * Check the given header, and throw a boost::archive::archive_exception if
+   * the archive cannot be read.
+   */
+  static void CheckHeader(const char* header);
+};
+
+/**
+ * An output archive writing the flat binary format described in FlatArchive.
+ * It provides the interface that boost::serialization expects of an archive,
+ * so it can be used like boost::archive::binary_oarchive:
+ *
+ * @code
+ * std::ofstream ofs("model.flat", std::ios::binary);
+ * data::FlatOutputArchive ar(ofs);
+ * ar << BOOST_SERIALIZATION_NVP(model);
+ * @endcode
+ *
+ * Only pointers are tracked, so an object that is serialized both by value
+ * and through a pointer is written twice.  Polymorphic objects can only be
+ * serialized through pointers to their most derived type.
+ */
+class FlatOutputArchive
+{
+ public:
+  typedef boost::mpl::bool_<false> is_loading;
+  typedef boost::mpl::bool_<true> is_saving;
+
+  /**
+   * Create the archive and write its header to the given stream.
+   *
+   * @param stream Stream to write to; it should be opened in binary mode.
+   */
+  FlatOutputArchive(std::ostream& stream);
+
+  //! Serialize the given object.
+  template<typename T>
+  FlatOutputArchive& operator<<(const T& t)
+  {
+    Save(t);
+    return *this;
+  }
+
+  //! Serialize the given object.
+  template<typename T>
+  FlatOutputArchive& operator&(const T& t)
+  {
+    return *this << t;
+  }
+
+  //! Write the given array of numbers as an aligned raw block.
+  template<typename ArrayType>
+  void save_array(const ArrayType& a, const unsigned int /* version */)
+  {
+    SaveArray(a.address(), a.count() * sizeof(*a.address()));
+  }
+
+  //! Write the given bytes.
+  void save_binary(const void* address, const std::size_t count);
+
+  //! Get the library version, which controls how containers are serialized.
+  boost::archive::library_version_type get_library_version() const
+  {
+    return boost::archive::library_version_type(FlatArchive::LibraryVersion);
+  }
+
+  //! Classes do not need to be registered with this archive.
+  template<typename T>
+  const void* register_type(const T* = NULL) { return NULL; }
+
+ private:
+  //! Write an arithmetic value.
+  template<typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type
+  Save(const T& t);
+
+  //! Write an enum.
+  template<typename T>
+  typename std::enable_if<std::is_enum<T>::value>::type Save(const T& t);
+
+  //! Write a string.
+  void Save(const std::string& s);
+
+  //! Write a pointer, and the object it points to if it was not written yet.
+  template<typename T>
+  void Save(T* const& t);
+
+  //! Write an object.
+  template<typename T>
+  typename std::enable_if<std::is_class<T>::value>::type Save(const T& t);
+
+  //! Write an object that is stored as raw bytes.
+  template<typename T>
+  void SaveObject(const T& t, const std::true_type /* primitive */);
+
+  //! Write an object with its serialize() function.
+  template<typename T>
+  void SaveObject(const T& t, const std::false_type /* primitive */);
+
+  //! Write the version of the given class, if it was not written yet.
+  template<typename T>
+  unsigned int SaveVersion();
+
+  //! Write the given block of memory after padding to its alignment.
+  void SaveArray(const void* address, const size_t bytes);
+
+  //! Write the given bytes.
+  void Write(const void* address, const size_t bytes);
+
+  //! The stream to write to.
+  std::ostream& stream;
+  //! The number of bytes written so far.
+  size_t position;
+  //! The classes whose version was written.
+  std::unordered_set<std::type_index> versions;
+  //! The identifiers of the pointers written so far.
+  std::unordered_map<const void*, uint64_t> pointers;
+};
+
+/**
+ * An input archive reading the flat binary format described in FlatArchive.
+ * It can either read from a stream, or from a block of memory such as a
+ * memory-mapped file; in the latter case, Armadillo matrices can optionally
+ * use the memory of the block directly instead of copying it.
+ *
+ * @code
+ * std::ifstream ifs("model.flat", std::ios::binary);
+ * data::FlatInputArchive ar(ifs);
+ * ar >> BOOST_SERIALIZATION_NVP(model);
+ * @endcode
+ */
+class FlatInputArchive
+{
+ public:
+  typedef boost::mpl::bool_<true> is_loading;
+  typedef boost::mpl::bool_<false> is_saving;
+
+  /**
+   * Create the archive and read its header from the given stream.
+   *
+   * @param stream Stream to read from; it should be opened in binary mode.
+   */
+  FlatInputArchive(std::istream& stream);
+
+  /**
+   * Create the archive and read its header from the given block of memory.
+   * If mapArrays is true, loaded Armadillo matrices point into the block
+   * instead of holding a copy of their elements, so the block must outlive
+   * them.  Such matrices can still be modified and resized as usual; the
+   * block itself is never written to if it is mapped with copy-on-write
+   * semantics, as data::LoadMapped() does.
+   *
+   * @param data Block of memory to read from.
+   * @param size Size of the block, in bytes.
+   * @param mapArrays Whether matrices should point into the block.
+   */
+  FlatInputArchive(const char* data,
+                   const size_t size,
+                   const bool mapArrays = false);
+
+  //! Deserialize the given object.
+  template<typename T>
+  FlatInputArchive& operator>>(T& t)
+  {
+    Load(t);
+    return *this;
+  }
+
+  //! Deserialize the given object.
+  template<typename T>
+  FlatInputArchive& operator&(T& t)
+  {
+    return *this >> t;
+  }
+
+  //! Read the given array of numbers from an aligned raw block.
+  template<typename ArrayType>
+  void load_array(ArrayType& a, const unsigned int /* version */)
+  {
+    LoadArray(a.address(), a.count() * sizeof(*a.address()));
+  }
+
+  /**
+   * If the archive maps arrays, return a pointer to the next array of the
+   * given number of elements in the block of memory and skip it; otherwise,
+   * return NULL and do nothing.  This is used by the serialize() function of
+   * Armadillo matrices.
+   */
+  template<typename eT>
+  const eT* MapArray(const size_t count);
+
+  //! Read the given bytes.
+  void load_binary(void* address, const std::size_t count);
+
+  //! Get the library version, which controls how containers are serialized.
+  boost::archive::library_version_type get_library_version() const
+  {
+    return boost::archive::library_version_type(FlatArchive::LibraryVersion);
+  }
+
+  //! Objects are not tracked, so there is nothing to do.
+  void reset_object_address(const void* /* newAddress */,
+                            const void* /* oldAddress */) { }
+
+  //! Classes do not need to be registered with this archive.
+  template<typename T>
+  const void* register_type(const T* = NULL) { return NULL; }
+
+ private:
+  //! Read an arithmetic value.
+  template<typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value>::type Load(T& t);
+
+  //! Read an enum.
+  template<typename T>
+  typename std::enable_if<std::is_enum<T>::value>::type Load(T& t);
+
+  //! Read a string.
+  void Load(std::string& s);
+
+  //! Read a pointer, and create the object it points to if necessary.
+  template<typename T>
+  void Load(T*& t);
+
+  //! Read an object.  The object is const for wrappers such as nvp.
+  template<typename T>
+  typename std::enable_if<std::is_class<T>::value>::type Load(const T& t);
+
+  //! Read an object that is stored as raw bytes.
+  template<typename T>
+  void LoadObject(T& t, const std::true_type /* primitive */);
+
+  //! Read an object with its serialize() function.
+  template<typename T>
+  void LoadObject(T& t, const std::false_type /* primitive */);
+
+  //! Read the version of the given class, if it was not read yet.
+  template<typename T>
+  unsigned int LoadVersion();
+
+  //! Skip the padding before a block of the given size.
+  void SkipPadding(const size_t bytes);
+
+  //! Read the given block of memory after skipping its padding.
+  void LoadArray(void* address, const size_t bytes);
+
+  //! Read the given bytes.
+  void Read(void* address, const size_t bytes);
+
+  //! The stream to read from, if any.
+  std::istream* stream;
+  //! The block of memory to read from, if there is no stream.
+  const char* data;
+  //! The size of the block of memory.
+  size_t size;
+  //! Whether matrices should point into the block of memory.
+  bool mapArrays;
+  //! The number of bytes read so far.
+  size_t position;
+  //! The version of each class that was read.
+  std::unordered_map<std::type_index, unsigned int> versions;
+  //! The objects created for each pointer identifier, in order.
+  std::vector<void*> pointers;
+};
+
+/**
+ * A file mapped into memory.  The mapping is owned by the MappedFile and
+ * released when it is destroyed, so a MappedFile must outlive every object
+ * whose matrices were loaded from it (see LoadMapped()).
+ *
+ * By default the mapping is private and writable, with copy-on-write
+ * semantics, so that loaded objects can modify their memory without changing
+ * the file; on Windows, the file is read into memory instead.  A private
+ * writable mapping counts against the memory the system can commit, so files
+ * that are only read (such as the datasets of ChunkedLoader) should be mapped
+ * read-only: the pages of a read-only mapping are read from the file when they
+ * are used and can be dropped again at any time, so files larger than the
+ * memory of the system can be mapped.
+ *
+ * An empty file is mapped as an empty block: Map() succeeds, Data() returns
+ * NULL and Size() returns 0.
+ *
+ * A MappedFile can be moved but not copied.
+ */
+class MappedFile
+{
+ public:
+  //! Create an empty MappedFile that holds no file.
+  MappedFile();
+
+  /**
+   * Map the given file.  If it cannot be mapped, Data() returns NULL.
+   *
+   * @param filename Name of the file to map.
+   * @param readOnly Whether to map the file read-only.
+   */
+  MappedFile(const std::string& filename, const bool readOnly = false);
+
+  //! Take the mapping of the given MappedFile.
+  MappedFile(MappedFile&& other);
+  //! Release the current mapping and take the mapping of the given MappedFile.
+  MappedFile& operator=(MappedFile&& other);
+
+  //! Release the mapping.
+  ~MappedFile();
+
+  /**
+   * Release the current mapping, if any, and map the given file.  Returns
+   * false if it could not be mapped.
+   *
+   * @param filename Name of the file to map.
+   * @param readOnly Whether to map the file read-only.
+   */
+  bool Map(const std::string& filename, const bool readOnly = false);
+
+  //! Release the mapping, if any.
+  void Unmap();
+
+  //! Get the address of the mapping, or NULL if no file is mapped.
+  const char* Data() const { return data; }
+  //! Get the size of the mapped file.
+  size_t Size() const { return size; }
+  //! Get whether the file is mapped read-only.
+  bool ReadOnly() const { return readOnly; }
+
+ private:
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  //! The address of the mapping.
+  char* data;
+  //! The size of the mapping.
+  size_t size;
+  //! Whether the file is mapped read-only.
+  bool readOnly;
+};
+
+} // namespace data
+} // namespace mlpack
+
+namespace boost {
+namespace serialization {
+
+//! Arrays of numbers are written as raw blocks.
+template<>
+struct use_array_optimization<mlpack::data::FlatOutputArchive>
+{
+  template<typename ValueType>
+  struct apply : public boost::mpl::bool_<std::is_arithmetic<
+      typename boost::remove_const<ValueType>::type>::value> { };
+};
+
+//! Arrays of numbers are read from raw blocks.
+template<>
+struct use_array_optimization<mlpack::data::FlatInputArchive>
+{
+  template<typename ValueType>
+  struct apply : public boost::mpl::bool_<std::is_arithmetic<
+      typename boost::remove_const<ValueType>::type>::value> { };
+};
+
+} // namespace serialization
+} // namespace boost
+
+// Include implementation.
+#include "flat_archive_impl.hpp"
+
+#endif
@@ -0,0 +1,243 @@
+/**
+ * @file core/data/flat_archive_impl.hpp
+ *
+ * Implementation of the templated methods of FlatOutputArchive and
+ * FlatInputArchive.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FLAT_ARCHIVE_IMPL_HPP
+#define MLPACK_CORE_DATA_FLAT_ARCHIVE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_archive.hpp"
+
+namespace mlpack {
+namespace data {
+
+//! Whether objects of the given type are stored as raw bytes.
+template<typename T>
+struct IsFlatPrimitive : public std::integral_constant<bool,
+    boost::serialization::implementation_level<T>::value ==
+    boost::serialization::primitive_type> { };
+
+//! Whether the version of the given type is stored in the archive.
+template<typename T>
+struct HasFlatVersion : public std::integral_constant<bool,
+    boost::serialization::implementation_level<T>::value >=
+    boost::serialization::object_class_info> { };
+
+template<typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+FlatOutputArchive::Save(const T& t)
+{
+  Write(&t, sizeof(T));
+}
+
+template<typename T>
+typename std::enable_if<std::is_enum<T>::value>::type
+FlatOutputArchive::Save(const T& t)
+{
+  const int32_t value = (int32_t) t;
+  Write(&value, sizeof(value));
+}
+
+template<typename T>
+void FlatOutputArchive::Save(T* const& t)
+{
+  uint64_t id = 0;
+  if (t != NULL)
+  {
+    std::unordered_map<const void*, uint64_t>::const_iterator it =
+        pointers.find(t);
+    if (it != pointers.end())
+    {
+      Write(&it->second, sizeof(uint64_t));
+      return;
+    }
+
+    // Only the static type of the object is known when loading.
+    if (typeid(*t) != typeid(T))
+    {
+      throw boost::archive::archive_exception(
+          boost::archive::archive_exception::unregistered_class,
+          typeid(*t).name());
+    }
+
+    id = pointers.size() + 1;
+    pointers[t] = id;
+  }
+
+  Write(&id, sizeof(uint64_t));
+  if (t == NULL)
+    return;
+
+  const unsigned int version = SaveVersion<T>();
+  boost::serialization::save_construct_data_adl(*this, t, version);
+  boost::serialization::serialize_adl(*this, const_cast<T&>(*t), version);
+}
+
+template<typename T>
+typename std::enable_if<std::is_class<T>::value>::type
+FlatOutputArchive::Save(const T& t)
+{
+  SaveObject(t, IsFlatPrimitive<T>());
+}
+
+template<typename T>
+void FlatOutputArchive::SaveObject(const T& t,
+                                   const std::true_type /* primitive */)
+{
+  Write(&t, sizeof(T));
+}
+
+template<typename T>
+void FlatOutputArchive::SaveObject(const T& t,
+                                   const std::false_type /* primitive */)
+{
+  const unsigned int version = SaveVersion<T>();
+  boost::serialization::serialize_adl(*this, const_cast<T&>(t), version);
+}
+
+template<typename T>
+unsigned int FlatOutputArchive::SaveVersion()
+{
+  const unsigned int version = boost::serialization::version<T>::value;
+  if (HasFlatVersion<T>::value && versions.insert(typeid(T)).second)
+  {
+    const uint32_t storedVersion = version;
+    Write(&storedVersion, sizeof(uint32_t));
+  }
+
+  return version;
+}
+
+template<typename eT>
+const eT* FlatInputArchive::MapArray(const size_t count)
+{
+  if (!mapArrays || count == 0)
+    return NULL;
+
+  const size_t bytes = count * sizeof(eT);
+  SkipPadding(bytes);
+  if (bytes > size - position)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::input_stream_error);
+  }
+
+  // If the block of memory itself is not aligned, the array has to be copied.
+  if (reinterpret_cast<uintptr_t>(data + position) % alignof(eT) != 0)
+    return NULL;
+
+  const eT* array = reinterpret_cast<const eT*>(data + position);
+  position += bytes;
+  return array;
+}
+
+template<typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+FlatInputArchive::Load(T& t)
+{
+  Read(&t, sizeof(T));
+}
+
+template<typename T>
+typename std::enable_if<std::is_enum<T>::value>::type
+FlatInputArchive::Load(T& t)
+{
+  int32_t value;
+  Read(&value, sizeof(value));
+  t = static_cast<T>(value);
+}
+
+template<typename T>
+void FlatInputArchive::Load(T*& t)
+{
+  uint64_t id;
+  Read(&id, sizeof(uint64_t));
+  if (id == 0)
+  {
+    t = NULL;
+    return;
+  }
+  else if (id <= pointers.size())
+  {
+    t = static_cast<T*>(pointers[id - 1]);
+    return;
+  }
+  else if (id != pointers.size() + 1)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::input_stream_error);
+  }
+
+  const unsigned int version = LoadVersion<T>();
+  T* object = static_cast<T*>(::operator new(sizeof(T)));
+  try
+  {
+    boost::serialization::load_construct_data_adl(*this, object, version);
+  }
+  catch (...)
+  {
+    ::operator delete(object);
+    throw;
+  }
+
+  // Register the object before loading it, in case it refers to itself.
+  pointers.push_back(object);
+  t = object;
+  boost::serialization::serialize_adl(*this, *object, version);
+}
+
+template<typename T>
+typename std::enable_if<std::is_class<T>::value>::type
+FlatInputArchive::Load(const T& t)
+{
+  LoadObject(const_cast<T&>(t), IsFlatPrimitive<T>());
+}
+
+template<typename T>
+void FlatInputArchive::LoadObject(T& t, const std::true_type /* primitive */)
+{
+  Read(&t, sizeof(T));
+}
+
+template<typename T>
+void FlatInputArchive::LoadObject(T& t, const std::false_type /* primitive */)
+{
+  const unsigned int version = LoadVersion<T>();
+  boost::serialization::serialize_adl(*this, t, version);
+}
+
+template<typename T>
+unsigned int FlatInputArchive::LoadVersion()
+{
+  if (!HasFlatVersion<T>::value)
+    return boost::serialization::version<T>::value;
+
+  std::unordered_map<std::type_index, unsigned int>::const_iterator it =
+      versions.find(typeid(T));
+  if (it != versions.end())
+    return it->second;
+
+  uint32_t version;
+  Read(&version, sizeof(uint32_t));
+  if (version > boost::serialization::version<T>::value)
+  {
+    throw boost::archive::archive_exception(
+        boost::archive::archive_exception::unsupported_class_version,
+        typeid(T).name());
+  }
+
+  versions[typeid(T)] = version;
+  return version;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "format.hpp"
+#include "flat_archive.hpp"
 #include "dataset_mapper.hpp"
 #include "image_info.hpp"
 
@@ -333,8 +334,13 @@ extern template bool Load<double, IncrementPolicy>(
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
  *
+ * mlpack's own flat binary format (see FlatArchive), denoted by .flat, is also
+ * supported; it is much faster to save and load than the others for large
+ * models.
+ *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::text', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::text', 'format::xml', 'format::binary', and
+ * 'format::flat'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -353,6 +359,45 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           format f = format::autodetect);
 
+/**
+ * Load a model from a file in the flat binary format (see FlatArchive),
+ * mapping the file into memory instead of reading it.  Armadillo matrices in
+ * the model use the memory of the mapping directly, so loading takes time
+ * proportional to the number of objects in the model rather than to its size,
+ * and the elements of the matrices are only read from the disk when they are
+ * used.
+ *
+ * The mapping is private, so the model can be modified without changing the
+ * file.  It is owned by the given MappedFile, which must outlive the model
+ * (declare it before the model), and the file should not be modified while it
+ * is mapped.  If loading fails, the mapping is released and the model must not
+ * be used.  If the file cannot be mapped, it is loaded like Load() would, and
+ * the MappedFile holds nothing.
+ *
+ * @code
+ * data::MappedFile mapping;
+ * KNN knn;
+ * data::LoadMapped("knn.flat", "knn", knn, mapping);
+ * @endcode
+ *
+ * If the parameter 'fatal' is set to true, then an exception will be thrown in
+ * the event of load failure.  Otherwise, the method will return false and the
+ * relevant error information will be printed to Log::Warn.
+ *
+ * @param filename Name of the file to load.
+ * @param name Name of the object, as given to Save().
+ * @param t Object to load into.
+ * @param mapping Set to the mapping of the file.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename T>
+bool LoadMapped(const std::string& filename,
+                const std::string& name,
+                T& t,
+                MappedFile& mapping,
+                const bool fatal = false);
+
 /**
  * Image load/save interfaces.
  */
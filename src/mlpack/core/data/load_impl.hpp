@@ -300,6 +300,7 @@ bool Load(const std::string& filename,
     success = inplace_transpose(matrix, fatal);
   }
 
+  Counter::Add("bytes_loaded", matrix.n_elem * sizeof(eT));
   Timer::Stop("loading_data");
 
   // Finally, return the success indicator.
@@ -397,6 +398,7 @@ bool Load(const std::string& filename,
   Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
       << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
 
+  Counter::Add("bytes_loaded", matrix.n_elem * sizeof(eT));
   Timer::Stop("loading_data");
 
   return true;
@@ -520,6 +522,7 @@ bool Load(const std::string& filename,
     success = inplace_transpose(matrix, fatal);
   }
 
+  Counter::Add("bytes_loaded", matrix.n_nonzero * sizeof(eT));
   Timer::Stop("loading_data");
 
   // Finally, return the success indicator.
@@ -19,6 +19,7 @@
 #include <mlpack/core/util/timers.hpp>
 
 #include "extension.hpp"
+#include "flat_archive.hpp"
 
 #include <boost/serialization/serialization.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -47,6 +48,8 @@ bool Load(const std::string& filename,
       f = format::xml;
     else if (extension == "bin")
       f = format::binary;
+    else if (extension == "flat")
+      f = format::flat;
     else if (extension == "txt")
       f = format::text;
     else
@@ -65,7 +68,7 @@ bool Load(const std::string& filename,
   // Now load the given format.
   std::ifstream ifs;
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
-  if (f == format::binary)
+  if (f == format::binary || f == format::flat)
     ifs.open(filename, std::ifstream::in | std::ifstream::binary);
   else
     ifs.open(filename, std::ifstream::in);
@@ -102,11 +105,50 @@ bool Load(const std::string& filename,
       boost::archive::binary_iarchive ar(ifs);
       ar >> boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::flat)
+    {
+      FlatInputArchive ar(ifs);
+      ar >> boost::serialization::make_nvp(name.c_str(), t);
+    }
+
+    return true;
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+}
+
+// Load a model from a memory-mapped file.
+template<typename T>
+bool LoadMapped(const std::string& filename,
+                const std::string& name,
+                T& t,
+                MappedFile& mapping,
+                const bool fatal)
+{
+  if (!mapping.Map(filename))
+  {
+    Log::Warn << "Unable to map file '" << filename << "'; loading it instead."
+        << std::endl;
+    return Load(filename, name, t, fatal, format::flat);
+  }
+
+  try
+  {
+    FlatInputArchive ar(mapping.Data(), mapping.Size(), true);
+    ar >> boost::serialization::make_nvp(name.c_str(), t);
 
     return true;
   }
   catch (boost::archive::archive_exception& e)
   {
+    mapping.Unmap();
     if (fatal)
       Log::Fatal << e.what() << std::endl;
     else
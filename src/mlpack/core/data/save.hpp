@@ -102,8 +102,13 @@ bool Save(const std::string& filename,
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
  *
+ * mlpack's own flat binary format (see FlatArchive), denoted by .flat, is also
+ * supported; it is much faster to save and load than the others for large
+ * models.
+ *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::text', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::text', 'format::xml', 'format::binary', and
+ * 'format::flat'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
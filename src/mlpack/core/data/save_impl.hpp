@@ -15,6 +15,7 @@
 // In case it hasn't already been included.
 #include "save.hpp"
 #include "extension.hpp"
+#include "flat_archive.hpp"
 
 #include <boost/serialization/serialization.hpp>
 #include <boost/archive/xml_oarchive.hpp>
@@ -332,14 +333,16 @@ bool Save(const std::string& filename,
       f = format::binary;
     else if (extension == "txt")
       f = format::text;
+    else if (extension == "flat")
+      f = format::flat;
     else
     {
       if (fatal)
         Log::Fatal << "Unable to detect type of '" << filename << "'; incorrect"
-            << " extension? (allowed: xml/bin/txt)" << std::endl;
+            << " extension? (allowed: xml/bin/txt/flat)" << std::endl;
       else
         Log::Warn << "Unable to detect type of '" << filename << "'; save "
-            << "failed.  Incorrect extension? (allowed: xml/bin/txt)"
+            << "failed.  Incorrect extension? (allowed: xml/bin/txt/flat)"
             << std::endl;
 
       return false;
@@ -349,7 +352,8 @@ bool Save(const std::string& filename,
   // Open the file to save to.
   std::ofstream ofs;
 #ifdef _WIN32
-  if (f == format::binary) // Open non-text types in binary mode on Windows.
+  // Open non-text types in binary mode on Windows.
+  if (f == format::binary || f == format::flat)
     ofs.open(filename, std::ofstream::out | std::ofstream::binary);
   else
     ofs.open(filename, std::ofstream::out);
@@ -386,6 +390,11 @@ bool Save(const std::string& filename,
       boost::archive::binary_oarchive ar(ofs);
       ar << boost::serialization::make_nvp(name.c_str(), t);
     }
+    else if (f == format::flat)
+    {
+      FlatOutputArchive ar(ofs);
+      ar << boost::serialization::make_nvp(name.c_str(), t);
+    }
 
     return true;
   }
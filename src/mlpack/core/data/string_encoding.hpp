@@ -169,7 +169,38 @@ class StringEncoding
   void EncodeHelper(const std::vector<std::string>& input,
                     OutputType& output,
                     const TokenizerType& tokenizer,
-                    PolicyType& policy);
+                    PolicyType& policy,
+                    typename std::enable_if<!StringEncodingPolicyTraits<
+                        PolicyType>::dictionaryFree>::type* = 0);
+
+  /**
+   * A helper function to encode the given text and write the result to
+   * the given output. This is an overload for policies that map the tokens to
+   * the output dimensions without a dictionary; the dataset items are encoded
+   * independently of each other (in parallel, if OpenMP is available), and
+   * the output is assembled in sparse form. The encoder writes data in the
+   * column-major order.
+   *
+   * @tparam MatType Type of the output matrix (arma::sp_mat or arma::mat).
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   *
+   * The tokenizer must not modify its state in operator(), since several
+   * threads may use it at once.
+   */
+  template<typename MatType, typename TokenizerType, typename PolicyType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    MatType& output,
+                    const TokenizerType& tokenizer,
+                    const PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::dictionaryFree>::type* = 0);
 
   /**
    * A helper function to encode the given text and write the result to
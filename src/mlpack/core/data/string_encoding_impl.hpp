@@ -103,7 +103,9 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::
 EncodeHelper(const std::vector<std::string>& input,
              MatType& output,
              const TokenizerType& tokenizer,
-             PolicyType& policy)
+             PolicyType& policy,
+             typename std::enable_if<!StringEncodingPolicyTraits<
+                 PolicyType>::dictionaryFree>::type*)
 {
   size_t numColumns = 0;
 
@@ -196,6 +198,86 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename MatType, typename TokenizerType, typename PolicyType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             MatType& output,
+             const TokenizerType& tokenizer,
+             const PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::dictionaryFree>::type*)
+{
+  using ElemType = typename MatType::elem_type;
+  using EntryType = std::pair<size_t, ElemType>;
+
+  policy.Reset();
+
+  // Every item is encoded on its own into a sorted list of (bucket, value)
+  // entries, so the items can be encoded in parallel.
+  std::vector<std::vector<EntryType>> columns(input.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+  {
+    boost::string_view strView(input[i]);
+    auto token = tokenizer(strView);
+    std::vector<EntryType>& column = columns[i];
+
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      double sign;
+      const size_t bucket = policy.Bucket(token, sign);
+      column.emplace_back(bucket, ElemType(sign));
+
+      token = tokenizer(strView);
+    }
+
+    // Merge the entries of tokens that fall into the same bucket.
+    std::sort(column.begin(), column.end(),
+        [](const EntryType& a, const EntryType& b)
+        {
+          return a.first < b.first;
+        });
+
+    size_t numEntries = 0;
+    for (size_t j = 0; j < column.size(); ++j)
+    {
+      if (numEntries > 0 && column[numEntries - 1].first == column[j].first)
+        column[numEntries - 1].second += column[j].second;
+      else
+        column[numEntries++] = column[j];
+    }
+    column.resize(numEntries);
+  }
+
+  size_t nonzeros = 0;
+  for (size_t i = 0; i < columns.size(); ++i)
+    nonzeros += columns[i].size();
+
+  // The columns are visited in order, so the locations are already sorted.
+  arma::umat locations(2, nonzeros);
+  arma::Col<ElemType> values(nonzeros);
+  size_t index = 0;
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    for (size_t j = 0; j < columns[i].size(); ++j, ++index)
+    {
+      locations(0, index) = columns[i][j].first;
+      locations(1, index) = i;
+      values[index] = columns[i][j].second;
+    }
+
+    // Release the memory of each column as soon as it is copied.
+    std::vector<EntryType>().swap(columns[i]);
+  }
+
+  // Entries whose signed counts cancelled out are dropped here.
+  arma::SpMat<ElemType> encoded(locations, values, policy.NumBuckets(),
+      input.size(), false, true);
+  output = std::move(encoded);
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
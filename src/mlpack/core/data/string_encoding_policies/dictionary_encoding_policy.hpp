@@ -133,6 +133,12 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy maps the tokens to the output dimensions without
+   * a dictionary.
+   */
+  static const bool dictionaryFree = false;
 };
 
 /**
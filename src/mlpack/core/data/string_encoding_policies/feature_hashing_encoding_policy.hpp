@@ -0,0 +1,215 @@
+/**
+ * @file core/data/string_encoding_policies/feature_hashing_encoding_policy.hpp
+ *
+ * Definition of the FeatureHashingEncodingPolicy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STR_ENCODING_POLICIES_HASHING_ENCODING_POLICY_HPP
+#define MLPACK_CORE_DATA_STR_ENCODING_POLICIES_HASHING_ENCODING_POLICY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+#include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <mlpack/core/data/string_encoding.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Definition of the FeatureHashingEncodingPolicy class.
+ *
+ * FeatureHashing (also known as the hashing trick) is used as a helper class
+ * for StringEncoding. Instead of labeling the tokens with a dictionary, the
+ * encoder hashes every token straight to one of a fixed number of buckets, and
+ * maps each dataset item to a vector whose i-th coordinate counts the tokens
+ * of the item that fall into the i-th bucket. If the alternating sign is used,
+ * every token is counted with a sign that is also given by its hash, so that
+ * collisions cancel out in expectation.
+ *
+ * Since no dictionary is built, the memory used by the encoder does not depend
+ * on the size of the vocabulary, the items are encoded independently of each
+ * other (and in parallel, if OpenMP is available), and different shards of a
+ * corpus encoded with the same policy yield compatible matrices that can be
+ * joined column-wise. The output has to be an arma::sp_mat or an arma::mat;
+ * the encoded matrix is assembled in sparse form either way.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{weinberger2009feature,
+ *   title={Feature Hashing for Large Scale Multitask Learning},
+ *   author={Weinberger, Kilian and Dasgupta, Anirban and Langford, John and
+ *       Smola, Alex and Attenberg, Josh},
+ *   booktitle={Proceedings of the 26th Annual International Conference on
+ *       Machine Learning},
+ *   pages={1113--1120},
+ *   year={2009}
+ * }
+ * @endcode
+ */
+class FeatureHashingEncodingPolicy
+{
+ public:
+  /**
+   * Construct the feature hashing encoding policy.
+   *
+   * @param numBuckets The number of buckets (the dimensionality of the
+   *     output).
+   * @param alternateSign If true, every token is counted with a sign given by
+   *     its hash.
+   * @param seed The seed of the hash function; shards of a corpus must be
+   *     encoded with the same seed.
+   */
+  FeatureHashingEncodingPolicy(const size_t numBuckets = 1048576,
+                               const bool alternateSign = true,
+                               const size_t seed = 0) :
+      numBuckets(numBuckets),
+      alternateSign(alternateSign),
+      seed(seed)
+  {
+    if (numBuckets == 0)
+    {
+      throw std::invalid_argument("FeatureHashingEncodingPolicy: the number "
+          "of buckets must be positive!");
+    }
+  }
+
+  /**
+   * Clear the necessary internal variables.
+   */
+  static void Reset()
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Hash the given token to its bucket.
+   *
+   * @tparam TokenType Type of the token.
+   *
+   * @param token The token to encode.
+   * @param sign The sign the token is counted with.
+   * @return The bucket of the token.
+   */
+  template<typename TokenType>
+  size_t Bucket(const TokenType& token, double& sign) const
+  {
+    const uint64_t hash = Hash(token);
+
+    // The low bits select the bucket, and the high bit selects the sign.
+    sign = (alternateSign && (hash >> 63)) ? -1.0 : 1.0;
+    return hash % numBuckets;
+  }
+
+  //! Get the number of buckets.
+  size_t NumBuckets() const { return numBuckets; }
+  //! Modify the number of buckets.
+  size_t& NumBuckets() { return numBuckets; }
+
+  //! Get whether the alternating sign is used.
+  bool AlternateSign() const { return alternateSign; }
+  //! Modify whether the alternating sign is used.
+  bool& AlternateSign() { return alternateSign; }
+
+  //! Get the seed of the hash function.
+  size_t Seed() const { return seed; }
+  //! Modify the seed of the hash function.
+  size_t& Seed() { return seed; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numBuckets);
+    ar & BOOST_SERIALIZATION_NVP(alternateSign);
+    ar & BOOST_SERIALIZATION_NVP(seed);
+  }
+
+ private:
+  /**
+   * Hash the characters of the given string token with the FNV-1a algorithm.
+   * The hash does not depend on the platform, so encoded data is portable.
+   */
+  uint64_t Hash(const boost::string_view& token) const
+  {
+    uint64_t hash = 14695981039346656037ULL ^ Mix(seed);
+    for (const char c : token)
+    {
+      hash ^= (unsigned char) c;
+      hash *= 1099511628211ULL;
+    }
+
+    return Mix(hash);
+  }
+
+  /**
+   * Hash the given integer token (as extracted by CharExtract).
+   */
+  template<typename TokenType>
+  uint64_t Hash(const TokenType& token,
+                const typename std::enable_if<
+                    std::is_integral<TokenType>::value>::type* = 0) const
+  {
+    return Mix((uint64_t) token ^ Mix(seed));
+  }
+
+  /**
+   * Scramble the bits of the given value (the finalizer of SplitMix64), so
+   * that the low bits used for the bucket depend on all bits of the value.
+   */
+  static uint64_t Mix(uint64_t x)
+  {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  //! The number of buckets.
+  size_t numBuckets;
+  //! Whether the tokens are counted with the sign given by their hash.
+  bool alternateSign;
+  //! The seed of the hash function.
+  size_t seed;
+};
+
+/**
+ * The specialization provides some information about the feature hashing
+ * encoding policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<FeatureHashingEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy maps the tokens to the output dimensions without
+   * a dictionary.
+   */
+  static const bool dictionaryFree = true;
+};
+
+/**
+ * A convenient alias for the StringEncoding class with
+ * FeatureHashingEncodingPolicy and the default dictionary for the given token
+ * type.  The dictionary is never filled by Encode().
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using FeatureHashingEncoding = StringEncoding<FeatureHashingEncodingPolicy,
+    StringEncodingDictionary<TokenType>>;
+} // namespace data
+} // namespace mlpack
+
+#endif
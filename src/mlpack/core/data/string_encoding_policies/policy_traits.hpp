@@ -31,6 +31,12 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy maps the tokens to the output dimensions without
+   * a dictionary.
+   */
+  static const bool dictionaryFree = false;
 };
 
 } // namespace data
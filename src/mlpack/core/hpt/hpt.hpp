@@ -13,7 +13,9 @@
 #define MLPACK_CORE_HPT_HPT_HPP
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
+#include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
+#include <exception>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -67,6 +69,15 @@ namespace hpt {
  *     Fixed(useCholesky), lambda1Set, lambda2Set);
  * @endcode
  *
+ * When GridSearch is used as the optimizer, the candidates of the grid can be
+ * evaluated concurrently by setting NumThreads() to a value other than 1 (0
+ * means the OpenMP default).  Every thread then works on its own copy of the
+ * cross-validation object, so the CV class has to be copy-constructible (as
+ * KFoldCV is); otherwise the candidates are evaluated one after another.  The
+ * result is the same as the one of a serial run.  For KFoldCV, the folds of
+ * every candidate can be trained concurrently too (see KFoldCV::NumThreads(),
+ * which can be accessed through CV()).
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
@@ -151,6 +162,22 @@ class HyperParameterTuner
    */
   double& MinDelta() { return minDelta; }
 
+  /**
+   * Get the number of threads used to evaluate the candidates of the grid when
+   * GridSearch is used as the optimizer (0 means the OpenMP default).
+   *
+   * The default value is 1.
+   */
+  size_t NumThreads() const { return numThreads; }
+
+  /**
+   * Modify the number of threads used to evaluate the candidates of the grid
+   * when GridSearch is used as the optimizer (0 means the OpenMP default).
+   *
+   * The default value is 1.
+   */
+  size_t& NumThreads() { return numThreads; }
+
   /**
    * Find the best hyper-parameters by using the given Optimizer. For each
    * hyper-parameter one of the following should be passed as an argument.
@@ -205,6 +232,15 @@ class HyperParameterTuner
       CV<MLAlgorithm, Negated<Metric>, MatType, PredictionsType,
           WeightsType>>::type;
 
+ public:
+  //! Access and modify the cross-validation object.
+  CVType& CV() { return cv; }
+
+ private:
+  //! Whether the candidates of the grid can be evaluated concurrently.
+  static const bool ParallelGridSearchSupported =
+      std::is_same<OptimizerType, ens::GridSearch>::value &&
+      std::is_copy_constructible<CVType>::value;
 
   //! The cross-validation object for assessing sets of hyper-parameters.
   CVType cv;
@@ -230,6 +266,9 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! The number of threads used to evaluate the candidates of the grid.
+  size_t numThreads;
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
@@ -324,6 +363,55 @@ class HyperParameterTuner
       data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
       FixedArgs... fixedArgs);
 
+  /**
+   * Run the optimizer on a CVFunction object built around the
+   * cross-validation object, and store the best model.  Return the optimized
+   * objective.
+   */
+  template<size_t TotalArgs, typename... FixedArgs>
+  double SerialOptimize(
+      arma::mat& bestParams,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+      const std::vector<bool>& categoricalDimensions,
+      const arma::Row<size_t>& numCategories,
+      FixedArgs... fixedArgs);
+
+  /**
+   * Evaluate all candidates of the grid concurrently, each thread with its own
+   * copy of the cross-validation object, and store the best model.  Ties are
+   * broken in favor of the candidate GridSearch would visit first.  Return the
+   * best objective.
+   *
+   * This overload is used when the candidates of the grid can be evaluated
+   * concurrently.
+   */
+  template<size_t TotalArgs,
+           typename... FixedArgs,
+           bool Enabled = ParallelGridSearchSupported,
+           typename = std::enable_if_t<Enabled>>
+  double ParallelOptimize(
+      arma::mat& bestParams,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+      const std::vector<bool>& categoricalDimensions,
+      const arma::Row<size_t>& numCategories,
+      FixedArgs... fixedArgs);
+
+  /**
+   * Fall back to SerialOptimize().  This overload is used when the optimizer
+   * is not GridSearch or the cross-validation object cannot be copied.
+   */
+  template<size_t TotalArgs,
+           typename... FixedArgs,
+           bool Enabled = !ParallelGridSearchSupported,
+           typename = std::enable_if_t<Enabled>,
+           typename = void>
+  double ParallelOptimize(
+      arma::mat& bestParams,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+      const std::vector<bool>& categoricalDimensions,
+      const arma::Row<size_t>& numCategories,
+      FixedArgs... fixedArgs);
+
   /**
    * Gather all elements of vector in an argument list and use them to create a
    * tuple.
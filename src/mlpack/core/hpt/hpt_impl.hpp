@@ -32,7 +32,7 @@ HyperParameterTuner<MLAlgorithm,
                     MatType,
                     PredictionsType,
                     WeightsType>::HyperParameterTuner(const CVArgs&... args) :
-    cv(args...), relativeDelta(0.01), minDelta(1e-10) {}
+    cv(args...), relativeDelta(0.01), minDelta(1e-10), numThreads(1) {}
 
 template<typename MLAlgorithm,
          typename Metric,
@@ -102,13 +102,181 @@ void HyperParameterTuner<MLAlgorithm,
         mlpack::data::Datatype::categorical;
   }
 
-  CVFunction<CVType, MLAlgorithm, totalArgs, FixedArgs...>
+  const double objective = (numThreads == 1) ?
+      SerialOptimize<totalArgs>(bestParams, datasetInfo, categoricalDimensions,
+          numCategories, fixedArgs...) :
+      ParallelOptimize<totalArgs>(bestParams, datasetInfo,
+          categoricalDimensions, numCategories, fixedArgs...);
+  bestObjective = Metric::NeedsMinimization ? objective : -objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t TotalArgs, typename... FixedArgs>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::SerialOptimize(
+    arma::mat& bestParams,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    FixedArgs... fixedArgs)
+{
+  CVFunction<CVType, MLAlgorithm, TotalArgs, FixedArgs...>
       cvFunction(cv, datasetInfo, relativeDelta, minDelta, fixedArgs...);
-  bestObjective = Metric::NeedsMinimization ? optimizer.Optimize(cvFunction,
-      bestParams, categoricalDimensions, numCategories) :
-      -optimizer.Optimize(cvFunction, bestParams, categoricalDimensions,
-      numCategories);
-      bestModel = std::move(cvFunction.BestModel());
+  const double objective = optimizer.Optimize(cvFunction, bestParams,
+      categoricalDimensions, numCategories);
+  bestModel = std::move(cvFunction.BestModel());
+
+  return objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t TotalArgs, typename... FixedArgs, bool Enabled, typename>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::ParallelOptimize(
+    arma::mat& bestParams,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    FixedArgs... fixedArgs)
+{
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+    {
+      std::ostringstream oss;
+      oss << "HyperParameterTuner::Optimize(): dimension " << d << " is not "
+          << "categorical; GridSearch requires all dimensions to be "
+          << "categorical" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  const size_t dimensionality = numCategories.n_elem;
+  const size_t numCandidates = arma::prod(numCategories);
+
+  double objective = std::numeric_limits<double>::max();
+  size_t bestIndex = numCandidates;
+  std::exception_ptr exception;
+
+  #pragma omp parallel \
+      num_threads(numThreads == 0 ? omp_get_max_threads() : numThreads)
+  {
+    // Every thread evaluates its candidates on its own copy of the
+    // cross-validation object, since evaluation stores the trained model.
+    CVType threadCV(cv);
+    CVFunction<CVType, MLAlgorithm, TotalArgs, FixedArgs...> threadFunction(
+        threadCV, datasetInfo, relativeDelta, minDelta, fixedArgs...);
+
+    double threadObjective = std::numeric_limits<double>::max();
+    size_t threadBestIndex = numCandidates;
+    arma::mat candidate(dimensionality, 1);
+
+    // Each thread visits its candidates in increasing order, so (as in
+    // CVFunction) its best model belongs to its first best candidate.
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t c = 0; c < (omp_size_t) numCandidates; ++c)
+    {
+      // Decode the candidate with the last dimension varying fastest, which is
+      // the order in which GridSearch visits the grid.
+      size_t rest = c;
+      for (size_t d = dimensionality; d > 0; --d)
+      {
+        candidate(d - 1) = rest % numCategories[d - 1];
+        rest /= numCategories[d - 1];
+      }
+
+      try
+      {
+        const double candidateObjective = threadFunction.Evaluate(candidate);
+        if (candidateObjective < threadObjective ||
+            threadBestIndex == numCandidates)
+        {
+          threadObjective = candidateObjective;
+          threadBestIndex = c;
+        }
+      }
+      catch (...)
+      {
+        // Exceptions cannot leave an OpenMP region, so keep the first one.
+        #pragma omp critical
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+
+    #pragma omp critical
+    if (threadBestIndex < numCandidates && (threadObjective < objective ||
+        (threadObjective == objective && threadBestIndex < bestIndex)))
+    {
+      objective = threadObjective;
+      bestIndex = threadBestIndex;
+      bestModel = std::move(threadFunction.BestModel());
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  bestParams.set_size(dimensionality, 1);
+  size_t rest = bestIndex;
+  for (size_t d = dimensionality; d > 0; --d)
+  {
+    bestParams(d - 1) = rest % numCategories[d - 1];
+    rest /= numCategories[d - 1];
+  }
+
+  return objective;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<size_t TotalArgs,
+         typename... FixedArgs,
+         bool Enabled,
+         typename,
+         typename>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::ParallelOptimize(
+    arma::mat& bestParams,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    FixedArgs... fixedArgs)
+{
+  return SerialOptimize<TotalArgs>(bestParams, datasetInfo,
+      categoricalDimensions, numCategories, fixedArgs...);
 }
 
 template<typename MLAlgorithm,
@@ -0,0 +1,84 @@
+/**
+ * @file core/math/gather_columns.hpp
+ *
+ * Gather a selection of the columns of a matrix into a reusable buffer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_GATHER_COLUMNS_HPP
+#define MLPACK_CORE_MATH_GATHER_COLUMNS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Copy the columns of a dense matrix (or row) with the given indices, in the
+ * given order, into the given output.  If the output already has the right
+ * size (as is the case when it is reused for minibatches of a fixed size), its
+ * memory is reused.
+ *
+ * @param input Matrix to gather columns from.
+ * @param indices Indices of the columns to gather.
+ * @param output Matrix to store the gathered columns in.
+ */
+template<typename MatType>
+void GatherColumns(const MatType& input,
+                   const arma::uvec& indices,
+                   MatType& output,
+                   const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    std::copy(input.colptr(indices[i]), input.colptr(indices[i]) + input.n_rows,
+        output.colptr(i));
+  }
+}
+
+/**
+ * Copy the columns of a sparse matrix with the given indices, in the given
+ * order, into the given output.
+ *
+ * @param input Matrix to gather columns from.
+ * @param indices Indices of the columns to gather.
+ * @param output Matrix to store the gathered columns in.
+ */
+template<typename MatType>
+void GatherColumns(const MatType& input,
+                   const arma::uvec& indices,
+                   MatType& output,
+                   const std::enable_if_t<arma::is_SpMat<MatType>::value>* = 0)
+{
+  input.sync();
+
+  size_t nonzeros = 0;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    nonzeros += input.col_ptrs[indices[i] + 1] - input.col_ptrs[indices[i]];
+
+  // The columns are visited in order, so the locations are already sorted.
+  arma::umat locations(2, nonzeros);
+  arma::Col<typename MatType::elem_type> values(nonzeros);
+  size_t index = 0;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    for (size_t j = input.col_ptrs[indices[i]];
+         j < input.col_ptrs[indices[i] + 1]; ++j, ++index)
+    {
+      locations(0, index) = input.row_indices[j];
+      locations(1, index) = i;
+      values[index] = input.values[j];
+    }
+  }
+
+  output = MatType(locations, values, input.n_rows, indices.n_elem, false);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
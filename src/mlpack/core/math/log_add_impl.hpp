@@ -52,7 +52,15 @@ T LogAdd(T x, T y)
 }
 
 /**
- * Sum a vector of log values.
+ * Sum a vector of log values.  Instead of a chain of LogAdd() calls (one log()
+ * and one exp() per element), the maximum element is factored out:
+ *
+ * @f[
+ * \log \sum_i e^{x_i} = m + \log \sum_i e^{x_i - m}, \quad m = \max_i x_i
+ * @f]
+ *
+ * so that the exponentials are computed in one vectorized pass and only one
+ * log() is needed.
  *
  * @param x vector of log values
  * @return log(e^x0 + e^x1 + ...)
@@ -60,15 +68,19 @@ T LogAdd(T x, T y)
 template<typename T>
 typename T::elem_type AccuLog(const T& x)
 {
-  typename T::elem_type sum =
-      -std::numeric_limits<typename T::elem_type>::infinity();
+  typedef typename T::elem_type ElemType;
 
-  for (size_t i = 0; i < x.n_elem; ++i)
-  {
-    sum = LogAdd(sum, x[i]);
-  }
+  if (x.n_elem == 0)
+    return -std::numeric_limits<ElemType>::infinity();
+
+  const ElemType maxVal = x.max();
+
+  // If the maximum is infinite (or all elements are -inf), the sum is simply
+  // the maximum.
+  if (!std::isfinite(maxVal))
+    return maxVal;
 
-  return sum;
+  return maxVal + std::log(arma::accu(arma::exp(x - maxVal)));
 }
 
 } // namespace math
@@ -19,6 +19,11 @@
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+// Forward declaration of the split type that can be used to build trees in
+// parallel, along with the MidpointSplit.
+template<typename BoundType, typename MatType>
+class MeanSplit;
+
 /**
  * A binary space partitioning tree, such as a KD-tree or a ball tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -32,6 +37,14 @@ namespace tree /** Trees and tree-building procedures. */ {
  * This tree does take one runtime parameter in the constructor, which is the
  * max leaf size to be used.
  *
+ * When OpenMP is available, large trees that use the MidpointSplit or the
+ * MeanSplit (such as kd-trees and ball trees) are built in parallel: the nodes
+ * of each of the first levels are split concurrently, with the bound of the
+ * root computed (when it is an HRectBound) and its points partitioned in
+ * parallel, and the subtrees below them are then built concurrently.  The
+ * tree, the reordered dataset and the mappings are the same as when the tree
+ * is built on one thread.
+ *
  * @tparam MetricType The metric used for tree-building.  The BoundType may
  *     place restrictions on the metrics that can be used.
  * @tparam StatisticType Extra data contained in the node.  See statistic.hpp
@@ -508,6 +521,19 @@ class BinarySpaceTree
   void Center(arma::vec& center) const { bound.Center(center); }
 
  private:
+  /**
+   * Construct this node as a child of the given parent, starting at column
+   * begin and using count points, without splitting it.  This is used when
+   * the tree is built in parallel; see BuildTree().
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point of the node.
+   * @param count Number of points of the node.
+   */
+  BinarySpaceTree(BinarySpaceTree* parent,
+                  const size_t begin,
+                  const size_t count);
+
   /**
    * Splits the current node, assigning its left and right children recursively.
    *
@@ -546,6 +572,102 @@ class BinarySpaceTree
    */
   void UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate);
 
+  /**
+   * Build the tree below this root node, in parallel if the tree is large and
+   * the split type allows it.
+   *
+   * @param oldFromNew Vector holding permuted indices, or NULL if they are not
+   *     needed.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void BuildTree(std::vector<size_t>* oldFromNew,
+                 const size_t maxLeafSize,
+                 SplitType<BoundType<MetricType>, MatType>& splitter);
+
+  /**
+   * Split the current node into two children, like SplitNode(), but without
+   * splitting the children.  Returns false if the node is a leaf.
+   *
+   * @param oldFromNew Vector holding permuted indices, or NULL if they are not
+   *     needed.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  bool SplitNodeOnce(std::vector<size_t>* oldFromNew,
+                     const size_t maxLeafSize,
+                     SplitType<BoundType<MetricType>, MatType>& splitter);
+
+  /**
+   * Update the bound of the current node in parallel.  Only bounds that don't
+   * depend on the order of the points can be computed in parallel, so this
+   * falls back to UpdateBound().
+   *
+   * @param boundToUpdate The bound to update.
+   */
+  template<typename BoundType2>
+  void ParallelUpdateBound(BoundType2& boundToUpdate);
+
+  /**
+   * Update the bound of the current node in parallel, by merging the bounds
+   * of blocks of points.
+   *
+   * @param boundToUpdate The bound to update.
+   */
+  template<typename BoundElemType>
+  void ParallelUpdateBound(
+      bound::HRectBound<MetricType, BoundElemType>& boundToUpdate);
+
+  /**
+   * Rearrange the points of the current node with the splitter's
+   * PerformSplit(), for split types that can't do it in parallel.  Returns the
+   * index of the first point of the right child.
+   *
+   * @param oldFromNew Vector holding permuted indices, or NULL if they are not
+   *     needed.
+   * @param splitInfo The information about the split.
+   * @param splitter Instantiated SplitType object.
+   */
+  size_t ParallelPerformSplit(
+      std::vector<size_t>* oldFromNew,
+      const typename Split::SplitInfo& splitInfo,
+      SplitType<BoundType<MetricType>, MatType>& splitter,
+      const std::false_type);
+
+  /**
+   * Rearrange the points of the current node in parallel, into exactly the
+   * order that split::PerformSplit() gives.  Returns the index of the first
+   * point of the right child.
+   *
+   * @param oldFromNew Vector holding permuted indices, or NULL if they are not
+   *     needed.
+   * @param splitInfo The information about the split.
+   * @param splitter Instantiated SplitType object.
+   */
+  size_t ParallelPerformSplit(
+      std::vector<size_t>* oldFromNew,
+      const typename Split::SplitInfo& splitInfo,
+      SplitType<BoundType<MetricType>, MatType>& splitter,
+      const std::true_type);
+
+  //! The smallest number of points of a tree that is built in parallel.
+  static const size_t parallelBuildSize = 100000;
+
+  //! The number of points whose bound is computed, or that are rearranged,
+  //! by each task.
+  static const size_t boundBlockSize = 16384;
+
+  //! Return true if the split type can be shared by the threads building
+  //! subtrees in parallel.
+  template<typename SplitterType>
+  struct IsParallelSplit : std::false_type { };
+  template<typename SplitBoundType, typename SplitMatType>
+  struct IsParallelSplit<MidpointSplit<SplitBoundType, SplitMatType>> :
+      std::true_type { };
+  template<typename SplitBoundType, typename SplitMatType>
+  struct IsParallelSplit<MeanSplit<SplitBoundType, SplitMatType>> :
+      std::true_type { };
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
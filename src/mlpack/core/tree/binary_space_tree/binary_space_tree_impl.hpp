@@ -17,6 +17,10 @@
 #include <mlpack/core/util/log.hpp>
 #include <queue>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -43,7 +47,7 @@ BinarySpaceTree(
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  BuildTree(NULL, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -76,7 +80,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  BuildTree(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -110,7 +114,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  BuildTree(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -140,7 +144,7 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  BuildTree(NULL, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -173,7 +177,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  BuildTree(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -207,7 +211,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  BuildTree(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -318,6 +322,31 @@ BinarySpaceTree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(
+    BinarySpaceTree* parent,
+    const size_t begin,
+    const size_t count) :
+    left(NULL),
+    right(NULL),
+    parent(parent),
+    begin(begin),
+    count(count),
+    bound(parent->Dataset().n_rows),
+    parentDistance(0),
+    furthestDescendantDistance(0),
+    dataset(&parent->Dataset())
+{
+  // Nothing to do: the node is split and its statistic is created by
+  // BuildTree().
+}
+
 /**
  * Create a binary space tree by copying the other tree.  Be careful!  This can
  * take a long time and use a lot of memory.
@@ -908,6 +937,7 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
       maxLeafSize);
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       splitter, maxLeafSize);
+  Counter::Add("tree_nodes_allocated", 2);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -976,6 +1006,7 @@ SplitNode(std::vector<size_t>& oldFromNew,
       splitter, maxLeafSize);
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       oldFromNew, splitter, maxLeafSize);
+  Counter::Add("tree_nodes_allocated", 2);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -992,6 +1023,328 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BuildTree(std::vector<size_t>* oldFromNew,
+          const size_t maxLeafSize,
+          SplitType<BoundType<MetricType>, MatType>& splitter)
+{
+  #ifdef HAS_OPENMP
+  const size_t threads = omp_get_max_threads();
+  #else
+  const size_t threads = 1;
+  #endif
+
+  if (!IsParallelSplit<Split>::value || threads == 1 ||
+      count < parallelBuildSize)
+  {
+    if (oldFromNew)
+      SplitNode(*oldFromNew, maxLeafSize, splitter);
+    else
+      SplitNode(maxLeafSize, splitter);
+    return;
+  }
+
+  // Split the first levels one level at a time, until there are enough
+  // subtrees to keep every thread busy.  Nodes that are too small to be worth
+  // splitting this way become subtrees right away.
+  std::vector<BinarySpaceTree*> splitNodes;
+  std::vector<BinarySpaceTree*> subtrees;
+  std::vector<BinarySpaceTree*> level(1, this);
+  while (!level.empty() && level.size() + subtrees.size() < 4 * threads)
+  {
+    // The nodes of a level hold disjoint ranges of the dataset (and of
+    // oldFromNew), so they are split concurrently.  A level with a single node
+    // is split by one thread, so that its bound can be computed and its points
+    // partitioned in parallel.
+    std::vector<char> isSplit(level.size(), 0);
+    #pragma omp parallel for schedule(dynamic) if (level.size() > 1)
+    for (omp_size_t i = 0; i < (omp_size_t) level.size(); ++i)
+    {
+      BinarySpaceTree* node = level[i];
+      if (node->count < parallelBuildSize)
+        continue;
+
+      if (node->SplitNodeOnce(oldFromNew, maxLeafSize, splitter))
+        isSplit[i] = 1;
+      else if (node != this)
+        node->stat = StatisticType(*node); // The node is a leaf.
+    }
+
+    // Collect the results in the order of the nodes, so that the tree does
+    // not depend on the number of threads.
+    std::vector<BinarySpaceTree*> nextLevel;
+    for (size_t i = 0; i < level.size(); ++i)
+    {
+      BinarySpaceTree* node = level[i];
+      if (node->count < parallelBuildSize)
+      {
+        subtrees.push_back(node);
+      }
+      else if (isSplit[i])
+      {
+        splitNodes.push_back(node);
+        nextLevel.push_back(node->left);
+        nextLevel.push_back(node->right);
+      }
+    }
+
+    level.swap(nextLevel);
+  }
+  subtrees.insert(subtrees.end(), level.begin(), level.end());
+
+  // The subtrees hold disjoint ranges of the dataset (and of oldFromNew), so
+  // they can be built concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) subtrees.size(); ++i)
+  {
+    BinarySpaceTree* node = subtrees[i];
+    if (oldFromNew)
+      node->SplitNode(*oldFromNew, maxLeafSize, splitter);
+    else
+      node->SplitNode(maxLeafSize, splitter);
+
+    node->stat = StatisticType(*node);
+  }
+
+  // Now finish the nodes of the first levels from the bottom up, as
+  // SplitNode() would have done.  The statistic of the root is created by the
+  // constructor.
+  for (size_t i = splitNodes.size(); i > 0; --i)
+  {
+    BinarySpaceTree* node = splitNodes[i - 1];
+
+    // Calculate parent distances for the two children.
+    arma::vec center, leftCenter, rightCenter;
+    node->Center(center);
+    node->left->Center(leftCenter);
+    node->right->Center(rightCenter);
+
+    node->left->ParentDistance() = node->bound.Metric().Evaluate(center,
+        leftCenter);
+    node->right->ParentDistance() = node->bound.Metric().Evaluate(center,
+        rightCenter);
+
+    if (node != this)
+      node->stat = StatisticType(*node);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+bool BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+SplitNodeOnce(std::vector<size_t>* oldFromNew,
+              const size_t maxLeafSize,
+              SplitType<BoundType<MetricType>, MatType>& splitter)
+{
+  // We need to expand the bounds of this node properly.
+  ParallelUpdateBound(bound);
+
+  // Calculate the furthest descendant distance.
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // First, check if we need to split at all.
+  if (count <= maxLeafSize)
+    return false; // We can't split this.
+
+  // Find the partition of the node. This method does not perform the split.
+  typename Split::SplitInfo splitInfo;
+
+  const bool split = splitter.SplitNode(bound, *dataset, begin, count,
+      splitInfo);
+
+  // The node may not be always split. For instance, if all the points are the
+  // same, we can't split them.
+  if (!split)
+    return false;
+
+  // Perform the actual splitting, as in SplitNode().
+  const size_t splitCol = ParallelPerformSplit(oldFromNew, splitInfo, splitter,
+      IsParallelSplit<Split>());
+
+  assert(splitCol > begin);
+  assert(splitCol < begin + count);
+
+  // The children are split later.
+  left = new BinarySpaceTree(this, begin, splitCol - begin);
+  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol);
+  Counter::Add("tree_nodes_allocated", 2);
+
+  return true;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundType2>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelUpdateBound(BoundType2& boundToUpdate)
+{
+  UpdateBound(boundToUpdate);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundElemType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelUpdateBound(bound::HRectBound<MetricType, BoundElemType>& boundToUpdate)
+{
+  // The bound of a block doesn't depend on the order of its points, so the
+  // bounds of the blocks can be computed in parallel and then merged.
+  const size_t numBlocks = (count + boundBlockSize - 1) / boundBlockSize;
+  std::vector<bound::HRectBound<MetricType, BoundElemType>> blockBounds(
+      numBlocks, bound::HRectBound<MetricType, BoundElemType>(dataset->n_rows));
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t first = begin + b * boundBlockSize;
+    const size_t last = std::min(first + boundBlockSize, begin + count);
+    blockBounds[b] |= dataset->cols(first, last - 1);
+  }
+
+  for (size_t b = 0; b < numBlocks; ++b)
+    boundToUpdate |= blockBounds[b];
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelPerformSplit(std::vector<size_t>* oldFromNew,
+                     const typename Split::SplitInfo& splitInfo,
+                     SplitType<BoundType<MetricType>, MatType>& splitter,
+                     const std::false_type)
+{
+  return oldFromNew ?
+      splitter.PerformSplit(*dataset, begin, count, splitInfo, *oldFromNew) :
+      splitter.PerformSplit(*dataset, begin, count, splitInfo);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelPerformSplit(std::vector<size_t>* oldFromNew,
+                     const typename Split::SplitInfo& splitInfo,
+                     SplitType<BoundType<MetricType>, MatType>& /* splitter */,
+                     const std::true_type)
+{
+  // Find the child of every point.
+  std::vector<char> toLeft(count);
+  size_t numLeft = 0;
+  #pragma omp parallel for reduction(+:numLeft)
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    toLeft[i] = Split::AssignToLeftNode(dataset->col(begin + i), splitInfo);
+    numLeft += toLeft[i];
+  }
+
+  // split::PerformSplit() swaps the k-th point from the left that belongs to
+  // the right child with the k-th point from the right that belongs to the
+  // left child, until they meet.  These pairs are disjoint, so they can be
+  // swapped in parallel once the misplaced points of each block are counted.
+  // The blocks of the left part are numbered from its start, and the blocks of
+  // the right part from its end.
+  const size_t numRight = count - numLeft;
+  const size_t leftBlocks = (numLeft + boundBlockSize - 1) / boundBlockSize;
+  const size_t rightBlocks = (numRight + boundBlockSize - 1) / boundBlockSize;
+  std::vector<size_t> leftMisplaced(leftBlocks + 1, 0);
+  std::vector<size_t> rightMisplaced(rightBlocks + 1, 0);
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) (leftBlocks + rightBlocks); ++b)
+  {
+    if ((size_t) b < leftBlocks)
+    {
+      const size_t first = b * boundBlockSize;
+      const size_t last = std::min(first + boundBlockSize, numLeft);
+      for (size_t i = first; i < last; ++i)
+        leftMisplaced[b + 1] += !toLeft[i];
+    }
+    else
+    {
+      const size_t r = b - leftBlocks;
+      const size_t first = r * boundBlockSize;
+      const size_t last = std::min(first + boundBlockSize, numRight);
+      for (size_t i = first; i < last; ++i)
+        rightMisplaced[r + 1] += toLeft[count - 1 - i];
+    }
+  }
+
+  // Turn the counts into the rank of the first misplaced point of each block.
+  for (size_t b = 0; b < leftBlocks; ++b)
+    leftMisplaced[b + 1] += leftMisplaced[b];
+  for (size_t r = 0; r < rightBlocks; ++r)
+    rightMisplaced[r + 1] += rightMisplaced[r];
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) leftBlocks; ++b)
+  {
+    size_t rank = leftMisplaced[b];
+    if (rank == leftMisplaced[b + 1])
+      continue;
+
+    // Find the point from the right with the same rank as the first misplaced
+    // point of this block.
+    const size_t r = std::upper_bound(rightMisplaced.begin(),
+        rightMisplaced.end(), rank) - rightMisplaced.begin() - 1;
+    size_t right = r * boundBlockSize; // Counted from the end.
+    size_t skip = rank - rightMisplaced[r];
+    while (!toLeft[count - 1 - right] || skip-- > 0)
+      ++right;
+
+    const size_t first = b * boundBlockSize;
+    const size_t last = std::min(first + boundBlockSize, numLeft);
+    for (size_t i = first; i < last; ++i)
+    {
+      if (toLeft[i])
+        continue;
+
+      // Move to the next misplaced point from the right, if this isn't the
+      // first one.
+      if (rank++ > leftMisplaced[b])
+      {
+        do
+        {
+          ++right;
+        } while (!toLeft[count - 1 - right]);
+      }
+
+      const size_t leftCol = begin + i;
+      const size_t rightCol = begin + count - 1 - right;
+      dataset->swap_cols(leftCol, rightCol);
+      if (oldFromNew)
+        std::swap((*oldFromNew)[leftCol], (*oldFromNew)[rightCol]);
+    }
+  }
+
+  return begin + numLeft;
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
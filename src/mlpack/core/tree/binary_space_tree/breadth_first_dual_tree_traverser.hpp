@@ -49,6 +49,16 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
    */
   BreadthFirstDualTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~BreadthFirstDualTreeTraverser()
+  {
+    Counter::Add("dual_tree_prunes", numPrunes);
+    Counter::Add("dual_tree_visited", numVisited);
+    Counter::Add("dual_tree_scores", numScores);
+  }
+
   typedef QueueFrame<BinarySpaceTree, typename RuleType::TraversalInfoType>
       QueueFrameType;
 
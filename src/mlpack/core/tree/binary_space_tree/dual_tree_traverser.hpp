@@ -38,6 +38,16 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
    */
   DualTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~DualTreeTraverser()
+  {
+    Counter::Add("dual_tree_prunes", numPrunes);
+    Counter::Add("dual_tree_visited", numVisited);
+    Counter::Add("dual_tree_scores", numScores);
+  }
+
   /**
    * Traverse the two trees.  This does not reset the number of prunes.
    *
@@ -37,6 +37,14 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
    */
   SingleTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~SingleTreeTraverser()
+  {
+    Counter::Add("single_tree_prunes", numPrunes);
+  }
+
   /**
    * Traverse the tree with the given point.
    *
@@ -34,6 +34,14 @@ class CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
    */
   DualTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~DualTreeTraverser()
+  {
+    Counter::Add("dual_tree_prunes", numPrunes);
+  }
+
   /**
    * Traverse the two specified trees.
    *
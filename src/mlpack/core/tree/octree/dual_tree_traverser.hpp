@@ -30,6 +30,16 @@ class Octree<MetricType, StatisticType, MatType>::DualTreeTraverser
    */
   DualTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~DualTreeTraverser()
+  {
+    Counter::Add("dual_tree_prunes", numPrunes);
+    Counter::Add("dual_tree_visited", numVisited);
+    Counter::Add("dual_tree_scores", numScores);
+  }
+
   /**
    * Traverse the two trees.  This does not reset the statistics of the
    * traversals (it just adds to them).
@@ -28,6 +28,14 @@ class Octree<MetricType, StatisticType, MatType>::SingleTreeTraverser
    */
   SingleTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~SingleTreeTraverser()
+  {
+    Counter::Add("single_tree_prunes", numPrunes);
+  }
+
   /**
    * Traverse the reference tree with the given query point.  This does not
    * reset the number of pruned nodes.
@@ -37,6 +37,14 @@ class RectangleTree<MetricType, StatisticType, MatType, SplitType,
    */
   SingleTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~SingleTreeTraverser()
+  {
+    Counter::Add("single_tree_prunes", numPrunes);
+  }
+
   /**
    * Traverse the tree with the given point.
    *
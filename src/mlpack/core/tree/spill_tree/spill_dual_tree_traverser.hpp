@@ -41,6 +41,16 @@ class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
    */
   SpillDualTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~SpillDualTreeTraverser()
+  {
+    Counter::Add("dual_tree_prunes", numPrunes);
+    Counter::Add("dual_tree_visited", numVisited);
+    Counter::Add("dual_tree_scores", numScores);
+  }
+
   /**
    * Traverse the two trees.  This does not reset the number of prunes.
    *
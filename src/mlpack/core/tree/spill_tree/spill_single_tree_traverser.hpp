@@ -40,6 +40,14 @@ class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
    */
   SpillSingleTreeTraverser(RuleType& rule);
 
+  /**
+   * Publish the statistics of the traversal to the performance counters.
+   */
+  ~SpillSingleTreeTraverser()
+  {
+    Counter::Add("single_tree_prunes", numPrunes);
+  }
+
   /**
    * Traverse the tree with the given point.
    *
@@ -0,0 +1,301 @@
+/**
+ * @file core/util/counters.cpp
+ *
+ * Implementation of performance counters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "counters.hpp"
+#include "io.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+// Counting is disabled by default.
+atomic<bool> Counter::enabled(false);
+
+// Add to the given counter.
+void Counter::Publish(const string& name, const double value)
+{
+  IO::GetSingleton().counters.Add(name, value);
+}
+
+// Append to the given series.
+void Counter::PublishSeries(const string& name, const double value)
+{
+  IO::GetSingleton().counters.Record(name, value);
+}
+
+// Get the given counter, summing over all threads.
+double Counter::Get(const string& name)
+{
+  return IO::GetSingleton().counters.GetCounter(name);
+}
+
+// Get the given series, concatenated over all threads.
+vector<double> Counter::GetSeries(const string& name)
+{
+  return IO::GetSingleton().counters.GetSeries(name);
+}
+
+// Enable counting.
+void Counter::EnableCounting()
+{
+  IO::GetSingleton().counters.Enabled() = true;
+  enabled = true;
+}
+
+// Disable counting.
+void Counter::DisableCounting()
+{
+  IO::GetSingleton().counters.Enabled() = false;
+  enabled = false;
+}
+
+// Return whether counting is enabled.
+bool Counter::Enabled()
+{
+  return enabled;
+}
+
+// Reset all counters.  Save state of enabled.
+void Counter::ResetAll()
+{
+  IO::GetSingleton().counters.Reset();
+}
+
+// Dump the timers and counters.
+string Counter::ToJSON()
+{
+  ostringstream stream;
+  IO::GetSingleton().counters.WriteJSON(stream,
+      IO::GetSingleton().timer.GetAllTimers());
+  return stream.str();
+}
+
+Counters::ThreadCounters& Counters::LocalCounters()
+{
+  // Each thread registers its own block the first time it publishes anything,
+  // and afterwards only takes the (uncontended) lock of that block.
+  thread_local Counters* owner = NULL;
+  thread_local ThreadCounters* local = NULL;
+  if (owner != this)
+  {
+    lock_guard<mutex> lock(countersMutex);
+    threadCounters.emplace_back();
+    local = &threadCounters.back();
+    owner = this;
+  }
+
+  return *local;
+}
+
+void Counters::Add(const string& name, const double value)
+{
+  // Don't do anything if we aren't counting.
+  if (!enabled)
+    return;
+
+  ThreadCounters& local = LocalCounters();
+  lock_guard<mutex> lock(local.mutex);
+  local.counters[name] += value;
+}
+
+void Counters::Record(const string& name, const double value)
+{
+  // Don't do anything if we aren't counting.
+  if (!enabled)
+    return;
+
+  ThreadCounters& local = LocalCounters();
+  lock_guard<mutex> lock(local.mutex);
+  local.series[name].push_back(value);
+}
+
+double Counters::GetCounter(const string& name)
+{
+  lock_guard<mutex> lock(countersMutex);
+  double sum = 0.0;
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    unordered_map<string, double>::const_iterator it =
+        block.counters.find(name);
+    if (it != block.counters.end())
+      sum += it->second;
+  }
+
+  return sum;
+}
+
+vector<double> Counters::GetSeries(const string& name)
+{
+  lock_guard<mutex> lock(countersMutex);
+  vector<double> series;
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    unordered_map<string, vector<double>>::const_iterator it =
+        block.series.find(name);
+    if (it != block.series.end())
+      series.insert(series.end(), it->second.begin(), it->second.end());
+  }
+
+  return series;
+}
+
+map<string, double> Counters::GetAllCounters()
+{
+  lock_guard<mutex> lock(countersMutex);
+  map<string, double> counters;
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    for (const pair<const string, double>& c : block.counters)
+      counters[c.first] += c.second;
+  }
+
+  return counters;
+}
+
+vector<map<string, double>> Counters::GetThreadCounters()
+{
+  lock_guard<mutex> lock(countersMutex);
+  vector<map<string, double>> counters;
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    if (!block.counters.empty())
+    {
+      counters.push_back(map<string, double>(block.counters.begin(),
+          block.counters.end()));
+    }
+  }
+
+  return counters;
+}
+
+map<string, vector<double>> Counters::GetAllSeries()
+{
+  lock_guard<mutex> lock(countersMutex);
+  map<string, vector<double>> series;
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    for (const pair<const string, vector<double>>& s : block.series)
+    {
+      vector<double>& values = series[s.first];
+      values.insert(values.end(), s.second.begin(), s.second.end());
+    }
+  }
+
+  return series;
+}
+
+void Counters::Reset()
+{
+  // The blocks stay registered, since their threads may still hold them.
+  lock_guard<mutex> lock(countersMutex);
+  for (ThreadCounters& block : threadCounters)
+  {
+    lock_guard<mutex> blockLock(block.mutex);
+    block.counters.clear();
+    block.series.clear();
+  }
+}
+
+// Write a string as a JSON string literal.
+static void WriteJSONString(ostream& stream, const string& str)
+{
+  stream << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if ((unsigned char) c < 0x20)
+      stream << "\\u" << hex << setw(4) << setfill('0') << (int) c << dec;
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+// Write a number as a JSON value; JSON has no representation of NaN or
+// infinity, so those become null.
+static void WriteJSONNumber(ostream& stream, const double value)
+{
+  if (std::isfinite(value))
+    stream << setprecision(15) << value;
+  else
+    stream << "null";
+}
+
+// Write a map of counters as a JSON object.
+static void WriteJSONCounters(ostream& stream,
+                              const map<string, double>& counters,
+                              const string& indent)
+{
+  stream << "{";
+  bool first = true;
+  for (const pair<const string, double>& c : counters)
+  {
+    stream << (first ? "\n" : ",\n") << indent << "  ";
+    WriteJSONString(stream, c.first);
+    stream << ": ";
+    WriteJSONNumber(stream, c.second);
+    first = false;
+  }
+  stream << (first ? "}" : "\n" + indent + "}");
+}
+
+void Counters::WriteJSON(ostream& stream,
+                         const map<string, microseconds>& timers)
+{
+  // Timers are converted to seconds.
+  map<string, double> timerSeconds;
+  for (const pair<const string, microseconds>& t : timers)
+    timerSeconds[t.first] = t.second.count() / 1e6;
+
+  stream << "{\n  \"timers\": ";
+  WriteJSONCounters(stream, timerSeconds, "  ");
+
+  stream << ",\n  \"counters\": ";
+  WriteJSONCounters(stream, GetAllCounters(), "  ");
+
+  stream << ",\n  \"series\": {";
+  bool first = true;
+  for (const pair<const string, vector<double>>& s : GetAllSeries())
+  {
+    stream << (first ? "\n" : ",\n") << "    ";
+    WriteJSONString(stream, s.first);
+    stream << ": [";
+    for (size_t i = 0; i < s.second.size(); ++i)
+    {
+      if (i > 0)
+        stream << ", ";
+      WriteJSONNumber(stream, s.second[i]);
+    }
+    stream << "]";
+    first = false;
+  }
+  stream << (first ? "}" : "\n  }");
+
+  // The counters of each thread show how the work was balanced.
+  stream << ",\n  \"threads\": [";
+  first = true;
+  for (const map<string, double>& counters : GetThreadCounters())
+  {
+    stream << (first ? "\n" : ",\n") << "    ";
+    WriteJSONCounters(stream, counters, "    ");
+    first = false;
+  }
+  stream << (first ? "]" : "\n  ]") << "\n}\n";
+}
@@ -0,0 +1,246 @@
+/**
+ * @file core/util/counters.hpp
+ *
+ * Performance counters for mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_COUNTERS_HPP
+#define MLPACK_CORE_UTILITIES_COUNTERS_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+namespace mlpack {
+
+/**
+ * The counter class provides a way for mlpack methods to publish structured
+ * statistics about their work, such as the number of base cases and prunes of
+ * a tree traversal, or the objective of each iteration of an optimization.  A
+ * named counter is a sum that can be added to from any thread; a named series
+ * is a list of values (for instance one objective per iteration) that can be
+ * appended to.
+ *
+ * Every thread accumulates into its own block of counters, so publishing a
+ * value never contends with other threads.  Counting is disabled by default,
+ * in which case Add() and Record() are inlined to a single check of a flag;
+ * names given as string literals are only turned into std::string objects
+ * when counting is enabled.  Hot loops should still accumulate locally and
+ * publish their totals once, as the tree traversers do.
+ */
+class Counter
+{
+ public:
+  /**
+   * Add the given value to the given counter.
+   *
+   * @param name Name of the counter.
+   * @param value Value to add to the counter.
+   */
+  static void Add(const char* name, const double value = 1.0)
+  {
+    if (enabled.load(std::memory_order_relaxed))
+      Publish(name, value);
+  }
+
+  /**
+   * Add the given value to the given counter.
+   *
+   * @param name Name of the counter.
+   * @param value Value to add to the counter.
+   */
+  static void Add(const std::string& name, const double value = 1.0)
+  {
+    if (enabled.load(std::memory_order_relaxed))
+      Publish(name, value);
+  }
+
+  /**
+   * Append the given value to the given series.
+   *
+   * @param name Name of the series.
+   * @param value Value to append to the series.
+   */
+  static void Record(const char* name, const double value)
+  {
+    if (enabled.load(std::memory_order_relaxed))
+      PublishSeries(name, value);
+  }
+
+  /**
+   * Append the given value to the given series.
+   *
+   * @param name Name of the series.
+   * @param value Value to append to the series.
+   */
+  static void Record(const std::string& name, const double value)
+  {
+    if (enabled.load(std::memory_order_relaxed))
+      PublishSeries(name, value);
+  }
+
+  /**
+   * Get the value of the given counter, summed over all threads.
+   *
+   * @param name Name of the counter.
+   */
+  static double Get(const std::string& name);
+
+  /**
+   * Get the values of the given series, in the order they were recorded in
+   * each thread.
+   *
+   * @param name Name of the series.
+   */
+  static std::vector<double> GetSeries(const std::string& name);
+
+  /**
+   * Enable counting.
+   */
+  static void EnableCounting();
+
+  /**
+   * Disable counting.
+   */
+  static void DisableCounting();
+
+  /**
+   * Return whether counting is enabled.
+   */
+  static bool Enabled();
+
+  /**
+   * Reset all counters and series to zero.  Whether or not counting is enabled
+   * will not be changed.
+   */
+  static void ResetAll();
+
+  /**
+   * Return a JSON document holding all timers (in seconds), all counters
+   * (summed over threads and per thread), and all series.
+   */
+  static std::string ToJSON();
+
+ private:
+  //! Add the given value to the given counter of the calling thread.
+  static void Publish(const std::string& name, const double value);
+  //! Append the given value to the given series of the calling thread.
+  static void PublishSeries(const std::string& name, const double value);
+
+  //! Whether or not counting is enabled; this is checked without touching the
+  //! IO singleton.
+  static std::atomic<bool> enabled;
+};
+
+class Counters
+{
+ public:
+  //! Default to disabled.
+  Counters() : enabled(false) { }
+
+  /**
+   * Add the given value to the given counter of the calling thread.
+   *
+   * @param name Name of the counter.
+   * @param value Value to add.
+   */
+  void Add(const std::string& name, const double value);
+
+  /**
+   * Append the given value to the given series of the calling thread.
+   *
+   * @param name Name of the series.
+   * @param value Value to append.
+   */
+  void Record(const std::string& name, const double value);
+
+  /**
+   * Returns the given counter, summed over all threads.
+   *
+   * @param name Name of the counter.
+   */
+  double GetCounter(const std::string& name);
+
+  /**
+   * Returns the given series, concatenated over all threads.
+   *
+   * @param name Name of the series.
+   */
+  std::vector<double> GetSeries(const std::string& name);
+
+  /**
+   * Returns a copy of all counters, summed over all threads.
+   */
+  std::map<std::string, double> GetAllCounters();
+
+  /**
+   * Returns a copy of the counters of each thread that has published any.
+   */
+  std::vector<std::map<std::string, double>> GetThreadCounters();
+
+  /**
+   * Returns a copy of all series, concatenated over all threads.
+   */
+  std::map<std::string, std::vector<double>> GetAllSeries();
+
+  /**
+   * Reset all counters and series to zero.
+   */
+  void Reset();
+
+  /**
+   * Write all counters and series, along with the given timers, as a JSON
+   * document to the given stream.
+   *
+   * @param stream Stream to write to.
+   * @param timers Timers to write along with the counters.
+   */
+  void WriteJSON(std::ostream& stream,
+                 const std::map<std::string, std::chrono::microseconds>&
+                     timers);
+
+  //! Modify whether or not counting is enabled.
+  std::atomic<bool>& Enabled() { return enabled; }
+  //! Get whether or not counting is enabled.
+  bool Enabled() const { return enabled; }
+
+ private:
+  //! The counters and series published by a single thread.
+  struct ThreadCounters
+  {
+    //! The counters of the thread.
+    std::unordered_map<std::string, double> counters;
+    //! The series of the thread.
+    std::unordered_map<std::string, std::vector<double>> series;
+    //! A mutex for reading the block while the thread modifies it.
+    std::mutex mutex;
+  };
+
+  /**
+   * Return the block of the calling thread, registering it the first time the
+   * thread publishes anything.
+   */
+  ThreadCounters& LocalCounters();
+
+  //! The blocks of all threads.  A list is used so that blocks never move.
+  std::list<ThreadCounters> threadCounters;
+  //! A mutex for registering new blocks.
+  std::mutex countersMutex;
+
+  //! Whether or not counting is enabled.
+  std::atomic<bool> enabled;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTILITIES_COUNTERS_HPP
@@ -23,6 +23,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "timers.hpp"
+#include "counters.hpp"
 #include "program_doc.hpp"
 #include "version.hpp"
 
@@ -322,6 +323,9 @@ class IO
   //! So that Timer::Start() and Timer::Stop() can access the timer variable.
   friend class Timer;
 
+  //! Holds the performance counters.
+  Counters counters;
+
   //! Pointer to the ProgramDoc object.
   util::ProgramDoc* doc;
 
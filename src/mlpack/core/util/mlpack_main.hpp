@@ -410,6 +410,8 @@ PARAM_FLAG("verbose", "Display informational messages and the full list of "
 PARAM_FLAG("help", "Default help info.", "h");
 PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("counters_file", "If specified, the timers and performance "
+    "counters of the run are written to the given file as JSON.", "", "");
 
 // Python-specific parameters.
 PARAM_FLAG("copy_all_inputs", "If specified, all input parameters will be deep"
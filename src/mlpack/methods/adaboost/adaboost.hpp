@@ -70,6 +70,9 @@ namespace adaboost {
  * void Classify(const MatType& data, arma::Row<size_t>& predictedLabels);
  * @endcode
  *
+ * AdaBoost classifies the test points in blocks in parallel, so Classify() may
+ * be called on the same weak learner from several threads at once.
+ *
  * For more information on and examples of weak learners, see
  * perceptron::Perceptron<> and decision_stump::DecisionStump<>.
  *
@@ -127,7 +127,8 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // buildClassificationMatrix(ht, predictedLabels);
 
     // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    #pragma omp parallel for reduction(+:rt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
         rt += arma::accu(D.col(j));
@@ -156,10 +157,12 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights.  Every point only touches its own
+    // column of D and sumFinalH.
+    const double expo = exp(alphat);
+    #pragma omp parallel for reduction(+:zt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
@@ -210,7 +213,6 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
   arma::mat probabilities;
 
   Classify(test, predictedLabels, probabilities);
@@ -225,28 +227,38 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // Classify the points in blocks with all the weak learners at once, so that
+  // every block is only read from memory once.  The blocks are independent, so
+  // they are classified in parallel.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (test.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
   {
-    wl[i].Classify(test, tempPredictedLabels);
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) test.n_cols);
+    const MatType block = test.cols(begin, end - 1);
 
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
-  }
+    arma::Row<size_t> tempPredictedLabels(block.n_cols);
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      wl[i].Classify(block, tempPredictedLabels);
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
+      for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
+        probabilities(tempPredictedLabels(j), begin + j) += alpha[i];
+    }
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
-    pRow.max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    arma::uword maxIndex = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= arma::accu(probabilities.col(i));
+      probabilities.unsafe_col(i).max(maxIndex);
+      predictedLabels(i) = maxIndex;
+    }
   }
 }
 
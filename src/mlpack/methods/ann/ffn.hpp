@@ -15,14 +15,20 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "visitor/backward_visitor.hpp"
 #include "visitor/delete_visitor.hpp"
+#include "visitor/forward_visitor.hpp"
+#include "visitor/gradient_set_visitor.hpp"
+#include "visitor/gradient_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
 #include "visitor/output_parameter_visitor.hpp"
 #include "visitor/output_width_visitor.hpp"
 #include "visitor/reset_visitor.hpp"
+#include "visitor/weight_set_visitor.hpp"
 #include "visitor/weight_size_visitor.hpp"
 #include "visitor/copy_visitor.hpp"
+#include "visitor/layer_call_visitor.hpp"
 #include "visitor/loss_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
@@ -55,6 +61,10 @@ class FFN
   //! Convenience typedef for the internal model construction.
   using NetworkType = FFN<OutputLayerType, InitializationRuleType>;
 
+  //! The type of the matrices the network works with, given by the output
+  //! layer (arma::mat by default).
+  typedef typename NetworkMatType<OutputLayerType>::type MatType;
+
   /**
    * Create the FFN object.
    *
@@ -133,8 +143,8 @@ class FFN
    * @return The final objective of the trained model (NaN or Inf on error).
    */
   template<typename OptimizerType, typename... CallbackTypes>
-  double Train(arma::mat predictors,
-               arma::mat responses,
+  double Train(MatType predictors,
+               MatType responses,
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
@@ -159,8 +169,8 @@ class FFN
    * @return The final objective of the trained model (NaN or Inf on error).
    */
   template<typename OptimizerType = ens::RMSProp, typename... CallbackTypes>
-  double Train(arma::mat predictors,
-               arma::mat responses,
+  double Train(MatType predictors,
+               MatType responses,
                CallbackTypes&&... callbacks);
 
   /**
@@ -174,7 +184,7 @@ class FFN
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
    */
-  void Predict(arma::mat predictors, arma::mat& results);
+  void Predict(MatType predictors, MatType& results);
 
   /**
    * Evaluate the feedforward network with the given predictors and responses.
@@ -193,7 +203,7 @@ class FFN
    *
    * @param parameters Matrix model parameters.
    */
-  double Evaluate(const arma::mat& parameters);
+  double Evaluate(const MatType& parameters);
 
    /**
    * Evaluate the feedforward network with the given parameters, but using only
@@ -208,7 +218,7 @@ class FFN
    * @param deterministic Whether or not to train or test the model. Note some
    *        layer act differently in training or testing mode.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const MatType& parameters,
                   const size_t begin,
                   const size_t batchSize,
                   const bool deterministic);
@@ -225,7 +235,7 @@ class FFN
    * @param batchSize Number of points to be passed at a time to use for
    *        objective function evaluation.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const MatType& parameters,
                   const size_t begin,
                   const size_t batchSize);
 
@@ -238,7 +248,7 @@ class FFN
    * @param gradient Matrix to output gradient into.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters, GradType& gradient);
+  double EvaluateWithGradient(const MatType& parameters, GradType& gradient);
 
    /**
    * Evaluate the feedforward network with the given parameters, but using only
@@ -253,7 +263,7 @@ class FFN
    *        objective function evaluation.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const MatType& parameters,
                               const size_t begin,
                               GradType& gradient,
                               const size_t batchSize);
@@ -270,9 +280,9 @@ class FFN
    * @param batchSize Number of points to be processed as a batch for objective
    *        function gradient evaluation.
    */
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const MatType& parameters,
                 const size_t begin,
-                arma::mat& gradient,
+                MatType& gradient,
                 const size_t batchSize);
 
   /**
@@ -294,35 +304,51 @@ class FFN
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<MatType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Get the network model.
-  const std::vector<LayerTypes<CustomLayers...> >& Model() const
+  const std::vector<BasicLayerTypes<MatType, CustomLayers...> >& Model() const
   {
     return network;
   }
   //! Modify the network model.  Be careful!  If you change the structure of the
   //! network or parameters for layers, its state may become invalid, so be sure
   //! to call ResetParameters() afterwards.
-  std::vector<LayerTypes<CustomLayers...> >& Model() { return network; }
+  std::vector<BasicLayerTypes<MatType, CustomLayers...> >& Model()
+  {
+    return network;
+  }
 
   //! Return the number of separable functions (the number of predictor points).
   size_t NumFunctions() const { return numFunctions; }
 
   //! Return the initial point for the optimization.
-  const arma::mat& Parameters() const { return parameter; }
+  const MatType& Parameters() const { return parameter; }
   //! Modify the initial point for the optimization.
-  arma::mat& Parameters() { return parameter; }
+  MatType& Parameters() { return parameter; }
+
+  //! Get the number of threads used to evaluate the gradient of a batch.
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads used to evaluate the gradient of a batch.
+  //! With more than one thread, every batch is split into contiguous shards
+  //! that are passed through copies of the network sharing the parameters, and
+  //! the gradients of the shards are summed in a fixed order.  The results only
+  //! depend on the number of threads, but layers that compute statistics over
+  //! the batch (like BatchNorm) only see the points of their shard.
+  size_t& NumThreads() { return numThreads; }
 
   //! Get the matrix of responses to the input data points.
-  const arma::mat& Responses() const { return responses; }
+  const MatType& Responses() const { return responses; }
   //! Modify the matrix of responses to the input data points.
-  arma::mat& Responses() { return responses; }
+  MatType& Responses() { return responses; }
 
   //! Get the matrix of data points (predictors).
-  const arma::mat& Predictors() const { return predictors; }
+  const MatType& Predictors() const { return predictors; }
   //! Modify the matrix of data points (predictors).
-  arma::mat& Predictors() { return predictors; }
+  MatType& Predictors() { return predictors; }
 
   /**
    * Reset the module infomration (weights/parameters).
@@ -383,6 +409,17 @@ class FFN
                   GradientsType& gradients);
 
  private:
+  //! The visitors used by the network work on layers with MatType.
+  typedef BasicForwardVisitor<MatType> ForwardVisitor;
+  typedef BasicBackwardVisitor<MatType> BackwardVisitor;
+  typedef BasicGradientVisitor<MatType> GradientVisitor;
+  typedef BasicDeltaVisitor<MatType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<MatType> OutputParameterVisitor;
+  typedef BasicGradientSetVisitor<MatType> GradientSetVisitor;
+  typedef BasicWeightSetVisitor<MatType> WeightSetVisitor;
+  typedef BasicCopyVisitor<MatType, CustomLayers...> CopyVisitor;
+  typedef BasicLayerCallVisitor<MatType> LayerCallVisitor;
+
   // Helper functions.
   /**
    * The Forward algorithm (part of the Forward-Backward algorithm).  Computes
@@ -400,7 +437,7 @@ class FFN
    * @param predictors Input data variables.
    * @param responses Outputs results from input data variables.
    */
-  void ResetData(arma::mat predictors, arma::mat responses);
+  void ResetData(MatType predictors, MatType responses);
 
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
@@ -415,6 +452,13 @@ class FFN
   template<typename InputType>
   void Gradient(const InputType& input);
 
+  /**
+   * Bind the Forward(), Backward() and Gradient() functions and the output
+   * parameter and delta of every layer, so that the passes through the network
+   * don't have to dispatch through the layer variant.
+   */
+  void ResetLayerCalls();
+
   /**
    * Reset the module status by setting the current deterministic parameter
    * for all modules that implement the Deterministic function.
@@ -424,7 +468,26 @@ class FFN
   /**
    * Reset the gradient for all modules that implement the Gradient function.
    */
-  void ResetGradients(arma::mat& gradient);
+  void ResetGradients(MatType& gradient);
+
+  /**
+   * Evaluate the objective and the gradient of the given batch, split into one
+   * shard per thread.  The first shard is passed through this network and the
+   * others through the replicas.
+   *
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix to store the gradient in.
+   * @param batchSize Number of points in the batch.
+   */
+  double ParallelEvaluateWithGradient(const size_t begin,
+                                      MatType& gradient,
+                                      const size_t batchSize);
+
+  /**
+   * Create the copies of the network used by the other threads.  The layers of
+   * the replicas use the parameters of this network.
+   */
+  void ResetReplicas();
 
   /**
    * Swap the content of this network with given network.
@@ -450,22 +513,22 @@ class FFN
   bool reset;
 
   //! Locally-stored model modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<MatType, CustomLayers...> > network;
 
   //! The matrix of data points (predictors).
-  arma::mat predictors;
+  MatType predictors;
 
   //! The matrix of responses to the input data points.
-  arma::mat responses;
+  MatType responses;
 
   //! Matrix of (trained) parameters.
-  arma::mat parameter;
+  MatType parameter;
 
   //! The number of separable functions (the number of predictor points).
   size_t numFunctions;
 
   //! The current error for the backward pass.
-  arma::mat error;
+  MatType error;
 
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
@@ -495,19 +558,40 @@ class FFN
   bool deterministic;
 
   //! Locally-stored delta object.
-  arma::mat delta;
+  MatType delta;
 
   //! Locally-stored input parameter object.
-  arma::mat inputParameter;
+  MatType inputParameter;
 
   //! Locally-stored output parameter object.
-  arma::mat outputParameter;
+  MatType outputParameter;
 
   //! Locally-stored gradient parameter.
-  arma::mat gradient;
+  MatType gradient;
 
   //! Locally-stored copy visitor
-  CopyVisitor<CustomLayers...> copyVisitor;
+  CopyVisitor copyVisitor;
+
+  //! The bound functions of the layers, in the order of the network.
+  std::vector<LayerCall<MatType> > layerCalls;
+
+  //! The number of threads used to evaluate the gradient of a batch.
+  size_t numThreads;
+
+  //! The copies of the network used by the other threads.
+  std::vector<FFN*> replicas;
+
+  //! The gradients of the shards of the replicas.
+  std::vector<MatType> replicaGradients;
+
+  //! The parameters the replicas were created for.
+  const typename MatType::elem_type* replicaParameter;
+
+  //! The output of the network for all the shards of a batch.
+  MatType networkOutput;
+
+  //! The error of the output layer for all the shards of a batch.
+  MatType networkError;
 
   // The GAN class should have access to internal members.
   template<
@@ -15,11 +15,7 @@
 // In case it hasn't been included yet.
 #include "ffn.hpp"
 
-#include "visitor/forward_visitor.hpp"
-#include "visitor/backward_visitor.hpp"
 #include "visitor/deterministic_set_visitor.hpp"
-#include "visitor/gradient_set_visitor.hpp"
-#include "visitor/gradient_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
 
@@ -39,7 +35,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    numThreads(1),
+    replicaParameter(NULL)
 {
   /* Nothing to do here. */
 }
@@ -50,12 +48,15 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
+
+  for (size_t i = 0; i < replicas.size(); ++i)
+    delete replicas[i];
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
-    arma::mat predictors, arma::mat responses)
+    MatType predictors, MatType responses)
 {
   numFunctions = responses.n_cols;
   this->predictors = std::move(predictors);
@@ -106,8 +107,8 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
-      arma::mat predictors,
-      arma::mat responses,
+      MatType predictors,
+      MatType responses,
       OptimizerType& optimizer,
       CallbackTypes&&... callbacks)
 {
@@ -129,8 +130,8 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
-    arma::mat predictors,
-    arma::mat responses,
+    MatType predictors,
+    MatType responses,
     CallbackTypes&&... callbacks)
 {
   ResetData(std::move(predictors), std::move(responses));
@@ -205,7 +206,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward(
   outputLayer.Backward(boost::apply_visitor(outputParameterVisitor,
       network.back()), targets, error);
 
-  gradients = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
+  gradients = arma::zeros<MatType>(parameter.n_rows, parameter.n_cols);
 
   Backward();
   ResetGradients(gradients);
@@ -217,7 +218,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
-    arma::mat predictors, arma::mat& results)
+    MatType predictors, MatType& results)
 {
   if (parameter.is_empty())
     ResetParameters();
@@ -228,17 +229,17 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
-  arma::mat resultsTemp;
-  Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
+  MatType resultsTemp;
+  Forward(MatType(predictors.colptr(0), predictors.n_rows, 1, false, true));
   resultsTemp = boost::apply_visitor(outputParameterVisitor,
       network.back()).col(0);
 
-  results = arma::mat(resultsTemp.n_elem, predictors.n_cols);
+  results = MatType(resultsTemp.n_elem, predictors.n_cols);
   results.col(0) = resultsTemp.col(0);
 
   for (size_t i = 1; i < predictors.n_cols; ++i)
   {
-    Forward(arma::mat(predictors.colptr(i), predictors.n_rows, 1, false, true));
+    Forward(MatType(predictors.colptr(i), predictors.n_rows, 1, false, true));
 
     resultsTemp = boost::apply_visitor(outputParameterVisitor,
         network.back());
@@ -277,7 +278,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
-    const arma::mat& parameters)
+    const MatType& parameters)
 {
   double res = 0;
   for (size_t i = 0; i < predictors.n_cols; ++i)
@@ -289,7 +290,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
-    const arma::mat& /* parameters */,
+    const MatType& /* parameters */,
     const size_t begin,
     const size_t batchSize,
     const bool deterministic)
@@ -319,7 +320,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
-    const arma::mat& parameters, const size_t begin, const size_t batchSize)
+    const MatType& parameters, const size_t begin, const size_t batchSize)
 {
   return Evaluate(parameters, begin, batchSize, true);
 }
@@ -328,7 +329,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename GradType>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
-EvaluateWithGradient(const arma::mat& parameters, GradType& gradient)
+EvaluateWithGradient(const MatType& parameters, GradType& gradient)
 {
   double res = 0;
   for (size_t i = 0; i < predictors.n_cols; ++i)
@@ -341,7 +342,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename GradType>
 double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
-EvaluateWithGradient(const arma::mat& /* parameters */,
+EvaluateWithGradient(const MatType& /* parameters */,
                      const size_t begin,
                      GradType& gradient,
                      const size_t batchSize)
@@ -351,7 +352,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     if (parameter.is_empty())
       ResetParameters();
 
-    gradient = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
+    gradient = arma::zeros<MatType>(parameter.n_rows, parameter.n_cols);
   }
   else
   {
@@ -364,34 +365,167 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
-  double res = outputLayer.Forward(
-      boost::apply_visitor(outputParameterVisitor, network.back()),
+  double res = 0;
+  if (numThreads > 1 && batchSize > 1)
+  {
+    res = ParallelEvaluateWithGradient(begin, gradient, batchSize);
+  }
+  else
+  {
+    Forward(predictors.cols(begin, begin + batchSize - 1));
+    res = outputLayer.Forward(
+        boost::apply_visitor(outputParameterVisitor, network.back()),
+        responses.cols(begin, begin + batchSize - 1));
+
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      res += boost::apply_visitor(lossVisitor, network[i]);
+    }
+
+    outputLayer.Backward(
+        boost::apply_visitor(outputParameterVisitor, network.back()),
+        responses.cols(begin, begin + batchSize - 1),
+        error);
+
+    Backward();
+    ResetGradients(gradient);
+    Gradient(predictors.cols(begin, begin + batchSize - 1));
+  }
+
+  // One call is one iteration of the optimizer.
+  Counter::Add("ffn_points", batchSize);
+  Counter::Record("ffn_objective", res);
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+ParallelEvaluateWithGradient(const size_t begin,
+                             MatType& gradient,
+                             const size_t batchSize)
+{
+  if (replicas.size() != numThreads - 1 ||
+      replicaParameter != parameter.memptr())
+  {
+    ResetReplicas();
+  }
+
+  // Split the batch into contiguous shards, one per thread.  The first shard
+  // is handled by this network.
+  const size_t shards = std::min(numThreads, batchSize);
+  std::vector<size_t> bounds(shards + 1);
+  for (size_t t = 0; t <= shards; ++t)
+    bounds[t] = begin + t * batchSize / shards;
+
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) shards; ++t)
+  {
+    FFN& shard = (t == 0) ? *this : *replicas[t - 1];
+    shard.Forward(predictors.cols(bounds[t], bounds[t + 1] - 1));
+  }
+
+  // The output layer sees the whole batch, so that its normalization doesn't
+  // depend on the number of shards.
+  for (size_t t = 0; t < shards; ++t)
+  {
+    FFN& shard = (t == 0) ? *this : *replicas[t - 1];
+    const MatType& shardOutput = boost::apply_visitor(outputParameterVisitor,
+        shard.network.back());
+    if (t == 0)
+      networkOutput.set_size(shardOutput.n_rows, batchSize);
+
+    networkOutput.cols(bounds[t] - begin, bounds[t + 1] - begin - 1) =
+        shardOutput;
+  }
+
+  double res = outputLayer.Forward(networkOutput,
       responses.cols(begin, begin + batchSize - 1));
+  outputLayer.Backward(networkOutput,
+      responses.cols(begin, begin + batchSize - 1), networkError);
 
-  for (size_t i = 0; i < network.size(); ++i)
+  for (size_t t = 0; t < shards; ++t)
   {
-    res += boost::apply_visitor(lossVisitor, network[i]);
+    FFN& shard = (t == 0) ? *this : *replicas[t - 1];
+    for (size_t i = 0; i < shard.network.size(); ++i)
+      res += boost::apply_visitor(lossVisitor, shard.network[i]);
   }
 
-  outputLayer.Backward(
-      boost::apply_visitor(outputParameterVisitor, network.back()),
-      responses.cols(begin, begin + batchSize - 1),
-      error);
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) shards; ++t)
+  {
+    FFN& shard = (t == 0) ? *this : *replicas[t - 1];
+    MatType& shardGradient = (t == 0) ? gradient : replicaGradients[t - 1];
+    if (t > 0)
+      shardGradient.zeros(parameter.n_rows, parameter.n_cols);
+
+    shard.error = networkError.cols(bounds[t] - begin,
+        bounds[t + 1] - begin - 1);
+    shard.Backward();
+    shard.ResetGradients(shardGradient);
+    shard.Gradient(predictors.cols(bounds[t], bounds[t + 1] - 1));
+  }
 
-  Backward();
-  ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  // Sum the gradients of the shards in order, so that the result only depends
+  // on the number of threads.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) gradient.n_elem; ++i)
+  {
+    for (size_t t = 1; t < shards; ++t)
+      gradient[i] += replicaGradients[t - 1][i];
+  }
 
   return res;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetReplicas()
+{
+  for (size_t i = 0; i < replicas.size(); ++i)
+    delete replicas[i];
+  replicas.clear();
+  replicaGradients.clear();
+
+  // Resetting the layers of a replica may initialize the weights of some
+  // layers again, so keep the current parameters.
+  const MatType currentParameter = parameter;
+
+  for (size_t t = 1; t < numThreads; ++t)
+  {
+    FFN* replica = new FFN(outputLayer, initializeRule);
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      replica->network.push_back(boost::apply_visitor(copyVisitor,
+          network[i]));
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < replica->network.size(); ++i)
+    {
+      offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+          replica->network[i]);
+
+      boost::apply_visitor(resetVisitor, replica->network[i]);
+    }
+
+    replica->ResetDeterministic();
+    replicas.push_back(replica);
+  }
+
+  replicaGradients.resize(replicas.size());
+  parameter = currentParameter;
+  replicaParameter = parameter.memptr();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
-    const arma::mat& parameters,
+    const MatType& parameters,
     const size_t begin,
-    arma::mat& gradient,
+    MatType& gradient,
     const size_t batchSize)
 {
   this->EvaluateWithGradient(parameters, begin, gradient, batchSize);
@@ -415,6 +549,22 @@ void FFN<OutputLayerType, InitializationRuleType,
   NetworkInitialization<InitializationRuleType,
                         CustomLayers...> networkInit(initializeRule);
   networkInit.Initialize(network, parameter);
+
+  ResetLayerCalls();
+
+  // The replicas have to be created again for the new layers.
+  replicaParameter = NULL;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetLayerCalls()
+{
+  layerCalls.clear();
+  layerCalls.reserve(network.size());
+  for (size_t i = 0; i < network.size(); ++i)
+    layerCalls.push_back(boost::apply_visitor(LayerCallVisitor(), network[i]));
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -430,7 +580,7 @@ void FFN<OutputLayerType, InitializationRuleType,
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType,
-         CustomLayers...>::ResetGradients(arma::mat& gradient)
+         CustomLayers...>::ResetGradients(MatType& gradient)
 {
   size_t offset = 0;
   for (size_t i = 0; i < network.size(); ++i)
@@ -446,73 +596,78 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
+  if (layerCalls.size() != network.size())
+    ResetLayerCalls();
+
+  // Once the input sizes of the layers are set, the layers can be called
+  // directly.
+  if (reset)
+  {
+    layerCalls.front().forward(layerCalls.front().layer, input,
+        *layerCalls.front().outputParameter);
+    for (size_t i = 1; i < layerCalls.size(); ++i)
+    {
+      layerCalls[i].forward(layerCalls[i].layer,
+          *layerCalls[i - 1].outputParameter, *layerCalls[i].outputParameter);
+    }
+
+    return;
+  }
+
   boost::apply_visitor(ForwardVisitor(input,
       boost::apply_visitor(outputParameterVisitor, network.front())),
       network.front());
 
-  if (!reset)
+  if (boost::apply_visitor(outputWidthVisitor, network.front()) != 0)
   {
-    if (boost::apply_visitor(outputWidthVisitor, network.front()) != 0)
-    {
-      width = boost::apply_visitor(outputWidthVisitor, network.front());
-    }
+    width = boost::apply_visitor(outputWidthVisitor, network.front());
+  }
 
-    if (boost::apply_visitor(outputHeightVisitor, network.front()) != 0)
-    {
-      height = boost::apply_visitor(outputHeightVisitor, network.front());
-    }
+  if (boost::apply_visitor(outputHeightVisitor, network.front()) != 0)
+  {
+    height = boost::apply_visitor(outputHeightVisitor, network.front());
   }
 
   for (size_t i = 1; i < network.size(); ++i)
   {
-    if (!reset)
-    {
-      // Set the input width.
-      boost::apply_visitor(SetInputWidthVisitor(width), network[i]);
+    // Set the input width.
+    boost::apply_visitor(SetInputWidthVisitor(width), network[i]);
 
-      // Set the input height.
-      boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
-    }
+    // Set the input height.
+    boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
 
     boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
         outputParameterVisitor, network[i - 1]),
         boost::apply_visitor(outputParameterVisitor, network[i])), network[i]);
 
-    if (!reset)
+    // Get the output width.
+    if (boost::apply_visitor(outputWidthVisitor, network[i]) != 0)
     {
-      // Get the output width.
-      if (boost::apply_visitor(outputWidthVisitor, network[i]) != 0)
-      {
-        width = boost::apply_visitor(outputWidthVisitor, network[i]);
-      }
-
-      // Get the output height.
-      if (boost::apply_visitor(outputHeightVisitor, network[i]) != 0)
-      {
-        height = boost::apply_visitor(outputHeightVisitor, network[i]);
-      }
+      width = boost::apply_visitor(outputWidthVisitor, network[i]);
+    }
+
+    // Get the output height.
+    if (boost::apply_visitor(outputHeightVisitor, network[i]) != 0)
+    {
+      height = boost::apply_visitor(outputHeightVisitor, network[i]);
     }
   }
 
-  if (!reset)
-    reset = true;
+  reset = true;
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
 {
-  boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-      outputParameterVisitor, network.back()), error,
-      boost::apply_visitor(deltaVisitor, network.back())), network.back());
+  const LayerCall<MatType>& last = layerCalls.back();
+  last.backward(last.layer, *last.outputParameter, error, *last.delta);
 
-  for (size_t i = 2; i < network.size(); ++i)
+  for (size_t i = 2; i < layerCalls.size(); ++i)
   {
-    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[network.size() - i]),
-        boost::apply_visitor(deltaVisitor, network[network.size() - i + 1]),
-        boost::apply_visitor(deltaVisitor, network[network.size() - i])),
-        network[network.size() - i]);
+    const LayerCall<MatType>& call = layerCalls[layerCalls.size() - i];
+    call.backward(call.layer, *call.outputParameter,
+        *layerCalls[layerCalls.size() - i + 1].delta, *call.delta);
   }
 }
 
@@ -522,19 +677,28 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Gradient(const InputType& input)
 {
-  boost::apply_visitor(GradientVisitor(input,
-      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+  // Layers without a gradient don't have a bound Gradient() function.
+  const size_t n = layerCalls.size();
+  if (layerCalls[0].gradient)
+  {
+    layerCalls[0].gradient(layerCalls[0].layer, input,
+        *layerCalls[1].delta);
+  }
 
-  for (size_t i = 1; i < network.size() - 1; ++i)
+  for (size_t i = 1; i < n - 1; ++i)
   {
-    boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[i - 1]),
-        boost::apply_visitor(deltaVisitor, network[i + 1])), network[i]);
+    if (layerCalls[i].gradient)
+    {
+      layerCalls[i].gradient(layerCalls[i].layer,
+          *layerCalls[i - 1].outputParameter, *layerCalls[i + 1].delta);
+    }
   }
 
-  boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-      outputParameterVisitor, network[network.size() - 2]), error),
-      network[network.size() - 1]);
+  if (layerCalls[n - 1].gradient)
+  {
+    layerCalls[n - 1].gradient(layerCalls[n - 1].layer,
+        *layerCalls[n - 2].outputParameter, error);
+  }
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -550,7 +714,7 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
   // Early versions used the currentInput member, which is now no longer needed.
   if (version < 2)
   {
-    arma::mat currentInput; // Temporary matrix to output.
+    MatType currentInput; // Temporary matrix to output.
     ar & BOOST_SERIALIZATION_NVP(currentInput);
   }
 
@@ -588,6 +752,9 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
       boost::apply_visitor(resetVisitor, network[i]);
     }
 
+    ResetLayerCalls();
+    replicaParameter = NULL;
+
     deterministic = true;
     ResetDeterministic();
   }
@@ -614,6 +781,11 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(layerCalls, network.layerCalls);
+  std::swap(numThreads, network.numThreads);
+  std::swap(replicas, network.replicas);
+  std::swap(replicaGradients, network.replicaGradients);
+  std::swap(replicaParameter, network.replicaParameter);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -634,7 +806,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    numThreads(network.numThreads),
+    replicaParameter(NULL)
 {
   // Build new layers according to source network
   for (size_t i = 0; i < network.network.size(); ++i)
@@ -662,7 +836,12 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    layerCalls(std::move(network.layerCalls)),
+    numThreads(network.numThreads),
+    replicas(std::move(network.replicas)),
+    replicaGradients(std::move(network.replicaGradients)),
+    replicaParameter(network.replicaParameter)
 {
   this->network = std::move(network.network);
 };
@@ -54,8 +54,11 @@ class NetworkInitialization
    * @param parameterOffset Offset for network paramater, default 0.
    */
   template <typename eT>
-  void Initialize(const std::vector<LayerTypes<CustomLayers...> >& network,
-                  arma::Mat<eT>& parameter, size_t parameterOffset = 0)
+  void Initialize(
+      const std::vector<BasicLayerTypes<arma::Mat<eT>, CustomLayers...> >&
+          network,
+      arma::Mat<eT>& parameter,
+      size_t parameterOffset = 0)
   {
     // Determine the number of parameter/weights of the given network.
     if (parameter.is_empty())
@@ -75,7 +78,7 @@ class NetworkInitialization
         // initialization rule.
         const size_t weight = boost::apply_visitor(weightSizeVisitor,
             network[i]);
-        arma::Mat<eT> tmp = arma::mat(parameter.memptr() + offset,
+        arma::Mat<eT> tmp = arma::Mat<eT>(parameter.memptr() + offset,
             weight, 1, false, false);
         initializeRule.Initialize(tmp, tmp.n_elem, 1);
 
@@ -94,8 +97,8 @@ class NetworkInitialization
     // hold various other modules.
     for (size_t i = 0, offset = parameterOffset; i < network.size(); ++i)
     {
-      offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
-          network[i]);
+      offset += boost::apply_visitor(BasicWeightSetVisitor<arma::Mat<eT> >(
+          parameter, offset), network[i]);
 
       boost::apply_visitor(resetVisitor, network[i]);
     }
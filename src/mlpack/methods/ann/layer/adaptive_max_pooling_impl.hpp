@@ -40,7 +40,7 @@ AdaptiveMaxPooling<InputDataType, OutputDataType>::AdaptiveMaxPooling(
     outputHeight(std::get<1>(outputShape)),
     reset(false)
 {
-  poolingLayer = ann::MaxPooling<>(0, 0);
+  poolingLayer = MaxPooling<InputDataType, OutputDataType>(0, 0);
 }
 
 template<typename InputDataType, typename OutputDataType>
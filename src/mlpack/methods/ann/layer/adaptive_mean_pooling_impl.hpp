@@ -40,7 +40,7 @@ AdaptiveMeanPooling<InputDataType, OutputDataType>::AdaptiveMeanPooling(
     outputHeight(std::get<1>(outputShape)),
     reset(false)
 {
-  poolingLayer = ann::MeanPooling<>(0, 0);
+  poolingLayer = MeanPooling<InputDataType, OutputDataType>(0, 0);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -141,7 +141,10 @@ class AddMerge
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<OutputDataType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Get the input parameter.
   InputDataType const& InputParameter() const { return inputParameter; }
@@ -159,7 +162,7 @@ class AddMerge
   OutputDataType& Delta() { return delta; }
 
   //! Return the model modules.
-  std::vector<LayerTypes<CustomLayers...> >& Model()
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
   {
     if (model)
     {
@@ -186,6 +189,13 @@ class AddMerge
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Parameter which indicates if the modules should be exposed.
   bool model;
 
@@ -198,10 +208,10 @@ class AddMerge
   bool ownsLayers;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! Locally-stored empty list of modules.
-  std::vector<LayerTypes<CustomLayers...> > empty;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > empty;
 
   //! Locally-stored delete visitor module object.
   DeleteVisitor deleteVisitor;
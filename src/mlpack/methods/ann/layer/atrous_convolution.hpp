@@ -52,6 +52,9 @@ template <
 class AtrousConvolution
 {
  public:
+  //! The type of the weights and of the intermediate maps.
+  typedef arma::Cube<typename OutputDataType::elem_type> CubeType;
+
   //! Create the AtrousConvolution object.
   AtrousConvolution();
 
@@ -172,14 +175,14 @@ class AtrousConvolution
   OutputDataType& Parameters() { return weights; }
 
   //! Get the weight of the layer.
-  arma::cube const& Weight() const { return weight; }
+  CubeType const& Weight() const { return weight; }
   //! Modify the weight of the layer.
-  arma::cube& Weight() { return weight; }
+  CubeType& Weight() { return weight; }
 
   //! Get the bias of the layer.
-  arma::mat const& Bias() const { return bias; }
+  OutputDataType const& Bias() const { return bias; }
   //! Modify the bias of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   //! Get the output parameter.
   OutputDataType const& OutputParameter() const { return outputParameter; }
@@ -347,10 +350,10 @@ class AtrousConvolution
   OutputDataType weights;
 
   //! Locally-stored weight object.
-  arma::cube weight;
+  CubeType weight;
 
   //! Locally-stored bias term object.
-  arma::mat bias;
+  OutputDataType bias;
 
   //! Locally-stored input width.
   size_t inputWidth;
@@ -371,16 +374,16 @@ class AtrousConvolution
   size_t dilationHeight;
 
   //! Locally-stored transformed output parameter.
-  arma::cube outputTemp;
+  CubeType outputTemp;
 
   //! Locally-stored transformed padded input parameter.
-  arma::cube inputPaddedTemp;
+  CubeType inputPaddedTemp;
 
   //! Locally-stored transformed error parameter.
-  arma::cube gTemp;
+  CubeType gTemp;
 
   //! Locally-stored transformed gradient parameter.
-  arma::cube gradientTemp;
+  CubeType gradientTemp;
 
   //! Locally-stored padding layer.
   ann::Padding<> padding;
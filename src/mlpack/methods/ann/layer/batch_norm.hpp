@@ -227,10 +227,10 @@ class BatchNorm
   OutputDataType outputParameter;
 
   //! Locally-stored normalized input.
-  arma::cube normalized;
+  arma::Cube<typename OutputDataType::elem_type> normalized;
 
   //! Locally-stored zero mean input.
-  arma::cube inputMean;
+  arma::Cube<typename OutputDataType::elem_type> inputMean;
 }; // class BatchNorm
 
 } // namespace ann
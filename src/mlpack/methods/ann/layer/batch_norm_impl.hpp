@@ -59,9 +59,9 @@ template<typename InputDataType, typename OutputDataType>
 void BatchNorm<InputDataType, OutputDataType>::Reset()
 {
   // Gamma acts as the scaling parameters for the normalized output.
-  gamma = arma::mat(weights.memptr(), size, 1, false, false);
+  gamma = OutputDataType(weights.memptr(), size, 1, false, false);
   // Beta acts as the shifting parameters for the normalized output.
-  beta = arma::mat(weights.memptr() + gamma.n_elem, size, 1, false, false);
+  beta = OutputDataType(weights.memptr() + gamma.n_elem, size, 1, false, false);
 
   if (!loading)
   {
@@ -99,40 +99,56 @@ void BatchNorm<InputDataType, OutputDataType>::Forward(
           " greater than 1 to fix the warning." << std::endl;
     }
 
-    // Input corresponds to output from convolution layer.
-    // Use a cube for simplicity.
-    arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
-        inputSize, size, batchSize, false, false);
+    // Input corresponds to output from convolution layer, so the element i of
+    // channel c of point b is input(c * inputSize + i, b).
+    mean.set_size(1, size);
+    variance.set_size(1, size);
+    inputMean.set_size(inputSize, size, batchSize);
+    normalized.set_size(inputSize, size, batchSize);
 
-    // Initialize output to same size and values for convenience.
-    arma::cube outputTemp(const_cast<arma::Mat<eT>&>(output).memptr(),
-        inputSize, size, batchSize, false, false);
-    outputTemp = inputTemp;
+    const size_t n = inputSize * batchSize;
 
-    // Calculate mean and variance over all channels.
-    mean = arma::mean(arma::mean(inputTemp, 2), 0);
-    variance = arma::mean(arma::mean(arma::pow(
-        inputTemp.each_slice() - arma::repmat(mean,
-        inputSize, 1), 2), 2), 0);
-
-    outputTemp.each_slice() -= arma::repmat(mean, inputSize, 1);
-
-    // Used in backward propagation.
-    inputMean.set_size(arma::size(inputTemp));
-    inputMean = outputTemp;
-
-    // Normalize output.
-    outputTemp.each_slice() /= arma::sqrt(arma::repmat(variance,
-        inputSize, 1) + eps);
-
-    // Re-used in backward propagation.
-    normalized.set_size(arma::size(inputTemp));
-    normalized = outputTemp;
-
-    outputTemp.each_slice() %= arma::repmat(gamma.t(),
-        inputSize, 1);
-    outputTemp.each_slice() += arma::repmat(beta.t(),
-        inputSize, 1);
+    // Every channel is normalized independently, in a single pass over the
+    // output, the zero mean input and the normalized input.
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) size; ++c)
+    {
+      double sum = 0.0;
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const eT* x = input.colptr(b) + c * inputSize;
+        for (size_t i = 0; i < inputSize; ++i)
+          sum += x[i];
+      }
+      const eT m = (eT) (sum / n);
+
+      double squaredSum = 0.0;
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const eT* x = input.colptr(b) + c * inputSize;
+        for (size_t i = 0; i < inputSize; ++i)
+          squaredSum += (double) (x[i] - m) * (x[i] - m);
+      }
+      const eT v = (eT) (squaredSum / n);
+
+      mean(c) = m;
+      variance(c) = v;
+
+      const eT stdDev = std::sqrt(v + (eT) eps);
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const eT* x = input.colptr(b) + c * inputSize;
+        eT* im = inputMean.slice(b).colptr(c);
+        eT* norm = normalized.slice(b).colptr(c);
+        eT* y = output.colptr(b) + c * inputSize;
+        for (size_t i = 0; i < inputSize; ++i)
+        {
+          im[i] = x[i] - m;
+          norm[i] = im[i] / stdDev;
+          y[i] = gamma(c) * norm[i] + beta(c);
+        }
+      }
+    }
 
     count += 1;
     averageFactor = average ? 1.0 / count : momentum;
@@ -151,18 +167,19 @@ void BatchNorm<InputDataType, OutputDataType>::Forward(
   else
   {
     // Normalize the input and scale and shift the output.
-    output = input;
-    arma::cube outputTemp(const_cast<arma::Mat<eT>&>(output).memptr(),
-        input.n_rows / size, size, batchSize, false, false);
-
-    outputTemp.each_slice() -= arma::repmat(runningMean.t(),
-        input.n_rows / size, 1);
-    outputTemp.each_slice() /= arma::sqrt(arma::repmat(runningVariance.t(),
-        input.n_rows / size, 1) + eps);
-    outputTemp.each_slice() %= arma::repmat(gamma.t(),
-        input.n_rows / size, 1);
-    outputTemp.each_slice() += arma::repmat(beta.t(),
-        input.n_rows / size, 1);
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) size; ++c)
+    {
+      const eT m = runningMean(c);
+      const eT stdDev = std::sqrt(runningVariance(c) + (eT) eps);
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const eT* x = input.colptr(b) + c * inputSize;
+        eT* y = output.colptr(b) + c * inputSize;
+        for (size_t i = 0; i < inputSize; ++i)
+          y[i] = gamma(c) * ((x[i] - m) / stdDev) + beta(c);
+      }
+    }
   }
 }
 
@@ -173,35 +190,46 @@ void BatchNorm<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& gy,
     arma::Mat<eT>& g)
 {
-  const arma::mat stdInv = 1.0 / arma::sqrt(variance + eps);
+  const size_t batchSize = input.n_cols;
+  const size_t inputSize = input.n_rows / size;
 
   g.set_size(arma::size(input));
-  arma::cube gyTemp(const_cast<arma::Mat<eT>&>(gy).memptr(),
-      input.n_rows / size, size, input.n_cols, false, false);
-  arma::cube gTemp(const_cast<arma::Mat<eT>&>(g).memptr(),
-      input.n_rows / size, size, input.n_cols, false, false);
-
-  // Step 1: dl / dxhat.
-  arma::cube norm = gyTemp.each_slice() % arma::repmat(gamma.t(),
-      input.n_rows / size, 1);
-
-  // Step 2: sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  arma::mat temp = arma::sum(norm % inputMean, 2);
-  arma::mat vars = temp % arma::repmat(arma::pow(stdInv, 3),
-      input.n_rows / size, 1) * -0.5;
-
-  // Step 3: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  gTemp = (norm.each_slice() % arma::repmat(stdInv,
-      input.n_rows / size, 1) +
-      (inputMean.each_slice() % vars * 2)) / input.n_cols;
-
-  // Step 4: sum (dl / dxhat * -1 / stdInv) + variance *
-  // (sum -2 * (x - mu)) / m.
-  arma::mat normTemp = arma::sum(norm.each_slice() %
-      arma::repmat(-stdInv, input.n_rows / size, 1) , 2) /
-      input.n_cols;
-  gTemp.each_slice() += normTemp;
+
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) size; ++c)
+  {
+    const eT stdInv = 1.0 / std::sqrt(variance(c) + eps);
+    const eT stdInvCubed = stdInv * stdInv * stdInv;
+
+    for (size_t i = 0; i < inputSize; ++i)
+    {
+      eT temp = 0;
+      eT normTemp = 0;
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        // Step 1: dl / dxhat.
+        const eT norm = gy(c * inputSize + i, b) * gamma(c);
+        temp += norm * inputMean(i, c, b);
+        normTemp += norm * -stdInv;
+      }
+
+      // Step 2: sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
+      const eT vars = temp * stdInvCubed * -0.5;
+
+      // Step 4: sum (dl / dxhat * -1 / stdInv) + variance *
+      // (sum -2 * (x - mu)) / m.
+      normTemp /= batchSize;
+
+      // Step 3: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
+      // dl / dmu * 1 / m.
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const eT norm = gy(c * inputSize + i, b) * gamma(c);
+        g(c * inputSize + i, b) = (norm * stdInv +
+            inputMean(i, c, b) * vars * 2) / batchSize + normTemp;
+      }
+    }
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -211,17 +239,30 @@ void BatchNorm<InputDataType, OutputDataType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
+  const size_t inputSize = error.n_rows / size;
   gradient.set_size(size + size, 1);
-  arma::cube errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
-      error.n_rows / size, size, error.n_cols, false, false);
 
-  // Step 5: dl / dy * xhat.
-  arma::mat temp = arma::sum(arma::sum(normalized % errorTemp, 0), 2);
-  gradient.submat(0, 0, gamma.n_elem - 1, 0) = temp.t();
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) size; ++c)
+  {
+    eT gammaGradient = 0;
+    eT betaGradient = 0;
+    for (size_t b = 0; b < error.n_cols; ++b)
+    {
+      const eT* e = error.colptr(b) + c * inputSize;
+      const eT* norm = normalized.slice(b).colptr(c);
+      for (size_t i = 0; i < inputSize; ++i)
+      {
+        // Step 5: dl / dy * xhat.
+        gammaGradient += norm[i] * e[i];
+        // Step 6: dl / dy.
+        betaGradient += e[i];
+      }
+    }
 
-  // Step 6: dl / dy.
-  temp = arma::sum(arma::sum(errorTemp, 0), 2);
-  gradient.submat(gamma.n_elem, 0, gradient.n_elem - 1, 0) = temp.t();
+    gradient(c) = gammaGradient;
+    gradient(size + c) = betaGradient;
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -68,9 +68,9 @@ void BilinearInterpolation<InputDataType, OutputDataType>::Forward(
   assert(inRowSize >= 2);
   assert(inColSize >= 2);
 
-  arma::cube inputAsCube(const_cast<arma::Mat<eT>&>(input).memptr(),
+  arma::Cube<eT> inputAsCube(const_cast<arma::Mat<eT>&>(input).memptr(),
       inRowSize, inColSize, depth * batchSize, false, false);
-  arma::cube outputAsCube(output.memptr(), outRowSize, outColSize,
+  arma::Cube<eT> outputAsCube(output.memptr(), outRowSize, outColSize,
                           depth * batchSize, false, true);
 
   double scaleRow = (double) inRowSize / (double) outRowSize;
@@ -129,9 +129,9 @@ void BilinearInterpolation<InputDataType, OutputDataType>::Backward(
   assert(outRowSize >= 2);
   assert(outColSize >= 2);
 
-  arma::cube gradientAsCube(((arma::Mat<eT>&) gradient).memptr(), outRowSize,
-      outColSize, depth * batchSize, false, false);
-  arma::cube outputAsCube(output.memptr(), inRowSize, inColSize,
+  arma::Cube<eT> gradientAsCube(((arma::Mat<eT>&) gradient).memptr(),
+      outRowSize, outColSize, depth * batchSize, false, false);
+  arma::Cube<eT> outputAsCube(output.memptr(), inRowSize, inColSize,
                           depth * batchSize, false, true);
 
   if (gradient.n_elem == output.n_elem)
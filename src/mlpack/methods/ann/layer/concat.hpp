@@ -151,10 +151,13 @@ class Concat
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<OutputDataType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Return the model modules.
-  std::vector<LayerTypes<CustomLayers...> >& Model()
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
   {
     if (model)
     {
@@ -165,33 +168,33 @@ class Concat
   }
 
   //! Return the initial point for the optimization.
-  const arma::mat& Parameters() const { return parameters; }
+  const OutputDataType& Parameters() const { return parameters; }
   //! Modify the initial point for the optimization.
-  arma::mat& Parameters() { return parameters; }
+  OutputDataType& Parameters() { return parameters; }
 
   //! Get the value of run parameter.
   bool Run() const { return run; }
   //! Modify the value of run parameter.
   bool& Run() { return run; }
 
-  arma::mat const& InputParameter() const { return inputParameter; }
+  OutputDataType const& InputParameter() const { return inputParameter; }
   //! Modify the input parameter.
-  arma::mat& InputParameter() { return inputParameter; }
+  OutputDataType& InputParameter() { return inputParameter; }
 
   //! Get the output parameter.
-  arma::mat const& OutputParameter() const { return outputParameter; }
+  OutputDataType const& OutputParameter() const { return outputParameter; }
   //! Modify the output parameter.
-  arma::mat& OutputParameter() { return outputParameter; }
+  OutputDataType& OutputParameter() { return outputParameter; }
 
   //! Get the delta.e
-  arma::mat const& Delta() const { return delta; }
+  OutputDataType const& Delta() const { return delta; }
   //! Modify the delta.
-  arma::mat& Delta() { return delta; }
+  OutputDataType& Delta() { return delta; }
 
   //! Get the gradient.
-  arma::mat const& Gradient() const { return gradient; }
+  OutputDataType const& Gradient() const { return gradient; }
   //! Modify the gradient.
-  arma::mat& Gradient() { return gradient; }
+  OutputDataType& Gradient() { return gradient; }
 
   //! Get the axis of concatenation.
   size_t const& ConcatAxis() const { return axis; }
@@ -203,6 +206,13 @@ class Concat
   void serialize(Archive& /* ar */, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Parameter which indicates the input size of modules.
   arma::Row<size_t> inputSize;
 
@@ -223,10 +233,10 @@ class Concat
   size_t channels;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! Locally-stored model parameters.
-  arma::mat parameters;
+  OutputDataType parameters;
 
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
@@ -238,19 +248,19 @@ class Concat
   DeleteVisitor deleteVisitor;
 
   //! Locally-stored empty list of modules.
-  std::vector<LayerTypes<CustomLayers...> > empty;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > empty;
 
   //! Locally-stored delta object.
-  arma::mat delta;
+  OutputDataType delta;
 
   //! Locally-stored input parameter object.
-  arma::mat inputParameter;
+  OutputDataType inputParameter;
 
   //! Locally-stored output parameter object.
-  arma::mat outputParameter;
+  OutputDataType outputParameter;
 
   //! Locally-stored gradient object.
-  arma::mat gradient;
+  OutputDataType gradient;
 }; // class Concat
 
 } // namespace ann
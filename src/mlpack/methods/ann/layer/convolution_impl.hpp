@@ -154,9 +154,9 @@ void Convolution<
     OutputDataType
 >::Reset()
 {
-    weight = arma::cube(weights.memptr(), kernelWidth, kernelHeight,
+    weight = CubeType(weights.memptr(), kernelWidth, kernelHeight,
         outSize * inSize, false, false);
-    bias = arma::mat(weights.memptr() + weight.n_elem,
+    bias = OutputDataType(weights.memptr() + weight.n_elem,
         outSize, 1, false, false);
 }
 
@@ -177,7 +177,7 @@ void Convolution<
 >::Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   batchSize = input.n_cols;
-  arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
+  arma::Cube<eT> inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, inSize * batchSize, false, false);
 
   if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
@@ -254,7 +254,7 @@ void Convolution<
 >::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
 
   g.set_size(inputWidth * inputHeight * inSize, batchSize);
@@ -311,9 +311,9 @@ void Convolution<
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
-  arma::cube inputTemp(((arma::Mat<eT>&) input).memptr(), inputWidth,
+  arma::Cube<eT> inputTemp(((arma::Mat<eT>&) input).memptr(), inputWidth,
       inputHeight, inSize * batchSize, false, false);
 
   gradient.set_size(weights.n_elem, 1);
@@ -112,7 +112,7 @@ class DropConnect
                 arma::Mat<eT>& /* gradient */);
 
   //! Get the model modules.
-  std::vector<LayerTypes<> >& Model() { return network; }
+  std::vector<BasicLayerTypes<OutputDataType> >& Model() { return network; }
 
   //! Get the parameters.
   OutputDataType const& Parameters() const { return parameters; }
@@ -157,6 +157,13 @@ class DropConnect
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicParametersVisitor<OutputDataType> ParametersVisitor;
+  typedef BasicParametersSetVisitor<OutputDataType> ParametersSetVisitor;
+
   //! The probability of setting a value to zero.
   double ratio;
 
@@ -185,10 +192,10 @@ class DropConnect
   OutputDataType denoise;
 
   //! Locally-stored layer module.
-  LayerTypes<> baseLayer;
+  BasicLayerTypes<OutputDataType> baseLayer;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<> > network;
+  std::vector<BasicLayerTypes<OutputDataType> > network;
 }; // class DropConnect.
 
 }  // namespace ann
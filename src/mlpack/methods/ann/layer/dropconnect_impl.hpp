@@ -70,7 +70,7 @@ void DropConnect<InputDataType, OutputDataType>::Forward(
     mask = arma::randu<arma::Mat<eT> >(denoise.n_rows, denoise.n_cols);
     mask.transform([&](double val) { return (val > ratio); });
 
-    arma::mat tmp = denoise % mask;
+    arma::Mat<eT> tmp = denoise % mask;
     boost::apply_visitor(ParametersSetVisitor(tmp), baseLayer);
 
     boost::apply_visitor(ForwardVisitor(input, output), baseLayer);
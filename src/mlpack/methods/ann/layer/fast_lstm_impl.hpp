@@ -91,7 +91,7 @@ void FastLSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
     if (prevOutput.is_empty())
     {
       prevOutput = arma::zeros<OutputDataType>(outSize, batchSize);
-      cell = arma::zeros(outSize, size * batchSize);
+      cell = arma::zeros<OutputDataType>(outSize, size * batchSize);
       cellActivationError = arma::zeros<OutputDataType>(outSize, batchSize);
       outParameter = arma::zeros<OutputDataType>(
           outSize, (size + 1) * batchSize);
@@ -147,7 +147,7 @@ class GRU
   OutputDataType& Gradient() { return gradient; }
 
   //! Get the model modules.
-  std::vector<LayerTypes<> >& Model() { return network; }
+  std::vector<BasicLayerTypes<OutputDataType> >& Model() { return network; }
 
   //! Get the number of input units.
   size_t InSize() const { return inSize; }
@@ -162,6 +162,13 @@ class GRU
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Locally-stored number of input units.
   size_t inSize;
 
@@ -178,22 +185,22 @@ class GRU
   OutputDataType weights;
 
   //! Locally-stored input 2 gate module.
-  LayerTypes<> input2GateModule;
+  BasicLayerTypes<OutputDataType> input2GateModule;
 
   //! Locally-stored output 2 gate module.
-  LayerTypes<> output2GateModule;
+  BasicLayerTypes<OutputDataType> output2GateModule;
 
   //! Locally-stored output hidden state 2 gate module.
-  LayerTypes<> outputHidden2GateModule;
+  BasicLayerTypes<OutputDataType> outputHidden2GateModule;
 
   //! Locally-stored input gate module.
-  LayerTypes<> inputGateModule;
+  BasicLayerTypes<OutputDataType> inputGateModule;
 
   //! Locally-stored hidden state module.
-  LayerTypes<> hiddenStateModule;
+  BasicLayerTypes<OutputDataType> hiddenStateModule;
 
   //! Locally-stored forget gate module.
-  LayerTypes<> forgetGateModule;
+  BasicLayerTypes<OutputDataType> forgetGateModule;
 
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
@@ -205,7 +212,7 @@ class GRU
   DeleteVisitor deleteVisitor;
 
   //! Locally-stored list of network modules.
-  std::vector<LayerTypes<> > network;
+  std::vector<BasicLayerTypes<OutputDataType> > network;
 
   //! Locally-stored number of forward steps.
   size_t forwardStep;
@@ -217,22 +224,22 @@ class GRU
   size_t gradientStep;
 
   //! Locally-stored output parameters.
-  std::list<arma::mat> outParameter;
+  std::list<OutputDataType> outParameter;
 
   //! Matrix of all zeroes to initialize the output
-  arma::mat allZeros;
+  OutputDataType allZeros;
 
   //! Iterator pointed to the last output produced by the cell
-  std::list<arma::mat>::iterator prevOutput;
+  typename std::list<OutputDataType>::iterator prevOutput;
 
   //! Iterator pointed to the last output processed by backward
-  std::list<arma::mat>::iterator backIterator;
+  typename std::list<OutputDataType>::iterator backIterator;
 
   //! Iterator pointed to the last output processed by gradient
-  std::list<arma::mat>::iterator gradIterator;
+  typename std::list<OutputDataType>::iterator gradIterator;
 
   //! Locally-stored previous error.
-  arma::mat prevError;
+  OutputDataType prevError;
 
   //! If true dropout and scaling is disabled, see notes above.
   bool deterministic;
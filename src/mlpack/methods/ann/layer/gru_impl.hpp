@@ -44,29 +44,35 @@ GRU<InputDataType, OutputDataType>::GRU(
     deterministic(false)
 {
   // Input specific linear layers(for zt, rt, ot).
-  input2GateModule = new Linear<>(inSize, 3 * outSize);
+  input2GateModule = new Linear<InputDataType, OutputDataType>(inSize,
+      3 * outSize);
 
   // Previous output gates (for zt and rt).
-  output2GateModule = new LinearNoBias<>(outSize, 2 * outSize);
+  output2GateModule = new LinearNoBias<InputDataType, OutputDataType>(
+      outSize, 2 * outSize);
 
   // Previous output gate for ot.
-  outputHidden2GateModule = new LinearNoBias<>(outSize, outSize);
+  outputHidden2GateModule = new LinearNoBias<InputDataType,
+      OutputDataType>(outSize, outSize);
 
   network.push_back(input2GateModule);
   network.push_back(output2GateModule);
   network.push_back(outputHidden2GateModule);
 
-  inputGateModule = new SigmoidLayer<>();
-  forgetGateModule = new SigmoidLayer<>();
-  hiddenStateModule = new TanHLayer<>();
+  inputGateModule = new SigmoidLayer<LogisticFunction, InputDataType,
+      OutputDataType>();
+  forgetGateModule = new SigmoidLayer<LogisticFunction, InputDataType,
+      OutputDataType>();
+  hiddenStateModule = new TanHLayer<TanhFunction, InputDataType,
+      OutputDataType>();
 
   network.push_back(inputGateModule);
   network.push_back(hiddenStateModule);
   network.push_back(forgetGateModule);
 
-  prevError = arma::zeros<arma::mat>(3 * outSize, batchSize);
+  prevError = arma::zeros<OutputDataType>(3 * outSize, batchSize);
 
-  allZeros = arma::zeros<arma::mat>(outSize, batchSize);
+  allZeros = arma::zeros<OutputDataType>(outSize, batchSize);
 
   outParameter.emplace_back(allZeros.memptr(),
       allZeros.n_rows, allZeros.n_cols, false, true);
@@ -128,7 +134,7 @@ void GRU<InputDataType, OutputDataType>::Forward(
       boost::apply_visitor(outputParameterVisitor, forgetGateModule)),
       forgetGateModule);
 
-  arma::mat modInput = (boost::apply_visitor(outputParameterVisitor,
+  arma::Mat<eT> modInput = (boost::apply_visitor(outputParameterVisitor,
       forgetGateModule) % *prevOutput);
 
   // Pass that through the outputHidden2GateModule.
@@ -137,7 +143,7 @@ void GRU<InputDataType, OutputDataType>::Forward(
       outputHidden2GateModule);
 
   // Merge for ot.
-  arma::mat outputH = boost::apply_visitor(outputParameterVisitor,
+  arma::Mat<eT> outputH = boost::apply_visitor(outputParameterVisitor,
       input2GateModule).submat(2 * outSize, 0, 3 * outSize - 1, batchSize - 1) +
       boost::apply_visitor(outputParameterVisitor, outputHidden2GateModule);
 
@@ -234,12 +240,12 @@ void GRU<InputDataType, OutputDataType>::Backward(
   }
 
   // Delta zt.
-  arma::mat dZt = gyLocal % (*backIterator -
+  arma::Mat<eT> dZt = gyLocal % (*backIterator -
       boost::apply_visitor(outputParameterVisitor,
       hiddenStateModule));
 
   // Delta ot.
-  arma::mat dOt = gyLocal % (arma::ones<arma::mat>(outSize, batchSize) -
+  arma::Mat<eT> dOt = gyLocal % (arma::ones<arma::Mat<eT>>(outSize, batchSize) -
       boost::apply_visitor(outputParameterVisitor, inputGateModule));
 
   // Delta of input gate.
@@ -262,7 +268,8 @@ void GRU<InputDataType, OutputDataType>::Backward(
       outputHidden2GateModule);
 
   // Delta rt.
-  arma::mat dRt = boost::apply_visitor(deltaVisitor, outputHidden2GateModule) %
+  arma::Mat<eT> dRt = boost::apply_visitor(deltaVisitor,
+      outputHidden2GateModule) %
       *backIterator;
 
   // Delta of forget gate.
@@ -284,7 +291,7 @@ void GRU<InputDataType, OutputDataType>::Backward(
       boost::apply_visitor(deltaVisitor, hiddenStateModule);
 
   // Get delta ht - 1 for input gate and forget gate.
-  arma::mat prevErrorSubview = prevError.submat(0, 0, 2 * outSize - 1,
+  arma::Mat<eT> prevErrorSubview = prevError.submat(0, 0, 2 * outSize - 1,
       batchSize - 1);
   boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
       outputParameterVisitor, input2GateModule),
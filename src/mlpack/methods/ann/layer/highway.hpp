@@ -132,14 +132,14 @@ class Highway
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer)
+  void Add(BasicLayerTypes<OutputDataType, CustomLayers...> layer)
   {
     network.push_back(layer);
     networkOwnerships.push_back(false);
   }
 
   //! Return the modules of the model.
-  std::vector<LayerTypes<CustomLayers...> >& Model()
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
   {
     if (model)
     {
@@ -184,6 +184,13 @@ class Highway
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Locally-stored number of input units.
   size_t inSize;
 
@@ -194,13 +201,13 @@ class Highway
   bool reset;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! The list of network modules we are responsible for.
   std::vector<bool> networkOwnerships;
 
   //! Locally-stored empty list of modules.
-  std::vector<LayerTypes<CustomLayers...> > empty;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > empty;
 
   //! Locally-stored weight object.
   OutputDataType weights;
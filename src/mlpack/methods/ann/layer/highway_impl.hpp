@@ -69,8 +69,9 @@ template<typename InputDataType, typename OutputDataType,
          typename... CustomLayers>
 void Highway<InputDataType, OutputDataType, CustomLayers...>::Reset()
 {
-  transformWeight = arma::mat(weights.memptr(), inSize, inSize, false, false);
-  transformBias = arma::mat(weights.memptr() + transformWeight.n_elem,
+  transformWeight = OutputDataType(weights.memptr(), inSize, inSize, false,
+      false);
+  transformBias = OutputDataType(weights.memptr() + transformWeight.n_elem,
       inSize, 1, false, false);
 }
 
@@ -221,7 +222,7 @@ void Highway<InputDataType, OutputDataType, CustomLayers...>::serialize(
   // If loading, delete the old layers and set size for weights.
   if (Archive::is_loading::value)
   {
-    for (LayerTypes<CustomLayers...>& layer : network)
+    for (BasicLayerTypes<OutputDataType, CustomLayers...>& layer : network)
     {
       boost::apply_visitor(deleteVisitor, layer);
     }
@@ -42,8 +42,8 @@ LayerNorm<InputDataType, OutputDataType>::LayerNorm(
 template<typename InputDataType, typename OutputDataType>
 void LayerNorm<InputDataType, OutputDataType>::Reset()
 {
-  gamma = arma::mat(weights.memptr(), size, 1, false, false);
-  beta = arma::mat(weights.memptr() + gamma.n_elem, size, 1, false, false);
+  gamma = OutputDataType(weights.memptr(), size, 1, false, false);
+  beta = OutputDataType(weights.memptr() + gamma.n_elem, size, 1, false, false);
 
   if (!loading)
   {
@@ -59,20 +59,44 @@ template<typename eT>
 void LayerNorm<InputDataType, OutputDataType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
-  mean = arma::mean(input, 0);
-  variance = arma::var(input, 1, 0);
-
-  // Normalize the input.
-  output = input.each_row() - mean;
-  inputMean = output;
-  output.each_row() /= arma::sqrt(variance + eps);
-
-  // Reused in the backward and gradient step.
-  normalized = output;
-
-  // Scale and shift the output.
-  output.each_col() %= gamma;
-  output.each_col() += beta;
+  mean.set_size(1, input.n_cols);
+  variance.set_size(1, input.n_cols);
+  inputMean.set_size(arma::size(input));
+  normalized.set_size(arma::size(input));
+  output.set_size(arma::size(input));
+
+  // Every point is normalized independently, in a single pass over the output,
+  // the zero mean input and the normalized input.
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+  {
+    const eT* x = input.colptr(j);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < input.n_rows; ++i)
+      sum += x[i];
+    const eT m = (eT) (sum / input.n_rows);
+
+    double squaredSum = 0.0;
+    for (size_t i = 0; i < input.n_rows; ++i)
+      squaredSum += (double) (x[i] - m) * (x[i] - m);
+    const eT v = (eT) (squaredSum / input.n_rows);
+
+    mean(j) = m;
+    variance(j) = v;
+
+    // Normalize the input, then scale and shift the output.
+    const eT stdDev = std::sqrt(v + (eT) eps);
+    eT* im = inputMean.colptr(j);
+    eT* norm = normalized.colptr(j);
+    eT* y = output.colptr(j);
+    for (size_t i = 0; i < input.n_rows; ++i)
+    {
+      im[i] = x[i] - m;
+      norm[i] = im[i] / stdDev;
+      y[i] = gamma(i) * norm[i] + beta(i);
+    }
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -80,23 +104,36 @@ template<typename eT>
 void LayerNorm<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& input, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  const arma::mat stdInv = 1.0 / arma::sqrt(variance + eps);
+  g.set_size(arma::size(input));
 
-  // dl / dxhat.
-  const arma::mat norm = gy.each_col() % gamma;
-
-  // sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  const arma::mat var = arma::sum(norm % inputMean, 0) %
-      arma::pow(stdInv, 3.0) * -0.5;
-
-  // dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  g = (norm.each_row() % stdInv) + (inputMean.each_row() %
-      var * 2 / input.n_rows);
-
-  // sum (dl / dxhat * -1 / stdInv) + variance *
-  // (sum -2 * (x - mu)) / m.
-  g.each_row() += arma::sum(norm.each_row() % -stdInv, 0) / input.n_rows;
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+  {
+    const eT stdInv = 1.0 / std::sqrt(variance(j) + eps);
+    const eT* error = gy.colptr(j);
+    const eT* im = inputMean.colptr(j);
+
+    // sum dl / dxhat * (x - mu) * -0.5 * stdInv^3, and
+    // sum (dl / dxhat * -1 / stdInv), where dl / dxhat = dl / dy * gamma.
+    eT var = 0;
+    eT normSum = 0;
+    for (size_t i = 0; i < input.n_rows; ++i)
+    {
+      const eT norm = error[i] * gamma(i);
+      var += norm * im[i];
+      normSum += norm * -stdInv;
+    }
+    var *= stdInv * stdInv * stdInv * -0.5;
+
+    // dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
+    // dl / dmu * 1 / m.
+    eT* delta = g.colptr(j);
+    for (size_t i = 0; i < input.n_rows; ++i)
+    {
+      delta[i] = error[i] * gamma(i) * stdInv + im[i] * var * 2 /
+          input.n_rows + normSum / input.n_rows;
+    }
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -13,6 +13,7 @@
 #ifndef MLPACK_METHODS_ANN_LAYER_LAYER_TRAITS_HPP
 #define MLPACK_METHODS_ANN_LAYER_LAYER_TRAITS_HPP
 
+#include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/sfinae_utility.hpp>
 
 namespace mlpack {
@@ -55,6 +56,27 @@ class LayerTraits
   static const bool IsConnection = false;
 };
 
+/**
+ * Get the type of the matrices a network works with from the type of its output
+ * layer: this is the type of the OutputParameter() of the output layer, so
+ * e.g. MeanSquaredError<arma::fmat, arma::fmat> gives a network working in
+ * single precision.  If the output layer has no OutputParameter() function,
+ * arma::mat is used.
+ */
+template<typename OutputLayerType, typename = void>
+struct NetworkMatType
+{
+  typedef arma::mat type;
+};
+
+template<typename OutputLayerType>
+struct NetworkMatType<OutputLayerType, decltype(void(
+    std::declval<OutputLayerType&>().OutputParameter()))>
+{
+  typedef typename std::decay<decltype(
+      std::declval<OutputLayerType&>().OutputParameter())>::type type;
+};
+
 // This gives us a HasGradientCheck<T, U> type (where U is a function pointer)
 // we can use with SFINAE to catch when a type has a Gradient(...) function.
 HAS_MEM_FUNC(Gradient, HasGradientCheck);
@@ -203,84 +203,106 @@ template <typename InputDataType,
 >
 class AdaptiveMeanPooling;
 
-using MoreTypes = boost::variant<
-        Glimpse<arma::mat, arma::mat>*,
-        Highway<arma::mat, arma::mat>*,
-        Recurrent<arma::mat, arma::mat>*,
-        RecurrentAttention<arma::mat, arma::mat>*,
-        ReinforceNormal<arma::mat, arma::mat>*,
-        Reparametrization<arma::mat, arma::mat>*,
-        Select<arma::mat, arma::mat>*,
-        Sequential<arma::mat, arma::mat, false>*,
-        Sequential<arma::mat, arma::mat, true>*,
-        Subview<arma::mat, arma::mat>*,
-        VRClassReward<arma::mat, arma::mat>*,
-        VirtualBatchNorm<arma::mat, arma::mat>*,
-        RBF<arma::mat, arma::mat, GaussianFunction>*,
-        BaseLayer<GaussianFunction, arma::mat, arma::mat>*
+/**
+ * The layers that do not fit into LayerTypes because of the limit on the number
+ * of types in a boost::variant, working with the given matrix type.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
+ */
+template<typename MatType>
+using BasicMoreTypes = boost::variant<
+        Glimpse<MatType, MatType>*,
+        Highway<MatType, MatType>*,
+        Recurrent<MatType, MatType>*,
+        RecurrentAttention<MatType, MatType>*,
+        ReinforceNormal<MatType, MatType>*,
+        Reparametrization<MatType, MatType>*,
+        Select<MatType, MatType>*,
+        Sequential<MatType, MatType, false>*,
+        Sequential<MatType, MatType, true>*,
+        Subview<MatType, MatType>*,
+        VRClassReward<MatType, MatType>*,
+        VirtualBatchNorm<MatType, MatType>*,
+        RBF<MatType, MatType, GaussianFunction>*,
+        BaseLayer<GaussianFunction, MatType, MatType>*
 >;
 
-template <typename... CustomLayers>
-using LayerTypes = boost::variant<
-    AdaptiveMaxPooling<arma::mat, arma::mat>*,
-    AdaptiveMeanPooling<arma::mat, arma::mat>*,
-    Add<arma::mat, arma::mat>*,
-    AddMerge<arma::mat, arma::mat>*,
-    AlphaDropout<arma::mat, arma::mat>*,
+//! The additional layers working with arma::mat.
+using MoreTypes = BasicMoreTypes<arma::mat>;
+
+/**
+ * The variant of all layers that can be added to a network working with the
+ * given matrix type (for instance arma::mat or arma::fmat).
+ *
+ * @tparam MatType Type of the matrices the layers work with.
+ * @tparam CustomLayers Any set of custom layers that could be a part of the
+ *         network.
+ */
+template<typename MatType, typename... CustomLayers>
+using BasicLayerTypes = boost::variant<
+    AdaptiveMaxPooling<MatType, MatType>*,
+    AdaptiveMeanPooling<MatType, MatType>*,
+    Add<MatType, MatType>*,
+    AddMerge<MatType, MatType>*,
+    AlphaDropout<MatType, MatType>*,
     AtrousConvolution<NaiveConvolution<ValidConvolution>,
                       NaiveConvolution<FullConvolution>,
                       NaiveConvolution<ValidConvolution>,
-                      arma::mat, arma::mat>*,
-    BaseLayer<LogisticFunction, arma::mat, arma::mat>*,
-    BaseLayer<IdentityFunction, arma::mat, arma::mat>*,
-    BaseLayer<TanhFunction, arma::mat, arma::mat>*,
-    BaseLayer<SoftplusFunction, arma::mat, arma::mat>*,
-    BaseLayer<RectifierFunction, arma::mat, arma::mat>*,
-    BatchNorm<arma::mat, arma::mat>*,
-    BilinearInterpolation<arma::mat, arma::mat>*,
-    CELU<arma::mat, arma::mat>*,
-    Concat<arma::mat, arma::mat>*,
-    Concatenate<arma::mat, arma::mat>*,
-    ConcatPerformance<NegativeLogLikelihood<arma::mat, arma::mat>,
-                      arma::mat, arma::mat>*,
-    Constant<arma::mat, arma::mat>*,
+                      MatType, MatType>*,
+    BaseLayer<LogisticFunction, MatType, MatType>*,
+    BaseLayer<IdentityFunction, MatType, MatType>*,
+    BaseLayer<TanhFunction, MatType, MatType>*,
+    BaseLayer<SoftplusFunction, MatType, MatType>*,
+    BaseLayer<RectifierFunction, MatType, MatType>*,
+    BatchNorm<MatType, MatType>*,
+    BilinearInterpolation<MatType, MatType>*,
+    CELU<MatType, MatType>*,
+    Concat<MatType, MatType>*,
+    Concatenate<MatType, MatType>*,
+    ConcatPerformance<NegativeLogLikelihood<MatType, MatType>,
+                      MatType, MatType>*,
+    Constant<MatType, MatType>*,
     Convolution<NaiveConvolution<ValidConvolution>,
                 NaiveConvolution<FullConvolution>,
-                NaiveConvolution<ValidConvolution>, arma::mat, arma::mat>*,
-    CReLU<arma::mat, arma::mat>*,
-    DropConnect<arma::mat, arma::mat>*,
-    Dropout<arma::mat, arma::mat>*,
-    ELU<arma::mat, arma::mat>*,
-    FastLSTM<arma::mat, arma::mat>*,
-    FlexibleReLU<arma::mat, arma::mat>*,
-    GRU<arma::mat, arma::mat>*,
-    HardTanH<arma::mat, arma::mat>*,
-    Join<arma::mat, arma::mat>*,
-    LayerNorm<arma::mat, arma::mat>*,
-    LeakyReLU<arma::mat, arma::mat>*,
-    Linear<arma::mat, arma::mat, NoRegularizer>*,
-    LinearNoBias<arma::mat, arma::mat, NoRegularizer>*,
-    LogSoftMax<arma::mat, arma::mat>*,
-    Lookup<arma::mat, arma::mat>*,
-    LSTM<arma::mat, arma::mat>*,
-    MaxPooling<arma::mat, arma::mat>*,
-    MeanPooling<arma::mat, arma::mat>*,
-    MiniBatchDiscrimination<arma::mat, arma::mat>*,
-    MultiplyConstant<arma::mat, arma::mat>*,
-    MultiplyMerge<arma::mat, arma::mat>*,
-    NegativeLogLikelihood<arma::mat, arma::mat>*,
-    NoisyLinear<arma::mat, arma::mat>*,
-    Padding<arma::mat, arma::mat>*,
-    PReLU<arma::mat, arma::mat>*,
-    Softmax<arma::mat, arma::mat>*,
+                NaiveConvolution<ValidConvolution>, MatType, MatType>*,
+    CReLU<MatType, MatType>*,
+    DropConnect<MatType, MatType>*,
+    Dropout<MatType, MatType>*,
+    ELU<MatType, MatType>*,
+    FastLSTM<MatType, MatType>*,
+    FlexibleReLU<MatType, MatType>*,
+    GRU<MatType, MatType>*,
+    HardTanH<MatType, MatType>*,
+    Join<MatType, MatType>*,
+    LayerNorm<MatType, MatType>*,
+    LeakyReLU<MatType, MatType>*,
+    Linear<MatType, MatType, NoRegularizer>*,
+    LinearNoBias<MatType, MatType, NoRegularizer>*,
+    LogSoftMax<MatType, MatType>*,
+    Lookup<MatType, MatType>*,
+    LSTM<MatType, MatType>*,
+    MaxPooling<MatType, MatType>*,
+    MeanPooling<MatType, MatType>*,
+    MiniBatchDiscrimination<MatType, MatType>*,
+    MultiplyConstant<MatType, MatType>*,
+    MultiplyMerge<MatType, MatType>*,
+    NegativeLogLikelihood<MatType, MatType>*,
+    NoisyLinear<MatType, MatType>*,
+    Padding<MatType, MatType>*,
+    PReLU<MatType, MatType>*,
+    Softmax<MatType, MatType>*,
     TransposedConvolution<NaiveConvolution<ValidConvolution>,
             NaiveConvolution<ValidConvolution>,
-            NaiveConvolution<ValidConvolution>, arma::mat, arma::mat>*,
-    WeightNorm<arma::mat, arma::mat>*,
-    MoreTypes,
+            NaiveConvolution<ValidConvolution>, MatType, MatType>*,
+    WeightNorm<MatType, MatType>*,
+    BasicMoreTypes<MatType>,
     CustomLayers*...
 >;
 
+//! The variant of all layers working with arma::mat.
+template<typename... CustomLayers>
+using LayerTypes = BasicLayerTypes<arma::mat, CustomLayers...>;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -47,8 +47,12 @@ namespace ann /** Artificial Neural Network. */ {
  * }
  * @endcode
  *
- * \see FastLSTM for a faster LSTM version which combines the calculation of the
- * input, forget, output gates and hidden state in a single step.
+ * The pre-activations of all gates are computed with one matrix multiplication
+ * for the input and one for the previous output, and the activations of all
+ * gates for every BPTT step are kept in a single contiguous matrix.
+ *
+ * \see FastLSTM for a faster LSTM version without the peephole connections to
+ * the cell.
  *
  * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
@@ -120,6 +124,13 @@ class LSTM
    */
   void Reset();
 
+  /**
+   * Stack the weights of all gates into input2GateWeight, input2GateBias and
+   * output2GateWeight, so that all gates can be computed at once.  This is
+   * called at the start of every sequence, since the weights may have changed.
+   */
+  void PackWeights();
+
   /*
    * Resets the cell to accept a new input. This breaks the BPTT chain starts a
    * new one.
@@ -175,7 +186,7 @@ class LSTM
    * Serialize the layer
    */
   template<typename Archive>
-  void serialize(Archive& ar, const unsigned int /* version */);
+  void serialize(Archive& ar, const unsigned int version);
 
  private:
   //! Locally-stored number of input units.
@@ -260,29 +271,20 @@ class LSTM
   //! Weights between cell and output gate.
   OutputDataType cell2GateOutputWeight;
 
-  //! Locally-stored input gate parameter.
-  OutputDataType inputGate;
-
-  //! Locally-stored forget gate parameter.
-  OutputDataType forgetGate;
-
-  //! Locally-stored hidden layer parameter.
-  OutputDataType hiddenLayer;
-
-  //! Locally-stored output gate parameter.
-  OutputDataType outputGate;
+  //! Stacked weights between the input and all gates.
+  OutputDataType input2GateWeight;
 
-  //! Locally-stored input gate activation.
-  OutputDataType inputGateActivation;
+  //! Stacked bias between the input and all gates.
+  OutputDataType input2GateBias;
 
-  //! Locally-stored forget gate activation.
-  OutputDataType forgetGateActivation;
+  //! Stacked weights between the output and all gates.
+  OutputDataType output2GateWeight;
 
-  //! Locally-stored output gate activation.
-  OutputDataType outputGateActivation;
+  //! Locally-stored pre-activation of all gates for the current step.
+  OutputDataType gate;
 
-  //! Locally-stored hidden layer activation.
-  OutputDataType hiddenLayerActivation;
+  //! Locally-stored activation of all gates for all steps.
+  OutputDataType gateActivation;
 
   //! Locally-stored input to hidden weight.
   OutputDataType input2HiddenWeight;
@@ -299,11 +301,8 @@ class LSTM
   //! Locally-stored cell activation error.
   OutputDataType cellActivation;
 
-  //! Locally-stored forget gate error.
-  OutputDataType forgetGateError;
-
-  //! Locally-stored output gate error.
-  OutputDataType outputGateError;
+  //! Locally-stored error of all gates for the current step.
+  OutputDataType gateError;
 
   //! Locally-stored previous error.
   OutputDataType prevError;
@@ -314,12 +313,6 @@ class LSTM
   //! Locally-stored input cell error parameter.
   OutputDataType inputCellError;
 
-  //! Locally-stored input gate error.
-  OutputDataType inputGateError;
-
-  //! Locally-stored hidden layer error.
-  OutputDataType hiddenError;
-
   //! Locally-stored current rho size.
   size_t rhoSize;
 
@@ -330,6 +323,19 @@ class LSTM
 } // namespace ann
 } // namespace mlpack
 
+//! Set the serialization version of the LSTM class.
+namespace boost {
+namespace serialization {
+
+template<typename InputDataType, typename OutputDataType>
+struct version<mlpack::ann::LSTM<InputDataType, OutputDataType> >
+{
+  BOOST_STATIC_CONSTANT(int, value = 1);
+};
+
+} // namespace serialization
+} // namespace boost
+
 // Include implementation.
 #include "lstm_impl.hpp"
 
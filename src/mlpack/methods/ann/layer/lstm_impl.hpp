@@ -60,25 +60,23 @@ void LSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
   backwardStep = batchSize * size - 1;
   gradientStep = batchSize * size - 1;
 
+  // The per-step buffers hold exactly one batch, so they have to follow the
+  // batch size even when it shrinks.
+  gate.set_size(4 * outSize, batchSize);
+  gateError.set_size(4 * outSize, batchSize);
+  prevError.set_size(4 * outSize, batchSize);
+
   const size_t rhoBatchSize = size * batchSize;
-  if (inputGate.is_empty() || inputGate.n_cols < rhoBatchSize)
+  if (gateActivation.is_empty() || gateActivation.n_cols < rhoBatchSize)
   {
-    inputGate.set_size(outSize, rhoBatchSize);
-    forgetGate.set_size(outSize, rhoBatchSize);
-    hiddenLayer.set_size(outSize, rhoBatchSize);
-    outputGate.set_size(outSize, rhoBatchSize);
-
-    inputGateActivation.set_size(outSize, rhoBatchSize);
-    forgetGateActivation.set_size(outSize, rhoBatchSize);
-    outputGateActivation.set_size(outSize, rhoBatchSize);
-    hiddenLayerActivation.set_size(outSize, rhoBatchSize);
-
+    // The activations of all gates for all BPTT steps are stored in one
+    // contiguous block.
+    gateActivation.set_size(4 * outSize, rhoBatchSize);
     cellActivation.set_size(outSize, rhoBatchSize);
-    prevError.set_size(4 * outSize, batchSize);
 
     if (cell.is_empty())
     {
-      cell = arma::zeros(outSize, size * batchSize);
+      cell = arma::zeros<OutputDataType>(outSize, size * batchSize);
       outParameter = arma::zeros<OutputDataType>(
           outSize, (size + 1) * batchSize);
     }
@@ -159,6 +157,32 @@ void LSTM<InputDataType, OutputDataType>::Reset()
       offset, outSize, 1, false, false);
 }
 
+template<typename InputDataType, typename OutputDataType>
+void LSTM<InputDataType, OutputDataType>::PackWeights()
+{
+  // Stack the weights of the input gate, forget gate, hidden layer and output
+  // gate, so that all gates can be computed with a single multiplication for
+  // the input and a single multiplication for the previous output.
+  input2GateWeight.set_size(4 * outSize, inSize);
+  input2GateWeight.rows(0, outSize - 1) = input2GateInputWeight;
+  input2GateWeight.rows(outSize, 2 * outSize - 1) = input2GateForgetWeight;
+  input2GateWeight.rows(2 * outSize, 3 * outSize - 1) = input2HiddenWeight;
+  input2GateWeight.rows(3 * outSize, 4 * outSize - 1) = input2GateOutputWeight;
+
+  input2GateBias.set_size(4 * outSize, 1);
+  input2GateBias.rows(0, outSize - 1) = input2GateInputBias;
+  input2GateBias.rows(outSize, 2 * outSize - 1) = input2GateForgetBias;
+  input2GateBias.rows(2 * outSize, 3 * outSize - 1) = input2HiddenBias;
+  input2GateBias.rows(3 * outSize, 4 * outSize - 1) = input2GateOutputBias;
+
+  output2GateWeight.set_size(4 * outSize, outSize);
+  output2GateWeight.rows(0, outSize - 1) = output2GateInputWeight;
+  output2GateWeight.rows(outSize, 2 * outSize - 1) = output2GateForgetWeight;
+  output2GateWeight.rows(2 * outSize, 3 * outSize - 1) = output2HiddenWeight;
+  output2GateWeight.rows(3 * outSize, 4 * outSize - 1) =
+      output2GateOutputWeight;
+}
+
 // Forward when cellState is not needed.
 template<typename InputDataType, typename OutputDataType>
 template<typename InputType, typename OutputType>
@@ -187,17 +211,17 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
     ResetCell(rhoSize);
   }
 
-  inputGate.cols(forwardStep, forwardStep + batchStep) = input2GateInputWeight *
-      input + output2GateInputWeight * outParameter.cols(forwardStep,
-      forwardStep + batchStep);
-  inputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateInputBias;
+  // The weights only change between sequences, so the stacked copy of the
+  // gate weights is refreshed at the start of each sequence.
+  if (forwardStep == 0)
+    PackWeights();
 
-  forgetGate.cols(forwardStep, forwardStep + batchStep) = input2GateForgetWeight
-      * input + output2GateForgetWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-  forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateForgetBias;
+  // Compute the pre-activations of all gates at once.  The rows of the gate
+  // matrix hold, in order, the input gate, the forget gate, the hidden layer
+  // and the output gate.
+  gate = input2GateWeight * input + output2GateWeight *
+      outParameter.cols(forwardStep, forwardStep + batchStep);
+  gate.each_col() += input2GateBias;
 
   if (forwardStep > 0)
   {
@@ -213,56 +237,50 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
         throw std::runtime_error("Cell parameter is empty.");
       }
     }
-    inputGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
 
-    forgetGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    gate.rows(0, outSize - 1) += cell.cols(forwardStep - batchSize,
+        forwardStep - batchSize + batchStep).each_col() % cell2GateInputWeight;
+    gate.rows(outSize, 2 * outSize - 1) += cell.cols(forwardStep - batchSize,
+        forwardStep - batchSize + batchStep).each_col() % cell2GateForgetWeight;
   }
 
-  inputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-inputGate.cols(forwardStep, forwardStep + batchStep)));
-
-  forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
+  // Apply the sigmoid to the input and forget gates in one pass, and the tanh
+  // to the hidden layer.
+  gateActivation.submat(0, forwardStep, 2 * outSize - 1,
+      forwardStep + batchStep) = 1.0 /
+      (1 + arma::exp(-gate.rows(0, 2 * outSize - 1)));
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
-      input + output2HiddenWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2HiddenBias;
-
-  hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
+  gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
+      forwardStep + batchStep) = arma::tanh(
+      gate.rows(2 * outSize, 3 * outSize - 1));
 
   if (forwardStep == 0)
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
-        inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
+        gateActivation.submat(0, forwardStep, outSize - 1,
+        forwardStep + batchStep) %
+        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
+        forwardStep + batchStep);
   }
   else
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
-        forgetGateActivation.cols(forwardStep, forwardStep + batchStep) %
+        gateActivation.submat(outSize, forwardStep, 2 * outSize - 1,
+        forwardStep + batchStep) %
         cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep)
-        + inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
+        + gateActivation.submat(0, forwardStep, outSize - 1,
+        forwardStep + batchStep) %
+        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
+        forwardStep + batchStep);
   }
 
-  outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
-      * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
+  // The output gate depends on the new cell state.
+  gate.rows(3 * outSize, 4 * outSize - 1) += cell.cols(forwardStep,
       forwardStep + batchStep).each_col() % cell2GateOutputWeight;
 
-  outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateOutputBias;
-
-  outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
+  gateActivation.submat(3 * outSize, forwardStep, 4 * outSize - 1,
+      forwardStep + batchStep) = 1.0 /
+      (1 + arma::exp(-gate.rows(3 * outSize, 4 * outSize - 1)));
 
   cellActivation.cols(forwardStep, forwardStep + batchStep) =
       arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
@@ -270,7 +288,8 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   outParameter.cols(forwardStep + batchSize,
       forwardStep + batchSize + batchStep) =
       cellActivation.cols(forwardStep, forwardStep + batchStep) %
-      outputGateActivation.cols(forwardStep, forwardStep + batchStep);
+      gateActivation.submat(3 * outSize, forwardStep, 4 * outSize - 1,
+      forwardStep + batchStep);
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
@@ -302,17 +321,26 @@ void LSTM<InputDataType, OutputDataType>::Backward(
         false);
   }
 
-  outputGateError =
+  // Aliases for the activations of each gate at this step.
+  const auto inputGateActivation = gateActivation.submat(0,
+      backwardStep - batchStep, outSize - 1, backwardStep);
+  const auto forgetGateActivation = gateActivation.submat(outSize,
+      backwardStep - batchStep, 2 * outSize - 1, backwardStep);
+  const auto hiddenLayerActivation = gateActivation.submat(2 * outSize,
+      backwardStep - batchStep, 3 * outSize - 1, backwardStep);
+  const auto outputGateActivation = gateActivation.submat(3 * outSize,
+      backwardStep - batchStep, 4 * outSize - 1, backwardStep);
+
+  // The rows of gateError hold the errors of the gates in the same order as
+  // the rows of the gate matrix.
+  gateError.rows(3 * outSize, 4 * outSize - 1) =
       gyLocal % cellActivation.cols(backwardStep - batchStep, backwardStep) %
-      (outputGateActivation.cols(backwardStep - batchStep, backwardStep) %
-      (1.0 - outputGateActivation.cols(backwardStep - batchStep,
-      backwardStep)));
+      (outputGateActivation % (1.0 - outputGateActivation));
 
-  OutputDataType cellError = gyLocal %
-      outputGateActivation.cols(backwardStep - batchStep, backwardStep) %
+  OutputDataType cellError = gyLocal % outputGateActivation %
       (1 - arma::pow(cellActivation.cols(backwardStep -
-      batchStep, backwardStep), 2)) + outputGateError.each_col() %
-      cell2GateOutputWeight;
+      batchStep, backwardStep), 2)) + gateError.rows(3 * outSize,
+      4 * outSize - 1).each_col() % cell2GateOutputWeight;
 
   if (gradientStepIdx > 0)
   {
@@ -321,38 +349,29 @@ void LSTM<InputDataType, OutputDataType>::Backward(
 
   if (backwardStep > batchStep)
   {
-    forgetGateError = cell.cols((backwardStep - batchSize) - batchStep,
-      (backwardStep - batchSize)) % cellError % (forgetGateActivation.cols(
-      backwardStep - batchStep, backwardStep) % (1.0 -
-      forgetGateActivation.cols(backwardStep - batchStep, backwardStep)));
+    gateError.rows(outSize, 2 * outSize - 1) = cell.cols((backwardStep -
+        batchSize) - batchStep, (backwardStep - batchSize)) % cellError %
+        (forgetGateActivation % (1.0 - forgetGateActivation));
   }
   else
   {
-    forgetGateError.zeros();
+    gateError.rows(outSize, 2 * outSize - 1).zeros();
   }
 
-  inputGateError = hiddenLayerActivation.cols(backwardStep - batchStep,
-      backwardStep) % cellError %
-      (inputGateActivation.cols(backwardStep - batchStep, backwardStep) %
-      (1.0 - inputGateActivation.cols(backwardStep - batchStep, backwardStep)));
-
-  hiddenError = inputGateActivation.cols(backwardStep - batchStep,
-      backwardStep) % cellError % (1 - arma::pow(hiddenLayerActivation.cols(
-      backwardStep - batchStep, backwardStep), 2));
+  gateError.rows(0, outSize - 1) = hiddenLayerActivation % cellError %
+      (inputGateActivation % (1.0 - inputGateActivation));
 
-  inputCellError = forgetGateActivation.cols(backwardStep - batchStep,
-      backwardStep) % cellError + forgetGateError.each_col() %
-      cell2GateForgetWeight + inputGateError.each_col() % cell2GateInputWeight;
+  gateError.rows(2 * outSize, 3 * outSize - 1) = inputGateActivation %
+      cellError % (1 - arma::pow(hiddenLayerActivation, 2));
 
-  g = input2GateInputWeight.t() * inputGateError +
-      input2HiddenWeight.t() * hiddenError +
-      input2GateForgetWeight.t() * forgetGateError +
-      input2GateOutputWeight.t() * outputGateError;
+  inputCellError = forgetGateActivation % cellError +
+      gateError.rows(outSize, 2 * outSize - 1).each_col() %
+      cell2GateForgetWeight + gateError.rows(0, outSize - 1).each_col() %
+      cell2GateInputWeight;
 
-  prevError = output2GateOutputWeight.t() * outputGateError +
-      output2GateForgetWeight.t() * forgetGateError +
-      output2GateInputWeight.t() * inputGateError +
-      output2HiddenWeight.t() * hiddenError;
+  // Propagate the error of all gates with a single multiplication each.
+  g = input2GateWeight.t() * gateError;
+  prevError = output2GateWeight.t() * gateError;
 
   backwardStep -= batchSize;
   gradientStepIdx++;
@@ -370,65 +389,44 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
     const ErrorType& /* error */,
     GradientType& gradient)
 {
-  // Input2GateOutputWeight and input2GateOutputBias gradients.
-  gradient.submat(0, 0, input2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError * input.t());
-  gradient.submat(input2GateOutputWeight.n_elem, 0,
-      input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem - 1, 0) =
-      arma::sum(outputGateError, 1);
-  size_t offset = input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem;
-
-  // Input2GateForgetWeight and input2GateForgetBias gradients.
-  gradient.submat(offset, 0, offset + input2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError * input.t());
-  gradient.submat(offset + input2GateForgetWeight.n_elem, 0,
-      offset + input2GateForgetWeight.n_elem +
-      input2GateForgetBias.n_elem - 1, 0) = arma::sum(forgetGateError, 1);
-  offset += input2GateForgetWeight.n_elem + input2GateForgetBias.n_elem;
-
-  // Input2GateInputWeight and input2GateInputBias gradients.
-  gradient.submat(offset, 0, offset + input2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError * input.t());
-  gradient.submat(offset + input2GateInputWeight.n_elem, 0,
-      offset + input2GateInputWeight.n_elem +
-      input2GateInputBias.n_elem - 1, 0) = arma::sum(inputGateError, 1);
-  offset += input2GateInputWeight.n_elem + input2GateInputBias.n_elem;
-
-  // Input2HiddenWeight and input2HiddenBias gradients.
-  gradient.submat(offset, 0, offset + input2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError * input.t());
-  gradient.submat(offset + input2HiddenWeight.n_elem, 0,
-      offset + input2HiddenWeight.n_elem + input2HiddenBias.n_elem - 1, 0) =
-      arma::sum(hiddenError, 1);
-  offset += input2HiddenWeight.n_elem + input2HiddenBias.n_elem;
-
-  // Output2GateOutputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateOutputWeight.n_elem;
-
-  // Output2GateForgetWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateForgetWeight.n_elem;
-
-  // Output2GateInputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateInputWeight.n_elem;
+  // The gradients of the weights of all gates are computed with a single
+  // multiplication for the input weights and a single multiplication for the
+  // output weights, and then scattered into the parameter layout.  The
+  // parameters are stored in the order output gate, forget gate, input gate,
+  // hidden layer, while the rows of gateError are stored in the order input
+  // gate, forget gate, hidden layer, output gate.
+  const OutputDataType input2GateGradient = gateError * input.t();
+  const OutputDataType output2GateGradient = gateError *
+      outParameter.cols(gradientStep - batchStep, gradientStep).t();
+  const OutputDataType biasGradient = arma::sum(gateError, 1);
+  const size_t gateOrder[4] = { 3, 1, 0, 2 };
+
+  // Input to gate weight and bias gradients.
+  size_t offset = 0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const size_t row = gateOrder[i] * outSize;
+    gradient.submat(offset, 0, offset + outSize * inSize - 1, 0) =
+        arma::vectorise(input2GateGradient.rows(row, row + outSize - 1));
+    offset += outSize * inSize;
+
+    gradient.submat(offset, 0, offset + outSize - 1, 0) =
+        biasGradient.rows(row, row + outSize - 1);
+    offset += outSize;
+  }
 
-  // Output2HiddenWeight gradients.
-  gradient.submat(offset, 0, offset + output2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2HiddenWeight.n_elem;
+  // Output to gate weight gradients.
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const size_t row = gateOrder[i] * outSize;
+    gradient.submat(offset, 0, offset + outSize * outSize - 1, 0) =
+        arma::vectorise(output2GateGradient.rows(row, row + outSize - 1));
+    offset += outSize * outSize;
+  }
 
   // Cell2GateOutputWeight gradients.
   gradient.submat(offset, 0, offset + cell2GateOutputWeight.n_elem - 1, 0) =
-      arma::sum(outputGateError %
+      arma::sum(gateError.rows(3 * outSize, 4 * outSize - 1) %
       cell.cols(gradientStep - batchStep, gradientStep), 1);
   offset += cell2GateOutputWeight.n_elem;
 
@@ -436,12 +434,12 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
   if (gradientStep > batchStep)
   {
     gradient.submat(offset, 0, offset + cell2GateForgetWeight.n_elem - 1, 0) =
-        arma::sum(forgetGateError %
+        arma::sum(gateError.rows(outSize, 2 * outSize - 1) %
                   cell.cols((gradientStep - batchSize) - batchStep,
                             (gradientStep - batchSize)), 1);
     gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
         cell2GateForgetWeight.n_elem + cell2GateInputWeight.n_elem - 1, 0) =
-        arma::sum(inputGateError %
+        arma::sum(gateError.rows(0, outSize - 1) %
                   cell.cols((gradientStep - batchSize) - batchStep,
                             (gradientStep - batchSize)), 1);
   }
@@ -467,7 +465,7 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void LSTM<InputDataType, OutputDataType>::serialize(
-    Archive& ar, const unsigned int /* version */)
+    Archive& ar, const unsigned int version)
 {
   ar & BOOST_SERIALIZATION_NVP(weights);
   ar & BOOST_SERIALIZATION_NVP(inSize);
@@ -481,10 +479,21 @@ void LSTM<InputDataType, OutputDataType>::serialize(
   ar & BOOST_SERIALIZATION_NVP(gradientStep);
   ar & BOOST_SERIALIZATION_NVP(gradientStepIdx);
   ar & BOOST_SERIALIZATION_NVP(cell);
-  ar & BOOST_SERIALIZATION_NVP(inputGateActivation);
-  ar & BOOST_SERIALIZATION_NVP(forgetGateActivation);
-  ar & BOOST_SERIALIZATION_NVP(outputGateActivation);
-  ar & BOOST_SERIALIZATION_NVP(hiddenLayerActivation);
+  if (version == 0)
+  {
+    // Older versions stored the activation of each gate separately; these are
+    // only needed during training, so they can be discarded.
+    OutputDataType inputGateActivation, forgetGateActivation,
+        outputGateActivation, hiddenLayerActivation;
+    ar & BOOST_SERIALIZATION_NVP(inputGateActivation);
+    ar & BOOST_SERIALIZATION_NVP(forgetGateActivation);
+    ar & BOOST_SERIALIZATION_NVP(outputGateActivation);
+    ar & BOOST_SERIALIZATION_NVP(hiddenLayerActivation);
+  }
+  else
+  {
+    ar & BOOST_SERIALIZATION_NVP(gateActivation);
+  }
   ar & BOOST_SERIALIZATION_NVP(cellActivation);
   ar & BOOST_SERIALIZATION_NVP(prevError);
   ar & BOOST_SERIALIZATION_NVP(outParameter);
@@ -167,59 +167,58 @@ class MaxPooling
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
- /**
-   * Apply pooling to the input and store the results.
+  /**
+   * Apply pooling to one channel of one point and store the results.  The
+   * position of the maximum of each pooling window is stored in indices, if
+   * given.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The input channel to apply the pooling rule to.
    * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
+   * @param indices The positions of the pooled values in the input channel, or
+   *     NULL.
    */
   template<typename eT>
-  void PoolingOperation(const arma::Mat<eT>& input,
-                        arma::Mat<eT>& output,
-                        arma::Mat<eT>& poolingIndices)
+  void PoolingOperation(const eT* input, eT* output, uint32_t* indices) const
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
+    const size_t windowWidth = kernelWidth - offset;
+    const size_t windowHeight = kernelHeight - offset;
+    for (size_t j = 0, colidx = 0; j < outputHeight;
         ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
           ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-        const size_t idx = pooling.Pooling(subInput);
-        output(i, j) = subInput(idx);
-
-        if (!deterministic)
+        // Take the first maximum in column-major order, like
+        // MaxPoolingRule::Pooling() does.
+        size_t maxIndex = rowidx + colidx * inputWidth;
+        for (size_t c = colidx; c < colidx + windowHeight; ++c)
         {
-          arma::Mat<size_t> subIndices = indices(arma::span(rowidx,
-              rowidx + kernelWidth - 1 - offset),
-              arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-          poolingIndices(i, j) = subIndices(idx);
+          for (size_t r = rowidx; r < rowidx + windowWidth; ++r)
+          {
+            if (input[r + c * inputWidth] > input[maxIndex])
+              maxIndex = r + c * inputWidth;
+          }
         }
+
+        output[i + j * outputWidth] = input[maxIndex];
+        if (indices != NULL)
+          indices[i + j * outputWidth] = (uint32_t) maxIndex;
       }
     }
   }
 
   /**
-   * Apply unpooling to the input and store the results.
+   * Apply unpooling to one channel of one point and store the results.
    *
-   * @param error The backward error.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
+   * @param error The backward error of the channel.
+   * @param output The unpooled error of the input channel.
+   * @param indices The positions of the pooled values in the input channel.
    */
   template<typename eT>
-  void Unpooling(const arma::Mat<eT>& error,
-                 arma::Mat<eT>& output,
-                 arma::Mat<eT>& poolingIndices)
+  void Unpooling(const eT* error, eT* output, const uint32_t* indices) const
   {
-    for (size_t i = 0; i < poolingIndices.n_elem; ++i)
-    {
-      output(poolingIndices(i)) += error(i);
-    }
+    for (size_t i = 0; i < outputWidth * outputHeight; ++i)
+      output[indices[i]] += error[i];
   }
 
   //! Locally-stored width of the pooling window.
@@ -243,9 +242,6 @@ class MaxPooling
   //! Locally-stored number of output channels.
   size_t outSize;
 
-  //! Locally-stored reset parameter used to initialize the module once.
-  bool reset;
-
   //! Locally-stored input width.
   size_t inputWidth;
 
@@ -267,18 +263,6 @@ class MaxPooling
   //! Locally-stored number of input units.
   size_t batchSize;
 
-  //! Locally-stored output parameter.
-  arma::cube outputTemp;
-
-  //! Locally-stored transformed input parameter.
-  arma::cube inputTemp;
-
-  //! Locally-stored transformed output parameter.
-  arma::cube gTemp;
-
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
-
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -288,14 +272,11 @@ class MaxPooling
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored indices matrix parameter.
-  arma::Mat<size_t> indices;
-
-  //! Locally-stored indices column parameter.
-  arma::Col<size_t> indicesCol;
-
-  //! Locally-stored pooling indicies.
-  std::vector<arma::cube> poolingIndices;
+  //! The positions of the pooled values of the forward passes in training
+  //! mode that were not yet used by a backward pass, one block per forward
+  //! pass.  The position of each pooled value is stored relative to its input
+  //! channel.
+  std::vector<uint32_t> poolingIndices;
 }; // class MaxPooling
 
 } // namespace ann
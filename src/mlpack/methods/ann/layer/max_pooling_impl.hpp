@@ -39,7 +39,6 @@ MaxPooling<InputDataType, OutputDataType>::MaxPooling(
     floor(floor),
     inSize(0),
     outSize(0),
-    reset(false),
     inputWidth(0),
     inputHeight(0),
     outputWidth(0),
@@ -58,8 +57,6 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
 {
   batchSize = input.n_cols;
   inSize = input.n_elem / (inputWidth * inputHeight * batchSize);
-  inputTemp = arma::cube(const_cast<arma::Mat<eT>&>(input).memptr(),
-      inputWidth, inputHeight, batchSize * inSize, false, false);
 
   if (floor)
   {
@@ -78,45 +75,30 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
     offset = 1;
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
+  outSize = batchSize * inSize;
+  const size_t inputElements = inputWidth * inputHeight;
+  const size_t outputElements = outputWidth * outputHeight;
 
-  if (!deterministic)
-  {
-    poolingIndices.push_back(outputTemp);
-  }
+  // The output keeps its memory if its size doesn't change.
+  output.set_size(outputElements * inSize, batchSize);
 
-  if (!reset)
+  // In training mode, the positions of the pooled values are pushed for the
+  // next backward pass.
+  uint32_t* indices = NULL;
+  if (!deterministic)
   {
-    size_t elements = inputWidth * inputHeight;
-    indicesCol = arma::linspace<arma::Col<size_t> >(0, (elements - 1),
-        elements);
-
-    indices = arma::Mat<size_t>(indicesCol.memptr(), inputWidth, inputHeight);
-
-    reset = true;
+    poolingIndices.resize(poolingIndices.size() + output.n_elem);
+    indices = poolingIndices.data() + poolingIndices.size() - output.n_elem;
   }
 
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
+  // Every channel of every point is pooled independently.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) outSize; ++s)
   {
-    if (!deterministic)
-    {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-        poolingIndices.back().slice(s));
-    }
-    else
-    {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-          inputTemp.slice(s));
-    }
+    PoolingOperation(input.memptr() + s * inputElements,
+        output.memptr() + s * outputElements,
+        (indices == NULL) ? NULL : indices + s * outputElements);
   }
-
-  output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
-      batchSize);
-
-  outputWidth = outputTemp.n_rows;
-  outputHeight = outputTemp.n_cols;
-  outSize = batchSize * inSize;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -124,21 +106,23 @@ template<typename eT>
 void MaxPooling<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  arma::cube mappedError = arma::cube(((arma::Mat<eT>&) gy).memptr(),
-      outputWidth, outputHeight, outSize, false, false);
+  const size_t inputElements = inputWidth * inputHeight;
+  const size_t outputElements = outputWidth * outputHeight;
+
+  g.zeros(inputElements * outSize / batchSize, batchSize);
 
-  gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
-      inputTemp.n_cols, inputTemp.n_slices);
+  // Use the positions of the last forward pass.
+  const uint32_t* indices = poolingIndices.data() + poolingIndices.size() -
+      gy.n_elem;
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) outSize; ++s)
   {
-    Unpooling(mappedError.slice(s), gTemp.slice(s),
-        poolingIndices.back().slice(s));
+    Unpooling(gy.memptr() + s * outputElements,
+        g.memptr() + s * inputElements, indices + s * outputElements);
   }
 
-  poolingIndices.pop_back();
-
-  g = arma::mat(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
+  poolingIndices.resize(poolingIndices.size() - gy.n_elem);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -149,56 +149,54 @@ class MeanPooling
 
  private:
   /**
-   * Apply pooling to the input and store the results.
+   * Apply pooling to one channel of one point and store the results.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The input channel to apply the pooling rule to.
    * @param output The pooled result.
    */
   template<typename eT>
-  void Pooling(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+  void Pooling(const eT* input, eT* output) const
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
+    const size_t windowWidth = kernelWidth - offset;
+    const size_t windowHeight = kernelHeight - offset;
+    for (size_t j = 0, colidx = 0; j < outputHeight;
          ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
            ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
+        eT sum = 0;
+        for (size_t c = colidx; c < colidx + windowHeight; ++c)
+          for (size_t r = rowidx; r < rowidx + windowWidth; ++r)
+            sum += input[r + c * inputWidth];
 
-        output(i, j) = arma::mean(arma::mean(subInput));
+        output[i + j * outputWidth] = sum / (windowWidth * windowHeight);
       }
     }
   }
 
   /**
-   * Apply unpooling to the input and store the results.
+   * Apply unpooling to one channel of one point and store the results.
    *
-   * @param input The input to be apply the unpooling rule.
-   * @param output The pooled result.
+   * @param error The backward error of the channel.
+   * @param output The unpooled error of the input channel.
    */
   template<typename eT>
-  void Unpooling(const arma::Mat<eT>& input,
-                 const arma::Mat<eT>& error,
-                 arma::Mat<eT>& output)
+  void Unpooling(const eT* error, eT* output) const
   {
-    const size_t rStep = input.n_rows / error.n_rows - offset;
-    const size_t cStep = input.n_cols / error.n_cols - offset;
+    const size_t rStep = inputWidth / outputWidth - offset;
+    const size_t cStep = inputHeight / outputHeight - offset;
 
-    arma::Mat<eT> unpooledError;
-    for (size_t j = 0; j < input.n_cols - cStep; j += cStep)
+    for (size_t j = 0; j < inputHeight - cStep; j += cStep)
     {
-      for (size_t i = 0; i < input.n_rows - rStep; i += rStep)
+      for (size_t i = 0; i < inputWidth - rStep; i += rStep)
       {
-        const arma::Mat<eT>& inputArea = input(arma::span(i, i + rStep - 1),
-            arma::span(j, j + cStep - 1));
-
-        unpooledError = arma::Mat<eT>(inputArea.n_rows, inputArea.n_cols);
-        unpooledError.fill(error(i / rStep, j / cStep) / inputArea.n_elem);
+        const eT unpooledError = error[i / rStep + (j / cStep) * outputWidth] /
+            (rStep * cStep);
 
-        output(arma::span(i, i + rStep - 1 - offset),
-            arma::span(j, j + cStep - 1 - offset)) += unpooledError;
+        for (size_t c = j; c < j + cStep - offset; ++c)
+          for (size_t r = i; r < i + rStep - offset; ++r)
+            output[r + c * inputWidth] += unpooledError;
       }
     }
   }
@@ -248,15 +246,6 @@ class MeanPooling
   //! Locally-stored number of input units.
   size_t batchSize;
 
-  //! Locally-stored output parameter.
-  arma::cube outputTemp;
-
-  //! Locally-stored transformed input parameter.
-  arma::cube inputTemp;
-
-  //! Locally-stored transformed output parameter.
-  arma::cube gTemp;
-
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -58,8 +58,6 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
 {
   batchSize = input.n_cols;
   inSize = input.n_elem / (inputWidth * inputHeight * batchSize);
-  inputTemp = arma::cube(const_cast<arma::Mat<eT>&>(input).memptr(),
-      inputWidth, inputHeight, batchSize * inSize, false, false);
 
   if (floor)
   {
@@ -80,18 +78,20 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
     offset = 1;
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
-
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
-    Pooling(inputTemp.slice(s), outputTemp.slice(s));
+  outSize = batchSize * inSize;
+  const size_t inputElements = inputWidth * inputHeight;
+  const size_t outputElements = outputWidth * outputHeight;
 
-  output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
-      batchSize);
+  // The output keeps its memory if its size doesn't change.
+  output.set_size(outputElements * inSize, batchSize);
 
-  outputWidth = outputTemp.n_rows;
-  outputHeight = outputTemp.n_cols;
-  outSize = batchSize * inSize;
+  // Every channel of every point is pooled independently.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) outSize; ++s)
+  {
+    Pooling(input.memptr() + s * inputElements,
+        output.memptr() + s * outputElements);
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -101,18 +101,17 @@ void MeanPooling<InputDataType, OutputDataType>::Backward(
   const arma::Mat<eT>& gy,
   arma::Mat<eT>& g)
 {
-  arma::cube mappedError = arma::cube(((arma::Mat<eT>&) gy).memptr(),
-      outputWidth, outputHeight, outSize, false, false);
+  const size_t inputElements = inputWidth * inputHeight;
+  const size_t outputElements = outputWidth * outputHeight;
 
-  gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
-      inputTemp.n_cols, inputTemp.n_slices);
+  g.zeros(inputElements * inSize, batchSize);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) outSize; ++s)
   {
-    Unpooling(inputTemp.slice(s), mappedError.slice(s), gTemp.slice(s));
+    Unpooling(gy.memptr() + s * outputElements,
+        g.memptr() + s * inputElements);
   }
-
-  g = arma::mat(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -148,7 +148,7 @@ class MiniBatchDiscrimination
   size_t batchSize;
 
   //! Locally-stored temporary features object.
-  arma::mat tempM;
+  OutputDataType tempM;
 
   //! Locally-stored weight object.
   OutputDataType weights;
@@ -157,13 +157,13 @@ class MiniBatchDiscrimination
   OutputDataType weight;
 
   //! Locally-stored features of input.
-  arma::cube M;
+  arma::Cube<typename OutputDataType::elem_type> M;
 
   //! Locally-stored delta for features object.
-  arma::cube deltaM;
+  arma::Cube<typename OutputDataType::elem_type> deltaM;
 
   //! Locally-stored L1 distances between features.
-  arma::cube distances;
+  arma::Cube<typename OutputDataType::elem_type> distances;
 
   //! Locally-stored delta object.
   OutputDataType delta;
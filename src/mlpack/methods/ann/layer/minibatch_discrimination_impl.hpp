@@ -46,7 +46,7 @@ MiniBatchDiscrimination<InputDataType, OutputDataType
 template<typename InputDataType, typename OutputDataType>
 void MiniBatchDiscrimination<InputDataType, OutputDataType>::Reset()
 {
-  weight = arma::mat(weights.memptr(), B * C, A, false, false);
+  weight = OutputDataType(weights.memptr(), B * C, A, false, false);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -56,7 +56,7 @@ void MiniBatchDiscrimination<InputDataType, OutputDataType>::Forward(
 {
   batchSize = input.n_cols;
   tempM = weight * input;
-  M = arma::cube(tempM.memptr(), B, C, batchSize, false, false);
+  M = arma::Cube<eT>(tempM.memptr(), B, C, batchSize, false, false);
   distances.set_size(B, batchSize, batchSize);
   output.set_size(B, batchSize);
 
@@ -102,7 +102,7 @@ void MiniBatchDiscrimination<InputDataType, OutputDataType>::Backward(
       {
         continue;
       }
-      arma::mat t = arma::sign(M.slice(i) - M.slice(j));
+      arma::Mat<eT> t = arma::sign(M.slice(i) - M.slice(j));
       t.each_col() %=
           distances.slice(std::min(i, j)).col(std::max(i, j)) % gM.col(i);
       deltaM.slice(i) -= t;
@@ -110,7 +110,7 @@ void MiniBatchDiscrimination<InputDataType, OutputDataType>::Backward(
     }
   }
 
-  deltaTemp = arma::mat(deltaM.memptr(), B * C, batchSize, false, false);
+  deltaTemp = arma::Mat<eT>(deltaM.memptr(), B * C, batchSize, false, false);
   g += weight.t() * deltaTemp;
 }
 
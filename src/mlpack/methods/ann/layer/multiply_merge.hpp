@@ -102,7 +102,10 @@ class MultiplyMerge
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<OutputDataType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Get the output parameter.
   OutputDataType const& OutputParameter() const { return outputParameter; }
@@ -120,7 +123,7 @@ class MultiplyMerge
   OutputDataType& Gradient() { return gradient; }
 
   //! Return the model modules.
-  std::vector<LayerTypes<CustomLayers...> >& Model()
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
   {
     if (model)
     {
@@ -142,6 +145,13 @@ class MultiplyMerge
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Parameter which indicates if the modules should be exposed.
   bool model;
 
@@ -153,10 +163,10 @@ class MultiplyMerge
   bool ownsLayer;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! Locally-stored empty list of modules.
-  std::vector<LayerTypes<CustomLayers...> > empty;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > empty;
 
   //! Locally-stored delete visitor module object.
   DeleteVisitor deleteVisitor;
@@ -131,7 +131,7 @@ class NoisyLinear
   OutputDataType& Gradient() { return gradient; }
 
   //! Modify the bias weights of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   /**
    * Serialize the layer
@@ -51,23 +51,23 @@ NoisyLinear<InputDataType, OutputDataType>::NoisyLinear(
 template<typename InputDataType, typename OutputDataType>
 void NoisyLinear<InputDataType, OutputDataType>::Reset()
 {
-  weightMu = arma::mat(weights.memptr(),
+  weightMu = OutputDataType(weights.memptr(),
       outSize, inSize, false, false);
-  biasMu = arma::mat(weights.memptr() + weightMu.n_elem,
-      outSize, 1, false, false);
-  weightSigma = arma::mat(weights.memptr() + weightMu.n_elem + biasMu.n_elem,
-      outSize, inSize, false, false);
-  biasSigma = arma::mat(weights.memptr() + weightMu.n_elem * 2 + biasMu.n_elem,
+  biasMu = OutputDataType(weights.memptr() + weightMu.n_elem,
       outSize, 1, false, false);
+  weightSigma = OutputDataType(weights.memptr() + weightMu.n_elem +
+      biasMu.n_elem, outSize, inSize, false, false);
+  biasSigma = OutputDataType(weights.memptr() + weightMu.n_elem * 2 +
+      biasMu.n_elem, outSize, 1, false, false);
   this->ResetNoise();
 }
 
 template<typename InputDataType, typename OutputDataType>
 void NoisyLinear<InputDataType, OutputDataType>::ResetNoise()
 {
-  arma::mat epsilonIn = arma::randn<arma::mat>(inSize, 1);
+  OutputDataType epsilonIn = arma::randn<OutputDataType>(inSize, 1);
   epsilonIn = arma::sign(epsilonIn) % arma::sqrt(arma::abs(epsilonIn));
-  arma::mat epsilonOut = arma::randn<arma::mat>(outSize, 1);
+  OutputDataType epsilonOut = arma::randn<OutputDataType>(outSize, 1);
   epsilonOut = arma::sign(epsilonOut) % arma::sqrt(arma::abs(epsilonOut));
   weightEpsilon = epsilonOut * epsilonIn.t();
   biasEpsilon = epsilonOut;
@@ -112,7 +112,7 @@ void NoisyLinear<InputDataType, OutputDataType>::Gradient(
     arma::Mat<eT>& gradient)
 {
   // Locally stored to prevent multiplication twice.
-  arma::mat weightGrad = error * input.t();
+  arma::Mat<eT> weightGrad = error * input.t();
 
   // Gradients for mu values.
   gradient.rows(0, weight.n_elem - 1) = arma::vectorise(weightGrad);
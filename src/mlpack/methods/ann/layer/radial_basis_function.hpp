@@ -67,7 +67,7 @@ class RBF
    */
   RBF(const size_t inSize,
       const size_t outSize,
-      arma::mat& centres,
+      OutputDataType& centres,
       double betas = 0);
 
   /**
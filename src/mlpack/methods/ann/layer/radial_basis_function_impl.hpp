@@ -33,7 +33,7 @@ template<typename InputDataType, typename OutputDataType,
 RBF<InputDataType, OutputDataType, Activation>::RBF(
     const size_t inSize,
     const size_t outSize,
-    arma::mat& centres,
+    OutputDataType& centres,
     double betas) :
     inSize(inSize),
     outSize(outSize),
@@ -46,7 +46,7 @@ RBF<InputDataType, OutputDataType, Activation>::RBF(
     for (size_t i = 0; i < centres.n_cols; i++)
     {
       double max_dis = 0;
-      arma::mat temp = centres.each_col() - centres.col(i);
+      OutputDataType temp = centres.each_col() - centres.col(i);
       max_dis = arma::accu(arma::max(arma::pow(arma::sum(
           arma::pow((temp), 2), 0), 0.5).t()));
       if (max_dis > sigmas)
@@ -63,11 +63,11 @@ void RBF<InputDataType, OutputDataType, Activation>::Forward(
     const arma::Mat<eT>& input,
     arma::Mat<eT>& output)
 {
-  distances = arma::mat(outSize, input.n_cols);
+  distances = arma::Mat<eT>(outSize, input.n_cols);
 
   for (size_t i = 0; i < input.n_cols; i++)
   {
-    arma::mat temp = centres.each_col() - input.col(i);
+    arma::Mat<eT> temp = centres.each_col() - input.col(i);
     distances.col(i) = arma::pow(arma::sum(
       arma::pow((temp), 2), 0), 0.5).t();
   }
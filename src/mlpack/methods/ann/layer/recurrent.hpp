@@ -109,7 +109,10 @@ class Recurrent
                 arma::Mat<eT>& /* gradient */);
 
   //! Get the model modules.
-  std::vector<LayerTypes<CustomLayers...> >& Model() { return network; }
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
+  {
+    return network;
+  }
 
     //! The value of the deterministic parameter.
   bool Deterministic() const { return deterministic; }
@@ -146,23 +149,32 @@ class Recurrent
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+  typedef BasicGradientZeroVisitor<OutputDataType> GradientZeroVisitor;
+  typedef BasicAddVisitor<OutputDataType, CustomLayers...> AddVisitor;
+
   //! Locally-stored delete visitor module object.
   DeleteVisitor deleteVisitor;
 
   //! Locally-stored copy visitor
-  CopyVisitor<CustomLayers...> copyVisitor;
+  BasicCopyVisitor<OutputDataType, CustomLayers...> copyVisitor;
 
   //! Locally-stored start module.
-  LayerTypes<CustomLayers...> startModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> startModule;
 
   //! Locally-stored input module.
-  LayerTypes<CustomLayers...> inputModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> inputModule;
 
   //! Locally-stored feedback module.
-  LayerTypes<CustomLayers...> feedbackModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> feedbackModule;
 
   //! Locally-stored transfer module.
-  LayerTypes<CustomLayers...> transferModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> transferModule;
 
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
@@ -187,16 +199,16 @@ class Recurrent
   OutputDataType parameters;
 
   //! Locally-stored initial module.
-  LayerTypes<CustomLayers...> initialModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> initialModule;
 
   //! Locally-stored recurrent module.
-  LayerTypes<CustomLayers...> recurrentModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> recurrentModule;
 
   //! Locally-stored model modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! Locally-stored merge module.
-  LayerTypes<CustomLayers...> mergeModule;
+  BasicLayerTypes<OutputDataType, CustomLayers...> mergeModule;
 
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
@@ -205,7 +217,7 @@ class Recurrent
   OutputParameterVisitor outputParameterVisitor;
 
   //! Locally-stored feedback output parameters.
-  std::vector<arma::mat> feedbackOutputParameter;
+  std::vector<OutputDataType> feedbackOutputParameter;
 
   //! Locally-stored delta object.
   OutputDataType delta;
@@ -217,7 +229,7 @@ class Recurrent
   OutputDataType outputParameter;
 
   //! Locally-stored recurrent error parameter.
-  arma::mat recurrentError;
+  OutputDataType recurrentError;
 }; // class Recurrent
 
 } // namespace ann
@@ -113,7 +113,7 @@ class RecurrentAttention
                 arma::Mat<eT>& /* gradient */);
 
   //! Get the model modules.
-  std::vector<LayerTypes<>>& Model() { return network; }
+  std::vector<BasicLayerTypes<OutputDataType>>& Model() { return network; }
 
     //! The value of the deterministic parameter.
   bool Deterministic() const { return deterministic; }
@@ -153,6 +153,19 @@ class RecurrentAttention
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+  typedef BasicGradientSetVisitor<OutputDataType> GradientSetVisitor;
+  typedef BasicGradientUpdateVisitor<OutputDataType> GradientUpdateVisitor;
+  typedef BasicSaveOutputParameterVisitor<OutputDataType>
+      SaveOutputParameterVisitor;
+  typedef BasicLoadOutputParameterVisitor<OutputDataType>
+      LoadOutputParameterVisitor;
+
   //! Calculate the gradient of the attention module.
   void IntermediateGradient()
   {
@@ -183,10 +196,10 @@ class RecurrentAttention
   size_t outSize;
 
   //! Locally-stored start module.
-  LayerTypes<> rnnModule;
+  BasicLayerTypes<OutputDataType> rnnModule;
 
   //! Locally-stored input module.
-  LayerTypes<> actionModule;
+  BasicLayerTypes<OutputDataType> actionModule;
 
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
@@ -204,7 +217,7 @@ class RecurrentAttention
   OutputDataType parameters;
 
   //! Locally-stored model modules.
-  std::vector<LayerTypes<>> network;
+  std::vector<BasicLayerTypes<OutputDataType>> network;
 
   //! Locally-stored weight size visitor.
   WeightSizeVisitor weightSizeVisitor;
@@ -216,10 +229,10 @@ class RecurrentAttention
   OutputParameterVisitor outputParameterVisitor;
 
   //! Locally-stored feedback output parameters.
-  std::vector<arma::mat> feedbackOutputParameter;
+  std::vector<OutputDataType> feedbackOutputParameter;
 
   //! List of all module parameters for the backward pass (BBTT).
-  std::vector<arma::mat> moduleOutputParameter;
+  std::vector<OutputDataType> moduleOutputParameter;
 
   //! Locally-stored delta object.
   OutputDataType delta;
@@ -231,28 +244,28 @@ class RecurrentAttention
   OutputDataType outputParameter;
 
   //! Locally-stored recurrent error parameter.
-  arma::mat recurrentError;
+  OutputDataType recurrentError;
 
   //! Locally-stored action error parameter.
-  arma::mat actionError;
+  OutputDataType actionError;
 
   //! Locally-stored action delta.
-  arma::mat actionDelta;
+  OutputDataType actionDelta;
 
   //! Locally-stored recurrent delta.
-  arma::mat rnnDelta;
+  OutputDataType rnnDelta;
 
   //! Locally-stored initial action input.
-  arma::mat initialInput;
+  OutputDataType initialInput;
 
   //! Locally-stored reset visitor.
   ResetVisitor resetVisitor;
 
   //! Locally-stored attention gradient.
-  arma::mat attentionGradient;
+  OutputDataType attentionGradient;
 
   //! Locally-stored intermediate gradient for the attention module.
-  arma::mat intermediateGradient;
+  OutputDataType intermediateGradient;
 }; // class RecurrentAttention
 
 } // namespace ann
@@ -63,7 +63,7 @@ void RecurrentAttention<InputDataType, OutputDataType>::Forward(
   // Initialize the action input.
   if (initialInput.is_empty())
   {
-    initialInput = arma::zeros(outSize, input.n_cols);
+    initialInput = arma::zeros<OutputDataType>(outSize, input.n_cols);
   }
 
   // Propagate through the action and recurrent module.
@@ -83,7 +83,7 @@ void RecurrentAttention<InputDataType, OutputDataType>::Forward(
     }
 
     // Initialize the glimpse input.
-    arma::mat glimpseInput = arma::zeros(input.n_elem, 2);
+    arma::Mat<eT> glimpseInput = arma::zeros<arma::Mat<eT> >(input.n_elem, 2);
     glimpseInput.col(0) = input;
     glimpseInput.submat(0, 1, boost::apply_visitor(outputParameterVisitor,
         actionModule).n_elem - 1, 1) = boost::apply_visitor(
@@ -123,11 +123,11 @@ void RecurrentAttention<InputDataType, OutputDataType>::Backward(
     size_t weights = boost::apply_visitor(weightSizeVisitor, rnnModule) +
         boost::apply_visitor(weightSizeVisitor, actionModule);
 
-    intermediateGradient = arma::zeros(weights, 1);
-    attentionGradient = arma::zeros(weights, 1);
+    intermediateGradient = arma::zeros<OutputDataType>(weights, 1);
+    attentionGradient = arma::zeros<OutputDataType>(weights, 1);
 
     // Initialize the action error.
-    actionError = arma::zeros(
+    actionError = arma::zeros<OutputDataType>(
       boost::apply_visitor(outputParameterVisitor, actionModule).n_rows,
       boost::apply_visitor(outputParameterVisitor, actionModule).n_cols);
   }
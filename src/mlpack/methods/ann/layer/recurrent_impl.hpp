@@ -66,19 +66,19 @@ Recurrent<InputDataType, OutputDataType, CustomLayers...>::Recurrent(
   mergeModule = new AddMerge<>(false, false, false);
   recurrentModule = new Sequential<>(false, false);
 
-  boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule),
+  boost::apply_visitor(AddVisitor(inputModule),
                        initialModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(startModule),
+  boost::apply_visitor(AddVisitor(startModule),
                        initialModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+  boost::apply_visitor(AddVisitor(transferModule),
                        initialModule);
 
-  boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule), mergeModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(feedbackModule),
+  boost::apply_visitor(AddVisitor(inputModule), mergeModule);
+  boost::apply_visitor(AddVisitor(feedbackModule),
                        mergeModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(mergeModule),
+  boost::apply_visitor(AddVisitor(mergeModule),
                        recurrentModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+  boost::apply_visitor(AddVisitor(transferModule),
                        recurrentModule);
 
   network.push_back(initialModule);
@@ -106,19 +106,19 @@ Recurrent<InputDataType, OutputDataType, CustomLayers...>::Recurrent(
   mergeModule = new AddMerge<>(false, false, false);
   recurrentModule = new Sequential<>(false, false);
 
-  boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule),
+  boost::apply_visitor(AddVisitor(inputModule),
                        initialModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(startModule),
+  boost::apply_visitor(AddVisitor(startModule),
                        initialModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+  boost::apply_visitor(AddVisitor(transferModule),
                        initialModule);
 
-  boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule), mergeModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(feedbackModule),
+  boost::apply_visitor(AddVisitor(inputModule), mergeModule);
+  boost::apply_visitor(AddVisitor(feedbackModule),
                        mergeModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(mergeModule),
+  boost::apply_visitor(AddVisitor(mergeModule),
                        recurrentModule);
-  boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+  boost::apply_visitor(AddVisitor(transferModule),
                        recurrentModule);
   this->network.push_back(initialModule);
   this->network.push_back(mergeModule);
@@ -282,20 +282,20 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::serialize(
     mergeModule = new AddMerge<>(false, false, false);
     recurrentModule = new Sequential<>(false, false);
 
-    boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule),
+    boost::apply_visitor(AddVisitor(inputModule),
                          initialModule);
-    boost::apply_visitor(AddVisitor<CustomLayers...>(startModule),
+    boost::apply_visitor(AddVisitor(startModule),
                          initialModule);
-    boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+    boost::apply_visitor(AddVisitor(transferModule),
                          initialModule);
 
-    boost::apply_visitor(AddVisitor<CustomLayers...>(inputModule),
+    boost::apply_visitor(AddVisitor(inputModule),
                          mergeModule);
-    boost::apply_visitor(AddVisitor<CustomLayers...>(feedbackModule),
+    boost::apply_visitor(AddVisitor(feedbackModule),
                          mergeModule);
-    boost::apply_visitor(AddVisitor<CustomLayers...>(mergeModule),
+    boost::apply_visitor(AddVisitor(mergeModule),
                          recurrentModule);
-    boost::apply_visitor(AddVisitor<CustomLayers...>(transferModule),
+    boost::apply_visitor(AddVisitor(transferModule),
                          recurrentModule);
 
     network.push_back(initialModule);
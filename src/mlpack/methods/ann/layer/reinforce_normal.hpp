@@ -106,7 +106,7 @@ class ReinforceNormal
   OutputDataType outputParameter;
 
   //!  Locally-stored output module parameter parameters.
-  std::vector<arma::mat> moduleInputParameter;
+  std::vector<OutputDataType> moduleInputParameter;
 
   //! If true use maximum a posteriori during the forward pass.
   bool deterministic;
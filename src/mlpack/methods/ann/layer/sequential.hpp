@@ -146,10 +146,13 @@ class Sequential
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<OutputDataType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Return the model modules.
-  std::vector<LayerTypes<CustomLayers...> >& Model()
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> >& Model()
   {
     if (model)
     {
@@ -160,29 +163,29 @@ class Sequential
   }
 
   //! Return the initial point for the optimization.
-  const arma::mat& Parameters() const { return parameters; }
+  const OutputDataType& Parameters() const { return parameters; }
   //! Modify the initial point for the optimization.
-  arma::mat& Parameters() { return parameters; }
+  OutputDataType& Parameters() { return parameters; }
 
   //! Get the input parameter.
-  arma::mat const& InputParameter() const { return inputParameter; }
+  OutputDataType const& InputParameter() const { return inputParameter; }
   //! Modify the input parameter.
-  arma::mat& InputParameter() { return inputParameter; }
+  OutputDataType& InputParameter() { return inputParameter; }
 
   //! Get the output parameter.
-  arma::mat const& OutputParameter() const { return outputParameter; }
+  OutputDataType const& OutputParameter() const { return outputParameter; }
   //! Modify the output parameter.
-  arma::mat& OutputParameter() { return outputParameter; }
+  OutputDataType& OutputParameter() { return outputParameter; }
 
   //! Get the delta.
-  arma::mat const& Delta() const { return delta; }
+  OutputDataType const& Delta() const { return delta; }
   //! Modify the delta.
-  arma::mat& Delta() { return delta; }
+  OutputDataType& Delta() { return delta; }
 
   //! Get the gradient.
-  arma::mat const& Gradient() const { return gradient; }
+  OutputDataType const& Gradient() const { return gradient; }
   //! Modify the gradient.
-  arma::mat& Gradient() { return gradient; }
+  OutputDataType& Gradient() { return gradient; }
 
   /**
    * Serialize the layer
@@ -191,6 +194,13 @@ class Sequential
   void serialize(Archive& /* ar */, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+
   //! Parameter which indicates if the modules should be exposed.
   bool model;
 
@@ -198,10 +208,10 @@ class Sequential
   bool reset;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > network;
 
   //! Locally-stored model parameters.
-  arma::mat parameters;
+  OutputDataType parameters;
 
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
@@ -213,19 +223,19 @@ class Sequential
   DeleteVisitor deleteVisitor;
 
   //! Locally-stored empty list of modules.
-  std::vector<LayerTypes<CustomLayers...> > empty;
+  std::vector<BasicLayerTypes<OutputDataType, CustomLayers...> > empty;
 
   //! Locally-stored delta object.
-  arma::mat delta;
+  OutputDataType delta;
 
   //! Locally-stored input parameter object.
-  arma::mat inputParameter;
+  OutputDataType inputParameter;
 
   //! Locally-stored output parameter object.
-  arma::mat outputParameter;
+  OutputDataType outputParameter;
 
   //! Locally-stored gradient object.
-  arma::mat gradient;
+  OutputDataType gradient;
 
   //! Locally-stored output width visitor.
   OutputWidthVisitor outputWidthVisitor;
@@ -234,7 +244,7 @@ class Sequential
   OutputHeightVisitor outputHeightVisitor;
 
   //! Locally-stored copy visitor
-  CopyVisitor<CustomLayers...> copyVisitor;
+  BasicCopyVisitor<OutputDataType, CustomLayers...> copyVisitor;
 
   //! The input width.
   size_t width;
@@ -89,7 +89,7 @@ Sequential<
 {
   if (!model && ownsLayers)
   {
-    for (LayerTypes<CustomLayers...>& layer : network)
+    for (BasicLayerTypes<OutputDataType, CustomLayers...>& layer : network)
       boost::apply_visitor(deleteVisitor, layer);
   }
 }
@@ -233,7 +233,7 @@ void Sequential<
   // If loading, delete the old layers.
   if (Archive::is_loading::value)
   {
-    for (LayerTypes<CustomLayers...>& layer : network)
+    for (BasicLayerTypes<OutputDataType, CustomLayers...>& layer : network)
     {
       boost::apply_visitor(deleteVisitor, layer);
     }
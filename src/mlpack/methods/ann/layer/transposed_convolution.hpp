@@ -49,6 +49,9 @@ template <
 class TransposedConvolution
 {
  public:
+  //! The type of the weights and of the intermediate maps.
+  typedef arma::Cube<typename OutputDataType::elem_type> CubeType;
+
   //! Create the Transposed Convolution object.
   TransposedConvolution();
 
@@ -179,14 +182,14 @@ class TransposedConvolution
   OutputDataType& Parameters() { return weights; }
 
   //! Get the weight of the layer.
-  arma::cube const& Weight() const { return weight; }
+  CubeType const& Weight() const { return weight; }
   //! Modify the weight of the layer.
-  arma::cube& Weight() { return weight; }
+  CubeType& Weight() { return weight; }
 
   //! Get the bias of the layer.
-  arma::mat const& Bias() const { return bias; }
+  OutputDataType const& Bias() const { return bias; }
   //! Modify the bias of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   //! Get the input parameter.
   InputDataType const& InputParameter() const { return inputParameter; }
@@ -334,7 +337,8 @@ class TransposedConvolution
     if (output.n_rows != input.n_rows * strideWidth - strideWidth + 1 ||
         output.n_cols != input.n_cols * strideHeight - strideHeight + 1)
     {
-      output = arma::zeros(input.n_rows * strideWidth - strideWidth + 1,
+      output = arma::zeros<arma::Mat<eT> >(
+          input.n_rows * strideWidth - strideWidth + 1,
           input.n_cols * strideHeight - strideHeight + 1);
     }
 
@@ -364,7 +368,8 @@ class TransposedConvolution
                    const size_t strideHeight,
                    arma::Cube<eT>& output)
   {
-    output = arma::zeros(input.n_rows * strideWidth - strideWidth + 1,
+    output = arma::zeros<arma::Cube<eT> >(
+        input.n_rows * strideWidth - strideWidth + 1,
         input.n_cols * strideHeight - strideHeight + 1, input.n_slices);
 
     for (size_t i = 0; i < input.n_slices; ++i)
@@ -417,10 +422,10 @@ class TransposedConvolution
   OutputDataType weights;
 
   //! Locally-stored weight object.
-  arma::cube weight;
+  CubeType weight;
 
   //! Locally-stored bias term object.
-  arma::mat bias;
+  OutputDataType bias;
 
   //! Locally-stored input width.
   size_t inputWidth;
@@ -435,19 +440,19 @@ class TransposedConvolution
   size_t outputHeight;
 
   //! Locally-stored transformed output parameter.
-  arma::cube outputTemp;
+  CubeType outputTemp;
 
   //! Locally-stored transformed padded input parameter.
-  arma::cube inputPaddedTemp;
+  CubeType inputPaddedTemp;
 
   //! Locally-stored transformed expanded input parameter.
-  arma::cube inputExpandedTemp;
+  CubeType inputExpandedTemp;
 
   //! Locally-stored transformed error parameter.
-  arma::cube gTemp;
+  CubeType gTemp;
 
   //! Locally-stored transformed gradient parameter.
-  arma::cube gradientTemp;
+  CubeType gradientTemp;
 
   //! Locally-stored padding layer for forward propagation.
   ann::Padding<> paddingForward;
@@ -50,8 +50,8 @@ VirtualBatchNorm<InputDataType, OutputDataType>::VirtualBatchNorm(
 template<typename InputDataType, typename OutputDataType>
 void VirtualBatchNorm<InputDataType, OutputDataType>::Reset()
 {
-  gamma = arma::mat(weights.memptr(), size, 1, false, false);
-  beta = arma::mat(weights.memptr() + gamma.n_elem, size, 1, false, false);
+  gamma = OutputDataType(weights.memptr(), size, 1, false, false);
+  beta = OutputDataType(weights.memptr() + gamma.n_elem, size, 1, false, false);
 
   if (!loading)
   {
@@ -68,11 +68,11 @@ void VirtualBatchNorm<InputDataType, OutputDataType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   inputParameter = input;
-  arma::mat inputMean = arma::mean(input, 1);
-  arma::mat inputMeanSquared = arma::mean(arma::square(input), 1);
+  arma::Mat<eT> inputMean = arma::mean(input, 1);
+  arma::Mat<eT> inputMeanSquared = arma::mean(arma::square(input), 1);
 
   mean = oldCoefficient * referenceBatchMean + newCoefficient * inputMean;
-  arma::mat meanSquared = oldCoefficient * referenceBatchMeanSquared +
+  arma::Mat<eT> meanSquared = oldCoefficient * referenceBatchMeanSquared +
       newCoefficient * inputMeanSquared;
   variance = meanSquared - arma::square(mean);
   // Normalize the input.
@@ -92,13 +92,13 @@ template<typename eT>
 void VirtualBatchNorm<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  const arma::mat stdInv = 1.0 / arma::sqrt(variance + eps);
+  const arma::Mat<eT> stdInv = 1.0 / arma::sqrt(variance + eps);
 
   // dl / dxhat.
-  const arma::mat norm = gy.each_col() % gamma;
+  const arma::Mat<eT> norm = gy.each_col() % gamma;
 
   // sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  const arma::mat var = arma::sum(norm % inputSubMean, 1) %
+  const arma::Mat<eT> var = arma::sum(norm % inputSubMean, 1) %
       arma::pow(stdInv, 3.0) * -0.5;
 
   // dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
@@ -96,10 +96,10 @@ class VRClassReward
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<OutputDataType> layer) { network.push_back(layer); }
 
   //! Get the network modules.
-  std::vector<LayerTypes<> >& Model() { return network; }
+  std::vector<BasicLayerTypes<OutputDataType> >& Model() { return network; }
 
   //! Get the value of parameter sizeAverage.
   bool SizeAverage() const { return sizeAverage; }
@@ -130,7 +130,7 @@ class VRClassReward
   OutputDataType outputParameter;
 
   //! Locally-stored network modules.
-  std::vector<LayerTypes<> > network;
+  std::vector<BasicLayerTypes<OutputDataType> > network;
 }; // class VRClassReward
 
 } // namespace ann
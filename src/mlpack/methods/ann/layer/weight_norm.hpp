@@ -66,7 +66,8 @@ class WeightNorm
    *
    * @param layer The layer whose weights are needed to be normalized.
    */
-  WeightNorm(LayerTypes<CustomLayers...> layer = LayerTypes<CustomLayers...>());
+  WeightNorm(BasicLayerTypes<OutputDataType, CustomLayers...> layer =
+      BasicLayerTypes<OutputDataType, CustomLayers...>());
 
   //! Destructor to release allocated memory.
   ~WeightNorm();
@@ -135,7 +136,10 @@ class WeightNorm
   OutputDataType& Parameters() { return weights; }
 
   //! Get the wrapped layer.
-  LayerTypes<CustomLayers...> const& Layer() { return wrappedLayer; }
+  BasicLayerTypes<OutputDataType, CustomLayers...> const& Layer()
+  {
+    return wrappedLayer;
+  }
 
   /**
    * Serialize the layer.
@@ -144,6 +148,16 @@ class WeightNorm
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by this module work on layers with OutputDataType.
+  typedef BasicForwardVisitor<OutputDataType> ForwardVisitor;
+  typedef BasicBackwardVisitor<OutputDataType> BackwardVisitor;
+  typedef BasicGradientVisitor<OutputDataType> GradientVisitor;
+  typedef BasicDeltaVisitor<OutputDataType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<OutputDataType> OutputParameterVisitor;
+  typedef BasicWeightSetVisitor<OutputDataType> WeightSetVisitor;
+  typedef BasicBiasSetVisitor<OutputDataType> BiasSetVisitor;
+  typedef BasicGradientSetVisitor<OutputDataType> GradientSetVisitor;
+
   //! Locally-stored number of bias elements in the weights of wrapped layer.
   size_t biasWeightSize;
 
@@ -160,7 +174,7 @@ class WeightNorm
   OutputDataType gradient;
 
   //! Locally-stored wrapped layer.
-  LayerTypes<CustomLayers...> wrappedLayer;
+  BasicLayerTypes<OutputDataType, CustomLayers...> wrappedLayer;
 
   //! Locally stored number of elements in the weights of wrapped layer.
   size_t layerWeightSize;
@@ -172,7 +186,7 @@ class WeightNorm
   OutputParameterVisitor outputParameterVisitor;
 
   //! Reset the gradient for all modules that implement the Gradient function.
-  void ResetGradients(arma::mat& gradient);
+  void ResetGradients(OutputDataType& gradient);
 
   //! Locally-stored reset visitor.
   ResetVisitor resetVisitor;
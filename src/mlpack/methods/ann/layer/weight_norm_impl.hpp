@@ -27,7 +27,7 @@ namespace ann { /** Artificial Neural Network. */
 template<typename InputDataType, typename OutputDataType,
          typename... CustomLayers>
 WeightNorm<InputDataType, OutputDataType, CustomLayers...>::WeightNorm(
-    LayerTypes<CustomLayers...> layer) :
+    BasicLayerTypes<OutputDataType, CustomLayers...> layer) :
     wrappedLayer(layer)
 {
   layerWeightSize = boost::apply_visitor(weightSizeVisitor, wrappedLayer);
@@ -57,11 +57,11 @@ void WeightNorm<InputDataType, OutputDataType, CustomLayers...>::Reset()
   biasWeightSize = boost::apply_visitor(BiasSetVisitor(weights, 0),
       wrappedLayer);
 
-  vectorParameter = arma::mat(weights.memptr() + biasWeightSize,
+  vectorParameter = OutputDataType(weights.memptr() + biasWeightSize,
       layerWeightSize - biasWeightSize, 1, false, false);
 
-  scalarParameter = arma::mat(weights.memptr() + layerWeightSize, 1, 1, false,
-      false);
+  scalarParameter = OutputDataType(weights.memptr() + layerWeightSize, 1, 1,
+      false, false);
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -114,8 +114,9 @@ void WeightNorm<InputDataType, OutputDataType, CustomLayers...>::Gradient(
   // Set the gradients of the bias terms.
   if (biasWeightSize != 0)
   {
-    gradient.rows(0, biasWeightSize - 1) = arma::mat(layerGradients.memptr() +
-        layerWeightSize - biasWeightSize, biasWeightSize, 1, false, false);
+    gradient.rows(0, biasWeightSize - 1) = arma::Mat<eT>(
+        layerGradients.memptr() + layerWeightSize - biasWeightSize,
+        biasWeightSize, 1, false, false);
   }
 
   // Calculate the gradients of the scalar parameter.
@@ -133,7 +134,7 @@ void WeightNorm<InputDataType, OutputDataType, CustomLayers...>::Gradient(
 template<typename InputDataType, typename OutputDataType,
          typename... CustomLayers>
 void WeightNorm<InputDataType, OutputDataType, CustomLayers...>::ResetGradients(
-    arma::mat& gradient)
+    OutputDataType& gradient)
 {
   boost::apply_visitor(GradientSetVisitor(gradient, 0), wrappedLayer);
 }
@@ -418,7 +418,8 @@ class LayerNameVisitor : public boost::static_visitor<std::string>
   }
 
   //! Overload function call.
-  std::string operator()(MoreTypes layer) const
+  template<typename MatType>
+  std::string operator()(BasicMoreTypes<MatType> layer) const
   {
     return layer.apply_visitor(*this);
   }
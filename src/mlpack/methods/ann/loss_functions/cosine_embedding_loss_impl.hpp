@@ -40,8 +40,8 @@ CosineEmbeddingLoss<InputDataType, OutputDataType>::Forward(
   if (arma::size(input) != arma::size(target))
     Log::Fatal << "Input Tensors must have same dimensions." << std::endl;
 
-  arma::colvec inputTemp1 = arma::vectorise(input);
-  arma::colvec inputTemp2 = arma::vectorise(target);
+  arma::Col<ElemType> inputTemp1 = arma::vectorise(input);
+  arma::Col<ElemType> inputTemp2 = arma::vectorise(target);
   ElemType loss = 0.0;
 
   for (size_t i = 0; i < inputTemp1.n_elem; i += cols)
@@ -77,11 +77,11 @@ void CosineEmbeddingLoss<InputDataType, OutputDataType>::Backward(
   if (arma::size(input) != arma::size(target))
     Log::Fatal << "Input Tensors must have same dimensions." << std::endl;
 
-  arma::colvec inputTemp1 = arma::vectorise(input);
-  arma::colvec inputTemp2 = arma::vectorise(target);
+  arma::Col<ElemType> inputTemp1 = arma::vectorise(input);
+  arma::Col<ElemType> inputTemp2 = arma::vectorise(target);
   output.set_size(arma::size(inputTemp1));
 
-  arma::colvec outputTemp(output.memptr(), inputTemp1.n_elem,
+  arma::Col<ElemType> outputTemp(output.memptr(), inputTemp1.n_elem,
       false, false);
   for (size_t i = 0; i < inputTemp1.n_elem; i += cols)
   {
@@ -35,7 +35,7 @@ MarginRankingLoss<InputDataType, OutputDataType>::Forward(
   const int inputRows = input.n_rows;
   const InputType& input1 = input.rows(0, inputRows / 2 - 1);
   const InputType& input2 = input.rows(inputRows / 2, inputRows - 1);
-  return arma::accu(arma::max(arma::zeros(size(target)),
+  return arma::accu(arma::max(arma::zeros<InputType>(size(target)),
       -target % (input1 - input2) + margin)) / target.n_cols;
 }
 
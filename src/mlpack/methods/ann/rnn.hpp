@@ -14,10 +14,17 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "visitor/backward_visitor.hpp"
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
+#include "visitor/forward_visitor.hpp"
+#include "visitor/gradient_set_visitor.hpp"
+#include "visitor/gradient_visitor.hpp"
+#include "visitor/load_output_parameter_visitor.hpp"
 #include "visitor/output_parameter_visitor.hpp"
 #include "visitor/reset_visitor.hpp"
+#include "visitor/save_output_parameter_visitor.hpp"
+#include "visitor/weight_set_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
 
@@ -50,6 +57,13 @@ class RNN
                           InitializationRuleType,
                           CustomLayers...>;
 
+  //! The type of the matrices the network works with, given by the output
+  //! layer (arma::mat by default).
+  typedef typename NetworkMatType<OutputLayerType>::type MatType;
+
+  //! The type of the sequences of the network.
+  typedef arma::Cube<typename MatType::elem_type> CubeType;
+
   /**
    * Create the RNN object.
    *
@@ -130,8 +144,8 @@ class RNN
    * @return The final objective of the trained model (NaN or Inf on error).
    */
   template<typename OptimizerType, typename... CallbackTypes>
-  double Train(arma::cube predictors,
-               arma::cube responses,
+  double Train(CubeType predictors,
+               CubeType responses,
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
@@ -163,8 +177,45 @@ class RNN
    * @return The final objective of the trained model (NaN or Inf on error).
    */
   template<typename OptimizerType = ens::StandardSGD, typename... CallbackTypes>
-  double Train(arma::cube predictors,
-               arma::cube responses,
+  double Train(CubeType predictors,
+               CubeType responses,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the recurrent neural network on a set of variable-length sequences
+   * using the given optimizer.  The sequences are stored padded to a common
+   * length in the predictors and responses cubes (in the same format as the
+   * other Train() overloads), and sequenceLengths(i) holds the number of
+   * valid time steps of the i'th sequence.  If the network was created with
+   * single = true, responses.slice(0) should hold the target of each
+   * sequence at its last valid time step.
+   *
+   * The sequences are bucketed by length (sorted, with ties shuffled every
+   * epoch) so that each batch holds sequences of similar length.  Each batch
+   * is then only unrolled up to the length of its longest sequence, and the
+   * loss and the error of the time steps past the end of a shorter sequence
+   * are masked out, so the padding never reaches the objective or the
+   * gradient.  Note that the padded responses are never read, so they can
+   * hold arbitrary values.
+   *
+   * Recurrent cells have to implement ResetCell() (as LSTM, FastLSTM and GRU
+   * do) to be reset to the per-batch number of steps.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Number of valid time steps of each sequence.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(CubeType predictors,
+               CubeType responses,
+               arma::urowvec sequenceLengths,
+               OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
   /**
@@ -186,8 +237,26 @@ class RNN
    * @param results Matrix to put output predictions of responses into.
    * @param batchSize Number of points to predict at once.
    */
-  void Predict(arma::cube predictors,
-               arma::cube& results,
+  void Predict(CubeType predictors,
+               CubeType& results,
+               const size_t batchSize = 256);
+
+  /**
+   * Predict the responses to a given set of variable-length sequences.  The
+   * predictors are padded to a common length as in Predict() above, and
+   * sequenceLengths(i) holds the number of valid time steps of the i'th
+   * sequence.  The sequences are processed in batches of similar length and
+   * every batch stops at the length of its longest sequence; the results of
+   * the time steps past the end of a sequence are set to zero.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param sequenceLengths Number of valid time steps of each sequence.
+   * @param batchSize Number of points to predict at once.
+   */
+  void Predict(CubeType predictors,
+               CubeType& results,
+               const arma::urowvec& sequenceLengths,
                const size_t batchSize = 256);
 
   /**
@@ -202,7 +271,7 @@ class RNN
    * @param deterministic Whether or not to train or test the model. Note some
    *        layer act differently in training or testing mode.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const MatType& parameters,
                   const size_t begin,
                   const size_t batchSize,
                   const bool deterministic);
@@ -218,7 +287,7 @@ class RNN
    * @param batchSize Number of points to be passed at a time to use for
    *        objective function evaluation.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const MatType& parameters,
                   const size_t begin,
                   const size_t batchSize);
 
@@ -234,7 +303,7 @@ class RNN
    *        objective function evaluation.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const MatType& parameters,
                               const size_t begin,
                               GradType& gradient,
                               const size_t batchSize);
@@ -252,9 +321,9 @@ class RNN
    * @param batchSize Number of points to be processed as a batch for objective
    *        function gradient evaluation.
    */
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const MatType& parameters,
                 const size_t begin,
-                arma::mat& gradient,
+                MatType& gradient,
                 const size_t batchSize);
 
   /**
@@ -276,15 +345,18 @@ class RNN
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(BasicLayerTypes<MatType, CustomLayers...> layer)
+  {
+    network.push_back(layer);
+  }
 
   //! Return the number of separable functions (the number of predictor points).
   size_t NumFunctions() const { return numFunctions; }
 
   //! Return the initial point for the optimization.
-  const arma::mat& Parameters() const { return parameter; }
+  const MatType& Parameters() const { return parameter; }
   //! Modify the initial point for the optimization.
-  arma::mat& Parameters() { return parameter; }
+  MatType& Parameters() { return parameter; }
 
   //! Return the maximum length of backpropagation through time.
   const size_t& Rho() const { return rho; }
@@ -292,14 +364,21 @@ class RNN
   size_t& Rho() { return rho; }
 
   //! Get the matrix of responses to the input data points.
-  const arma::cube& Responses() const { return responses; }
+  const CubeType& Responses() const { return responses; }
   //! Modify the matrix of responses to the input data points.
-  arma::cube& Responses() { return responses; }
+  CubeType& Responses() { return responses; }
 
   //! Get the matrix of data points (predictors).
-  const arma::cube& Predictors() const { return predictors; }
+  const CubeType& Predictors() const { return predictors; }
   //! Modify the matrix of data points (predictors).
-  arma::cube& Predictors() { return predictors; }
+  CubeType& Predictors() { return predictors; }
+
+  //! Get the number of valid time steps of each training sequence (empty if
+  //! all sequences span every time step).
+  const arma::urowvec& SequenceLengths() const { return sequenceLengths; }
+  //! Modify the number of valid time steps of each training sequence.  The
+  //! sequences have to be sorted by ascending length.
+  arma::urowvec& SequenceLengths() { return sequenceLengths; }
 
   /**
    * Reset the state of the network.  This ensures that all internally-held
@@ -318,6 +397,17 @@ class RNN
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  //! The visitors used by the network work on layers with MatType.
+  typedef BasicForwardVisitor<MatType> ForwardVisitor;
+  typedef BasicBackwardVisitor<MatType> BackwardVisitor;
+  typedef BasicGradientVisitor<MatType> GradientVisitor;
+  typedef BasicDeltaVisitor<MatType> DeltaVisitor;
+  typedef BasicOutputParameterVisitor<MatType> OutputParameterVisitor;
+  typedef BasicGradientSetVisitor<MatType> GradientSetVisitor;
+  typedef BasicWeightSetVisitor<MatType> WeightSetVisitor;
+  typedef BasicSaveOutputParameterVisitor<MatType> SaveOutputParameterVisitor;
+  typedef BasicLoadOutputParameterVisitor<MatType> LoadOutputParameterVisitor;
+
   // Helper functions.
   /**
    * The Forward algorithm (part of the Forward-Backward algorithm).  Computes
@@ -333,6 +423,79 @@ class RNN
    */
   void ResetCells();
 
+  /**
+   * Reset the state of RNN cells in the network for a new input sequence of
+   * the given number of steps.
+   *
+   * @param steps Number of steps of the next input sequence.
+   */
+  void ResetCells(const size_t steps);
+
+  /**
+   * Reorder the training sequences by ascending length, so that every batch
+   * holds sequences of similar length.  Sequences of the same length are
+   * optionally shuffled.
+   *
+   * @param shuffle Whether to shuffle sequences of the same length.
+   */
+  void SortByLength(const bool shuffle);
+
+  /**
+   * Return the number of time steps the batch starting at the given point has
+   * to be unrolled for; that is the length of its longest sequence, capped by
+   * the given maximum.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param maxSteps Maximum number of steps.
+   */
+  size_t BatchSteps(const size_t begin,
+                    const size_t batchSize,
+                    const size_t maxSteps) const;
+
+  /**
+   * Find the (contiguous) range of columns of the batch starting at the given
+   * point whose loss is taken into account at the given time step.  These are
+   * the sequences that did not end yet, or, if only the last element of each
+   * sequence is predicted, the sequences that end at the given step.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param step Current time step.
+   * @param first Index of the first active column of the batch.
+   * @param last One past the index of the last active column of the batch.
+   */
+  void ActiveColumns(const size_t begin,
+                     const size_t batchSize,
+                     const size_t step,
+                     size_t& first,
+                     size_t& last) const;
+
+  /**
+   * Compute the masked loss of the current network output at the given time
+   * step of the batch starting at the given point.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param step Current time step.
+   */
+  double MaskedLoss(const size_t begin,
+                    const size_t batchSize,
+                    const size_t step);
+
+  /**
+   * Compute the masked error of the current network output at the given time
+   * step of the batch starting at the given point; the error of the inactive
+   * columns is set to zero.
+   *
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param step Current time step.
+   */
+  void MaskedError(const size_t begin,
+                   const size_t batchSize,
+                   const size_t step);
+
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
    * backward pass for module.
@@ -355,7 +518,7 @@ class RNN
   /**
    * Reset the gradient for all modules that implement the Gradient function.
    */
-  void ResetGradients(arma::mat& gradient);
+  void ResetGradients(MatType& gradient);
 
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
@@ -383,22 +546,26 @@ class RNN
   bool single;
 
   //! Locally-stored model modules.
-  std::vector<LayerTypes<CustomLayers...> > network;
+  std::vector<BasicLayerTypes<MatType, CustomLayers...> > network;
 
   //! The matrix of data points (predictors).
-  arma::cube predictors;
+  CubeType predictors;
 
   //! The matrix of responses to the input data points.
-  arma::cube responses;
+  CubeType responses;
+
+  //! The number of valid time steps of each training sequence (empty if all
+  //! sequences span every time step).
+  arma::urowvec sequenceLengths;
 
   //! Matrix of (trained) parameters.
-  arma::mat parameter;
+  MatType parameter;
 
   //! The number of separable functions (the number of predictor points).
   size_t numFunctions;
 
   //! The current error for the backward pass.
-  arma::mat error;
+  MatType error;
 
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
@@ -407,7 +574,7 @@ class RNN
   OutputParameterVisitor outputParameterVisitor;
 
   //! List of all module parameters for the backward pass (BBTT).
-  std::vector<arma::mat> moduleOutputParameter;
+  std::vector<MatType> moduleOutputParameter;
 
   //! Locally-stored weight size visitor.
   WeightSizeVisitor weightSizeVisitor;
@@ -422,7 +589,7 @@ class RNN
   bool deterministic;
 
   //! The current gradient for the gradient pass.
-  arma::mat currentGradient;
+  MatType currentGradient;
 
   // The BRN class should have access to internal members.
   template<
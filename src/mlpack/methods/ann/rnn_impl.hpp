@@ -15,15 +15,8 @@
 // In case it hasn't been included yet.
 #include "rnn.hpp"
 
-#include "visitor/load_output_parameter_visitor.hpp"
-#include "visitor/save_output_parameter_visitor.hpp"
-#include "visitor/forward_visitor.hpp"
-#include "visitor/backward_visitor.hpp"
 #include "visitor/reset_cell_visitor.hpp"
 #include "visitor/deterministic_set_visitor.hpp"
-#include "visitor/gradient_set_visitor.hpp"
-#include "visitor/gradient_visitor.hpp"
-#include "visitor/weight_set_visitor.hpp"
 
 #include <boost/serialization/variant.hpp>
 
@@ -55,7 +48,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::~RNN()
 {
-  for (LayerTypes<CustomLayers...>& layer : network)
+  for (BasicLayerTypes<MatType, CustomLayers...>& layer : network)
   {
     boost::apply_visitor(deleteVisitor, layer);
   }
@@ -100,8 +93,8 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
-    arma::cube predictors,
-    arma::cube responses,
+    CubeType predictors,
+    CubeType responses,
     OptimizerType& optimizer,
     CallbackTypes&&... callbacks)
 {
@@ -109,6 +102,65 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.reset();
+
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+  {
+    ResetParameters();
+  }
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+
+  // Train the model.
+  Timer::Start("rnn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("rnn_optimization");
+
+  Log::Info << "RNN::RNN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    CubeType predictors,
+    CubeType responses,
+    arma::urowvec sequenceLengths,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "RNN::Train(): number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match the number of "
+        << "sequences (" << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (!sequenceLengths.is_empty() && (sequenceLengths.min() == 0 ||
+      sequenceLengths.max() > predictors.n_slices))
+  {
+    std::ostringstream oss;
+    oss << "RNN::Train(): sequence lengths must be between 1 and the number "
+        << "of time steps (" << predictors.n_slices << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  numFunctions = responses.n_cols;
+
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->sequenceLengths = std::move(sequenceLengths);
+
+  // Bucket the sequences by length, so that the batches seen by the optimizer
+  // hold sequences of similar length.
+  SortByLength(false);
 
   this->deterministic = true;
   ResetDeterministic();
@@ -134,10 +186,18 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::ResetCells()
+{
+  ResetCells(rho);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetCells(const size_t steps)
 {
   for (size_t i = 1; i < network.size(); ++i)
   {
-    boost::apply_visitor(ResetCellVisitor(rho), network[i]);
+    boost::apply_visitor(ResetCellVisitor(steps), network[i]);
   }
 }
 
@@ -145,14 +205,15 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
-    arma::cube predictors,
-    arma::cube responses,
+    CubeType predictors,
+    CubeType responses,
     CallbackTypes&&... callbacks)
 {
   numFunctions = responses.n_cols;
 
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.reset();
 
   this->deterministic = true;
   ResetDeterministic();
@@ -179,7 +240,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
-    arma::cube predictors, arma::cube& results, const size_t batchSize)
+    CubeType predictors, CubeType& results, const size_t batchSize)
 {
   ResetCells();
 
@@ -197,13 +258,13 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   const size_t effectiveBatchSize = std::min(batchSize,
       size_t(predictors.n_cols));
 
-  Forward(arma::mat(predictors.slice(0).colptr(0), predictors.n_rows,
+  Forward(MatType(predictors.slice(0).colptr(0), predictors.n_rows,
       effectiveBatchSize, false, true));
-  arma::mat resultsTemp = boost::apply_visitor(outputParameterVisitor,
+  MatType resultsTemp = boost::apply_visitor(outputParameterVisitor,
       network.back());
 
   outputSize = resultsTemp.n_rows;
-  results = arma::zeros<arma::cube>(outputSize, predictors.n_cols, rho);
+  results = arma::zeros<CubeType>(outputSize, predictors.n_cols, rho);
   results.slice(0).submat(0, 0, results.n_rows - 1,
       effectiveBatchSize - 1) = resultsTemp;
 
@@ -214,7 +275,7 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
         size_t(predictors.n_cols - begin));
     for (size_t seqNum = !begin; seqNum < rho; ++seqNum)
     {
-      Forward(arma::mat(predictors.slice(seqNum).colptr(begin),
+      Forward(MatType(predictors.slice(seqNum).colptr(begin),
           predictors.n_rows, effectiveBatchSize, false, true));
 
       results.slice(seqNum).submat(0, begin, results.n_rows - 1, begin +
@@ -224,10 +285,77 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
+    CubeType predictors,
+    CubeType& results,
+    const arma::urowvec& sequenceLengths,
+    const size_t batchSize)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "RNN::Predict(): number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match the number of "
+        << "sequences (" << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (parameter.is_empty())
+  {
+    ResetParameters();
+  }
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // Visit the sequences by ascending length, so that every batch holds
+  // sequences of similar length and stops at its longest sequence.
+  const arma::uvec order = arma::stable_sort_index(sequenceLengths);
+
+  results.reset();
+  MatType stepData;
+  for (size_t begin = 0; begin < predictors.n_cols; begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols - begin));
+    const arma::uvec batch = order.subvec(begin,
+        begin + effectiveBatchSize - 1);
+    const arma::uvec batchLengths = sequenceLengths.elem(batch);
+    const size_t steps = std::min(rho, std::min(size_t(predictors.n_slices),
+        size_t(arma::max(batchLengths))));
+
+    ResetCells(steps);
+    for (size_t seqNum = 0; seqNum < steps; ++seqNum)
+    {
+      stepData = predictors.slice(seqNum).cols(batch);
+      Forward(stepData);
+
+      const MatType& output = boost::apply_visitor(outputParameterVisitor,
+          network.back());
+      if (results.is_empty())
+      {
+        outputSize = output.n_rows;
+        results = arma::zeros<CubeType>(outputSize, predictors.n_cols, rho);
+      }
+
+      for (size_t i = 0; i < effectiveBatchSize; ++i)
+      {
+        if (seqNum < sequenceLengths[batch[i]])
+          results.slice(seqNum).col(batch[i]) = output.col(i);
+      }
+    }
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
-    const arma::mat& /* parameters */,
+    const MatType& /* parameters */,
     const size_t begin,
     const size_t batchSize,
     const bool deterministic)
@@ -253,17 +381,27 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     targetSize = responses.n_rows;
   }
 
-  ResetCells();
+  // Variable-length batches are only unrolled up to their longest sequence.
+  const bool masked = !sequenceLengths.is_empty();
+  const size_t steps = masked ? BatchSteps(begin, batchSize, rho) : rho;
+  ResetCells(steps);
 
   double performance = 0;
   size_t responseSeq = 0;
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < steps; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
+    MatType stepData(predictors.slice(seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true);
     Forward(stepData);
+
+    if (masked)
+    {
+      performance += MaskedLoss(begin, batchSize, seqNum);
+      continue;
+    }
+
     if (!single)
     {
       responseSeq = seqNum;
@@ -271,7 +409,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 
     performance += outputLayer.Forward(boost::apply_visitor(
         outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
+        MatType(responses.slice(responseSeq).colptr(begin),
             responses.n_rows, batchSize, false, true));
   }
 
@@ -287,7 +425,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
-    const arma::mat& parameters,
+    const MatType& parameters,
     const size_t begin,
     const size_t batchSize)
 {
@@ -298,7 +436,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename GradType>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
-EvaluateWithGradient(const arma::mat& /* parameters */,
+EvaluateWithGradient(const MatType& /* parameters */,
                      const size_t begin,
                      GradType& gradient,
                      const size_t batchSize)
@@ -311,7 +449,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       ResetParameters();
     }
 
-    gradient = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
+    gradient = arma::zeros<MatType>(parameter.n_rows, parameter.n_cols);
   }
   else
   {
@@ -334,16 +472,19 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     targetSize = responses.n_rows;
   }
 
-  ResetCells();
+  // Variable-length batches are only unrolled up to their longest sequence.
+  const bool masked = !sequenceLengths.is_empty();
+  const size_t effectiveRho = masked ? BatchSteps(begin, batchSize, rho) :
+      std::min(rho, size_t(responses.size()));
+  ResetCells(masked ? effectiveRho : rho);
 
   double performance = 0;
   size_t responseSeq = 0;
-  const size_t effectiveRho = std::min(rho, size_t(responses.size()));
 
   for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
+    MatType stepData(predictors.slice(seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true);
     Forward(stepData);
     if (!single)
@@ -357,9 +498,15 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           network[l]);
     }
 
+    if (masked)
+    {
+      performance += MaskedLoss(begin, batchSize, seqNum);
+      continue;
+    }
+
     performance += outputLayer.Forward(boost::apply_visitor(
         outputParameterVisitor, network.back()),
-        arma::mat(responses.slice(responseSeq).colptr(begin),
+        MatType(responses.slice(responseSeq).colptr(begin),
             responses.n_rows, batchSize, false, true));
   }
 
@@ -372,7 +519,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   // Initialize current/working gradient.
   if (currentGradient.is_empty())
   {
-    currentGradient = arma::zeros<arma::mat>(parameter.n_rows,
+    currentGradient = arma::zeros<MatType>(parameter.n_rows,
         parameter.n_cols);
   }
 
@@ -387,7 +534,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
           network[network.size() - 1 - l]);
     }
 
-    if (single && seqNum > 0)
+    if (masked)
+    {
+      MaskedError(begin, batchSize, effectiveRho - seqNum - 1);
+    }
+    else if (single && seqNum > 0)
     {
       error.zeros();
     }
@@ -395,33 +546,37 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(0).colptr(begin),
+          MatType(responses.slice(0).colptr(begin),
           responses.n_rows, batchSize, false, true), error);
     }
     else
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(effectiveRho - seqNum - 1).colptr(begin),
+          MatType(responses.slice(effectiveRho - seqNum - 1).colptr(begin),
           responses.n_rows, batchSize, false, true), error);
     }
 
     Backward();
     Gradient(
-        arma::mat(predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
+        MatType(predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     gradient += currentGradient;
   }
 
+  // One call is one iteration of the optimizer.
+  Counter::Add("rnn_points", batchSize);
+  Counter::Record("rnn_objective", performance);
+
   return performance;
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
-    const arma::mat& parameters,
+    const MatType& parameters,
     const size_t begin,
-    arma::mat& gradient,
+    MatType& gradient,
     const size_t batchSize)
 {
   this->EvaluateWithGradient(parameters, begin, gradient, batchSize);
@@ -431,13 +586,143 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  arma::cube newPredictors, newResponses;
+  // Keep variable-length sequences bucketed by length; only the order of the
+  // sequences of the same length is shuffled.
+  if (!sequenceLengths.is_empty())
+  {
+    SortByLength(true);
+    return;
+  }
+
+  CubeType newPredictors, newResponses;
   math::ShuffleData(predictors, responses, newPredictors, newResponses);
 
   predictors = std::move(newPredictors);
   responses = std::move(newResponses);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::SortByLength(const bool shuffle)
+{
+  arma::uvec order;
+  if (shuffle)
+  {
+    // The stable sort keeps the shuffled order of sequences of the same
+    // length.
+    const arma::uvec permutation = arma::shuffle(arma::linspace<arma::uvec>(0,
+        sequenceLengths.n_elem - 1, sequenceLengths.n_elem));
+    const arma::urowvec shuffledLengths = sequenceLengths.cols(permutation);
+    order = permutation(arma::stable_sort_index(shuffledLengths));
+  }
+  else
+  {
+    order = arma::stable_sort_index(sequenceLengths);
+  }
+
+  CubeType newPredictors(predictors.n_rows, predictors.n_cols,
+      predictors.n_slices);
+  for (size_t i = 0; i < predictors.n_slices; ++i)
+    newPredictors.slice(i) = predictors.slice(i).cols(order);
+
+  CubeType newResponses(responses.n_rows, responses.n_cols,
+      responses.n_slices);
+  for (size_t i = 0; i < responses.n_slices; ++i)
+    newResponses.slice(i) = responses.slice(i).cols(order);
+
+  arma::urowvec newSequenceLengths = sequenceLengths.cols(order);
+
+  predictors = std::move(newPredictors);
+  responses = std::move(newResponses);
+  sequenceLengths = std::move(newSequenceLengths);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::BatchSteps(const size_t begin,
+                                        const size_t batchSize,
+                                        const size_t maxSteps) const
+{
+  return std::min(maxSteps, size_t(arma::max(
+      sequenceLengths.subvec(begin, begin + batchSize - 1))));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ActiveColumns(const size_t begin,
+                                         const size_t batchSize,
+                                         const size_t step,
+                                         size_t& first,
+                                         size_t& last) const
+{
+  // The sequences are sorted by ascending length, so the sequences that are
+  // still running (or that end at the given step) are a contiguous block.
+  const arma::uword* lengths = sequenceLengths.memptr() + begin;
+  first = std::upper_bound(lengths, lengths + batchSize,
+      arma::uword(step)) - lengths;
+
+  if (single)
+  {
+    last = std::upper_bound(lengths + first, lengths + batchSize,
+        arma::uword(step + 1)) - lengths;
+  }
+  else
+  {
+    last = batchSize;
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+double RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::MaskedLoss(const size_t begin,
+                                        const size_t batchSize,
+                                        const size_t step)
+{
+  size_t first, last;
+  ActiveColumns(begin, batchSize, step, first, last);
+  if (first == last)
+    return 0;
+
+  MatType& output = boost::apply_visitor(outputParameterVisitor,
+      network.back());
+  const size_t responseSeq = single ? 0 : step;
+
+  // Wrap matrices around the active columns to avoid a copy.
+  return outputLayer.Forward(MatType(output.colptr(first), output.n_rows,
+      last - first, false, true), MatType(responses.slice(
+      responseSeq).colptr(begin + first), responses.n_rows, last - first,
+      false, true));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::MaskedError(const size_t begin,
+                                       const size_t batchSize,
+                                       const size_t step)
+{
+  MatType& output = boost::apply_visitor(outputParameterVisitor,
+      network.back());
+  error.zeros(output.n_rows, output.n_cols);
+
+  size_t first, last;
+  ActiveColumns(begin, batchSize, step, first, last);
+  if (first == last)
+    return;
+
+  const size_t responseSeq = single ? 0 : step;
+  MatType activeError;
+  outputLayer.Backward(MatType(output.colptr(first), output.n_rows,
+      last - first, false, true), MatType(responses.slice(
+      responseSeq).colptr(begin + first), responses.n_rows, last - first,
+      false, true), activeError);
+  error.cols(first, last - 1) = activeError;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType,
@@ -477,10 +762,10 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::ResetGradients(
-    arma::mat& gradient)
+    MatType& gradient)
 {
   size_t offset = 0;
-  for (LayerTypes<CustomLayers...>& layer : network)
+  for (BasicLayerTypes<MatType, CustomLayers...>& layer : network)
   {
     offset += boost::apply_visitor(GradientSetVisitor(gradient, offset), layer);
   }
@@ -580,7 +865,7 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
       reset = false;
 
     size_t offset = 0;
-    for (LayerTypes<CustomLayers...>& layer : network)
+    for (BasicLayerTypes<MatType, CustomLayers...>& layer : network)
     {
       offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
           layer);
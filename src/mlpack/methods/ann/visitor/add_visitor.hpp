@@ -23,38 +23,48 @@ namespace ann {
 
 /**
  * AddVisitor exposes the Add() method of the given module.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
+ * @tparam CustomLayers Any set of custom layers that could be a part of the
+ *         network.
  */
-template <typename... CustomLayers>
-class AddVisitor : public boost::static_visitor<void>
+template<typename MatType, typename... CustomLayers>
+class BasicAddVisitor : public boost::static_visitor<void>
 {
  public:
   //! Exposes the Add() method of the given module.
   template<typename T>
-  AddVisitor(T newLayer);
+  BasicAddVisitor(T newLayer);
 
   //! Exposes the Add() method.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The layer that should be added.
-  LayerTypes<CustomLayers...> newLayer;
+  BasicLayerTypes<MatType, CustomLayers...> newLayer;
 
   //! Only add the layer if the module implements the Add() function.
   template<typename T>
   typename std::enable_if<
-      HasAddCheck<T, void(T::*)(LayerTypes<CustomLayers...>)>::value, void>::type
+      HasAddCheck<T, void(T::*)(
+          BasicLayerTypes<MatType, CustomLayers...>)>::value, void>::type
   LayerAdd(T* layer) const;
 
   //! Do not add the layer if the module doesn't implement the Add() function.
   template<typename T>
   typename std::enable_if<
-      !HasAddCheck<T, void(T::*)(LayerTypes<CustomLayers...>)>::value, void>::type
+      !HasAddCheck<T, void(T::*)(
+          BasicLayerTypes<MatType, CustomLayers...>)>::value, void>::type
   LayerAdd(T* layer) const;
 };
 
+//! AddVisitor for layers working with arma::mat.
+template<typename... CustomLayers>
+using AddVisitor = BasicAddVisitor<arma::mat, CustomLayers...>;
+
 } // namespace ann
 } // namespace mlpack
 
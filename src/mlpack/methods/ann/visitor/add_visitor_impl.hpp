@@ -19,41 +19,46 @@ namespace mlpack {
 namespace ann {
 
 //! AddVisitor visitor class.
-template<typename... CustomLayers>
+template<typename MatType, typename... CustomLayers>
 template<typename T>
-inline AddVisitor<CustomLayers...>::AddVisitor(T newLayer) :
+inline BasicAddVisitor<MatType, CustomLayers...>::BasicAddVisitor(
+    T newLayer) :
     newLayer(std::move(newLayer))
 {
   /* Nothing to do here. */
 }
 
-template<typename... CustomLayers>
+template<typename MatType, typename... CustomLayers>
 template<typename LayerType>
-inline void AddVisitor<CustomLayers...>::operator()(LayerType* layer) const
+inline void BasicAddVisitor<MatType, CustomLayers...>::operator()(
+    LayerType* layer) const
 {
   LayerAdd<LayerType>(layer);
 }
 
-template<typename... CustomLayers>
-inline void AddVisitor<CustomLayers...>::operator()(MoreTypes layer) const
+template<typename MatType, typename... CustomLayers>
+inline void BasicAddVisitor<MatType, CustomLayers...>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
-template<typename... CustomLayers>
+template<typename MatType, typename... CustomLayers>
 template<typename T>
 inline typename std::enable_if<
-    HasAddCheck<T, void(T::*)(LayerTypes<CustomLayers...>)>::value, void>::type
-AddVisitor<CustomLayers...>::LayerAdd(T* layer) const
+    HasAddCheck<T, void(T::*)(
+        BasicLayerTypes<MatType, CustomLayers...>)>::value, void>::type
+BasicAddVisitor<MatType, CustomLayers...>::LayerAdd(T* layer) const
 {
   layer->Add(newLayer);
 }
 
-template<typename... CustomLayers>
+template<typename MatType, typename... CustomLayers>
 template<typename T>
 inline typename std::enable_if<
-    !HasAddCheck<T, void(T::*)(LayerTypes<CustomLayers...>)>::value, void>::type
-AddVisitor<CustomLayers...>::LayerAdd(T* /* layer */) const
+    !HasAddCheck<T, void(T::*)(
+        BasicLayerTypes<MatType, CustomLayers...>)>::value, void>::type
+BasicAddVisitor<MatType, CustomLayers...>::LayerAdd(T* /* layer */) const
 {
   /* Nothing to do here. */
 }
@@ -24,37 +24,40 @@ namespace ann {
 /**
  * BackwardVisitor executes the Backward() function given the input, error and
  * delta parameter.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class BackwardVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicBackwardVisitor : public boost::static_visitor<void>
 {
  public:
   //! Execute the Backward() function given the input, error and delta
   //! parameter.
-  BackwardVisitor(const arma::mat& input,
-                  const arma::mat& error,
-                  arma::mat& delta);
+  BasicBackwardVisitor(const MatType& input,
+                       const MatType& error,
+                       MatType& delta);
 
   //! Execute the Backward() function for the layer with the specified index.
-  BackwardVisitor(const arma::mat& input,
-                  const arma::mat& error,
-                  arma::mat& delta,
-                  const size_t index);
+  BasicBackwardVisitor(const MatType& input,
+                       const MatType& error,
+                       MatType& delta,
+                       const size_t index);
 
   //! Execute the Backward() function.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The input parameter set.
-  const arma::mat& input;
+  const MatType& input;
 
   //! The error parameter.
-  const arma::mat& error;
+  const MatType& error;
 
   //! The delta parameter.
-  arma::mat& delta;
+  MatType& delta;
 
   //! The index of the layer to run.
   size_t index;
@@ -67,15 +70,18 @@ class BackwardVisitor : public boost::static_visitor<void>
   template<typename T>
   typename std::enable_if<
       !HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-  LayerBackward(T* layer, arma::mat& input) const;
+  LayerBackward(T* layer, MatType& input) const;
 
   //! Execute the Backward() function if the module is has Run() function.
   template<typename T>
   typename std::enable_if<
       HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-  LayerBackward(T* layer, arma::mat& input) const;
+  LayerBackward(T* layer, MatType& input) const;
 };
 
+//! BackwardVisitor for layers working with arma::mat.
+typedef BasicBackwardVisitor<arma::mat> BackwardVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
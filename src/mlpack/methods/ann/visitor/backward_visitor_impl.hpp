@@ -19,9 +19,11 @@ namespace mlpack {
 namespace ann {
 
 //! BackwardVisitor visitor class.
-inline BackwardVisitor::BackwardVisitor(const arma::mat& input,
-                                        const arma::mat& error,
-                                        arma::mat& delta) :
+template<typename MatType>
+inline BasicBackwardVisitor<MatType>::BasicBackwardVisitor(
+    const MatType& input,
+    const MatType& error,
+    MatType& delta) :
   input(input),
   error(error),
   delta(delta),
@@ -31,10 +33,12 @@ inline BackwardVisitor::BackwardVisitor(const arma::mat& input,
   /* Nothing to do here. */
 }
 
-inline BackwardVisitor::BackwardVisitor(const arma::mat& input,
-                                        const arma::mat& error,
-                                        arma::mat& delta,
-                                        const size_t index) :
+template<typename MatType>
+inline BasicBackwardVisitor<MatType>::BasicBackwardVisitor(
+    const MatType& input,
+    const MatType& error,
+    MatType& delta,
+    const size_t index) :
   input(input),
   error(error),
   delta(delta),
@@ -44,29 +48,36 @@ inline BackwardVisitor::BackwardVisitor(const arma::mat& input,
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void BackwardVisitor::operator()(LayerType* layer) const
+inline void BasicBackwardVisitor<MatType>::operator()(LayerType* layer) const
 {
   LayerBackward(layer, layer->OutputParameter());
 }
 
-inline void BackwardVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicBackwardVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     !HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-BackwardVisitor::LayerBackward(T* layer, arma::mat& /* input */) const
+BasicBackwardVisitor<MatType>::LayerBackward(
+    T* layer, MatType& /* input */) const
 {
   layer->Backward(input, error, delta);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-BackwardVisitor::LayerBackward(T* layer, arma::mat& /* input */) const
+BasicBackwardVisitor<MatType>::LayerBackward(
+    T* layer, MatType& /* input */) const
 {
   if (!hasIndex)
   {
@@ -22,22 +22,25 @@ namespace ann {
 
 /**
  * BiasSetVisitor updates the module bias parameters given the parameters set.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class BiasSetVisitor : public boost::static_visitor<size_t>
+template<typename MatType>
+class BasicBiasSetVisitor : public boost::static_visitor<size_t>
 {
  public:
   //! Update the bias parameters given the parameters' set and offset.
-  BiasSetVisitor(arma::mat& weight, const size_t offset = 0);
+  BasicBiasSetVisitor(MatType& weight, const size_t offset = 0);
 
   //! Update the parameters' set.
   template<typename LayerType>
   size_t operator()(LayerType* layer) const;
 
-  size_t operator()(MoreTypes layer) const;
+  size_t operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameters' set.
-  arma::mat& weight;
+  MatType& weight;
 
   //! The parameters' offset.
   const size_t offset;
@@ -46,21 +49,21 @@ class BiasSetVisitor : public boost::static_visitor<size_t>
   //! Bias() or Model() function.
   template<typename T>
   typename std::enable_if<
-      !HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+      !HasBiasCheck<T, MatType&(T::*)()>::value &&
       !HasModelCheck<T>::value, size_t>::type
   LayerSize(T* layer) const;
 
   //! Update the bias parameters if the module implements the Model() function.
   template<typename T>
   typename std::enable_if<
-      !HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+      !HasBiasCheck<T, MatType&(T::*)()>::value &&
       HasModelCheck<T>::value, size_t>::type
   LayerSize(T* layer) const;
 
   //! Update the bias parameters if the module implements the Bias() function.
   template<typename T>
   typename std::enable_if<
-      HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+      HasBiasCheck<T, MatType&(T::*)()>::value &&
       !HasModelCheck<T>::value, size_t>::type
   LayerSize(T* layer) const;
 
@@ -68,11 +71,14 @@ class BiasSetVisitor : public boost::static_visitor<size_t>
   //! Bias() function.
   template<typename T>
   typename std::enable_if<
-      HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+      HasBiasCheck<T, MatType&(T::*)()>::value &&
       HasModelCheck<T>::value, size_t>::type
   LayerSize(T* layer) const;
 };
 
+//! BiasSetVisitor for layers working with arma::mat.
+typedef BasicBiasSetVisitor<arma::mat> BiasSetVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
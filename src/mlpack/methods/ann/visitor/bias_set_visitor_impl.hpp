@@ -19,76 +19,86 @@ namespace mlpack {
 namespace ann {
 
 //! BiasSetVisitor visitor class.
-inline BiasSetVisitor::BiasSetVisitor(arma::mat& weight, const size_t offset) :
+template<typename MatType>
+inline BasicBiasSetVisitor<MatType>::BasicBiasSetVisitor(
+    MatType& weight,
+    const size_t offset) :
     weight(weight),
     offset(offset)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline size_t BiasSetVisitor::operator()(LayerType* layer) const
+inline size_t BasicBiasSetVisitor<MatType>::operator()(LayerType* layer) const
 {
   return LayerSize(layer);
 }
 
-inline size_t BiasSetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline size_t BasicBiasSetVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    !HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+    !HasBiasCheck<T, MatType&(T::*)()>::value &&
     !HasModelCheck<T>::value, size_t>::type
-BiasSetVisitor::LayerSize(T* /* layer */) const
+BasicBiasSetVisitor<MatType>::LayerSize(T* /* layer */) const
 {
   return 0;
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    !HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+    !HasBiasCheck<T, MatType&(T::*)()>::value &&
     HasModelCheck<T>::value, size_t>::type
-BiasSetVisitor::LayerSize(T* layer) const
+BasicBiasSetVisitor<MatType>::LayerSize(T* layer) const
 {
   size_t modelOffset = 0;
 
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    modelOffset += boost::apply_visitor(BiasSetVisitor(
+    modelOffset += boost::apply_visitor(BasicBiasSetVisitor(
         weight, modelOffset + offset), layer->Model()[i]);
   }
 
   return modelOffset;
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+    HasBiasCheck<T, MatType&(T::*)()>::value &&
     !HasModelCheck<T>::value, size_t>::type
-BiasSetVisitor::LayerSize(T* layer) const
+BasicBiasSetVisitor<MatType>::LayerSize(T* layer) const
 {
-  layer->Bias() = arma::mat(weight.memptr() + offset,
+  layer->Bias() = MatType(weight.memptr() + offset,
       layer->Bias().n_rows, layer->Bias().n_cols, false, false);
 
   return layer->Bias().n_elem;
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasBiasCheck<T, arma::mat&(T::*)()>::value &&
+    HasBiasCheck<T, MatType&(T::*)()>::value &&
     HasModelCheck<T>::value, size_t>::type
-BiasSetVisitor::LayerSize(T* layer) const
+BasicBiasSetVisitor<MatType>::LayerSize(T* layer) const
 {
-  layer->Bias() = arma::mat(weight.memptr() + offset,
+  layer->Bias() = MatType(weight.memptr() + offset,
       layer->Bias().n_rows, layer->Bias().n_cols, false, false);
 
   size_t modelOffset = layer->Bias().n_elem;
 
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    modelOffset += boost::apply_visitor(BiasSetVisitor(
+    modelOffset += boost::apply_visitor(BasicBiasSetVisitor(
         weight, modelOffset + offset), layer->Model()[i]);
   }
 
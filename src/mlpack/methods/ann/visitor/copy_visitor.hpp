@@ -21,17 +21,27 @@ namespace ann {
 /**
  * This visitor is to support copy constructor for neural network module.
  * We want a layer-wise copy rather than simple duplicate the pointer.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
+ * @tparam CustomLayers Any set of custom layers that could be a part of the
+ *         network.
  */
-template <typename... CustomLayers>
-class CopyVisitor : public boost::static_visitor<LayerTypes<CustomLayers...> >
+template <typename MatType, typename... CustomLayers>
+class BasicCopyVisitor :
+    public boost::static_visitor<BasicLayerTypes<MatType, CustomLayers...> >
 {
  public:
   template <typename LayerType>
-  LayerTypes<CustomLayers...> operator()(LayerType*) const;
+  BasicLayerTypes<MatType, CustomLayers...> operator()(LayerType*) const;
 
-  LayerTypes<CustomLayers...> operator()(MoreTypes) const;
+  BasicLayerTypes<MatType, CustomLayers...> operator()(
+      BasicMoreTypes<MatType>) const;
 };
 
+//! CopyVisitor for layers working with arma::mat.
+template <typename... CustomLayers>
+using CopyVisitor = BasicCopyVisitor<arma::mat, CustomLayers...>;
+
 } // namespace ann
 } // namespace mlpack
 
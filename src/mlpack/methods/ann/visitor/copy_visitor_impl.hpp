@@ -18,17 +18,18 @@
 namespace mlpack {
 namespace ann {
 
-template <typename... CustomLayers>
+template <typename MatType, typename... CustomLayers>
 template <typename LayerType>
-inline LayerTypes<CustomLayers...>
-CopyVisitor<CustomLayers...>::operator()(LayerType* layer) const
+inline BasicLayerTypes<MatType, CustomLayers...>
+BasicCopyVisitor<MatType, CustomLayers...>::operator()(LayerType* layer) const
 {
   return new LayerType(*layer);
 }
 
-template <typename... CustomLayers>
-inline LayerTypes<CustomLayers...>
-CopyVisitor<CustomLayers...>::operator()(MoreTypes layer) const
+template <typename MatType, typename... CustomLayers>
+inline BasicLayerTypes<MatType, CustomLayers...>
+BasicCopyVisitor<MatType, CustomLayers...>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
@@ -39,7 +39,8 @@ class DeleteVisitor : public boost::static_visitor<void>
       HasModelCheck<LayerType>::value, void>::type
   operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  template<typename MatType>
+  void operator()(BasicMoreTypes<MatType> layer) const;
 };
 
 } // namespace ann
@@ -42,7 +42,8 @@ DeleteVisitor::operator()(LayerType* layer) const
   }
 }
 
-inline void DeleteVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void DeleteVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
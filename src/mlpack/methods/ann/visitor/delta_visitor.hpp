@@ -23,17 +23,23 @@ namespace ann {
 
 /**
  * DeltaVisitor exposes the delta parameter of the given module.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class DeltaVisitor : public boost::static_visitor<arma::mat&>
+template<typename MatType>
+class BasicDeltaVisitor : public boost::static_visitor<MatType&>
 {
  public:
   //! Return the delta parameter.
   template<typename LayerType>
-  arma::mat& operator()(LayerType* layer) const;
+  MatType& operator()(LayerType* layer) const;
 
-  arma::mat& operator()(MoreTypes layer) const;
+  MatType& operator()(BasicMoreTypes<MatType> layer) const;
 };
 
+//! DeltaVisitor for layers working with arma::mat.
+typedef BasicDeltaVisitor<arma::mat> DeltaVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -19,13 +19,16 @@ namespace mlpack {
 namespace ann {
 
 //! DeltaVisitor visitor class.
+template<typename MatType>
 template<typename LayerType>
-inline arma::mat& DeltaVisitor::operator()(LayerType *layer) const
+inline MatType& BasicDeltaVisitor<MatType>::operator()(LayerType *layer) const
 {
   return layer->Delta();
 }
 
-inline arma::mat& DeltaVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline MatType& BasicDeltaVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
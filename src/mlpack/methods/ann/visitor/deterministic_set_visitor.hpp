@@ -35,7 +35,8 @@ class DeterministicSetVisitor : public boost::static_visitor<void>
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  template<typename MatType>
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The deterministic parameter.
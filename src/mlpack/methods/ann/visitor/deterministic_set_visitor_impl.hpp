@@ -31,7 +31,9 @@ inline void DeterministicSetVisitor::operator()(LayerType* layer) const
   LayerDeterministic(layer);
 }
 
-inline void DeterministicSetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void DeterministicSetVisitor::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
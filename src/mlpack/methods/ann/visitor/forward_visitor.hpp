@@ -24,27 +24,33 @@ namespace ann {
 /**
  * ForwardVisitor executes the Forward() function given the input and output
  * parameter.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class ForwardVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicForwardVisitor : public boost::static_visitor<void>
 {
  public:
   //! Execute the Forward() function given the input and output parameter.
-  ForwardVisitor(const arma::mat& input, arma::mat& output);
+  BasicForwardVisitor(const MatType& input, MatType& output);
 
   //! Execute the Forward() function.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The input parameter set.
-  const arma::mat& input;
+  const MatType& input;
 
   //! The output parameter set.
-  arma::mat& output;
+  MatType& output;
 };
 
+//! ForwardVisitor for layers working with arma::mat.
+typedef BasicForwardVisitor<arma::mat> ForwardVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
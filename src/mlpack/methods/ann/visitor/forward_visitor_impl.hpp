@@ -19,20 +19,26 @@ namespace mlpack {
 namespace ann {
 
 //! ForwardVisitor visitor class.
-inline ForwardVisitor::ForwardVisitor(const arma::mat& input, arma::mat& output) :
+template<typename MatType>
+inline BasicForwardVisitor<MatType>::BasicForwardVisitor(
+    const MatType& input,
+    MatType& output) :
     input(input),
     output(output)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void ForwardVisitor::operator()(LayerType* layer) const
+inline void BasicForwardVisitor<MatType>::operator()(LayerType* layer) const
 {
   layer->Forward(input, output);
 }
 
-inline void ForwardVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicForwardVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
@@ -22,22 +22,25 @@ namespace ann {
 
 /**
  * GradientUpdateVisitor update the gradient parameter given the gradient set.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class GradientUpdateVisitor : public boost::static_visitor<size_t>
+template<typename MatType>
+class BasicGradientUpdateVisitor : public boost::static_visitor<size_t>
 {
  public:
   //! Update the gradient parameter given the gradient set.
-  GradientUpdateVisitor(arma::mat& gradient, size_t offset = 0);
+  BasicGradientUpdateVisitor(MatType& gradient, size_t offset = 0);
 
   //! Update the gradient parameter.
   template<typename LayerType>
   size_t operator()(LayerType* layer) const;
 
-  size_t operator()(MoreTypes layer) const;
+  size_t operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The gradient set.
-  arma::mat& gradient;
+  MatType& gradient;
 
   //! The gradient offset.
   size_t offset;
@@ -45,24 +48,24 @@ class GradientUpdateVisitor : public boost::static_visitor<size_t>
   //! Update the gradient if the module implements the Gradient() function.
   template<typename T>
   typename std::enable_if<
-      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasGradientCheck<T, MatType&(T::*)()>::value &&
       !HasModelCheck<T>::value, size_t>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Update the gradient if the module implements the Model() function.
   template<typename T>
   typename std::enable_if<
-      !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      !HasGradientCheck<T, MatType&(T::*)()>::value &&
       HasModelCheck<T>::value, size_t>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Update the gradient if the module implements the Gradient() and Model()
   //! function.
   template<typename T>
   typename std::enable_if<
-      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasGradientCheck<T, MatType&(T::*)()>::value &&
       HasModelCheck<T>::value, size_t>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Do not update the gradient parameter if the module doesn't implement the
   //! Gradient() or Model() function.
@@ -73,6 +76,9 @@ class GradientUpdateVisitor : public boost::static_visitor<size_t>
   LayerGradients(T* layer, P& input) const;
 };
 
+//! GradientUpdateVisitor for layers working with arma::mat.
+typedef BasicGradientUpdateVisitor<arma::mat> GradientUpdateVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -19,30 +19,38 @@ namespace mlpack {
 namespace ann {
 
 //! GradientUpdateVisitor visitor class.
-inline GradientUpdateVisitor::GradientUpdateVisitor(arma::mat& gradient,
-                                                    size_t offset) :
+template<typename MatType>
+inline BasicGradientUpdateVisitor<MatType>::BasicGradientUpdateVisitor(
+    MatType& gradient,
+    size_t offset) :
     gradient(gradient),
     offset(offset)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline size_t GradientUpdateVisitor::operator()(LayerType* layer) const
+inline size_t BasicGradientUpdateVisitor<MatType>::operator()(
+    LayerType* layer) const
 {
   return LayerGradients(layer, layer->OutputParameter());
 }
 
-inline size_t GradientUpdateVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline size_t BasicGradientUpdateVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasGradientCheck<T, MatType&(T::*)()>::value &&
     !HasModelCheck<T>::value, size_t>::type
-GradientUpdateVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+BasicGradientUpdateVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   if (layer->Parameters().n_elem != 0)
   {
@@ -53,27 +61,31 @@ GradientUpdateVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
   return layer->Parameters().n_elem;
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    !HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    !HasGradientCheck<T, MatType&(T::*)()>::value &&
     HasModelCheck<T>::value, size_t>::type
-GradientUpdateVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+BasicGradientUpdateVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   size_t modelOffset = 0;
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    modelOffset += boost::apply_visitor(GradientUpdateVisitor(
+    modelOffset += boost::apply_visitor(BasicGradientUpdateVisitor(
         gradient, modelOffset + offset), layer->Model()[i]);
   }
 
   return modelOffset;
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasGradientCheck<T, MatType&(T::*)()>::value &&
     HasModelCheck<T>::value, size_t>::type
-GradientUpdateVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+BasicGradientUpdateVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   if (layer->Parameters().n_elem != 0)
   {
@@ -84,18 +96,20 @@ GradientUpdateVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
   size_t modelOffset = layer->Parameters().n_elem;
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    modelOffset += boost::apply_visitor(GradientUpdateVisitor(
+    modelOffset += boost::apply_visitor(BasicGradientUpdateVisitor(
         gradient, modelOffset + offset), layer->Model()[i]);
   }
 
   return modelOffset;
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     !HasGradientCheck<T, P&(T::*)()>::value &&
     !HasModelCheck<T>::value, size_t>::type
-GradientUpdateVisitor::LayerGradients(T* /* layer */, P& /* input */) const
+BasicGradientUpdateVisitor<MatType>::LayerGradients(
+    T* /* layer */, P& /* input */) const
 {
   return 0;
 }
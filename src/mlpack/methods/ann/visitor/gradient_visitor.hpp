@@ -24,31 +24,34 @@ namespace ann {
 /**
  * SearchModeVisitor executes the Gradient() method of the given module using
  * the input and delta parameter.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class GradientVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicGradientVisitor : public boost::static_visitor<void>
 {
  public:
   //! Executes the Gradient() method of the given module using the input and
   //! delta parameter.
-  GradientVisitor(const arma::mat& input, const arma::mat& delta);
+  BasicGradientVisitor(const MatType& input, const MatType& delta);
 
   //! Executes the Gradient() method for the layer with the specified index.
-  GradientVisitor(const arma::mat& input,
-                  const arma::mat& delta,
-                  const size_t index);
+  BasicGradientVisitor(const MatType& input,
+                       const MatType& delta,
+                       const size_t index);
 
   //! Executes the Gradient() method.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The input set.
-  const arma::mat& input;
+  const MatType& input;
 
   //! The delta parameter.
-  const arma::mat& delta;
+  const MatType& delta;
 
   //! Index of the layer to run.
   size_t index;
@@ -60,17 +63,17 @@ class GradientVisitor : public boost::static_visitor<void>
   //! function.
   template<typename T>
   typename std::enable_if<
-      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasGradientCheck<T, MatType&(T::*)()>::value &&
       !HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Execute the Gradient() function if the module implements the Gradient()
   //! and has a Run() function.
   template<typename T>
   typename std::enable_if<
-      HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+      HasGradientCheck<T, MatType&(T::*)()>::value &&
       HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Do not execute the Gradient() function if the module doesn't implement
   //! the Gradient() function.
@@ -80,6 +83,9 @@ class GradientVisitor : public boost::static_visitor<void>
   LayerGradients(T* layer, P& input) const;
 };
 
+//! GradientVisitor for layers working with arma::mat.
+typedef BasicGradientVisitor<arma::mat> GradientVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -19,8 +19,10 @@ namespace mlpack {
 namespace ann {
 
 //! GradientVisitor visitor class.
-inline GradientVisitor::GradientVisitor(const arma::mat& input,
-                                        const arma::mat& delta) :
+template<typename MatType>
+inline BasicGradientVisitor<MatType>::BasicGradientVisitor(
+    const MatType& input,
+    const MatType& delta) :
     input(input),
     delta(delta),
     index(0),
@@ -29,9 +31,11 @@ inline GradientVisitor::GradientVisitor(const arma::mat& input,
   /* Nothing to do here. */
 }
 
-inline GradientVisitor::GradientVisitor(const arma::mat& input,
-                                        const arma::mat& delta,
-                                        const size_t index) :
+template<typename MatType>
+inline BasicGradientVisitor<MatType>::BasicGradientVisitor(
+    const MatType& input,
+    const MatType& delta,
+    const size_t index) :
     input(input),
     delta(delta),
     index(index),
@@ -40,31 +44,38 @@ inline GradientVisitor::GradientVisitor(const arma::mat& input,
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void GradientVisitor::operator()(LayerType* layer) const
+inline void BasicGradientVisitor<MatType>::operator()(LayerType* layer) const
 {
   LayerGradients(layer, layer->OutputParameter());
 }
 
-inline void GradientVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicGradientVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasGradientCheck<T, MatType&(T::*)()>::value &&
     !HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-GradientVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+BasicGradientVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   layer->Gradient(input, delta, layer->Gradient());
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasGradientCheck<T, arma::mat&(T::*)()>::value &&
+    HasGradientCheck<T, MatType&(T::*)()>::value &&
     HasRunCheck<T, bool&(T::*)(void)>::value, void>::type
-GradientVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+BasicGradientVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   if (!hasIndex)
   {
@@ -76,10 +87,12 @@ GradientVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
   }
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     !HasGradientCheck<T, P&(T::*)()>::value, void>::type
-GradientVisitor::LayerGradients(T* /* layer */, P& /* input */) const
+BasicGradientVisitor<MatType>::LayerGradients(
+    T* /* layer */, P& /* input */) const
 {
   /* Nothing to do here. */
 }
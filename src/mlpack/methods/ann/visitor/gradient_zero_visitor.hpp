@@ -23,25 +23,28 @@ namespace ann {
 
 /*
  * GradientZeroVisitor set the gradient to zero for the given module.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class GradientZeroVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicGradientZeroVisitor : public boost::static_visitor<void>
 {
  public:
   //! Set the gradient to zero for the given module.
-  GradientZeroVisitor();
+  BasicGradientZeroVisitor();
 
   //! Set the gradient to zero.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! Set the gradient to zero if the module implements the Gradient() function.
   template<typename T>
   typename std::enable_if<
-      HasGradientCheck<T, arma::mat&(T::*)()>::value, void>::type
-  LayerGradients(T* layer, arma::mat& input) const;
+      HasGradientCheck<T, MatType&(T::*)()>::value, void>::type
+  LayerGradients(T* layer, MatType& input) const;
 
   //! Do not set the gradient to zero if the module doesn't implement the
   //! Gradient() function.
@@ -51,6 +54,9 @@ class GradientZeroVisitor : public boost::static_visitor<void>
   LayerGradients(T* layer, P& input) const;
 };
 
+//! GradientZeroVisitor for layers working with arma::mat.
+typedef BasicGradientZeroVisitor<arma::mat> GradientZeroVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
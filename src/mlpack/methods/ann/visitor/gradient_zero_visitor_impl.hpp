@@ -19,34 +19,43 @@ namespace mlpack {
 namespace ann {
 
 //! GradientZeroVisitor visitor class.
-inline GradientZeroVisitor::GradientZeroVisitor()
+template<typename MatType>
+inline BasicGradientZeroVisitor<MatType>::BasicGradientZeroVisitor()
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void GradientZeroVisitor::operator()(LayerType* layer) const
+inline void BasicGradientZeroVisitor<MatType>::operator()(
+    LayerType* layer) const
 {
   LayerGradients(layer, layer->OutputParameter());
 }
 
-inline void GradientZeroVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicGradientZeroVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
-    HasGradientCheck<T, arma::mat&(T::*)()>::value, void>::type
-GradientZeroVisitor::LayerGradients(T* layer, arma::mat& /* input */) const
+    HasGradientCheck<T, MatType&(T::*)()>::value, void>::type
+BasicGradientZeroVisitor<MatType>::LayerGradients(
+    T* layer, MatType& /* input */) const
 {
   layer->Gradient().zeros();
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     !HasGradientCheck<T, P&(T::*)()>::value, void>::type
-GradientZeroVisitor::LayerGradients(T* /* layer */, P& /* input */) const
+BasicGradientZeroVisitor<MatType>::LayerGradients(
+    T* /* layer */, P& /* input */) const
 {
   /* Nothing to do here. */
 }
@@ -0,0 +1,121 @@
+/**
+ * @file methods/ann/visitor/layer_call_visitor.hpp
+ *
+ * This file provides a visitor that resolves the type of a layer once and
+ * binds its Forward(), Backward() and Gradient() functions, so that they can
+ * be called later without dispatching through the layer variant again.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_LAYER_CALL_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_LAYER_CALL_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * LayerCall holds the Forward(), Backward() and Gradient() functions of a
+ * layer bound to the layer, together with the output parameter and the delta
+ * of the layer.  A network can keep one LayerCall per layer and run its
+ * passes as a flat list of calls.  The LayerCall is valid as long as the layer
+ * is alive.
+ *
+ * @tparam MatType Type of the matrices the layer works with.
+ */
+template<typename MatType>
+struct LayerCall
+{
+  //! The type of a bound Forward() function.
+  typedef void (*ForwardFunction)(void* layer,
+                                  const MatType& input,
+                                  MatType& output);
+  //! The type of a bound Backward() function.
+  typedef void (*BackwardFunction)(void* layer,
+                                   const MatType& input,
+                                   const MatType& error,
+                                   MatType& delta);
+  //! The type of a bound Gradient() function.
+  typedef void (*GradientFunction)(void* layer,
+                                   const MatType& input,
+                                   const MatType& error);
+
+  //! The layer the functions are bound to.
+  void* layer;
+  //! Call the Forward() function of the layer.
+  ForwardFunction forward;
+  //! Call the Backward() function of the layer.
+  BackwardFunction backward;
+  //! Call the Gradient() function of the layer, or NULL if the layer has no
+  //! gradient.
+  GradientFunction gradient;
+  //! The output parameter of the layer.
+  MatType* outputParameter;
+  //! The delta of the layer.
+  MatType* delta;
+};
+
+/**
+ * LayerCallVisitor returns the LayerCall of the given layer.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
+ */
+template<typename MatType>
+class BasicLayerCallVisitor : public boost::static_visitor<LayerCall<MatType> >
+{
+ public:
+  //! Bind the functions of the given layer.
+  template<typename LayerType>
+  LayerCall<MatType> operator()(LayerType* layer) const;
+
+  LayerCall<MatType> operator()(BasicMoreTypes<MatType> layer) const;
+
+ private:
+  //! Call the Forward() function of the given layer.
+  template<typename LayerType>
+  static void Forward(void* layer, const MatType& input, MatType& output);
+
+  //! Call the Backward() function of the given layer.
+  template<typename LayerType>
+  static void Backward(void* layer,
+                       const MatType& input,
+                       const MatType& error,
+                       MatType& delta);
+
+  //! Call the Gradient() function of the given layer.
+  template<typename LayerType>
+  static void Gradient(void* layer, const MatType& input, const MatType& error);
+
+  //! Return the bound Gradient() function if the layer implements the
+  //! Gradient() function.
+  template<typename T>
+  static typename std::enable_if<
+      HasGradientCheck<T, MatType&(T::*)()>::value,
+      typename LayerCall<MatType>::GradientFunction>::type
+  LayerGradient();
+
+  //! Return NULL if the layer doesn't implement the Gradient() function.
+  template<typename T>
+  static typename std::enable_if<
+      !HasGradientCheck<T, MatType&(T::*)()>::value,
+      typename LayerCall<MatType>::GradientFunction>::type
+  LayerGradient();
+};
+
+//! LayerCallVisitor for layers working with arma::mat.
+typedef BasicLayerCallVisitor<arma::mat> LayerCallVisitor;
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "layer_call_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file methods/ann/visitor/layer_call_visitor_impl.hpp
+ *
+ * Implementation of the LayerCallVisitor class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_LAYER_CALL_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_LAYER_CALL_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "layer_call_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! LayerCallVisitor visitor class.
+template<typename MatType>
+template<typename LayerType>
+inline LayerCall<MatType> BasicLayerCallVisitor<MatType>::operator()(
+    LayerType* layer) const
+{
+  LayerCall<MatType> call;
+  call.layer = layer;
+  call.forward = &Forward<LayerType>;
+  call.backward = &Backward<LayerType>;
+  call.gradient = LayerGradient<LayerType>();
+  call.outputParameter = &layer->OutputParameter();
+  call.delta = &layer->Delta();
+  return call;
+}
+
+template<typename MatType>
+inline LayerCall<MatType> BasicLayerCallVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+template<typename MatType>
+template<typename LayerType>
+inline void BasicLayerCallVisitor<MatType>::Forward(void* layer,
+                                                    const MatType& input,
+                                                    MatType& output)
+{
+  static_cast<LayerType*>(layer)->Forward(input, output);
+}
+
+template<typename MatType>
+template<typename LayerType>
+inline void BasicLayerCallVisitor<MatType>::Backward(void* layer,
+                                                     const MatType& input,
+                                                     const MatType& error,
+                                                     MatType& delta)
+{
+  static_cast<LayerType*>(layer)->Backward(input, error, delta);
+}
+
+template<typename MatType>
+template<typename LayerType>
+inline void BasicLayerCallVisitor<MatType>::Gradient(void* layer,
+                                                     const MatType& input,
+                                                     const MatType& error)
+{
+  LayerType* typedLayer = static_cast<LayerType*>(layer);
+  typedLayer->Gradient(input, error, typedLayer->Gradient());
+}
+
+template<typename MatType>
+template<typename T>
+inline typename std::enable_if<
+    HasGradientCheck<T, MatType&(T::*)()>::value,
+    typename LayerCall<MatType>::GradientFunction>::type
+BasicLayerCallVisitor<MatType>::LayerGradient()
+{
+  return &Gradient<T>;
+}
+
+template<typename MatType>
+template<typename T>
+inline typename std::enable_if<
+    !HasGradientCheck<T, MatType&(T::*)()>::value,
+    typename LayerCall<MatType>::GradientFunction>::type
+BasicLayerCallVisitor<MatType>::LayerGradient()
+{
+  return NULL;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -24,22 +24,25 @@ namespace ann {
 /**
  * LoadOutputParameterVisitor restores the output parameter using the given
  * parameter set.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class LoadOutputParameterVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicLoadOutputParameterVisitor : public boost::static_visitor<void>
 {
  public:
   //! Restore the output parameter given a parameter set.
-  LoadOutputParameterVisitor(std::vector<arma::mat>& parameter);
+  BasicLoadOutputParameterVisitor(std::vector<MatType>& parameter);
 
   //! Restore the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameter set.
-  std::vector<arma::mat>& parameter;
+  std::vector<MatType>& parameter;
 
   //! Restore the output parameter for a module which doesn't implement the
   //! Model() function.
@@ -56,6 +59,9 @@ class LoadOutputParameterVisitor : public boost::static_visitor<void>
   OutputParameter(T* layer) const;
 };
 
+//! LoadOutputParameterVisitor for layers working with arma::mat.
+typedef BasicLoadOutputParameterVisitor<arma::mat> LoadOutputParameterVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
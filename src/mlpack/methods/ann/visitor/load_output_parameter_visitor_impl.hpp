@@ -19,40 +19,48 @@ namespace mlpack {
 namespace ann {
 
 //! LoadOutputParameterVisitor visitor class.
-inline LoadOutputParameterVisitor::LoadOutputParameterVisitor(
-    std::vector<arma::mat>& parameter) : parameter(parameter)
+template<typename MatType>
+inline BasicLoadOutputParameterVisitor<MatType>::
+BasicLoadOutputParameterVisitor(
+    std::vector<MatType>& parameter) : parameter(parameter)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void LoadOutputParameterVisitor::operator()(LayerType* layer) const
+inline void BasicLoadOutputParameterVisitor<MatType>::operator()(
+    LayerType* layer) const
 {
   OutputParameter(layer);
 }
 
-inline void LoadOutputParameterVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicLoadOutputParameterVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     !HasModelCheck<T>::value, void>::type
-LoadOutputParameterVisitor::OutputParameter(T* layer) const
+BasicLoadOutputParameterVisitor<MatType>::OutputParameter(T* layer) const
 {
   layer->OutputParameter() = parameter.back();
   parameter.pop_back();
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     HasModelCheck<T>::value, void>::type
-LoadOutputParameterVisitor::OutputParameter(T* layer) const
+BasicLoadOutputParameterVisitor<MatType>::OutputParameter(T* layer) const
 {
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(LoadOutputParameterVisitor(parameter),
+    boost::apply_visitor(BasicLoadOutputParameterVisitor(parameter),
         layer->Model()[layer->Model().size() - i - 1]);
   }
 
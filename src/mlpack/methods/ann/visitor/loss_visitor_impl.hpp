@@ -25,7 +25,8 @@ inline double LossVisitor::operator()(LayerType* layer) const
   return LayerLoss(layer);
 }
 
-inline double LossVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline double LossVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
@@ -25,7 +25,9 @@ inline size_t OutputHeightVisitor::operator()(LayerType* layer) const
   return LayerOutputHeight(layer);
 }
 
-inline size_t OutputHeightVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline size_t OutputHeightVisitor::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
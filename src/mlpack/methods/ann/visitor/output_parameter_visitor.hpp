@@ -23,17 +23,23 @@ namespace ann {
 
 /**
  * OutputParameterVisitor exposes the output parameter of the given module.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class OutputParameterVisitor : public boost::static_visitor<arma::mat&>
+template<typename MatType>
+class BasicOutputParameterVisitor : public boost::static_visitor<MatType&>
 {
  public:
   //! Return the output parameter set.
   template<typename LayerType>
-  arma::mat& operator()(LayerType* layer) const;
+  MatType& operator()(LayerType* layer) const;
 
-  arma::mat& operator()(MoreTypes layer) const;
+  MatType& operator()(BasicMoreTypes<MatType> layer) const;
 };
 
+//! OutputParameterVisitor for layers working with arma::mat.
+typedef BasicOutputParameterVisitor<arma::mat> OutputParameterVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -19,13 +19,17 @@ namespace mlpack {
 namespace ann {
 
 //! OutputParameterVisitor visitor class.
+template<typename MatType>
 template<typename LayerType>
-inline arma::mat& OutputParameterVisitor::operator()(LayerType *layer) const
+inline MatType& BasicOutputParameterVisitor<MatType>::operator()(
+    LayerType *layer) const
 {
   return layer->OutputParameter();
 }
 
-inline arma::mat& OutputParameterVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline MatType& BasicOutputParameterVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
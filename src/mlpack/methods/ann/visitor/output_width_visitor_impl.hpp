@@ -25,7 +25,9 @@ inline size_t OutputWidthVisitor::operator()(LayerType* layer) const
   return LayerOutputWidth(layer);
 }
 
-inline size_t OutputWidthVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline size_t OutputWidthVisitor::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
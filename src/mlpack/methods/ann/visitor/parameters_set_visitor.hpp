@@ -23,22 +23,25 @@ namespace ann {
 
 /**
  * ParametersSetVisitor update the parameters set using the given matrix.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class ParametersSetVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicParametersSetVisitor : public boost::static_visitor<void>
 {
  public:
   //! Update the parameters set given the parameters matrix.
-  ParametersSetVisitor(arma::mat& parameters);
+  BasicParametersSetVisitor(MatType& parameters);
 
   //! Update the parameters set.
   template<typename LayerType>
   void operator()(LayerType *layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameters set.
-  arma::mat& parameters;
+  MatType& parameters;
 
   //! Do not update the parameters set if the module doesn't implement the
   //! Parameters() function.
@@ -55,6 +58,9 @@ class ParametersSetVisitor : public boost::static_visitor<void>
   LayerParameters(T* layer, P& output) const;
 };
 
+//! ParametersSetVisitor for layers working with arma::mat.
+typedef BasicParametersSetVisitor<arma::mat> ParametersSetVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
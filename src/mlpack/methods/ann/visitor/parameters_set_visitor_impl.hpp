@@ -19,35 +19,45 @@ namespace mlpack {
 namespace ann {
 
 //! ParametersSetVisitor visitor class.
-inline ParametersSetVisitor::ParametersSetVisitor(arma::mat& parameters) :
+template<typename MatType>
+inline BasicParametersSetVisitor<MatType>::BasicParametersSetVisitor(
+    MatType& parameters) :
     parameters(parameters)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void ParametersSetVisitor::operator()(LayerType *layer) const
+inline void BasicParametersSetVisitor<MatType>::operator()(
+    LayerType *layer) const
 {
   LayerParameters(layer, layer->OutputParameter());
 }
 
-inline void ParametersSetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicParametersSetVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     !HasParametersCheck<T, P&(T::*)()>::value, void>::type
-ParametersSetVisitor::LayerParameters(T* /* layer */, P& /* output */) const
+BasicParametersSetVisitor<MatType>::LayerParameters(
+    T* /* layer */, P& /* output */) const
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     HasParametersCheck<T, P&(T::*)()>::value, void>::type
-ParametersSetVisitor::LayerParameters(T* layer, P& /* output */) const
+BasicParametersSetVisitor<MatType>::LayerParameters(
+    T* layer, P& /* output */) const
 {
   layer->Parameters() = parameters;
 }
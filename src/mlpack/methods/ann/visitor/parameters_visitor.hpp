@@ -24,22 +24,25 @@ namespace ann {
 /**
  * ParametersVisitor exposes the parameters set of the given module and stores
  * the parameters set into the given matrix.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class ParametersVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicParametersVisitor : public boost::static_visitor<void>
 {
  public:
   //! Store the parameters set into the given parameters matrix.
-  ParametersVisitor(arma::mat& parameters);
+  BasicParametersVisitor(MatType& parameters);
 
   //! Set the parameters set.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameters set.
-  arma::mat& parameters;
+  MatType& parameters;
 
   //! Do not set the parameters set if the module doesn't implement the
   //! Parameters() function.
@@ -55,6 +58,9 @@ class ParametersVisitor : public boost::static_visitor<void>
   LayerParameters(T* layer, P& output) const;
 };
 
+//! ParametersVisitor for layers working with arma::mat.
+typedef BasicParametersVisitor<arma::mat> ParametersVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
@@ -19,35 +19,44 @@ namespace mlpack {
 namespace ann {
 
 //! ParametersVisitor visitor class.
-inline ParametersVisitor::ParametersVisitor(arma::mat& parameters) :
+template<typename MatType>
+inline BasicParametersVisitor<MatType>::BasicParametersVisitor(
+    MatType& parameters) :
     parameters(parameters)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void ParametersVisitor::operator()(LayerType *layer) const
+inline void BasicParametersVisitor<MatType>::operator()(LayerType *layer) const
 {
   LayerParameters(layer, layer->OutputParameter());
 }
 
-inline void ParametersVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicParametersVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     !HasParametersCheck<T, P&(T::*)()>::value, void>::type
-ParametersVisitor::LayerParameters(T* /* layer */, P& /* output */) const
+BasicParametersVisitor<MatType>::LayerParameters(
+    T* /* layer */, P& /* output */) const
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename T, typename P>
 inline typename std::enable_if<
     HasParametersCheck<T, P&(T::*)()>::value, void>::type
-ParametersVisitor::LayerParameters(T* layer, P& /* output */) const
+BasicParametersVisitor<MatType>::LayerParameters(
+    T* layer, P& /* output */) const
 {
   parameters = layer->Parameters();
 }
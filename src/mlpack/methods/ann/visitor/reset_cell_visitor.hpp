@@ -33,7 +33,8 @@ class ResetCellVisitor : public boost::static_visitor<void>
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  template<typename MatType>
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   size_t size;
@@ -31,7 +31,8 @@ inline void ResetCellVisitor::operator()(LayerType* layer) const
   ResetCell(layer);
 }
 
-inline void ResetCellVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void ResetCellVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
@@ -25,7 +25,8 @@ inline void ResetVisitor::operator()(LayerType* layer) const
   ResetParameter(layer);
 }
 
-inline void ResetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void ResetVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
@@ -33,7 +33,8 @@ class RewardSetVisitor : public boost::static_visitor<void>
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  template<typename MatType>
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The reward value.
@@ -30,7 +30,8 @@ inline void RewardSetVisitor::operator()(LayerType* layer) const
   LayerReward(layer);
 }
 
-inline void RewardSetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void RewardSetVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
@@ -31,7 +31,8 @@ inline void RunSetVisitor::operator()(LayerType* layer) const
   LayerRun(layer);
 }
 
-inline void RunSetVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void RunSetVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
@@ -23,22 +23,25 @@ namespace ann {
 /**
  * SaveOutputParameterVisitor saves the output parameter into the given
  * parameter set.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class SaveOutputParameterVisitor : public boost::static_visitor<void>
+template<typename MatType>
+class BasicSaveOutputParameterVisitor : public boost::static_visitor<void>
 {
  public:
   //! Save the output parameter into the given parameter set.
-  SaveOutputParameterVisitor(std::vector<arma::mat>& parameter);
+  BasicSaveOutputParameterVisitor(std::vector<MatType>& parameter);
 
   //! Save the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
 
-  void operator()(MoreTypes layer) const;
+  void operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameter set.
-  std::vector<arma::mat>& parameter;
+  std::vector<MatType>& parameter;
 
   //! Save the output parameter for a module which doesn't implement the
   //! Model() function.
@@ -55,6 +58,9 @@ class SaveOutputParameterVisitor : public boost::static_visitor<void>
   OutputParameter(T* layer) const;
 };
 
+//! SaveOutputParameterVisitor for layers working with arma::mat.
+typedef BasicSaveOutputParameterVisitor<arma::mat> SaveOutputParameterVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
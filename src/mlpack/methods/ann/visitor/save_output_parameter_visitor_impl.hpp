@@ -19,41 +19,49 @@ namespace mlpack {
 namespace ann {
 
 //! SaveOutputParameterVisitor visitor class.
-inline SaveOutputParameterVisitor::SaveOutputParameterVisitor(
-    std::vector<arma::mat>& parameter) : parameter(parameter)
+template<typename MatType>
+inline BasicSaveOutputParameterVisitor<MatType>::
+BasicSaveOutputParameterVisitor(
+    std::vector<MatType>& parameter) : parameter(parameter)
 {
   /* Nothing to do here. */
 }
 
+template<typename MatType>
 template<typename LayerType>
-inline void SaveOutputParameterVisitor::operator()(LayerType* layer) const
+inline void BasicSaveOutputParameterVisitor<MatType>::operator()(
+    LayerType* layer) const
 {
   OutputParameter(layer);
 }
 
-inline void SaveOutputParameterVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline void BasicSaveOutputParameterVisitor<MatType>::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   layer.apply_visitor(*this);
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     !HasModelCheck<T>::value, void>::type
-SaveOutputParameterVisitor::OutputParameter(T* layer) const
+BasicSaveOutputParameterVisitor<MatType>::OutputParameter(T* layer) const
 {
   parameter.push_back(layer->OutputParameter());
 }
 
+template<typename MatType>
 template<typename T>
 inline typename std::enable_if<
     HasModelCheck<T>::value, void>::type
-SaveOutputParameterVisitor::OutputParameter(T* layer) const
+BasicSaveOutputParameterVisitor<MatType>::OutputParameter(T* layer) const
 {
   parameter.push_back(layer->OutputParameter());
 
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(SaveOutputParameterVisitor(parameter),
+    boost::apply_visitor(BasicSaveOutputParameterVisitor(parameter),
         layer->Model()[i]);
   }
 }
@@ -34,7 +34,8 @@ class SetInputHeightVisitor : public boost::static_visitor<bool>
   template<typename LayerType>
   bool operator()(LayerType* layer) const;
 
-  bool operator()(MoreTypes layer) const;
+  template<typename MatType>
+  bool operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The input height parameter.
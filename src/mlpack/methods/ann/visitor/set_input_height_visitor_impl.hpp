@@ -33,7 +33,9 @@ inline bool SetInputHeightVisitor::operator()(LayerType* layer) const
   return LayerInputHeight(layer);
 }
 
-inline bool SetInputHeightVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline bool SetInputHeightVisitor::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
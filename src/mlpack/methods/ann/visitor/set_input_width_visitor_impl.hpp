@@ -33,7 +33,9 @@ inline bool SetInputWidthVisitor::operator()(LayerType* layer) const
   return LayerInputWidth(layer);
 }
 
-inline bool SetInputWidthVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline bool SetInputWidthVisitor::operator()(
+    BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
@@ -22,22 +22,25 @@ namespace ann {
 
 /**
  * WeightSetVisitor update the module parameters given the parameters set.
+ *
+ * @tparam MatType Type of the matrices the layers work with.
  */
-class WeightSetVisitor : public boost::static_visitor<size_t>
+template<typename MatType>
+class BasicWeightSetVisitor : public boost::static_visitor<size_t>
 {
  public:
   //! Update the parameters given the parameters set and offset.
-  WeightSetVisitor(arma::mat& weight, const size_t offset = 0);
+  BasicWeightSetVisitor(MatType& weight, const size_t offset = 0);
 
   //! Update the parameters set.
   template<typename LayerType>
   size_t operator()(LayerType* layer) const;
 
-  size_t operator()(MoreTypes layer) const;
+  size_t operator()(BasicMoreTypes<MatType> layer) const;
 
  private:
   //! The parameters set.
-  arma::mat& weight;
+  MatType& weight;
 
   //! The parameters offset.
   const size_t offset;
@@ -73,6 +76,9 @@ class WeightSetVisitor : public boost::static_visitor<size_t>
   LayerSize(T* layer, P&& input) const;
 };
 
+//! WeightSetVisitor for layers working with arma::mat.
+typedef BasicWeightSetVisitor<arma::mat> WeightSetVisitor;
+
 } // namespace ann
 } // namespace mlpack
 
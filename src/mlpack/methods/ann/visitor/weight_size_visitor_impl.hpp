@@ -25,7 +25,8 @@ inline size_t WeightSizeVisitor::operator()(LayerType* layer) const
   return LayerSize(layer, layer->OutputParameter());
 }
 
-inline size_t WeightSizeVisitor::operator()(MoreTypes layer) const
+template<typename MatType>
+inline size_t WeightSizeVisitor::operator()(BasicMoreTypes<MatType> layer) const
 {
   return layer.apply_visitor(*this);
 }
@@ -0,0 +1,100 @@
+/**
+ * @file methods/decision_tree/binned_dataset.hpp
+ *
+ * Definition of the BinnedDataset class, which quantizes each dimension of a
+ * numeric dataset into at most 256 bins.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BINNED_DATASET_HPP
+#define MLPACK_METHODS_DECISION_TREE_BINNED_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The BinnedDataset holds a numeric dataset where every value is replaced by
+ * the index of its bin, stored in one byte.  The bins of each dimension are
+ * chosen from the quantiles of the values in that dimension, and they are
+ * separated by split points: a value falls in bin b if it is larger than the
+ * split points of the bins before b and not larger than the split point of bin
+ * b.  So the bin of a value is at most b if and only if the value is not
+ * larger than the split point of bin b, and a split on a bin can be turned
+ * into a split on the original values.  If a dimension has no more distinct
+ * values than bins, every distinct value gets its own bin.
+ *
+ * Like the thresholds of BestBinaryNumericSplit, each split point is halfway
+ * between the largest value of its bin and the smallest value of the next
+ * bin, so a tree trained on the bins splits the original values where a tree
+ * trained on the values themselves would.
+ *
+ * A decision tree can be trained on a BinnedDataset with histograms of the
+ * bins instead of sorting the points in every node; see DecisionTree::Train().
+ *
+ * @tparam ElemType Type of the original values.
+ */
+template<typename ElemType = double>
+class BinnedDataset
+{
+ public:
+  /**
+   * Quantize the given dataset.
+   *
+   * @param data Numeric dataset to quantize.
+   * @param maximumBins Maximum number of bins in each dimension (between 2 and
+   *     256).
+   */
+  template<typename MatType>
+  BinnedDataset(const MatType& data, const size_t maximumBins = 256);
+
+  //! Get the bin of every value, with one column per point.
+  const arma::Mat<unsigned char>& Bins() const { return bins; }
+
+  //! Get the bin of the given value.
+  unsigned char Bin(const size_t dimension, const size_t point) const
+  {
+    return bins(dimension, point);
+  }
+
+  //! Get the number of bins in the given dimension.
+  size_t NumBins(const size_t dimension) const
+  {
+    return splitPoints[dimension].n_elem + 1;
+  }
+
+  //! Get the split point after the given bin of the given dimension (the bin
+  //! must not be the last one).
+  ElemType SplitPoint(const size_t dimension, const size_t bin) const
+  {
+    return splitPoints[dimension][bin];
+  }
+
+  //! Get the largest number of bins in any dimension.
+  size_t MaximumBins() const { return maximumBins; }
+
+  //! Get the number of dimensions.
+  size_t Dimensionality() const { return bins.n_rows; }
+  //! Get the number of points.
+  size_t NumPoints() const { return bins.n_cols; }
+
+ private:
+  //! The bin of every value.
+  arma::Mat<unsigned char> bins;
+  //! The split points between the bins of every dimension.
+  std::vector<arma::Col<ElemType>> splitPoints;
+  //! The largest number of bins in any dimension.
+  size_t maximumBins;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "binned_dataset_impl.hpp"
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file methods/decision_tree/binned_dataset_impl.hpp
+ *
+ * Implementation of the BinnedDataset class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_BINNED_DATASET_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_BINNED_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "binned_dataset.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename ElemType>
+template<typename MatType>
+BinnedDataset<ElemType>::BinnedDataset(const MatType& data,
+                                       const size_t maximumBins) :
+    bins(data.n_rows, data.n_cols),
+    splitPoints(data.n_rows),
+    maximumBins(0)
+{
+  if (maximumBins < 2 || maximumBins > 256)
+  {
+    std::ostringstream oss;
+    oss << "BinnedDataset::BinnedDataset(): the maximum number of bins must "
+        << "be between 2 and 256, not " << maximumBins << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The dimensions are independent, so they are quantized in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    const arma::Col<ElemType> sorted = arma::sort(
+        arma::conv_to<arma::Col<ElemType>>::from(data.row(d).t()));
+    const size_t n = sorted.n_elem;
+
+    // Collect the distinct values.  If there are few enough of them, every
+    // value gets its own bin.
+    std::vector<ElemType> points;
+    for (size_t i = 0; i + 1 < n && points.size() < maximumBins; ++i)
+    {
+      if (sorted[i] != sorted[i + 1])
+        points.push_back(sorted[i]);
+    }
+
+    if (points.size() >= maximumBins)
+    {
+      // Otherwise, use the quantiles.  Values equal to the largest value
+      // can't split anything, so they are skipped.
+      points.clear();
+      for (size_t b = 1; b < maximumBins; ++b)
+      {
+        const ElemType value = sorted[(b * n) / maximumBins];
+        if (value < sorted[n - 1] && (points.empty() || value > points.back()))
+          points.push_back(value);
+      }
+    }
+
+    // Like BestBinaryNumericSplit, split halfway between the largest value of
+    // a bin and the smallest value of the next bin.
+    for (size_t b = 0; b < points.size(); ++b)
+    {
+      const ElemType next = *std::upper_bound(sorted.begin(), sorted.end(),
+          points[b]);
+      points[b] = (points[b] + next) / 2;
+    }
+
+    splitPoints[d] = arma::Col<ElemType>(points);
+
+    // The bin of a value is the number of split points smaller than it.
+    const ElemType* first = splitPoints[d].memptr();
+    const ElemType* last = first + splitPoints[d].n_elem;
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      bins(d, i) = (unsigned char) (std::lower_bound(first, last,
+          (ElemType) data(d, i)) - first);
+    }
+  }
+
+  for (size_t d = 0; d < splitPoints.size(); ++d)
+    this->maximumBins = std::max(this->maximumBins, NumBins(d));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,7 @@
 #include "best_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
+#include "binned_dataset.hpp"
 #include <type_traits>
 
 namespace mlpack {
@@ -398,6 +399,66 @@ class DecisionTree :
                const std::enable_if_t<arma::is_arma_type<typename
                    std::remove_reference<WeightsType>::type>::value>* = 0);
 
+  /**
+   * Train the decision tree on the given points of a binned dataset.  This
+   * will overwrite the given model.  The best split of each node is found
+   * from histograms of the bins of its points instead of by sorting its
+   * points, and only the indices of the points are rearranged, so neither the
+   * dataset nor the labels are copied.  A point may appear more than once in
+   * the indices, as in a bootstrap sample.  The split points of the trained
+   * tree are split points of the binned dataset, so the tree classifies
+   * points with their original values.
+   *
+   * This is only available when the numeric split type is the
+   * BestBinaryNumericSplit.
+   *
+   * @param data Binned dataset to train on.
+   * @param labels Labels for each point of the binned dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param indices Indices of the points to train on.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final entropy of decision tree.
+   */
+  double Train(const BinnedDataset<ElemType>& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               arma::uvec indices,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
+  /**
+   * Train the decision tree on the given weighted points of a binned dataset.
+   * This will overwrite the given model.  See the unweighted overload for
+   * details.
+   *
+   * @param data Binned dataset to train on.
+   * @param labels Labels for each point of the binned dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point of the binned dataset.
+   * @param indices Indices of the points to train on.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final entropy of decision tree.
+   */
+  double Train(const BinnedDataset<ElemType>& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               arma::uvec indices,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
   /**
    * Classify the given point, using the entire tree.  The predicted label is
    * returned.
@@ -465,6 +526,18 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  {
+    return (data::Datatype) dimensionTypeOrMajorityClass;
+  }
+
+  //! Get the class probabilities of a leaf, or the auxiliary split
+  //! information used by the split type's CalculateDirection() function if
+  //! this is a non-leaf.
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -505,6 +578,24 @@ class DecisionTree :
   typedef typename CategoricalSplit::template AuxiliarySplitInfo<ElemType>
       CategoricalAuxiliarySplitInfo;
 
+  /**
+   * Given the gain of the best split of each searched dimension (or DBL_MAX if
+   * the dimension can't be split), in the order in which the dimension
+   * selector returned them, choose the dimension to split on as if the
+   * dimensions had been searched one after the other: a dimension only
+   * replaces the best dimension so far if its gain is larger by more than
+   * minimumGainSplit, and the search stops at a perfect split.
+   *
+   * @param gains Gain of the best split of each dimension.
+   * @param bestGain Gain of the node; set to the gain of the chosen split.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @return Index of the chosen dimension in gains, or gains.size() if the node
+   *      should not be split.
+   */
+  static size_t SelectSplitDimension(const std::vector<double>& gains,
+                                     double& bestGain,
+                                     const double minimumGainSplit);
+
   /**
    * Calculate the class probabilities of the given labels.
    */
@@ -570,6 +661,35 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Corresponding to the public Train() method on a binned dataset, this
+   * method is called for training children.
+   *
+   * @param data Binned dataset to train on.
+   * @param indices Indices of the points to train on.
+   * @param begin Index of the first index that belongs to this node.
+   * @param count Number of points in this node.
+   * @param labels Labels for each point of the binned dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point of the binned dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights>
+  double Train(const BinnedDataset<ElemType>& data,
+               arma::uvec& indices,
+               const size_t begin,
+               const size_t count,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector);
 };
 
 /**
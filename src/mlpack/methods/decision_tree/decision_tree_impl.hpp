@@ -696,17 +696,34 @@ double DecisionTree<FitnessFunction,
       numClasses,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
-  const size_t end = dimensionSelector.End();
 
   if (maximumDepth != 1)
   {
-    for (size_t i = dimensionSelector.Begin(); i != end;
+    // The dimension selector can't be shared between threads, so get the
+    // dimensions to search first.
+    std::vector<size_t> dimensions;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // The best split of each dimension only depends on the gain of this node,
+    // so the dimensions are searched in parallel, each with its own auxiliary
+    // information.  Small nodes are searched serially, since there the threads
+    // would cost more than they save.
+    std::vector<double> dimGains(dimensions.size(), DBL_MAX);
+    std::vector<arma::vec> dimProbabilities(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(
+        dimensions.size());
+    #pragma omp parallel for schedule(dynamic) \
+        if (count * dimensions.size() >= 10000)
+    for (omp_size_t d = 0; d < (omp_size_t) dimensions.size(); ++d)
     {
-      double dimGain = -DBL_MAX;
+      const size_t i = dimensions[d];
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[d] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -714,34 +731,39 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            dimProbabilities[d],
+            categoricalAux[d]);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[d] = NumericSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            dimProbabilities[d],
+            numericAux[d]);
       }
+    }
 
-      // If the splitter reported that it did not split, move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
-
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+    const size_t bestIndex = SelectSplitDimension(dimGains, bestGain,
+        minimumGainSplit);
+    if (bestIndex != dimensions.size())
+    {
+      bestDim = dimensions[bestIndex];
+      classProbabilities = std::move(dimProbabilities[bestIndex]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+      {
+        CategoricalAuxiliarySplitInfo::operator=(
+            categoricalAux[bestIndex]);
+      }
+      else
+      {
+        NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+      }
     }
   }
 
@@ -887,12 +909,27 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // The dimension selector can't be shared between threads, so get the
+    // dimensions to search first.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // The best split of each dimension only depends on the gain of this node,
+    // so the dimensions are searched in parallel (unless the node is small),
+    // each with its own auxiliary information.
+    std::vector<double> dimGains(dimensions.size());
+    std::vector<arma::vec> dimProbabilities(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+    #pragma omp parallel for schedule(dynamic) \
+        if (count * dimensions.size() >= 10000)
+    for (omp_size_t d = 0; d < (omp_size_t) dimensions.size(); ++d)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
+      dimGains[d] = NumericSplitType<FitnessFunction>::template
           SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+                                    data.cols(begin, begin + count - 1).row(
+                                        dimensions[d]),
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
                                     UseWeights ?
@@ -900,20 +937,17 @@ double DecisionTree<FitnessFunction,
                                         weights,
                                     minimumLeafSize,
                                     minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
-
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
-        continue;
-
-      bestDim = i;
-      bestGain = dimGain;
+                                    dimProbabilities[d],
+                                    numericAux[d]);
+    }
 
-      // If the gain is the best possible, no need to keep looking.
-      if (bestGain >= 0.0)
-        break;
+    const size_t bestIndex = SelectSplitDimension(dimGains, bestGain,
+        minimumGainSplit);
+    if (bestIndex != dimensions.size())
+    {
+      bestDim = dimensions[bestIndex];
+      classProbabilities = std::move(dimProbabilities[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
     }
   }
 
@@ -999,6 +1033,341 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
+//! Train on the given points of a binned dataset.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const BinnedDataset<ElemType>& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::uvec indices,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  // The weights are ignored.
+  arma::rowvec weights;
+  return Train(data, labels, numClasses, weights, std::move(indices),
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Train on the given weighted points of a binned dataset.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const BinnedDataset<ElemType>& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    arma::uvec indices,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  // The split points of the binned dataset are only meaningful for a binary
+  // split that sends the points not larger than the split point to the left.
+  static_assert(std::is_same<NumericSplit,
+      BestBinaryNumericSplit<FitnessFunction>>::value,
+      "DecisionTree::Train(): training on a BinnedDataset is only available "
+      "with the BestBinaryNumericSplit!");
+
+  // Sanity checks on data.
+  if (data.NumPoints() != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.NumPoints()
+        << ") does not match number of labels (" << labels.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (!weights.is_empty() && weights.n_elem != data.NumPoints())
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.NumPoints()
+        << ") does not match number of weights (" << weights.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (indices.is_empty())
+  {
+    throw std::invalid_argument("DecisionTree::Train(): no points to train "
+        "on!");
+  }
+
+  if (indices.max() >= data.NumPoints())
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): index " << indices.max() << " is out of "
+        << "range for a dataset with " << data.NumPoints() << " points!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.Dimensionality();
+
+  // Pass off work to the Train() method.
+  if (weights.is_empty())
+  {
+    return Train<false>(data, indices, 0, indices.n_elem, labels, numClasses,
+        weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+        dimensionSelector);
+  }
+  else
+  {
+    return Train<true>(data, indices, 0, indices.n_elem, labels, numClasses,
+        weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+        dimensionSelector);
+  }
+}
+
+//! Train on the given points of a binned dataset with histograms.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const BinnedDataset<ElemType>& data,
+    arma::uvec& indices,
+    const size_t begin,
+    const size_t count,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  // Points are counted, or their weights are summed.
+  typedef typename std::conditional<UseWeights, double, size_t>::type
+      CountType;
+
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members, so reset them.
+  CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Count the classes of the points in this node.
+  arma::Col<CountType> classCounts(numClasses, arma::fill::zeros);
+  for (size_t j = begin; j < begin + count; ++j)
+  {
+    if (UseWeights)
+      classCounts[labels[indices[j]]] += weights[indices[j]];
+    else
+      ++classCounts[labels[indices[j]]];
+  }
+  const CountType totalCount = arma::accu(classCounts);
+
+  double bestGain = FitnessFunction::template EvaluatePtr<UseWeights>(
+      classCounts.memptr(), numClasses, totalCount);
+  size_t bestDim = data.Dimensionality(); // This means "no split".
+  size_t bestBin = 0;
+
+  // Like BestBinaryNumericSplit, force a minimum leaf size of 1.
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  if (maximumDepth != 1 && count >= 2 * minimumLeafSize && bestGain != 0.0)
+  {
+    arma::Mat<CountType> histogram(numClasses, data.MaximumBins());
+    arma::Col<size_t> binCounts(data.MaximumBins());
+    arma::Col<CountType> leftCounts(numClasses);
+    arma::Col<CountType> rightCounts(numClasses);
+
+    // Find the best split of each dimension against the gain of this node,
+    // and then choose between the dimensions like the other trainers do.
+    std::vector<size_t> dimensions;
+    std::vector<double> dimGains;
+    std::vector<size_t> dimBins;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+    {
+      dimensions.push_back(i);
+      dimGains.push_back(DBL_MAX);
+      dimBins.push_back(0);
+
+      const size_t numBins = data.NumBins(i);
+      if (numBins < 2)
+        continue;
+
+      // Build the histogram of the classes in every bin.
+      histogram.zeros();
+      binCounts.zeros();
+      for (size_t j = begin; j < begin + count; ++j)
+      {
+        const size_t point = indices[j];
+        const size_t bin = data.Bin(i, point);
+        if (UseWeights)
+          histogram(labels[point], bin) += weights[point];
+        else
+          ++histogram(labels[point], bin);
+        ++binCounts[bin];
+      }
+
+      // Loop through the split points between the bins, as
+      // BestBinaryNumericSplit loops through the sorted points.
+      double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0) *
+          (double) totalCount;
+      bool improved = false;
+      size_t bestDimBin = 0;
+      leftCounts.zeros();
+      CountType leftTotal = 0;
+      size_t leftPoints = 0;
+      for (size_t b = 0; b + 1 < numBins; ++b)
+      {
+        leftCounts += histogram.col(b);
+        leftTotal += arma::accu(histogram.col(b));
+        leftPoints += binCounts[b];
+
+        // An empty bin gives the same split as the bin before it.  The bounds
+        // on the number of points in each child are the same as the ones of
+        // BestBinaryNumericSplit.
+        if (binCounts[b] == 0 || leftPoints < minimum)
+          continue;
+        if (count - leftPoints <= minimum)
+          break;
+
+        rightCounts = classCounts - leftCounts;
+        const CountType rightTotal = totalCount - leftTotal;
+        const double leftGain = FitnessFunction::template
+            EvaluatePtr<UseWeights>(leftCounts.memptr(), numClasses,
+            leftTotal);
+        const double rightGain = FitnessFunction::template
+            EvaluatePtr<UseWeights>(rightCounts.memptr(), numClasses,
+            rightTotal);
+        const double gain = double(leftTotal) * leftGain +
+            double(rightTotal) * rightGain;
+
+        if (gain > bestFoundGain || gain >= 0.0)
+        {
+          bestFoundGain = gain;
+          bestDimBin = b;
+          improved = true;
+
+          // No split will be better than a perfect one.
+          if (gain >= 0.0)
+            break;
+        }
+      }
+
+      // If the histogram did not report that it improved, then move to the
+      // next dimension.
+      if (!improved)
+        continue;
+
+      dimGains.back() = bestFoundGain / (double) totalCount;
+      dimBins.back() = bestDimBin;
+
+      // A perfect split is always chosen, so no need to keep looking.
+      if (dimGains.back() >= 0.0)
+        break;
+    }
+
+    const size_t bestIndex = SelectSplitDimension(dimGains, bestGain,
+        minimumGainSplit);
+    if (bestIndex != dimensions.size())
+    {
+      bestDim = dimensions[bestIndex];
+      bestBin = dimBins[bestIndex];
+    }
+  }
+
+  // Did we split or not?  If so, then split the indices and create the
+  // children.
+  if (bestDim != data.Dimensionality())
+  {
+    splitDimension = bestDim;
+    dimensionTypeOrMajorityClass = (size_t) data::Datatype::numeric;
+    classProbabilities.set_size(1);
+    classProbabilities[0] = data.SplitPoint(bestDim, bestBin);
+
+    // Move the indices of the points that go to the left child to the front.
+    arma::uword* first = indices.memptr() + begin;
+    arma::uword* middle = std::partition(first, first + count,
+        [&data, bestDim, bestBin](const arma::uword point)
+        {
+          return (size_t) data.Bin(bestDim, point) <= bestBin;
+        });
+    const size_t childCounts[2] = { size_t(middle - first),
+                                    size_t(first + count - middle) };
+
+    // Initialize bestGain if recursive split is allowed.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+    }
+
+    size_t childBegin = begin;
+    for (size_t i = 0; i < 2; ++i)
+    {
+      // Now build the child recursively.
+      DecisionTree* child = new DecisionTree();
+      if (NoRecursion)
+      {
+        child->Train<UseWeights>(data, indices, childBegin, childCounts[i],
+            labels, numClasses, weights, childCounts[i], minimumGainSplit,
+            maximumDepth - 1, dimensionSelector);
+      }
+      else
+      {
+        // During recursion entropy of child node may change.
+        double childGain = child->Train<UseWeights>(data, indices, childBegin,
+            childCounts[i], labels, numClasses, weights, minimumLeafSize,
+            minimumGainSplit, maximumDepth - 1, dimensionSelector);
+        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+      }
+      children.push_back(child);
+      childBegin += childCounts[i];
+    }
+  }
+  else
+  {
+    // We won't be needing these members, so reset them.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    classProbabilities = arma::conv_to<arma::vec>::from(classCounts) /
+        (double) totalCount;
+    arma::uword maxIndex = 0;
+    classProbabilities.max(maxIndex);
+    dimensionTypeOrMajorityClass = (size_t) maxIndex;
+  }
+
+  return -bestGain;
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -1074,8 +1443,10 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Loop over each point.  The points are independent, so they are classified
+  // in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     predictions[i] = Classify(data.col(i));
 }
 
@@ -1111,7 +1482,8 @@ void DecisionTree<FitnessFunction,
     node = &node->Child(0);
   probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     arma::vec v = probabilities.unsafe_col(i); // Alias of column.
     Classify(data.col(i), predictions[i], v);
@@ -1196,6 +1568,48 @@ size_t DecisionTree<FitnessFunction,
     return children[0]->NumClasses();
 }
 
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+size_t DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::SelectSplitDimension(
+    const std::vector<double>& gains,
+    double& bestGain,
+    const double minimumGainSplit)
+{
+  size_t bestIndex = gains.size();
+  for (size_t d = 0; d < gains.size(); ++d)
+  {
+    // If the splitter reported that it did not split, move to the next
+    // dimension.
+    if (gains[d] == DBL_MAX)
+      continue;
+
+    // The splitter only compared the gain with the gain of the node, so a
+    // later dimension must also improve on the best dimension so far, by more
+    // than minimumGainSplit (unless it splits perfectly).
+    if (bestIndex != gains.size() && gains[d] < 0.0 &&
+        gains[d] <= bestGain + minimumGainSplit)
+      continue;
+
+    bestIndex = d;
+    bestGain = gains[d];
+
+    // If the gain is the best possible, no need to keep looking.
+    if (bestGain >= 0.0)
+      break;
+  }
+
+  return bestIndex;
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
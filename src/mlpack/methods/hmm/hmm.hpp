@@ -79,6 +79,13 @@ namespace hmm /** Hidden Markov Models. */ {
  * (with Predict()), generate a sequence (with Generate()), or estimate the
  * probabilities of each state for a sequence of observations (with Train()).
  *
+ * Transitions with zero probability are skipped by the Forward-Backward and
+ * Viterbi algorithms, so sparse or banded topologies (such as left-to-right
+ * models) cost time proportional to the number of possible transitions instead
+ * of the square of the number of states.  Baum-Welch training does not make an
+ * impossible transition possible (unless a state has no possible outgoing
+ * transitions at all), so the structure is kept during training.
+ *
  * @tparam Distribution Type of emission distribution for this HMM.
  */
 template<typename Distribution = distribution::DiscreteDistribution>
@@ -163,6 +170,9 @@ class HMM
    * is called, it uses the current parameters of the HMM as a starting point
    * for training.
    *
+   * If OpenMP is available, the expectation step of each iteration is run in
+   * parallel over the given sequences.
+   *
    * @param dataSeq Vector of observation sequences.
    * @return Log-likelihood of state sequence.
    */
@@ -282,6 +292,21 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are independent, so
+   * if OpenMP is available they are decoded in parallel.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateSeq Vector in which the most probable state sequence of each
+   *    observation sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of the most
+   *    probable state sequence of each observation sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t> >& stateSeq,
+               arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -399,6 +424,50 @@ class HMM
                 const arma::vec& logScales,
                 arma::mat& backwardLogProb) const;
 
+  /**
+   * The Forward algorithm, using the given emission log-probabilities of each
+   * observation (as computed by EmissionLogProbabilities()) instead of
+   * evaluating the emission distributions again.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param logProbs Emission log-probabilities of each state (rows) for each
+   *     observation (columns).
+   * @param logScales Vector in which scaling factors will be saved.
+   * @param forwardLogProb Matrix in which forward probabilities will be saved.
+   */
+  void Forward(const arma::mat& dataSeq,
+               const arma::mat& logProbs,
+               arma::vec& logScales,
+               arma::mat& forwardLogProb) const;
+
+  /**
+   * The Backward algorithm, using the given emission log-probabilities of each
+   * observation (as computed by EmissionLogProbabilities()) instead of
+   * evaluating the emission distributions again.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param logProbs Emission log-probabilities of each state (rows) for each
+   *     observation (columns).
+   * @param logScales Vector of scaling factors.
+   * @param backwardLogProb Matrix in which backward probabilities will be saved.
+   */
+  void Backward(const arma::mat& dataSeq,
+                const arma::mat& logProbs,
+                const arma::vec& logScales,
+                arma::mat& backwardLogProb) const;
+
+  /**
+   * Compute the log-probability of each observation in the given data sequence
+   * under the emission distribution of each state.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param logProbs Matrix in which the log-probabilities will be stored; it
+   *     has rows equal to the number of hidden states and columns equal to the
+   *     number of observations.
+   */
+  void EmissionLogProbabilities(const arma::mat& dataSeq,
+                                arma::mat& logProbs) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -419,6 +488,13 @@ class HMM
    */
   void ConvertToLogSpace() const;
 
+  /**
+   * Rebuild the lists of possible transitions (predecessorOffsets,
+   * predecessors, successorOffsets, and successors) from logTransition.  This
+   * must be called every time logTransition is modified.
+   */
+  void BuildTransitionStructure() const;
+
   /**
    * A proxy vriable in linear space for logInitial.
    * Should be removed in mlpack 4.0.
@@ -445,6 +521,25 @@ class HMM
    * Should be removed in mlpack 4.0.
    */
   mutable bool recalculateTransition;
+
+  /**
+   * The states that can transition into state i (that is, the nonzero entries
+   * of row i of the transition matrix) are stored in
+   * predecessors[predecessorOffsets[i]] to
+   * predecessors[predecessorOffsets[i + 1] - 1].
+   */
+  mutable arma::uvec predecessorOffsets;
+  //! The states that can transition into each state.
+  mutable arma::uvec predecessors;
+
+  /**
+   * The states that can be reached from state j (that is, the nonzero entries
+   * of column j of the transition matrix) are stored in
+   * successors[successorOffsets[j]] to successors[successorOffsets[j + 1] - 1].
+   */
+  mutable arma::uvec successorOffsets;
+  //! The states that can be reached from each state.
+  mutable arma::uvec successors;
 };
 
 } // namespace hmm
@@ -44,6 +44,7 @@ HMM<Distribution>::HMM(const size_t states,
 
   logTransition = log(transitionProxy);
   logInitial = log(initialProxy);
+  BuildTransitionStructure();
 }
 
 /**
@@ -74,6 +75,8 @@ HMM<Distribution>::HMM(const arma::vec& initial,
         << std::endl;
     dimensionality = 0;
   }
+
+  BuildTransitionStructure();
 }
 
 /**
@@ -101,10 +104,14 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  We also
+  // keep the offset of each sequence in the list of emissions, so that each
+  // sequence can be processed independently.
+  std::vector<size_t> seqOffsets(dataSeq.size());
   size_t totalLength = 0;
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -113,11 +120,29 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
           << dimensionality << " dimensions)." << std::endl;
   }
 
-  // These are used later for training of each distribution.  We initialize it
-  // all now so we don't have to do any allocation later on.
+  // These are used later for training of each distribution.  The observations
+  // do not change between iterations, so the list of emissions is assembled
+  // only once; if there is only one sequence, we can use its memory directly.
   std::vector<arma::vec> emissionProb(logTransition.n_cols,
       arma::vec(totalLength));
-  arma::mat emissionList(dimensionality, totalLength);
+  arma::mat emissionList;
+  if (dataSeq.size() == 1)
+  {
+    emissionList = arma::mat(const_cast<double*>(dataSeq[0].memptr()),
+        dataSeq[0].n_rows, dataSeq[0].n_cols, false, true);
+  }
+  else
+  {
+    emissionList.set_size(dimensionality, totalLength);
+    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    {
+      if (dataSeq[seq].n_cols > 0)
+      {
+        emissionList.cols(seqOffsets[seq],
+            seqOffsets[seq] + dataSeq[seq].n_cols - 1) = dataSeq[seq];
+      }
+    }
+  }
 
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
@@ -133,53 +158,96 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
+    // Make sure the log-space parameters are up to date before the sequences
+    // are processed in parallel.
+    ConvertToLogSpace();
 
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // Each sequence is independent, so the sequences are split between the
+    // threads.  Each thread accumulates its own sufficient statistics, which
+    // are combined at the end.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
+      arma::vec localLogInitial(logTransition.n_rows);
+      localLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat localLogTransition(logTransition.n_rows, logTransition.n_cols);
+      localLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double localLoglik = 0;
+
+      arma::mat logProbs;
       arma::mat forwardLog;
       arma::mat backwardLog;
       arma::vec logScales;
 
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      for (size_t j = 0; j < logTransition.n_cols; ++j)
-        newLogInitial[j] = math::LogAdd(newLogInitial[j], stateLogProb(j, 0));
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); ++seq)
       {
+        if (dataSeq[seq].n_cols == 0)
+          continue;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.  The
+        // emission log-probabilities of the sequence are only computed once.
+        EmissionLogProbabilities(dataSeq[seq], logProbs);
+        Forward(dataSeq[seq], logProbs, logScales, forwardLog);
+        Backward(dataSeq[seq], logProbs, logScales, backwardLog);
+        localLoglik += accu(logScales);
+
+        // Add to estimate of initial probability for state j.
         for (size_t j = 0; j < logTransition.n_cols; ++j)
         {
-          if (t < dataSeq[seq].n_cols - 1)
+          localLogInitial[j] = math::LogAdd(localLogInitial[j],
+              forwardLog(j, 0) + backwardLog(j, 0));
+        }
+
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        const size_t offset = seqOffsets[seq];
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
-            for (size_t i = 0; i < logTransition.n_rows; ++i)
+            if (t < dataSeq[seq].n_cols - 1)
             {
-              newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
-                  forwardLog(j, t) + backwardLog(i, t + 1) +
-                  emission[i].LogProbability(dataSeq[seq].unsafe_col(t + 1)) -
-                  logScales[t + 1]);
+              // Estimate of T_ij (probability of transition from state j to
+              // state i).  We postpone multiplication of the old T_ij until
+              // later.  Transitions that are impossible under the current
+              // model will remain impossible, so we skip them.
+              for (size_t k = successorOffsets[j]; k < successorOffsets[j + 1];
+                  ++k)
+              {
+                const size_t i = successors[k];
+                localLogTransition(i, j) = math::LogAdd(
+                    localLogTransition(i, j), forwardLog(j, t) +
+                    backwardLog(i, t + 1) + logProbs(i, t + 1) -
+                    logScales[t + 1]);
+              }
             }
+
+            // Store the weight of this observation for Distribution::Train().
+            emissionProb[j][offset + t] = exp(forwardLog(j, t) +
+                backwardLog(j, t));
           }
+        }
+      }
 
-          // Add to list of emission observations, for Distribution::Train().
-          emissionList.col(sumTime) = dataSeq[seq].col(t);
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+      // Combine the statistics calculated by each thread.
+      #pragma omp critical
+      {
+        loglik += localLoglik;
+        for (size_t j = 0; j < newLogInitial.n_elem; ++j)
+        {
+          newLogInitial[j] = math::LogAdd(newLogInitial[j],
+              localLogInitial[j]);
+        }
+        for (size_t i = 0; i < newLogTransition.n_elem; ++i)
+        {
+          newLogTransition[i] = math::LogAdd(newLogTransition[i],
+              localLogTransition[i]);
         }
-        sumTime++;
       }
     }
 
@@ -215,6 +283,8 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
 
     initialProxy = exp(logInitial);
     transitionProxy = exp(logTransition);
+    BuildTransitionStructure();
+
     // Now estimate emission probabilities.
     for (size_t state = 0; state < logTransition.n_cols; state++)
       emission[state].Train(emissionList, emissionProb[state]);
@@ -300,6 +370,7 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
   transitionProxy = transition;
   logTransition = log(transition);
   logInitial = log(initial);
+  BuildTransitionStructure();
 
   // Estimate emission matrix.
   for (size_t state = 0; state < transition.n_cols; state++)
@@ -468,14 +539,17 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
 
   ConvertToLogSpace();
 
+  // Compute the emission probabilities of every observation only once.
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
+
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
   // came to be j from another state.
   logStateProb.col(0).zeros();
   for (size_t state = 0; state < logTransition.n_rows; state++)
   {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
+    logStateProb(state, 0) = logInitial[state] + logProbs(state, 0);
     stateSeqBack(state, 0) = state;
   }
 
@@ -485,13 +559,28 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
   {
     // Assemble the state probability for this element.
     // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
+    // of being the previous state.  Only states that can transition to state j
+    // are considered.
     for (size_t j = 0; j < logTransition.n_rows; ++j)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-      stateSeqBack(j, t) = index;
+      double bestLogProb = -std::numeric_limits<double>::infinity();
+      size_t bestState = (predecessorOffsets[j] < predecessorOffsets[j + 1]) ?
+          predecessors[predecessorOffsets[j]] : 0;
+      for (size_t k = predecessorOffsets[j]; k < predecessorOffsets[j + 1];
+          ++k)
+      {
+        const size_t state = predecessors[k];
+        const double prob = logStateProb(state, t - 1) +
+            logTransition(j, state);
+        if (prob > bestLogProb)
+        {
+          bestLogProb = prob;
+          bestState = state;
+        }
+      }
+
+      logStateProb(j, t) = bestLogProb + logProbs(j, t);
+      stateSeqBack(j, t) = bestState;
     }
   }
 
@@ -507,6 +596,28 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
   return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
 }
 
+/**
+ * Compute the most probable hidden state sequence for each of the given
+ * observation sequences using the Viterbi algorithm.  The sequences are decoded
+ * in parallel.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t> >& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  stateSeq.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+
+  // Make sure the log-space parameters are up to date before any thread reads
+  // them.
+  ConvertToLogSpace();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); ++seq)
+    logLikelihoods[seq] = Predict(dataSeq[seq], stateSeq[seq]);
+}
+
 /**
  * Compute the log-likelihood of the given data sequence.
  */
@@ -577,6 +688,21 @@ template<typename Distribution>
 void HMM<Distribution>::Forward(const arma::mat& dataSeq,
                                 arma::vec& logScales,
                                 arma::mat& forwardLogProb) const
+{
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
+  Forward(dataSeq, logProbs, logScales, forwardLogProb);
+}
+
+/**
+ * The Forward procedure (part of the Forward-Backward algorithm), using
+ * precomputed emission log-probabilities.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Forward(const arma::mat& dataSeq,
+                                const arma::mat& logProbs,
+                                arma::vec& logScales,
+                                arma::mat& forwardLogProb) const
 {
   // Our goal is to calculate the forward probabilities:
   //  P(X_k | o_{1:k}) for all possible states X_k, for each time point k.
@@ -593,10 +719,7 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
   for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    forwardLogProb(state, 0) = logInitial(state) +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-  }
+    forwardLogProb(state, 0) = logInitial(state) + logProbs(state, 0);
 
   // Then normalize the column.
   logScales[0] = math::AccuLog(forwardLogProb.col(0));
@@ -604,16 +727,27 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
     forwardLogProb.col(0) -= logScales[0];
 
   // Now compute the probabilities for each successive observation.
+  arma::vec tmp(logTransition.n_rows);
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
     for (size_t j = 0; j < logTransition.n_rows; ++j)
     {
       // The forward probability of state j at time t is the sum over all states
       // of the probability of the previous state transitioning to the current
-      // state and emitting the given observation.
-      arma::vec tmp = forwardLogProb.col(t - 1) + logTransition.row(j).t();
-      forwardLogProb(j, t) = math::AccuLog(tmp) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
+      // state and emitting the given observation.  Only the states that can
+      // transition to state j contribute to the sum.
+      const size_t begin = predecessorOffsets[j];
+      const size_t count = predecessorOffsets[j + 1] - begin;
+      if (count == 0)
+        continue;
+
+      for (size_t k = 0; k < count; ++k)
+      {
+        const size_t state = predecessors[begin + k];
+        tmp[k] = forwardLogProb(state, t - 1) + logTransition(j, state);
+      }
+
+      forwardLogProb(j, t) = math::AccuLog(tmp.head(count)) + logProbs(j, t);
     }
 
     // Normalize probability.
@@ -623,10 +757,28 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
   }
 }
 
+/**
+ * The Backward procedure (part of the Forward-Backward algorithm).
+ */
 template<typename Distribution>
 void HMM<Distribution>::Backward(const arma::mat& dataSeq,
                                  const arma::vec& logScales,
                                  arma::mat& backwardLogProb) const
+{
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
+  Backward(dataSeq, logProbs, logScales, backwardLogProb);
+}
+
+/**
+ * The Backward procedure (part of the Forward-Backward algorithm), using
+ * precomputed emission log-probabilities.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Backward(const arma::mat& dataSeq,
+                                 const arma::mat& logProbs,
+                                 const arma::vec& logScales,
+                                 arma::mat& backwardLogProb) const
 {
   // Our goal is to calculate the backward probabilities:
   //  P(X_k | o_{k + 1:T}) for all possible states X_k, for each time point k.
@@ -637,21 +789,34 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
   // Now step backwards through all other observations.
+  arma::vec next(logTransition.n_rows);
+  arma::vec tmp(logTransition.n_rows);
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
+    // The probability of each state at time t + 1 emitting its observation
+    // does not depend on the current state.
+    next = backwardLogProb.col(t + 1) + logProbs.col(t + 1);
+
     for (size_t j = 0; j < logTransition.n_rows; ++j)
     {
       // The backward probability of state j at time t is the sum over all state
       // of the probability of the next state having been a transition from the
       // current state multiplied by the probability of each of those states
-      // emitting the given observation.
-      for (size_t state = 0; state < logTransition.n_rows; state++)
+      // emitting the given observation.  Only the states reachable from state j
+      // contribute to the sum.
+      const size_t begin = successorOffsets[j];
+      const size_t count = successorOffsets[j + 1] - begin;
+      if (count == 0)
+        continue;
+
+      for (size_t k = 0; k < count; ++k)
       {
-        backwardLogProb(j, t) = math::LogAdd(backwardLogProb(j, t),
-            logTransition(state, j) + backwardLogProb(state, t + 1)
-            + emission[state].LogProbability(dataSeq.unsafe_col(t + 1)));
+        const size_t state = successors[begin + k];
+        tmp[k] = logTransition(state, j) + next[state];
       }
 
+      backwardLogProb(j, t) = math::AccuLog(tmp.head(count));
+
       // Normalize by the weights from the forward algorithm.
       if (std::isfinite(logScales[t + 1]))
         backwardLogProb(j, t) -= logScales[t + 1];
@@ -659,6 +824,24 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   }
 }
 
+/**
+ * Compute the emission log-probability of each observation for each state.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionLogProbabilities(const arma::mat& dataSeq,
+                                                 arma::mat& logProbs) const
+{
+  logProbs.set_size(emission.size(), dataSeq.n_cols);
+  for (size_t t = 0; t < dataSeq.n_cols; ++t)
+  {
+    for (size_t state = 0; state < emission.size(); ++state)
+    {
+      logProbs(state, t) =
+          emission[state].LogProbability(dataSeq.unsafe_col(t));
+    }
+  }
+}
+
 /**
  * Make sure the variables in log space are in sync with the linear counter parts
  */
@@ -674,10 +857,58 @@ void HMM<Distribution>::ConvertToLogSpace() const
   if (recalculateTransition)
   {
     logTransition = log(transitionProxy);
+    BuildTransitionStructure();
     recalculateTransition = false;
   }
 }
 
+/**
+ * Collect, for each state, the states it can be reached from and the states
+ * that can be reached from it.
+ */
+template<typename Distribution>
+void HMM<Distribution>::BuildTransitionStructure() const
+{
+  const size_t states = logTransition.n_rows;
+  const double negInf = -std::numeric_limits<double>::infinity();
+
+  // First count the number of possible transitions into and out of each state.
+  predecessorOffsets.zeros(states + 1);
+  successorOffsets.zeros(logTransition.n_cols + 1);
+  for (size_t j = 0; j < logTransition.n_cols; ++j)
+  {
+    for (size_t i = 0; i < states; ++i)
+    {
+      if (logTransition(i, j) != negInf)
+      {
+        ++predecessorOffsets[i + 1];
+        ++successorOffsets[j + 1];
+      }
+    }
+  }
+
+  predecessorOffsets = arma::cumsum(predecessorOffsets);
+  successorOffsets = arma::cumsum(successorOffsets);
+
+  // Now fill the lists.  Since we walk the matrix in column-major order, each
+  // list is sorted.
+  predecessors.set_size(predecessorOffsets[states]);
+  successors.set_size(successorOffsets[logTransition.n_cols]);
+  arma::uvec predecessorPos = predecessorOffsets.head(states);
+  size_t successorPos = 0;
+  for (size_t j = 0; j < logTransition.n_cols; ++j)
+  {
+    for (size_t i = 0; i < states; ++i)
+    {
+      if (logTransition(i, j) != negInf)
+      {
+        predecessors[predecessorPos[i]++] = j;
+        successors[successorPos++] = i;
+      }
+    }
+  }
+}
+
 //! Serialize the HMM.
 template<typename Distribution>
 template<typename Archive>
@@ -700,6 +931,7 @@ void HMM<Distribution>::load(Archive& ar, const unsigned int /* version */)
   logInitial = log(initial);
   initialProxy = std::move(initial);
   transitionProxy = std::move(transition);
+  BuildTransitionStructure();
 }
 
 //! Serialize the HMM.
@@ -192,6 +192,22 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a mini-batch of points in streaming mode, with the given labels.
+   * All points are routed to their leaves at once, the statistics of every
+   * dimension of a leaf are updated in parallel (if OpenMP is available), and
+   * each leaf checks for a split at most once per mini-batch, if its number of
+   * samples crossed a multiple of the check interval.  If a leaf splits, the
+   * points of the mini-batch it already saw are not passed to the new
+   * children.  For mini-batches of one point, this is equivalent to
+   * Train(point, label).
+   *
+   * @param data Mini-batch of points to train on.
+   * @param labels Labels of the points.
+   */
+  template<typename MatType>
+  void TrainMiniBatch(const MatType& data, const arma::Row<size_t>& labels);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -314,6 +330,18 @@ class HoeffdingTree
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Train on the given points of a mini-batch in streaming mode.
+   *
+   * @param data Mini-batch of points.
+   * @param labels Labels of the points of the mini-batch.
+   * @param points Indices of the points that reach this node.
+   */
+  template<typename MatType>
+  void TrainMiniBatch(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const arma::uvec& points);
+
   // We need to keep some information for before we have split.
 
   //! Information for splitting of numeric features (used before split).
@@ -429,6 +429,101 @@ void HoeffdingTree<
   }
 }
 
+//! Train on a mini-batch of points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainMiniBatch(const MatType& data, const arma::Row<size_t>& labels)
+{
+  if (data.n_cols == 0)
+    return;
+
+  TrainMiniBatch(data, labels, arma::regspace<arma::uvec>(0, data.n_cols - 1));
+}
+
+//! Train on the points of a mini-batch that reach this node.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainMiniBatch(const MatType& data,
+                  const arma::Row<size_t>& labels,
+                  const arma::uvec& points)
+{
+  if (splitDimension != size_t(-1))
+  {
+    // Already split.  Route all the points to the relevant children at once.
+    arma::Col<size_t> directions(points.n_elem);
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) points.n_elem; ++i)
+      directions[i] = CalculateDirection(data.col(points[i]));
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+      const arma::uvec childPoints = points.elem(arma::find(directions == i));
+      if (childPoints.n_elem > 0)
+        children[i]->TrainMiniBatch(data, labels, childPoints);
+    }
+
+    return;
+  }
+
+  // The statistics of each dimension are kept in a separate split object, so
+  // they can be updated in parallel.
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    const size_t type = dimensionMappings->at(d).first;
+    const size_t index = dimensionMappings->at(d).second;
+    if (type == data::Datatype::categorical)
+    {
+      for (size_t i = 0; i < points.n_elem; ++i)
+        categoricalSplits[index].Train(data(d, points[i]), labels[points[i]]);
+    }
+    else if (type == data::Datatype::numeric)
+    {
+      for (size_t i = 0; i < points.n_elem; ++i)
+        numericSplits[index].Train(data(d, points[i]), labels[points[i]]);
+    }
+  }
+
+  const size_t oldNumSamples = numSamples;
+  numSamples += points.n_elem;
+
+  // Grab majority class from splits.
+  if (categoricalSplits.size() > 0)
+  {
+    majorityClass = categoricalSplits[0].MajorityClass();
+    majorityProbability = categoricalSplits[0].MajorityProbability();
+  }
+  else
+  {
+    majorityClass = numericSplits[0].MajorityClass();
+    majorityProbability = numericSplits[0].MajorityProbability();
+  }
+
+  // Check for a split once, if we passed a multiple of the check interval.
+  if (numSamples / checkInterval > oldNumSamples / checkInterval)
+  {
+    const size_t numChildren = SplitCheck();
+    if (numChildren > 0)
+    {
+      // We need to add a bunch of children.
+      children.clear();
+      CreateChildren();
+    }
+  }
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
@@ -48,7 +48,11 @@ PROGRAM_INFO("Hoeffding trees",
     "The training may be performed in batch mode "
     "(like a typical decision tree algorithm) by specifying the " +
     PRINT_PARAM_STRING("batch_mode") + " option, but this may not be the best "
-    "option for large datasets."
+    "option for large datasets.  In streaming mode, the points can be "
+    "considered in mini-batches of the size given with " +
+    PRINT_PARAM_STRING("mini_batch_size") + "; the statistics of all "
+    "dimensions are then updated in parallel, and splits are only checked once "
+    "per mini-batch."
     "\n\n"
     "When a model is trained, it may be saved via the " +
     PRINT_PARAM_STRING("output_model") + " output parameter.  A model may be "
@@ -115,6 +119,8 @@ PARAM_FLAG("batch_mode", "If true, samples will be considered in batch instead "
 PARAM_FLAG("info_gain", "If set, information gain is used instead of Gini "
     "impurity for calculating Hoeffding bounds.", "i");
 PARAM_INT_IN("passes", "Number of passes to take over the dataset.", "s", 1);
+PARAM_INT_IN("mini_batch_size", "If nonzero and batch mode is not used, the "
+    "number of samples considered at once in streaming mode.", "", 0);
 
 PARAM_INT_IN("bins", "If the 'domingos' split strategy is used, this specifies "
     "the number of bins for each numeric split.", "B", 10);
@@ -141,6 +147,11 @@ static void mlpackMain()
 
   ReportIgnoredParam({{ "training", false }}, "batch_mode");
   ReportIgnoredParam({{ "training", false }}, "passes");
+  ReportIgnoredParam({{ "training", false }}, "mini_batch_size");
+  ReportIgnoredParam({{ "batch_mode", true }}, "mini_batch_size");
+
+  RequireParamValue<int>("mini_batch_size", [](int x) { return x >= 0; }, true,
+      "mini-batch size must be nonnegative");
 
   if (IO::HasParam("test"))
   {
@@ -187,6 +198,8 @@ static void mlpackMain()
     size_t passes = (size_t) IO::GetParam<int>("passes");
     if (passes > 1)
       batchTraining = false; // We already warned about this earlier.
+    const size_t miniBatchSize = batchTraining ? 0 :
+        (size_t) IO::GetParam<int>("mini_batch_size");
 
     // We need to train the model.  First, load the data.
     datasetInfo = std::move(std::get<0>(IO::GetParam<TupleType>("training")));
@@ -216,7 +229,14 @@ static void mlpackMain()
     Timer::Start("tree_training");
 
     // Do we need to initialize a model?
-    if (!IO::HasParam("input_model"))
+    if (!IO::HasParam("input_model") && miniBatchSize > 0)
+    {
+      // Build an empty model; all passes are then taken in mini-batches.
+      model->BuildModel(arma::mat(trainingSet.n_rows, 0), datasetInfo,
+          arma::Row<size_t>(), arma::max(labels) + 1, false, confidence,
+          maxSamples, 100, minSamples, bins, observationsBeforeBinning);
+    }
+    else if (!IO::HasParam("input_model"))
     {
       // Build the model.
       model->BuildModel(trainingSet, datasetInfo, labels,
@@ -236,7 +256,7 @@ static void mlpackMain()
     else
     {
       for (size_t p = 0; p < passes; ++p)
-        model->Train(trainingSet, labels, false);
+        model->Train(trainingSet, labels, false, miniBatchSize);
     }
 
     Timer::Stop("tree_training");
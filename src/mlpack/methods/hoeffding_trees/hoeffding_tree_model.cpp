@@ -184,28 +184,56 @@ void HoeffdingTreeModel::BuildModel(
   }
 }
 
+// Train the given tree on one pass of the dataset, in mini-batches if
+// requested.
+template<typename TreeType>
+void TrainTree(TreeType& tree,
+               const arma::mat& dataset,
+               const arma::Row<size_t>& labels,
+               const bool batchTraining,
+               const size_t miniBatchSize)
+{
+  if (batchTraining || miniBatchSize == 0)
+  {
+    tree.Train(dataset, labels, batchTraining);
+    return;
+  }
+
+  for (size_t i = 0; i < dataset.n_cols; i += miniBatchSize)
+  {
+    const size_t last = std::min(i + miniBatchSize, (size_t) dataset.n_cols) -
+        1;
+    tree.TrainMiniBatch(dataset.cols(i, last), labels.subvec(i, last));
+  }
+}
+
 // Train the model on one pass of the dataset.
 void HoeffdingTreeModel::Train(const arma::mat& dataset,
                                const arma::Row<size_t>& labels,
-                               const bool batchTraining)
+                               const bool batchTraining,
+                               const size_t miniBatchSize)
 {
   // Depending on the type, pass through once.
   switch (type)
   {
     case GINI_HOEFFDING:
-      giniHoeffdingTree->Train(dataset, labels, batchTraining);
+      TrainTree(*giniHoeffdingTree, dataset, labels, batchTraining,
+          miniBatchSize);
       break;
 
     case GINI_BINARY:
-      giniBinaryTree->Train(dataset, labels, batchTraining);
+      TrainTree(*giniBinaryTree, dataset, labels, batchTraining,
+          miniBatchSize);
       break;
 
     case INFO_HOEFFDING:
-      infoHoeffdingTree->Train(dataset, labels, batchTraining);
+      TrainTree(*infoHoeffdingTree, dataset, labels, batchTraining,
+          miniBatchSize);
       break;
 
     case INFO_BINARY:
-      infoBinaryTree->Train(dataset, labels, batchTraining);
+      TrainTree(*infoBinaryTree, dataset, labels, batchTraining,
+          miniBatchSize);
       break;
   }
 }
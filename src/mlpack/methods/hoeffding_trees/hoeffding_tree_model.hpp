@@ -130,10 +130,14 @@ class HoeffdingTreeModel
    * @param dataset Dataset to train on.
    * @param labels Labels for training set.
    * @param batchTraining Whether or not to train in batch.
+   * @param miniBatchSize If nonzero and batchTraining is false, the points are
+   *      streamed in mini-batches of this size (see
+   *      HoeffdingTree::TrainMiniBatch()).
    */
   void Train(const arma::mat& dataset,
              const arma::Row<size_t>& labels,
-             const bool batchTraining);
+             const bool batchTraining,
+             const size_t miniBatchSize = 0);
 
   /**
    * Using the model, classify the given test points.  Be sure that BuildModel()
@@ -48,9 +48,11 @@ class KernelPCA
    *
    * @param kernel Kernel to be used for computation.
    * @param centerTransformedData Center transformed data.
+   * @param kernelRule Instantiated rule used to compute the kernel matrix.
    */
   KernelPCA(const KernelType kernel = KernelType(),
-            const bool centerTransformedData = false);
+            const bool centerTransformedData = false,
+            const KernelRule kernelRule = KernelRule());
 
   /**
    * Apply Kernel Principal Components Analysis to the provided data set.
@@ -111,6 +113,11 @@ class KernelPCA
   //! Modify the kernel.
   KernelType& Kernel() { return kernel; }
 
+  //! Get the rule used to compute the kernel matrix.
+  const KernelRule& Rule() const { return kernelRule; }
+  //! Modify the rule used to compute the kernel matrix.
+  KernelRule& Rule() { return kernelRule; }
+
   //! Return whether or not the transformed data is centered.
   bool CenterTransformedData() const { return centerTransformedData; }
   //! Return whether or not the transformed data is centered.
@@ -119,6 +126,8 @@ class KernelPCA
  private:
   //! The instantiated kernel.
   KernelType kernel;
+  //! The instantiated rule used to compute the kernel matrix.
+  KernelRule kernelRule;
   //! If true, the data will be scaled (by standard deviation) when Apply() is
   //! run.
   bool centerTransformedData;
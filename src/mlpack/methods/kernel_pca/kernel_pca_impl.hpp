@@ -22,8 +22,10 @@ namespace kpca {
 
 template <typename KernelType, typename KernelRule>
 KernelPCA<KernelType, KernelRule>::KernelPCA(const KernelType kernel,
-                                 const bool centerTransformedData) :
+                                 const bool centerTransformedData,
+                                 const KernelRule kernelRule) :
       kernel(kernel),
+      kernelRule(kernelRule),
       centerTransformedData(centerTransformedData)
 { }
 
@@ -35,8 +37,8 @@ void KernelPCA<KernelType, KernelRule>::Apply(const arma::mat& data,
                                   arma::mat& eigvec,
                                   const size_t newDimension)
 {
-  KernelRule::ApplyKernelMatrix(data, transformedData, eigval,
-                                eigvec, newDimension, kernel);
+  kernelRule.ApplyKernelMatrix(data, transformedData, eigval,
+                               eigvec, newDimension, kernel);
 
   // Center the transformed data, if the user asked for it.
   if (centerTransformedData)
@@ -77,7 +79,9 @@ void KernelPCA<KernelType, KernelRule>::Apply(arma::mat& data,
 
   Apply(data, data, eigVal, coeffs, newDimension);
 
-  if (newDimension < coeffs.n_rows && newDimension > 0)
+  // The rows of the transformed data are the components.  Some rules only
+  // compute as many components as needed.
+  if (newDimension < data.n_rows && newDimension > 0)
     data.shed_rows(newDimension, data.n_rows - 1);
 }
 
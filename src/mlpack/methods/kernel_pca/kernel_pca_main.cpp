@@ -30,6 +30,7 @@
 #include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
 #include <mlpack/methods/nystroem_method/nystroem_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/random_fourier_method.hpp>
 
 #include "kernel_pca.hpp"
 
@@ -98,7 +99,15 @@ PROGRAM_INFO("Kernel Principal Components Analysis",
     "the kernel matrix; to specify the sampling scheme, the " +
     PRINT_PARAM_STRING("sampling") + " parameter is used.  The "
     "sampling scheme for the Nystroem method can be chosen from the "
-    "following list: 'kmeans', 'random', 'ordered'.",
+    "following list: 'kmeans', 'random', 'ordered'."
+    "\n\n"
+    "For the 'gaussian' and 'laplacian' kernels, the kernel matrix can instead "
+    "be approximated with random Fourier features (\"Random Features for "
+    "Large-Scale Kernel Machines\", 2008) by specifying the " +
+    PRINT_PARAM_STRING("random_fourier_features") + " parameter.  This never "
+    "builds a matrix larger than the number of features squared, so it can be "
+    "used on datasets too large for the kernel matrix; the number of features "
+    "is given with the " + PRINT_PARAM_STRING("num_features") + " parameter.",
     SEE_ALSO("Kernel principal component analysis on Wikipedia",
         "https://en.wikipedia.org/wiki/Kernel_principal_component_analysis"),
     SEE_ALSO("Kernel Principal Component Analysis (pdf)",
@@ -123,6 +132,11 @@ PARAM_FLAG("nystroem_method", "If set, the Nystroem method will be used.", "n");
 PARAM_STRING_IN("sampling", "Sampling scheme to use for the Nystroem method: "
     "'kmeans', 'random', 'ordered'", "s", "kmeans");
 
+PARAM_FLAG("random_fourier_features", "If set, the kernel matrix will be "
+    "approximated with random Fourier features.", "R");
+PARAM_INT_IN("num_features", "Number of random Fourier features to use.", "F",
+    256);
+
 PARAM_DOUBLE_IN("kernel_scale", "Scale, for 'hyptan' kernel.", "S", 1.0);
 PARAM_DOUBLE_IN("offset", "Offset, for 'hyptan' and 'polynomial' kernels.", "O",
     0.0);
@@ -136,11 +150,20 @@ template<typename KernelType>
 void RunKPCA(arma::mat& dataset,
              const bool centerTransformedData,
              const bool nystroem,
+             const bool fourier,
+             const size_t numFeatures,
              const size_t newDim,
              const string& sampling,
              KernelType& kernel)
 {
-  if (nystroem)
+  if (fourier)
+  {
+    KernelPCA<KernelType, RandomFourierKernelRule<KernelType> > kpca(kernel,
+        centerTransformedData, RandomFourierKernelRule<KernelType>(
+        numFeatures));
+    kpca.Apply(dataset, newDim);
+  }
+  else if (nystroem)
   {
     // Make sure the sampling scheme is valid.
     if (sampling == "kmeans")
@@ -206,19 +229,38 @@ static void mlpackMain()
   const bool nystroem = IO::HasParam("nystroem_method");
   const string sampling = IO::GetParam<string>("sampling");
 
+  const bool fourier = IO::HasParam("random_fourier_features");
+  if (fourier && nystroem)
+  {
+    Log::Fatal << "Can only pass one of "
+        << PRINT_PARAM_STRING("nystroem_method") << " or "
+        << PRINT_PARAM_STRING("random_fourier_features") << "!" << endl;
+  }
+
+  if (fourier && kernelType != "gaussian" && kernelType != "laplacian")
+  {
+    Log::Fatal << "Random Fourier features can only be used with the "
+        << "'gaussian' and 'laplacian' kernels!" << endl;
+  }
+
+  ReportIgnoredParam({{ "random_fourier_features", false }}, "num_features");
+  RequireParamValue<int>("num_features", [](int x) { return x > 0; }, true,
+      "number of features must be positive");
+  const size_t numFeatures = (size_t) IO::GetParam<int>("num_features");
+
   if (kernelType == "linear")
   {
     LinearKernel kernel;
-    RunKPCA<LinearKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<LinearKernel>(dataset, centerTransformedData, nystroem, fourier,
+        numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "gaussian")
   {
     const double bandwidth = IO::GetParam<double>("bandwidth");
 
     GaussianKernel kernel(bandwidth);
-    RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem, fourier,
+        numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "polynomial")
   {
@@ -227,7 +269,7 @@ static void mlpackMain()
 
     PolynomialKernel kernel(degree, offset);
     RunKPCA<PolynomialKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        fourier, numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "hyptan")
   {
@@ -236,15 +278,15 @@ static void mlpackMain()
 
     HyperbolicTangentKernel kernel(scale, offset);
     RunKPCA<HyperbolicTangentKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        fourier, numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "laplacian")
   {
     const double bandwidth = IO::GetParam<double>("bandwidth");
 
     LaplacianKernel kernel(bandwidth);
-    RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem, fourier,
+        numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "epanechnikov")
   {
@@ -252,13 +294,13 @@ static void mlpackMain()
 
     EpanechnikovKernel kernel(bandwidth);
     RunKPCA<EpanechnikovKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        fourier, numFeatures, newDim, sampling, kernel);
   }
   else if (kernelType == "cosine")
   {
     CosineDistance kernel;
-    RunKPCA<CosineDistance>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<CosineDistance>(dataset, centerTransformedData, nystroem, fourier,
+        numFeatures, newDim, sampling, kernel);
   }
 
   // Save the output dataset.
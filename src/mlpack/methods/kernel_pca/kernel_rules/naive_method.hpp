@@ -46,10 +46,12 @@ class NaiveKernelRule
 
   // Note that we only need to calculate the upper triangular part of the
   // kernel matrix, since it is symmetric. This helps minimize the number of
-  // kernel evaluations.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // kernel evaluations.  Every column is filled by one thread; the columns get
+  // longer, so they are handed out dynamically.
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
   {
-    for (size_t j = i; j < data.n_cols; ++j)
+    for (size_t i = 0; i <= (size_t) j; ++i)
     {
       // Evaluate the kernel on these two points.
       kernelMatrix(i, j) = kernel.Evaluate(data.unsafe_col(i),
@@ -58,9 +60,7 @@ class NaiveKernelRule
   }
 
   // Copy to the lower triangular part of the matrix.
-  for (size_t i = 1; i < data.n_cols; ++i)
-    for (size_t j = 0; j < i; ++j)
-      kernelMatrix(i, j) = kernelMatrix(j, i);
+  kernelMatrix = arma::symmatu(kernelMatrix);
 
   // For PCA the data has to be centered, even if the data is centered. But it
   // is not guaranteed that the data, when mapped to the kernel space, is also
@@ -0,0 +1,269 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/random_fourier_method.hpp
+ *
+ * Use random Fourier features to approximate the kernel matrix of a
+ * shift-invariant kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/laplacian_kernel.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * Approximate the kernel matrix with random Fourier features, as described in
+ * the following paper:
+ *
+ * @code
+ * @inproceedings{rahimi2008random,
+ *   title={Random Features for Large-Scale Kernel Machines},
+ *   author={Rahimi, Ali and Recht, Benjamin},
+ *   booktitle={Advances in Neural Information Processing Systems},
+ *   pages={1177--1184},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * Every point x is mapped to z(x) = sqrt(2 / D) cos(W^T x + b), where the D
+ * columns of W are sampled from the Fourier transform of the kernel and b is
+ * uniform in [0, 2 pi], so that z(x)^T z(y) approximates K(x, y).  The kernel
+ * principal components are then the principal components of the features,
+ * which only needs a D x D covariance matrix instead of the n x n kernel
+ * matrix.  The features are computed in blocks of points, so the feature
+ * matrix of the whole dataset is never stored either.  When fewer components
+ * than features are needed, they are computed with a randomized eigensolver.
+ *
+ * Only shift-invariant kernels have a Fourier transform; the GaussianKernel
+ * and the LaplacianKernel are supported.
+ *
+ * @tparam KernelType The kernel to approximate.
+ */
+template<typename KernelType>
+class RandomFourierKernelRule
+{
+ public:
+  /**
+   * Create the rule.
+   *
+   * @param numFeatures Number of random features to use.
+   * @param powerIterations Number of power iterations of the randomized
+   *     eigensolver.
+   */
+  RandomFourierKernelRule(const size_t numFeatures = 256,
+                          const size_t powerIterations = 2) :
+      numFeatures(numFeatures),
+      powerIterations(powerIterations)
+  { }
+
+  /**
+   * Compute the kernel principal components of the approximated kernel
+   * matrix.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Number of components to compute (at most the number of
+   *     features).
+   * @param kernel Kernel to be used for computation.
+   */
+  void ApplyKernelMatrix(const arma::mat& data,
+                         arma::mat& transformedData,
+                         arma::vec& eigval,
+                         arma::mat& eigvec,
+                         const size_t rank,
+                         KernelType kernel = KernelType()) const
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("RandomFourierKernelRule::"
+          "ApplyKernelMatrix(): the number of features must be positive!");
+    }
+
+    arma::mat frequencies;
+    SampleFrequencies(kernel, data.n_rows, frequencies);
+    const arma::vec phases = 2 * M_PI * arma::randu<arma::vec>(numFeatures);
+
+    // Accumulate the mean and the scatter matrix of the features block by
+    // block.
+    arma::vec mean(numFeatures, arma::fill::zeros);
+    arma::mat scatter(numFeatures, numFeatures, arma::fill::zeros);
+    arma::mat features;
+    for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+      Features(data.cols(begin, end - 1), frequencies, phases, features);
+      mean += arma::sum(features, 1);
+      scatter += features * features.t();
+    }
+    mean /= data.n_cols;
+
+    // Center the features, which centers the approximated kernel matrix.
+    scatter -= data.n_cols * mean * mean.t();
+    scatter = arma::symmatu(scatter);
+
+    const size_t dimensionality = std::min(rank, numFeatures);
+    if (dimensionality + oversampling < numFeatures)
+    {
+      RandomizedEig(scatter, dimensionality, eigval, eigvec);
+    }
+    else
+    {
+      if (!arma::eig_sym(eigval, eigvec, scatter))
+      {
+        Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
+      }
+
+      // We need the eigenvalues from largest to smallest.
+      eigval = arma::flipud(eigval.tail(dimensionality));
+      eigvec = arma::fliplr(eigvec.tail_cols(dimensionality));
+    }
+
+    // Project the centered features of every point.  The data may be the
+    // output matrix, so it can't be overwritten before the last block.
+    arma::mat projections(dimensionality, data.n_cols);
+    const arma::vec meanProjection = eigvec.t() * mean;
+    for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+      Features(data.cols(begin, end - 1), frequencies, phases, features);
+      projections.cols(begin, end - 1) = eigvec.t() * features;
+      projections.cols(begin, end - 1).each_col() -= meanProjection;
+    }
+
+    transformedData = std::move(projections);
+  }
+
+  //! Get the number of random features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of random features.
+  size_t& NumFeatures() { return numFeatures; }
+
+  //! Get the number of power iterations of the randomized eigensolver.
+  size_t PowerIterations() const { return powerIterations; }
+  //! Modify the number of power iterations of the randomized eigensolver.
+  size_t& PowerIterations() { return powerIterations; }
+
+ private:
+  //! The number of points whose features are computed at once.
+  static const size_t blockSize = 1024;
+
+  //! The number of extra directions used by the randomized eigensolver.
+  static const size_t oversampling = 10;
+
+  /**
+   * Compute the random features of the given points.
+   *
+   * @param points The points to map.
+   * @param frequencies The sampled frequencies, one per column.
+   * @param phases The sampled phases.
+   * @param features Matrix to store the features in, one column per point.
+   */
+  void Features(const arma::mat& points,
+                const arma::mat& frequencies,
+                const arma::vec& phases,
+                arma::mat& features) const
+  {
+    features = frequencies.t() * points;
+    features.each_col() += phases;
+    features = std::sqrt(2.0 / numFeatures) * arma::cos(features);
+  }
+
+  /**
+   * Sample the frequencies of the Gaussian kernel, which are normally
+   * distributed with a standard deviation of 1 / bandwidth.
+   */
+  void SampleFrequencies(const kernel::GaussianKernel& kernel,
+                         const size_t dimensionality,
+                         arma::mat& frequencies) const
+  {
+    frequencies = arma::randn<arma::mat>(dimensionality, numFeatures) /
+        kernel.Bandwidth();
+  }
+
+  /**
+   * Sample the frequencies of the Laplacian kernel, which follow a
+   * multivariate Cauchy distribution with a scale of 1 / bandwidth.
+   */
+  void SampleFrequencies(const kernel::LaplacianKernel& kernel,
+                         const size_t dimensionality,
+                         arma::mat& frequencies) const
+  {
+    frequencies = arma::randn<arma::mat>(dimensionality, numFeatures);
+    const arma::rowvec scale = arma::abs(arma::randn<arma::rowvec>(
+        numFeatures)) * kernel.Bandwidth();
+    frequencies.each_row() /= scale;
+  }
+
+  /**
+   * Other kernels are not shift-invariant, so they can't be approximated with
+   * random Fourier features.
+   */
+  template<typename OtherKernelType>
+  void SampleFrequencies(const OtherKernelType& /* kernel */,
+                         const size_t /* dimensionality */,
+                         arma::mat& /* frequencies */) const
+  {
+    throw std::invalid_argument("RandomFourierKernelRule::ApplyKernelMatrix():"
+        " random Fourier features are only available for the GaussianKernel "
+        "and the LaplacianKernel!");
+  }
+
+  /**
+   * Compute the eigenvectors of the given symmetric matrix with the largest
+   * eigenvalues, using a randomized range finder with power iterations.
+   *
+   * @param matrix The symmetric matrix to decompose.
+   * @param k The number of eigenvectors to compute.
+   * @param eigval The eigenvalues, from largest to smallest.
+   * @param eigvec The eigenvectors, one per column.
+   */
+  void RandomizedEig(const arma::mat& matrix,
+                     const size_t k,
+                     arma::vec& eigval,
+                     arma::mat& eigvec) const
+  {
+    // Find an orthonormal basis of the dominant subspace.
+    arma::mat basis, r;
+    arma::mat sample = matrix * arma::randn<arma::mat>(matrix.n_cols,
+        k + oversampling);
+    arma::qr_econ(basis, r, sample);
+    for (size_t i = 0; i < powerIterations; ++i)
+    {
+      sample = matrix * basis;
+      arma::qr_econ(basis, r, sample);
+    }
+
+    // Decompose the matrix restricted to the subspace.
+    arma::vec values;
+    arma::mat vectors;
+    const arma::mat projected = basis.t() * matrix * basis;
+    if (!arma::eig_sym(values, vectors, arma::symmatu(projected)))
+    {
+      Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
+    }
+
+    eigval = arma::flipud(values.tail(k));
+    eigvec = basis * arma::fliplr(vectors.tail_cols(k));
+  }
+
+  //! The number of random features.
+  size_t numFeatures;
+  //! The number of power iterations of the randomized eigensolver.
+  size_t powerIterations;
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
@@ -239,6 +239,7 @@ Cluster(const MatType& data,
     iteration++;
     Log::Info << "KMeans::Cluster(): iteration " << iteration << ", residual "
         << cNorm << ".\n";
+    Counter::Record("kmeans_residual", cNorm);
     if (std::isnan(cNorm) || std::isinf(cNorm))
       cNorm = 1e-4; // Keep iterating.
   } while (cNorm > 1e-5 && iteration != maxIterations);
@@ -261,6 +262,9 @@ Cluster(const MatType& data,
   }
   Log::Info << lloydStep.DistanceCalculations() << " distance calculations."
       << std::endl;
+  Counter::Add("kmeans_iterations", iteration);
+  Counter::Add("kmeans_distance_calculations",
+      lloydStep.DistanceCalculations());
 }
 
 /**
@@ -88,6 +88,71 @@ double LinearRegression::Train(const arma::mat& predictors,
   return ComputeError(predictors, responses);
 }
 
+double LinearRegression::Train(data::ChunkedLoader<double>& loader,
+                               const bool intercept)
+{
+  this->intercept = intercept;
+
+  if (loader.Dimensionality() < 2)
+  {
+    Log::Fatal << "LinearRegression::Train(): the dataset must have at least "
+        << "one predictor and a response!" << std::endl;
+  }
+
+  // Accumulate X X^T, X y^T and y y^T, where X has the row of ones if an
+  // intercept is used.  In that case the first row and column of X X^T hold
+  // the number of points and the sums of the predictors, and the first element
+  // of X y^T holds the sum of the responses.
+  const size_t dimensionality = loader.Dimensionality() - 1;
+  const size_t offset = intercept ? 1 : 0;
+  arma::mat cov(dimensionality + offset, dimensionality + offset,
+      arma::fill::zeros);
+  arma::vec rhs(dimensionality + offset, arma::fill::zeros);
+  double squaredResponses = 0.0;
+  size_t numPoints = 0;
+
+  arma::mat chunk;
+  loader.Reset();
+  while (loader.Next(chunk))
+  {
+    const arma::mat predictors = chunk.rows(0, dimensionality - 1);
+    const arma::rowvec responses = chunk.row(dimensionality);
+
+    cov.submat(offset, offset, cov.n_rows - 1, cov.n_cols - 1) +=
+        predictors * predictors.t();
+    rhs.subvec(offset, rhs.n_elem - 1) += predictors * responses.t();
+    if (intercept)
+    {
+      const arma::vec sums = arma::sum(predictors, 1);
+      cov(0, 0) += chunk.n_cols;
+      cov.submat(1, 0, cov.n_rows - 1, 0) += sums;
+      cov.submat(0, 1, 0, cov.n_cols - 1) += sums.t();
+      rhs[0] += arma::accu(responses);
+    }
+
+    squaredResponses += arma::dot(responses, responses);
+    numPoints += chunk.n_cols;
+  }
+  loader.Reset();
+
+  if (numPoints == 0)
+  {
+    Log::Fatal << "LinearRegression::Train(): the dataset has no points!"
+        << std::endl;
+  }
+
+  // The error is y y^T - 2 a^T X y^T + a^T X X^T a, which only needs the
+  // accumulated sums.  This is the same as ComputeError() on the whole dataset,
+  // up to rounding.
+  const arma::mat gram = cov;
+  cov += lambda * arma::eye<arma::mat>(cov.n_rows, cov.n_rows);
+  parameters = arma::solve(cov, rhs);
+
+  const double error = squaredResponses - 2 * arma::dot(parameters, rhs) +
+      arma::as_scalar(parameters.t() * gram * parameters);
+  return std::max(error, 0.0) / numPoints;
+}
+
 void LinearRegression::Predict(const arma::mat& points,
     arma::rowvec& predictions) const
 {
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/chunked_loader.hpp>
 
 namespace mlpack {
 namespace regression /** Regression methods. */ {
@@ -95,6 +96,22 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Train the LinearRegression model on the dataset read by the given loader,
+   * one chunk at a time, so that the dataset never has to fit in memory.  The
+   * last dimension of every point is its response.  Only the d x d normal
+   * equations are accumulated, and they are solved once every chunk has been
+   * read, so the model is the same as when training on the whole dataset at
+   * once.  Careful!  This will completely ignore and overwrite the existing
+   * model.  The loader is reset before and after training.
+   *
+   * @param loader Loader of the dataset to train the model on.
+   * @param intercept Whether or not to fit an intercept term.
+   * @return The least squares error after training.
+   */
+  double Train(data::ChunkedLoader<double>& loader,
+               const bool intercept = true);
+
   /**
    * Calculate y_i for each data point in points.
    *
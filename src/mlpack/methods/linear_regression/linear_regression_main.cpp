@@ -44,6 +44,12 @@ PROGRAM_INFO("Simple Linear Regression and Prediction",
     "invertible.  The calculated b may be saved with the " +
     PRINT_PARAM_STRING("output_predictions") + " output parameter."
     "\n\n"
+    "Datasets too large to fit in memory may instead be given as the name of a "
+    "file with the " + PRINT_PARAM_STRING("streaming_training") + " parameter;"
+    " the file is then read in chunks of " + PRINT_PARAM_STRING("chunk_size") +
+    " points, the responses are the last dimension of each point, and only the"
+    " normal equations are kept in memory."
+    "\n\n"
     "Optionally, the calculated value of b is used to predict the responses for"
     " another matrix X' (specified by the " + PRINT_PARAM_STRING("test") + " "
     "parameter):"
@@ -82,6 +88,11 @@ PARAM_MATRIX_IN("training", "Matrix containing training set X (regressors).",
 PARAM_ROW_IN("training_responses", "Optional vector containing y "
     "(responses). If not given, the responses are assumed to be the last row "
     "of the input file.", "r");
+PARAM_STRING_IN("streaming_training", "File containing a training set with "
+    "responses as the last dimension, to be read one chunk at a time instead "
+    "of the training parameter.", "", "");
+PARAM_INT_IN("chunk_size", "Number of points of the streaming training set "
+    "read at once.", "", 10000);
 
 PARAM_MODEL_IN(LinearRegression, "input_model", "Existing LinearRegression "
     "model to use.", "m");
@@ -101,7 +112,15 @@ static void mlpackMain()
 {
   const double lambda = IO::GetParam<double>("lambda");
 
-  RequireOnlyOnePassed({ "training", "input_model" }, true);
+  RequireOnlyOnePassed({ "training", "streaming_training", "input_model" },
+      true);
+  ReportIgnoredParam({{ "training", false }}, "training_responses");
+  ReportIgnoredParam({{ "streaming_training", false }}, "chunk_size");
+  if (IO::HasParam("streaming_training"))
+  {
+    RequireParamValue<int>("chunk_size", [](int x) { return x > 0; }, true,
+        "chunk size must be positive");
+  }
 
   ReportIgnoredParam({{ "test", true }}, "output_predictions");
 
@@ -127,7 +146,18 @@ static void mlpackMain()
       "no output will be saved");
 
   // An input file was given and we need to generate the model.
-  if (computeModel)
+  if (computeModel && IO::HasParam("streaming_training"))
+  {
+    data::ChunkedLoader<> loader(IO::GetParam<string>("streaming_training"),
+        (size_t) IO::GetParam<int>("chunk_size"));
+
+    Timer::Start("regression");
+    lr = new LinearRegression();
+    lr->Lambda() = lambda;
+    lr->Train(loader);
+    Timer::Stop("regression");
+  }
+  else if (computeModel)
   {
     Timer::Start("load_regressors");
     regressors = std::move(IO::GetParam<mat>("training"));
@@ -15,6 +15,9 @@
 #define MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/gather_columns.hpp>
+
+#include <atomic>
 
 namespace mlpack {
 namespace svm {
@@ -23,6 +26,19 @@ namespace svm {
  * The hinge loss function for the linear SVM objective function.
  * This is used by various ensmallen optimizers to train the linear
  * SVM model.
+ *
+ * The function only holds references to the given dataset and labels, so they
+ * must outlive it.  Shuffle() permutes the order in which the points are
+ * visited rather than the data itself.  When both the dataset and the
+ * requested gradient are sparse (arma::sp_mat), as with ens::ParallelSGD on
+ * sparse data, the separable gradient only contains the weights of the
+ * features that occur in the batch.  The regularization of each weight is
+ * applied lazily: when its feature occurs, the weight receives the
+ * regularization of all gradients computed since the feature last occurred.
+ * That gradient therefore depends on the gradients computed before it, and not
+ * only on its arguments.  Shuffle() starts a new pass over the data and resets
+ * this bookkeeping; after that, the first gradient in which a feature occurs
+ * only holds its own regularization.
  */
 template <typename MatType = arma::mat>
 class LinearSVMFunction
@@ -46,7 +62,9 @@ class LinearSVMFunction
                     const bool fitIntercept = false);
 
   /**
-   * Shuffle the dataset.
+   * Shuffle the order in which the points of the dataset are visited.  The
+   * dataset itself is not moved.  This also resets the lazy regularization of
+   * the sparse separable gradient.
    */
   void Shuffle();
 
@@ -71,7 +89,7 @@ class LinearSVMFunction
    * @param groundTruth Pointer to arma::mat which stores the computed matrix.
    */
   void GetGroundTruthMatrix(const arma::Row<size_t>& labels,
-                            arma::sp_mat& groundTruth);
+                            arma::sp_mat& groundTruth) const;
 
   /**
    * Evaluate the hinge loss function for all the datapoints
@@ -163,9 +181,7 @@ class LinearSVMFunction
   arma::mat& InitialPoint() { return initialPoint; }
 
   //! Get the dataset.
-  const arma::sp_mat& Dataset() const { return dataset; }
-  //! Modify the dataset.
-  arma::sp_mat& Dataset() { return dataset; }
+  const MatType& Dataset() const { return dataset; }
 
   //! Sets the regularization parameter.
   double& Lambda() { return lambda; }
@@ -186,7 +202,13 @@ class LinearSVMFunction
   arma::sp_mat groundTruth;
 
   //! The datapoints for training.
-  MatType dataset;
+  const MatType& dataset;
+
+  //! The labels of the datapoints.
+  const arma::Row<size_t>& labels;
+
+  //! The order in which the datapoints are visited by the separable functions.
+  arma::uvec visitationOrder;
 
   //! Number of Classes.
   size_t numClasses;
@@ -199,6 +221,62 @@ class LinearSVMFunction
 
   //! Intercept term flag.
   bool fitIntercept;
+
+  //! The number of sparse separable gradients computed so far.
+  mutable std::atomic<size_t> gradientCalls;
+
+  //! The value of gradientCalls when the weights of each feature were last
+  //! regularized, or 0 if they haven't been since the last Shuffle() (only
+  //! used with sparse data).
+  mutable std::vector<std::atomic<size_t>> lastCall;
+
+  /**
+   * Gather the points with visitation indices [firstId, firstId + batchSize)
+   * and their label matrix.
+   */
+  void GatherBatch(const size_t firstId,
+                   const size_t batchSize,
+                   MatType& batch,
+                   arma::sp_mat& batchGroundTruth) const;
+
+  /**
+   * Compute the margin of every class for the given points: the score of the
+   * class minus the score of the correct class, plus delta for the incorrect
+   * classes.
+   */
+  void Margin(const arma::mat& parameters,
+              const MatType& points,
+              const arma::sp_mat& pointsGroundTruth,
+              arma::mat& margin) const;
+
+  /**
+   * Compute the regularized gradient of the hinge loss of the given points
+   * into a dense gradient, given their margin.
+   */
+  template<typename GradType>
+  void ComputeGradient(const arma::mat& parameters,
+                       const MatType& points,
+                       const arma::sp_mat& pointsGroundTruth,
+                       const arma::mat& margin,
+                       GradType& gradient,
+                       const std::enable_if_t<!arma::is_SpMat<MatType>::value ||
+                           !arma::is_SpMat<GradType>::value>* = 0) const;
+
+  /**
+   * Compute the gradient of the hinge loss of the given sparse points into a
+   * sparse gradient, given their margin.  Only the weights of the features
+   * that occur in the points (and the intercept) receive a gradient; those
+   * weights also receive the regularization they missed since their feature
+   * last occurred.
+   */
+  template<typename GradType>
+  void ComputeGradient(const arma::mat& parameters,
+                       const MatType& points,
+                       const arma::sp_mat& pointsGroundTruth,
+                       const arma::mat& margin,
+                       GradType& gradient,
+                       const std::enable_if_t<arma::is_SpMat<MatType>::value &&
+                           arma::is_SpMat<GradType>::value>* = 0) const;
 };
 
 } // namespace svm
@@ -14,9 +14,6 @@
 #ifndef MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_IMPL_HPP
 #define MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_IMPL_HPP
 
-#include <mlpack/core/math/make_alias.hpp>
-#include <mlpack/core/math/shuffle_data.hpp>
-
 // In case it hasn't been included yet.
 #include "linear_svm_function.hpp"
 
@@ -31,11 +28,16 @@ LinearSVMFunction<MatType>::LinearSVMFunction(
     const double lambda,
     const double delta,
     const bool fitIntercept) :
-    dataset(math::MakeAlias(const_cast<MatType&>(dataset), false)),
+    dataset(dataset),
+    labels(labels),
+    visitationOrder(arma::linspace<arma::uvec>(0, dataset.n_cols - 1,
+        dataset.n_cols)),
     numClasses(numClasses),
     lambda(lambda),
     delta(delta),
-    fitIntercept(fitIntercept)
+    fitIntercept(fitIntercept),
+    gradientCalls(0),
+    lastCall(arma::is_SpMat<MatType>::value ? dataset.n_rows : 0)
 {
   InitializeWeights(initialPoint, dataset.n_rows, numClasses, fitIntercept);
   initialPoint *= 0.005;
@@ -73,7 +75,7 @@ void LinearSVMFunction<MatType>::InitializeWeights(
 template <typename MatType>
 void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels,
-    arma::sp_mat& groundTruth)
+    arma::sp_mat& groundTruth) const
 {
   // Calculate the ground truth matrix according to the labels passed. The
   // ground truth matrix is a matrix of dimensions 'numClasses * numExamples',
@@ -105,62 +107,49 @@ void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
 }
 
 /**
- * Shuffle the data.
+ * Shuffle the order in which the datapoints are visited.
  */
 template <typename MatType>
 void LinearSVMFunction<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      dataset.n_cols - 1, dataset.n_cols));
-
-  // Re-sort data.
-  arma::mat newData = dataset.cols(ordering);
-  math::ClearAlias(dataset);
-  dataset = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
+  visitationOrder = arma::shuffle(visitationOrder);
 
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-                             groundTruth.n_cols);
+  // A new pass over the data starts, so restart the lazy regularization.
+  gradientCalls = 0;
+  for (size_t i = 0; i < lastCall.size(); ++i)
+    lastCall[i] = 0;
 }
 
 template <typename MatType>
-double LinearSVMFunction<MatType>::Evaluate(
-    const arma::mat& parameters)
+void LinearSVMFunction<MatType>::GatherBatch(
+    const size_t firstId,
+    const size_t batchSize,
+    MatType& batch,
+    arma::sp_mat& batchGroundTruth) const
 {
-  // The objective function is the hinge loss function and it is
-  // calculated over all the training examples.
+  const arma::uvec batchIndices = visitationOrder.subvec(firstId,
+      firstId + batchSize - 1);
+  math::GatherColumns(dataset, batchIndices, batch);
 
-  // Calculate the loss and regularization terms.
-  // L_i = Σ_i Σ_m max(0, Δ + (w_m x_i + b_m) - (w_{y_i} x_i + b_{y_i}))
-  // where (m != y_i)
-  double loss, regularization;
+  arma::Row<size_t> batchLabels;
+  math::GatherColumns(labels, batchIndices, batchLabels);
+  GetGroundTruthMatrix(batchLabels, batchGroundTruth);
+}
 
+template <typename MatType>
+void LinearSVMFunction<MatType>::Margin(
+    const arma::mat& parameters,
+    const MatType& points,
+    const arma::sp_mat& pointsGroundTruth,
+    arma::mat& margin) const
+{
   // Scores for each class are evaluated.
   arma::mat scores;
 
   // Check intercept condition.
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset;
+    scores = parameters.t() * points;
   }
   else
   {
@@ -169,9 +158,8 @@ double LinearSVMFunction<MatType>::Evaluate(
     // of Weights `w_i`, and the last row holds `b_i`.
     // On calculating the score, we add `b_i` term to each element of
     // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    scores = parameters.rows(0, points.n_rows - 1).t() * points;
+    scores.each_col() += parameters.row(points.n_rows).t();
   }
 
   // Evaluate the margin by the following steps:
@@ -179,9 +167,140 @@ double LinearSVMFunction<MatType>::Evaluate(
   //  - Adding the margin parameter `delta`.
   //  - Removing the `delta` parameter from correct class label in each
   //    column.
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
+  margin = scores - (arma::repmat(arma::ones(numClasses).t()
+      * (scores % pointsGroundTruth), numClasses, 1)) + delta
+      - (delta * pointsGroundTruth);
+}
+
+template <typename MatType>
+template <typename GradType>
+void LinearSVMFunction<MatType>::ComputeGradient(
+    const arma::mat& parameters,
+    const MatType& points,
+    const arma::sp_mat& pointsGroundTruth,
+    const arma::mat& margin,
+    GradType& gradient,
+    const std::enable_if_t<!arma::is_SpMat<MatType>::value ||
+        !arma::is_SpMat<GradType>::value>*) const
+{
+  // An element of `mask` matrix holds `1` corresponding to
+  // each positive element of `margin` matrix.
+  const arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0.0);
+
+  const arma::mat difference = pointsGroundTruth
+      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+  // The gradient is evaluated as follows:
+  //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
+  //  - Subtract `x_i` from `w_y_i` for each positive
+  //    `margin_i_j`.
+  //  - Take the average over the size of dataset.
+  //  - Add the regularization parameter.
+
+  // Check intercept condition
+  if (!fitIntercept)
+  {
+    gradient = points * difference.t();
+  }
+  else
+  {
+    gradient.set_size(arma::size(parameters));
+    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
+        points * difference.t();
+    gradient.row(parameters.n_rows - 1) = arma::sum(difference, 1).t();
+  }
+
+  gradient /= points.n_cols;
+
+  // Adding the regularization contribution to the gradient.
+  gradient += lambda * parameters;
+}
+
+template <typename MatType>
+template <typename GradType>
+void LinearSVMFunction<MatType>::ComputeGradient(
+    const arma::mat& parameters,
+    const MatType& points,
+    const arma::sp_mat& pointsGroundTruth,
+    const arma::mat& margin,
+    GradType& gradient,
+    const std::enable_if_t<arma::is_SpMat<MatType>::value &&
+        arma::is_SpMat<GradType>::value>*) const
+{
+  const arma::mat mask = arma::conv_to<arma::mat>::from(margin > 0.0);
+
+  const arma::mat difference = pointsGroundTruth
+      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+  // A sparse-sparse product only touches the features that occur in the
+  // points.
+  const arma::sp_mat featureGradient = points *
+      arma::sp_mat(difference.t());
+
+  // Collect the features that occur in the points.
+  arma::uvec features(points.n_nonzero);
+  size_t index = 0;
+  for (typename MatType::const_iterator it = points.begin();
+       it != points.end(); ++it, ++index)
+    features[index] = it.row();
+  features = arma::unique(features);
+
+  // The regularization of the weights of each feature is applied lazily: when
+  // the feature occurs, its weights receive the regularization of every
+  // gradient computed since the feature last occurred, including this one.  A
+  // feature that hasn't occurred since the last Shuffle() only receives the
+  // regularization of this gradient.
+  const size_t calls = gradientCalls.fetch_add(1) + 1;
+
+  const size_t interceptElements = fitIntercept ? numClasses : 0;
+  arma::umat locations(2, features.n_elem * numClasses + interceptElements);
+  arma::vec values(features.n_elem * numClasses + interceptElements);
+
+  index = 0;
+  for (size_t i = 0; i < features.n_elem; ++i)
+  {
+    const size_t feature = features[i];
+    const size_t last = lastCall[feature].exchange(calls);
+    const size_t missed = (last == 0) ? 1 : (calls > last) ? calls - last : 0;
+
+    for (size_t c = 0; c < numClasses; ++c, ++index)
+    {
+      locations(0, index) = feature;
+      locations(1, index) = c;
+      values[index] = featureGradient(feature, c) / points.n_cols +
+          lambda * missed * parameters(feature, c);
+    }
+  }
+
+  if (fitIntercept)
+  {
+    const arma::vec interceptGradient = arma::sum(difference, 1);
+    for (size_t c = 0; c < numClasses; ++c, ++index)
+    {
+      locations(0, index) = parameters.n_rows - 1;
+      locations(1, index) = c;
+      values[index] = interceptGradient[c] / points.n_cols +
+          lambda * parameters(parameters.n_rows - 1, c);
+    }
+  }
+
+  gradient = GradType(locations, values, parameters.n_rows, parameters.n_cols);
+}
+
+template <typename MatType>
+double LinearSVMFunction<MatType>::Evaluate(
+    const arma::mat& parameters)
+{
+  // The objective function is the hinge loss function and it is
+  // calculated over all the training examples.
+
+  // Calculate the loss and regularization terms.
+  // L_i = Σ_i Σ_m max(0, Δ + (w_m x_i + b_m) - (w_{y_i} x_i + b_{y_i}))
+  // where (m != y_i)
+  double loss, regularization;
+
+  arma::mat margin;
+  Margin(parameters, dataset, groundTruth, margin);
 
   // The Hinge Loss Function
   loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX)) / dataset.n_cols;
@@ -198,30 +317,15 @@ double LinearSVMFunction<MatType>::Evaluate(
     const size_t firstId,
     const size_t batchSize)
 {
-  const size_t lastId = firstId + batchSize - 1;
-
   // Calculate the loss and regularization terms.
   double loss, regularization, cost;
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
+  MatType batch;
+  arma::sp_mat batchGroundTruth;
+  GatherBatch(firstId, batchSize, batch, batchGroundTruth);
 
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
+  arma::mat margin;
+  Margin(parameters, batch, batchGroundTruth, margin);
 
   // The Hinge Loss Function
   loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
@@ -244,58 +348,10 @@ void LinearSVMFunction<MatType>::Gradient(
   // of all the positive elements of `margin` matrix.
   // So, we focus of these positive elements and reduce them.
   // Also, we need to increase the score of the correct class.
+  arma::mat margin;
+  Margin(parameters, dataset, groundTruth, margin);
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // An element of `mask` matrix holds `1` corresponding to
-  // each positive element of `margin` matrix.
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // The gradient is evaluated as follows:
-  //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
-  //  - Subtract `x_i` from `w_y_i` for each positive
-  //    `margin_i_j`.
-  //  - Take the average over the size of dataset.
-  //  - Add the regularization parameter.
-
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
-  }
-
-  gradient /= dataset.n_cols;
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  ComputeGradient(parameters, dataset, groundTruth, margin, gradient);
 }
 
 template <typename MatType>
@@ -306,53 +362,14 @@ void LinearSVMFunction<MatType>::Gradient(
     GradType& gradient,
     const size_t batchSize)
 {
-  const size_t lastId = firstId + batchSize - 1;
-
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
-
-  // For each sample, find the total number of classes where
-  // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth.cols(firstId, lastId)
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(batchSize) * difference.t();
-  }
+  MatType batch;
+  arma::sp_mat batchGroundTruth;
+  GatherBatch(firstId, batchSize, batch, batchGroundTruth);
 
-  gradient /= batchSize;
+  arma::mat margin;
+  Margin(parameters, batch, batchGroundTruth, margin);
 
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  ComputeGradient(parameters, batch, batchGroundTruth, margin, gradient);
 }
 
 template <typename MatType>
@@ -363,50 +380,10 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
 {
   double loss, regularization, cost;
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
-
-  // For each sample, find the total number of classes where
-  // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-            dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-            arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
-  }
+  arma::mat margin;
+  Margin(parameters, dataset, groundTruth, margin);
 
-  gradient /= dataset.n_cols;
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  ComputeGradient(parameters, dataset, groundTruth, margin, gradient);
 
   // The Hinge Loss Function
   loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
@@ -427,60 +404,20 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
     GradType& gradient,
     const size_t batchSize) const
 {
-  const size_t lastId = firstId + batchSize - 1;
-
   // Calculate the loss and regularization terms.
   double loss, regularization, cost;
 
-  // Scores for each class are evaluated.
-  arma::mat scores;
-
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
-  }
-
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
-
-  // For each sample, find the total number of classes where
-  // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
-      { val = (val > 0) ? 1: 0; });
-
-  arma::mat difference = groundTruth.cols(firstId, lastId)
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
-
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(batchSize) * difference.t();
-  }
-
-  gradient /= batchSize;
+  MatType batch;
+  arma::sp_mat batchGroundTruth;
+  GatherBatch(firstId, batchSize, batch, batchGroundTruth);
 
+  arma::mat margin;
+  Margin(parameters, batch, batchGroundTruth, margin);
 
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  ComputeGradient(parameters, batch, batchGroundTruth, margin, gradient);
 
   // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX));
+  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
   loss /= batchSize;
 
   // Adding the regularization term.
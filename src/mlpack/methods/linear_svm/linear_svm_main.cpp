@@ -79,6 +79,12 @@ PROGRAM_INFO("Linear SVM is an L2-regularized support vector machine.",
     "from the linear SVM model may be saved with the " +
     PRINT_PARAM_STRING("predictions") + " parameter." +
     "\n\n"
+    "For very high-dimensional sparse data, the training set may instead be "
+    "given as the name of a file holding a sparse matrix (for instance, in "
+    "coordinate list format) with the " + PRINT_PARAM_STRING("sparse_training")
+    + " parameter; the model is then trained without ever densifying the data, "
+    "and the labels must be given with " + PRINT_PARAM_STRING("labels") + "."
+    "\n\n"
     "As an example, to train a LinaerSVM on the data '" +
     PRINT_DATASET("data") + "' with labels '" + PRINT_DATASET("labels") + "' "
     "with L2 regularization of 0.1, saving the model to '" +
@@ -106,6 +112,8 @@ PARAM_MATRIX_IN("training", "A matrix containing the training set (the matrix "
     "of predictors, X).", "t");
 PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
     "in the training set (y).", "l");
+PARAM_STRING_IN("sparse_training", "File containing a sparse training set, to "
+    "be used instead of the training parameter.", "", "");
 
 // Optimizer parameters.
 PARAM_DOUBLE_IN("lambda", "L2-regularization parameter for training.", "r",
@@ -160,6 +168,57 @@ PARAM_MATRIX_OUT("probabilities", "If test data is specified, this "
     "matrix is where the class probabilities for the test set will be saved.",
     "p");
 
+// Train the given model on the given dense or sparse data with the optimizer
+// requested on the command line.
+template<typename MatType>
+void TrainModel(LinearSVM<MatType>& svm,
+                const MatType& trainingSet,
+                const arma::Row<size_t>& labels,
+                const size_t numClasses)
+{
+  const string optimizerType = IO::GetParam<string>("optimizer");
+  const double tolerance = IO::GetParam<double>("tolerance");
+  const size_t epochs = (size_t) IO::GetParam<int>("epochs");
+  const size_t maxIterations = (size_t) IO::GetParam<int>("max_iterations");
+
+  if (optimizerType == "lbfgs")
+  {
+    ens::L_BFGS lbfgsOpt;
+    lbfgsOpt.MaxIterations() = maxIterations;
+    lbfgsOpt.MinGradientNorm() = tolerance;
+
+    Log::Info << "Training model with L-BFGS optimizer." << endl;
+
+    // This will train the model.
+    svm.Train(trainingSet, labels, numClasses, lbfgsOpt);
+  }
+  else if (optimizerType == "psgd")
+  {
+    const double stepSize = IO::GetParam<double>("step_size");
+    const bool shuffle = !IO::HasParam("shuffle");
+    const size_t maxIt = epochs * trainingSet.n_cols;
+
+    ens::ConstantStep decayPolicy(stepSize);
+
+    #ifdef HAS_OPENMP
+    size_t threads = omp_get_max_threads();
+    #else
+    size_t threads = 1;
+    Log::Warn << "Using parallel SGD, but OpenMP support is "
+              << "not available!" << endl;
+    #endif
+
+    ens::ParallelSGD<ens::ConstantStep> psgdOpt(maxIt, std::ceil(
+      (float) trainingSet.n_cols / threads), tolerance, shuffle,
+      decayPolicy);
+
+    Log::Info << "Training model with ParallelSGD optimizer." << endl;
+
+    // This will train the model.
+    svm.Train(trainingSet, labels, numClasses, psgdOpt);
+  }
+}
+
 static void mlpackMain()
 {
   if (IO::GetParam<int>("seed") != 0)
@@ -171,13 +230,22 @@ static void mlpackMain()
   const double lambda = IO::GetParam<double>("lambda");
   const double delta = IO::GetParam<double>("delta");
   const string optimizerType = IO::GetParam<string>("optimizer");
-  const double tolerance = IO::GetParam<double>("tolerance");
   const bool intercept = !IO::HasParam("no_intercept");
-  const size_t epochs = (size_t) IO::GetParam<int>("epochs");
-  const size_t maxIterations = (size_t) IO::GetParam<int>("max_iterations");
 
   // One of training and input_model must be specified.
-  RequireAtLeastOnePassed({ "training", "input_model" }, true);
+  RequireAtLeastOnePassed({ "training", "sparse_training", "input_model" },
+      true);
+
+  // A sparse training set replaces the dense one, and its labels must be given
+  // separately.
+  if (IO::HasParam("sparse_training"))
+  {
+    RequireOnlyOnePassed({ "training", "sparse_training" }, true);
+    RequireAtLeastOnePassed({ "labels" }, true, "labels must be given with a "
+        "sparse training set");
+  }
+  const bool training = IO::HasParam("training") ||
+      IO::HasParam("sparse_training");
 
   // If no output file is given, the user should know that the model will not be
   // saved, but only if a model is being trained.
@@ -255,6 +323,7 @@ static void mlpackMain()
 
   // These are the matrices we might use.
   arma::mat trainingSet;
+  arma::sp_mat sparseTrainingSet;
   arma::Row<size_t> labels;
   arma::Row<size_t> rawLabels;
   arma::mat testSet;
@@ -264,12 +333,19 @@ static void mlpackMain()
   // Load data matrix.
   if (IO::HasParam("training"))
     trainingSet = std::move(IO::GetParam<arma::mat>("training"));
+  else if (IO::HasParam("sparse_training"))
+  {
+    data::Load(IO::GetParam<string>("sparse_training"), sparseTrainingSet,
+        true);
+  }
+  const size_t numPoints = IO::HasParam("sparse_training") ?
+      sparseTrainingSet.n_cols : trainingSet.n_cols;
 
   // Check if the labels are in a separate file.
-  if (IO::HasParam("training") && IO::HasParam("labels"))
+  if (training && IO::HasParam("labels"))
   {
     rawLabels = std::move(IO::GetParam<arma::Row<size_t>>("labels"));
-    if (trainingSet.n_cols != rawLabels.n_cols)
+    if (numPoints != rawLabels.n_cols)
     {
       Log::Fatal << "The labels must have the same number of points as the "
           << "training dataset." << endl;
@@ -302,7 +378,7 @@ static void mlpackMain()
   }
 
   // Now, do the training.
-  if (IO::HasParam("training"))
+  if (training)
   {
     data::NormalizeLabels(rawLabels, labels, model->mappings);
     numClasses = IO::GetParam<int>("num_classes") == 0 ?
@@ -319,41 +395,18 @@ static void mlpackMain()
       throw std::invalid_argument("Given input data has only 1 class!");
     }
 
-    if (optimizerType == "lbfgs")
+    if (IO::HasParam("training"))
     {
-      ens::L_BFGS lbfgsOpt;
-      lbfgsOpt.MaxIterations() = maxIterations;
-      lbfgsOpt.MinGradientNorm() = tolerance;
-
-      Log::Info << "Training model with L-BFGS optimizer." << endl;
-
-      // This will train the model.
-      model->svm.Train(trainingSet, labels, numClasses, lbfgsOpt);
+      TrainModel(model->svm, trainingSet, labels, numClasses);
     }
-    else if (optimizerType == "psgd")
+    else
     {
-      const double stepSize = IO::GetParam<double>("step_size");
-      const bool shuffle = !IO::HasParam("shuffle");
-      const size_t maxIt = epochs * trainingSet.n_cols;
-
-      ens::ConstantStep decayPolicy(stepSize);
-
-      #ifdef HAS_OPENMP
-      size_t threads = omp_get_max_threads();
-      #else
-      size_t threads = 1;
-      Log::Warn << "Using parallel SGD, but OpenMP support is "
-                << "not available!" << endl;
-      #endif
-
-      ens::ParallelSGD<ens::ConstantStep> psgdOpt(maxIt, std::ceil(
-        (float) trainingSet.n_cols / threads), tolerance, shuffle,
-        decayPolicy);
-
-      Log::Info << "Training model with ParallelSGD optimizer." << endl;
-
-      // This will train the model.
-      model->svm.Train(trainingSet, labels, numClasses, psgdOpt);
+      // The parameters learned on sparse data are used as-is by the dense
+      // model.
+      LinearSVM<arma::sp_mat> sparseSVM(numClasses, lambda, delta, intercept);
+      sparseSVM.Parameters() = std::move(model->svm.Parameters());
+      TrainModel(sparseSVM, sparseTrainingSet, labels, numClasses);
+      model->svm.Parameters() = std::move(sparseSVM.Parameters());
     }
   }
   if (IO::HasParam("test"))
@@ -364,7 +417,7 @@ static void mlpackMain()
     oss << IO::GetPrintableParam<arma::mat>("test");
     std::string testOutput = oss.str();
 
-    if (!IO::HasParam("training"))
+    if (!training)
     {
       numClasses = model->svm.NumClasses();
     }
@@ -95,30 +95,31 @@ LMNNFunction<MetricType>::LMNNFunction(const arma::mat& dataset,
 template<typename MetricType>
 void LMNNFunction<MetricType>::Shuffle()
 {
-  arma::mat newDataset = dataset;
-  arma::Mat<size_t> newLabels = labels;
-  arma::cube newEvalOld = evalOld;
-  arma::vec newlastTransformationIndices = lastTransformationIndices;
-  arma::mat newMaxImpNorm = maxImpNorm;
-  arma::vec newNorm = norm;
-
   // Generate ordering.
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       dataset.n_cols - 1, dataset.n_cols));
 
+  // Gather the permuted points directly; the dataset and labels may be aliases
+  // of the user's data, so they are not permuted in place.
+  arma::mat newDataset = dataset.cols(ordering);
+  arma::Row<size_t> newLabels = labels.cols(ordering);
+
   math::ClearAlias(dataset);
   math::ClearAlias(labels);
 
-  dataset = newDataset.cols(ordering);
-  labels = newLabels.cols(ordering);
-  maxImpNorm = newMaxImpNorm.cols(ordering);
-  lastTransformationIndices = newlastTransformationIndices.elem(ordering);
-  norm = newNorm.elem(ordering);
+  dataset = std::move(newDataset);
+  labels = std::move(newLabels);
+
+  // The remaining members are owned by this object, so they can be permuted
+  // without an intermediate copy of the original.
+  maxImpNorm = maxImpNorm.cols(ordering);
+  lastTransformationIndices = lastTransformationIndices.elem(ordering);
+  norm = norm.elem(ordering);
 
+  arma::cube newEvalOld(evalOld.n_rows, evalOld.n_cols, evalOld.n_slices);
   for (size_t i = 0; i < ordering.n_elem; ++i)
-  {
-    evalOld.slice(i) = newEvalOld.slice(ordering(i));
-  }
+    newEvalOld.slice(i) = evalOld.slice(ordering(i));
+  evalOld = std::move(newEvalOld);
 
   // Re-calculate target neighbors as indices changed.
   constraint.PreCalulated() = false;
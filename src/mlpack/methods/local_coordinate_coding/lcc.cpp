@@ -29,37 +29,51 @@ LocalCoordinateCoding::LocalCoordinateCoding(
 }
 
 void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
+    const
 {
-  arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
-      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
-      * data);
-
-  arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
+  const arma::mat dictGram = trans(dictionary) * dictionary;
+  const arma::vec dictSqNorms = trans(sum(square(dictionary)));
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
 
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+  // The points are encoded independently.  Every thread keeps its own
+  // workspaces and one LARS object that refers to the weighted Gram matrix of
+  // the thread; all of them are overwritten in place for every point.
+  #pragma omp parallel
+  {
+    arma::vec invW(atoms);
+    arma::mat dictPrime(dictionary.n_rows, atoms);
+    arma::mat dictGramTD(atoms, atoms);
+    arma::rowvec responses(data.n_rows);
 
-    bool useCholesky = false;
+    const bool useCholesky = false;
     regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Inverse squared distances between the point and every atom.
+      invW = 1.0 / (dictSqNorms + arma::dot(data.col(i), data.col(i)) -
+          2 * trans(dictionary) * data.col(i));
+
+      // dictPrime = dictionary * diagmat(invW).
+      dictPrime = dictionary;
+      dictPrime.each_row() %= trans(invW);
+
+      // dictGramTD = diagmat(invW) * dictGram * diagmat(invW).
+      dictGramTD = dictGram;
+      dictGramTD.each_col() %= invW;
+      dictGramTD.each_row() %= trans(invW);
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      responses = data.col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
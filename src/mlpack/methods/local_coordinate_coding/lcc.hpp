@@ -145,12 +145,14 @@ class LocalCoordinateCoding
                    DictionaryInitializer());
 
   /**
-   * Code each point via distance-weighted LARS.
+   * Code each point via distance-weighted LARS.  The points are encoded in
+   * parallel if OpenMP is available, and the model is not modified, so a
+   * trained model can encode new batches of data from several threads.
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
    */
-  void Encode(const arma::mat& data, arma::mat& codes);
+  void Encode(const arma::mat& data, arma::mat& codes) const;
 
   /**
    * Learn dictionary by solving linear system.
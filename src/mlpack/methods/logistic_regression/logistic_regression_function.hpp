@@ -15,8 +15,9 @@
 #define MLPACK_METHODS_LOGISTIC_REGRESSION_LOGISTIC_REGRESSION_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
-#include <mlpack/core/math/make_alias.hpp>
-#include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/core/math/gather_columns.hpp>
+
+#include <atomic>
 
 namespace mlpack {
 namespace regression {
@@ -25,6 +26,23 @@ namespace regression {
  * The log-likelihood function for the logistic regression objective function.
  * This is used by various mlpack optimizers to train a logistic regression
  * model.
+ *
+ * The function only holds references to the given predictors and responses, so
+ * they must be lvalues that outlive it; passing temporaries does not compile.
+ * Shuffle() permutes the order in which points are visited rather than the
+ * data itself.  The separable functions do not modify the object, so they may
+ * be called from several threads at once (as ens::ParallelSGD does).
+ *
+ * When both the predictors and the requested gradient are sparse
+ * (arma::sp_mat), the separable gradient only contains the intercept and the
+ * weights of the features that occur in the batch.  The L2-regularization of
+ * each weight is applied lazily: when its feature occurs, the weight receives
+ * the regularization of all points visited since the feature last occurred.
+ * The sparse separable gradient therefore depends on the gradients computed
+ * before it, and not only on its arguments.  Shuffle() starts a new pass over
+ * the data and resets this bookkeeping; after that, the first gradient in
+ * which a feature occurs only holds the regularization of its own batch.  The
+ * per-feature bookkeeping is atomic, so it is safe under ens::ParallelSGD.
  */
 template<typename MatType = arma::mat>
 class LogisticRegressionFunction
@@ -54,6 +72,23 @@ class LogisticRegressionFunction
                              const arma::vec& initialPoint,
                              const double lambda = 0);
 
+  // Only references to the predictors and responses are kept, so temporaries
+  // can't be given.
+  LogisticRegressionFunction(MatType&&,
+                             const arma::Row<size_t>&,
+                             const double = 0) = delete;
+  LogisticRegressionFunction(const MatType&,
+                             arma::Row<size_t>&&,
+                             const double = 0) = delete;
+  LogisticRegressionFunction(MatType&&,
+                             const arma::Row<size_t>&,
+                             const arma::vec&,
+                             const double = 0) = delete;
+  LogisticRegressionFunction(const MatType&,
+                             arma::Row<size_t>&&,
+                             const arma::vec&,
+                             const double = 0) = delete;
+
   //! Return the initial point for the optimization.
   const arma::mat& InitialPoint() const { return initialPoint; }
   //! Modify the initial point for the optimization.
@@ -70,8 +105,10 @@ class LogisticRegressionFunction
   const arma::Row<size_t>& Responses() const { return responses; }
 
   /**
-  * Shuffle the order of function visitation.  This may be called by the optimizer.
-  */
+   * Shuffle the order of function visitation.  This may be called by the
+   * optimizer.  This also resets the lazy regularization of the sparse
+   * separable gradient.
+   */
   void Shuffle();
 
   /**
@@ -182,14 +219,58 @@ class LogisticRegressionFunction
  private:
   //! The initial point, from which to start the optimization.
   arma::mat initialPoint;
-  //! The matrix of data points (predictors).  This is an alias until shuffling
-  //! is done.
-  MatType predictors;
-  //! The vector of responses to the input data points.  This is an alias until
-  //! shuffling is done.
-  arma::Row<size_t> responses;
+  //! The matrix of data points (predictors).
+  const MatType& predictors;
+  //! The vector of responses to the input data points.
+  const arma::Row<size_t>& responses;
+  //! The order in which the points are visited by the separable functions.
+  arma::uvec visitationOrder;
   //! The regularization parameter for L2-regularization.
   double lambda;
+  //! The number of points visited by the sparse separable gradient.
+  mutable std::atomic<size_t> visitedPoints;
+  //! The value of visitedPoints when each feature was last regularized, or 0
+  //! if it hasn't been since the last Shuffle() (only used with sparse
+  //! predictors).
+  mutable std::vector<std::atomic<size_t>> lastVisit;
+
+  /**
+   * Gather the points with visitation indices [begin, begin + batchSize) and
+   * their responses.
+   */
+  void GatherBatch(const size_t begin,
+                   const size_t batchSize,
+                   MatType& batchPredictors,
+                   arma::Row<size_t>& batchResponses) const;
+
+  /**
+   * Compute the gradient of the objective on the given batch of points into a
+   * dense gradient, given the sigmoids of the points.
+   */
+  template<typename GradType>
+  void BatchGradient(const arma::mat& parameters,
+                     const MatType& batchPredictors,
+                     const arma::Row<size_t>& batchResponses,
+                     const arma::rowvec& sigmoids,
+                     GradType& gradient,
+                     const std::enable_if_t<!arma::is_SpMat<MatType>::value ||
+                         !arma::is_SpMat<GradType>::value>* = 0) const;
+
+  /**
+   * Compute the gradient of the objective on the given batch of sparse points
+   * into a sparse gradient, given the sigmoids of the points.  Only the
+   * intercept and the weights of the features that occur in the batch receive
+   * a gradient; those weights also receive the regularization they missed
+   * since their feature last occurred.
+   */
+  template<typename GradType>
+  void BatchGradient(const arma::mat& parameters,
+                     const MatType& batchPredictors,
+                     const arma::Row<size_t>& batchResponses,
+                     const arma::rowvec& sigmoids,
+                     GradType& gradient,
+                     const std::enable_if_t<arma::is_SpMat<MatType>::value &&
+                         arma::is_SpMat<GradType>::value>* = 0) const;
 };
 
 } // namespace regression
@@ -25,11 +25,13 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
     const MatType& predictors,
     const arma::Row<size_t>& responses,
     const double lambda) :
-    // We promise to be well-behaved... the elements won't be modified.
-    predictors(math::MakeAlias(const_cast<MatType&>(predictors), false)),
-    responses(math::MakeAlias(const_cast<arma::Row<size_t>&>(responses),
-        false)),
-    lambda(lambda)
+    predictors(predictors),
+    responses(responses),
+    visitationOrder(arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+        predictors.n_cols)),
+    lambda(lambda),
+    visitedPoints(0),
+    lastVisit(arma::is_SpMat<MatType>::value ? predictors.n_rows : 0)
 {
   initialPoint = arma::rowvec(predictors.n_rows + 1, arma::fill::zeros);
 
@@ -50,11 +52,13 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
     const arma::vec& initialPoint,
     const double lambda) :
     initialPoint(initialPoint),
-    // We promise to be well-behaved... the elements won't be modified.
-    predictors(math::MakeAlias(const_cast<MatType&>(predictors), false)),
-    responses(math::MakeAlias(const_cast<arma::Row<size_t>&>(responses),
-        false)),
-    lambda(lambda)
+    predictors(predictors),
+    responses(responses),
+    visitationOrder(arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+        predictors.n_cols)),
+    lambda(lambda),
+    visitedPoints(0),
+    lastVisit(arma::is_SpMat<MatType>::value ? predictors.n_rows : 0)
 {
   // To check if initialPoint is compatible with predictors.
   if (initialPoint.n_rows != (predictors.n_rows + 1) ||
@@ -63,23 +67,34 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
 }
 
 /**
- * Shuffle the datapoints.
+ * Shuffle the order in which the datapoints are visited.  The data itself is
+ * not moved.
  */
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Shuffle()
 {
-  MatType newPredictors;
-  arma::Row<size_t> newResponses;
+  visitationOrder = arma::shuffle(visitationOrder);
 
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
-
-  // If we are an alias, make sure we don't write to the original data.
-  math::ClearAlias(predictors);
-  math::ClearAlias(responses);
+  // A new pass over the data starts, so restart the lazy regularization.
+  visitedPoints = 0;
+  for (size_t i = 0; i < lastVisit.size(); ++i)
+    lastVisit[i] = 0;
+}
 
-  // Take ownership of the new data.
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+/**
+ * Gather the points of the given batch into the batch buffers.
+ */
+template<typename MatType>
+void LogisticRegressionFunction<MatType>::GatherBatch(
+    const size_t begin,
+    const size_t batchSize,
+    MatType& batchPredictors,
+    arma::Row<size_t>& batchResponses) const
+{
+  const arma::uvec batch = visitationOrder.subvec(begin,
+      begin + batchSize - 1);
+  math::GatherColumns(predictors, batch, batchPredictors);
+  math::GatherColumns(responses, batch, batchResponses);
 }
 
 /**
@@ -139,13 +154,14 @@ double LogisticRegressionFunction<MatType>::Evaluate(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  GatherBatch(begin, batchSize, batchPredictors, batchResponses);
   const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors)));
 
   // Compute the objective for the given batch size from a given point.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(batchResponses);
   const double result = arma::accu(arma::log(1.0 - respD + sigmoid %
       (2 * respD - 1.0)));
 
@@ -182,23 +198,96 @@ void LogisticRegressionFunction<MatType>::Gradient(
                 GradType& gradient,
                 const size_t batchSize) const
 {
-  // Regularization term.
-  arma::mat regularization;
-  regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
-      / predictors.n_cols * batchSize;
-
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  GatherBatch(begin, batchSize, batchPredictors, batchResponses);
   const arma::rowvec exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors;
   // Calculating the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
 
+  BatchGradient(parameters, batchPredictors, batchResponses, sigmoids,
+      gradient);
+}
+
+template<typename MatType>
+template<typename GradType>
+void LogisticRegressionFunction<MatType>::BatchGradient(
+    const arma::mat& parameters,
+    const MatType& batchPredictors,
+    const arma::Row<size_t>& batchResponses,
+    const arma::rowvec& sigmoids,
+    GradType& gradient,
+    const std::enable_if_t<!arma::is_SpMat<MatType>::value ||
+        !arma::is_SpMat<GradType>::value>*) const
+{
+  // Regularization term.
+  arma::mat regularization;
+  regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
+      / predictors.n_cols * batchPredictors.n_cols;
+
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = -arma::accu(batchResponses - sigmoids);
+  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - batchResponses) *
+      batchPredictors.t() + regularization;
+}
+
+template<typename MatType>
+template<typename GradType>
+void LogisticRegressionFunction<MatType>::BatchGradient(
+    const arma::mat& parameters,
+    const MatType& batchPredictors,
+    const arma::Row<size_t>& batchResponses,
+    const arma::rowvec& sigmoids,
+    GradType& gradient,
+    const std::enable_if_t<arma::is_SpMat<MatType>::value &&
+        arma::is_SpMat<GradType>::value>*) const
+{
+  const arma::rowvec diffs = sigmoids - batchResponses;
+
+  // A sparse-sparse product only touches the features that occur in the
+  // batch.
+  const arma::sp_mat featureGradient = batchPredictors *
+      arma::sp_mat(diffs.t());
+
+  // Collect the features that occur in the batch.
+  arma::uvec features(batchPredictors.n_nonzero);
+  size_t index = 0;
+  for (typename MatType::const_iterator it = batchPredictors.begin();
+       it != batchPredictors.end(); ++it, ++index)
+    features[index] = it.row();
+  features = arma::unique(features);
+
+  // The L2-regularization of each weight is applied lazily: when its feature
+  // occurs, the weight receives the regularization of every point visited
+  // since the feature last occurred, including the points of this batch.  A
+  // feature that hasn't occurred since the last Shuffle() only receives the
+  // regularization of this batch.
+  const size_t visited = visitedPoints.fetch_add(batchPredictors.n_cols) +
+      batchPredictors.n_cols;
+
+  arma::umat locations(2, features.n_elem + 1);
+  arma::vec values(features.n_elem + 1);
+
+  // The intercept is not regularized.
+  locations(0, 0) = 0;
+  locations(1, 0) = 0;
+  values[0] = arma::accu(diffs);
+
+  for (size_t i = 0; i < features.n_elem; ++i)
+  {
+    const size_t feature = features[i];
+    const size_t last = lastVisit[feature].exchange(visited);
+    const size_t missed = (last == 0) ? batchPredictors.n_cols :
+        (visited > last) ? visited - last : 0;
+
+    locations(0, i + 1) = 0;
+    locations(1, i + 1) = feature + 1;
+    values[i + 1] = featureGradient(feature, 0) + lambda * missed /
+        predictors.n_cols * parameters(0, feature + 1);
+  }
+
+  gradient = GradType(locations, values, parameters.n_rows, parameters.n_cols);
 }
 
 /**
@@ -267,31 +356,23 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
     GradType& gradient,
     const size_t batchSize) const
 {
-  // Regularization term.
-  arma::mat regularization =
-      lambda * parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
-      batchSize;
-
   const double objectiveRegularization = lambda *
       (batchSize / (2.0 * predictors.n_cols)) *
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
+  MatType batchPredictors;
+  arma::Row<size_t> batchResponses;
+  GatherBatch(begin, batchSize, batchPredictors, batchResponses);
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batchPredictors)));
 
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  BatchGradient(parameters, batchPredictors, batchResponses, sigmoids,
+      gradient);
 
   // Now compute the objective function using the sigmoids.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(batchResponses);
   const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
       (2 * respD - 1.0)));
 
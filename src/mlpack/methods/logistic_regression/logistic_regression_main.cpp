@@ -94,6 +94,12 @@ PROGRAM_INFO("L2-regularized Logistic Regression and Prediction",
     "multi-class case but instead only the two-class case.  Any labels must "
     "be either 0 or 1.  For more classes, see the softmax_regression program."
     "\n\n"
+    "For very high-dimensional sparse data, the training set may instead be "
+    "given as the name of a file holding a sparse matrix (for instance, in "
+    "coordinate list format) with the " + PRINT_PARAM_STRING("sparse_training")
+    + " parameter; the model is then trained without ever densifying the data, "
+    "and the labels must be given with " + PRINT_PARAM_STRING("labels") + "."
+    "\n\n"
     "As an example, to train a logistic regression model on the data '" +
     PRINT_DATASET("data") + "' with labels '" + PRINT_DATASET("labels") + "' "
     "with L2 regularization of 0.1, saving the model to '" +
@@ -120,6 +126,8 @@ PARAM_MATRIX_IN("training", "A matrix containing the training set (the matrix "
     "of predictors, X).", "t");
 PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
     "in the training set (y).", "l");
+PARAM_STRING_IN("sparse_training", "File containing a sparse training set, to "
+    "be used instead of the training parameter.", "", "");
 
 // Optimizer parameters.
 PARAM_DOUBLE_IN("lambda", "L2-regularization parameter for training.", "L",
@@ -160,23 +168,66 @@ PARAM_DOUBLE_IN("decision_boundary", "Decision boundary for prediction; if the "
     "logistic function for a point is less than the boundary, the class is "
     "taken to be 0; otherwise, the class is 1.", "d", 0.5);
 
+// Train the given model on the given dense or sparse data with the optimizer
+// requested on the command line.
+template<typename MatType>
+void TrainModel(LogisticRegression<MatType>& model,
+                const MatType& regressors,
+                const arma::Row<size_t>& responses)
+{
+  const string optimizerType = IO::GetParam<string>("optimizer");
+  const double tolerance = IO::GetParam<double>("tolerance");
+  const size_t maxIterations = (size_t) IO::GetParam<int>("max_iterations");
+
+  if (optimizerType == "sgd")
+  {
+    ens::SGD<> sgdOpt;
+    sgdOpt.MaxIterations() = maxIterations;
+    sgdOpt.Tolerance() = tolerance;
+    sgdOpt.StepSize() = IO::GetParam<double>("step_size");
+    sgdOpt.BatchSize() = (size_t) IO::GetParam<int>("batch_size");
+    Log::Info << "Training model with SGD optimizer." << endl;
+
+    // This will train the model.
+    model.Train(regressors, responses, sgdOpt);
+  }
+  else if (optimizerType == "lbfgs")
+  {
+    ens::L_BFGS lbfgsOpt;
+    lbfgsOpt.MaxIterations() = maxIterations;
+    lbfgsOpt.MinGradientNorm() = tolerance;
+    Log::Info << "Training model with L-BFGS optimizer." << endl;
+
+    // This will train the model.
+    model.Train(regressors, responses, lbfgsOpt);
+  }
+}
+
 static void mlpackMain()
 {
   // Collect command-line options.
   const double lambda = IO::GetParam<double>("lambda");
   const string optimizerType = IO::GetParam<string>("optimizer");
-  const double tolerance = IO::GetParam<double>("tolerance");
-  const double stepSize = IO::GetParam<double>("step_size");
-  const size_t batchSize = (size_t) IO::GetParam<int>("batch_size");
-  const size_t maxIterations = (size_t) IO::GetParam<int>("max_iterations");
   const double decisionBoundary = IO::GetParam<double>("decision_boundary");
 
   // One of training and input_model must be specified.
-  RequireAtLeastOnePassed({ "training", "input_model" }, true);
+  RequireAtLeastOnePassed({ "training", "sparse_training", "input_model" },
+      true);
+
+  // A sparse training set replaces the dense one, and its labels must be given
+  // separately.
+  if (IO::HasParam("sparse_training"))
+  {
+    RequireOnlyOnePassed({ "training", "sparse_training" }, true);
+    RequireAtLeastOnePassed({ "labels" }, true, "labels must be given with a "
+        "sparse training set");
+  }
+  const bool training = IO::HasParam("training") ||
+      IO::HasParam("sparse_training");
 
   // If no output file is given, the user should know that the model will not be
   // saved, but only if a model is being trained.
-  if (IO::HasParam("training"))
+  if (training)
   {
     RequireAtLeastOnePassed({ "output_model" }, false, "trained model will not "
         "be saved");
@@ -238,6 +289,7 @@ static void mlpackMain()
 
   // These are the matrices we might use.
   arma::mat regressors;
+  arma::sp_mat sparseRegressors;
   arma::Row<size_t> responses;
   arma::mat testSet;
   arma::Row<size_t> predictions;
@@ -245,6 +297,12 @@ static void mlpackMain()
   // Load data matrix.
   if (IO::HasParam("training"))
     regressors = std::move(IO::GetParam<arma::mat>("training"));
+  else if (IO::HasParam("sparse_training"))
+    data::Load(IO::GetParam<string>("sparse_training"), sparseRegressors, true);
+  const size_t dimensionality = IO::HasParam("sparse_training") ?
+      sparseRegressors.n_rows : regressors.n_rows;
+  const size_t numPoints = IO::HasParam("sparse_training") ?
+      sparseRegressors.n_cols : regressors.n_cols;
 
   // Load the model, if necessary.
   LogisticRegression<>* model;
@@ -256,16 +314,16 @@ static void mlpackMain()
 
     // Set the size of the parameters vector, if necessary.
     if (!IO::HasParam("labels"))
-      model->Parameters() = arma::zeros<arma::rowvec>(regressors.n_rows);
+      model->Parameters() = arma::zeros<arma::rowvec>(dimensionality);
     else
-      model->Parameters() = arma::zeros<arma::rowvec>(regressors.n_rows + 1);
+      model->Parameters() = arma::zeros<arma::rowvec>(dimensionality + 1);
   }
 
   // Check if the responses are in a separate file.
-  if (IO::HasParam("training") && IO::HasParam("labels"))
+  if (training && IO::HasParam("labels"))
   {
     responses = std::move(IO::GetParam<arma::Row<size_t>>("labels"));
-    if (responses.n_cols != regressors.n_cols)
+    if (responses.n_cols != numPoints)
     {
       // Clean memory if needed.
       if (!IO::HasParam("input_model"))
@@ -295,7 +353,7 @@ static void mlpackMain()
   }
 
   // Verify the labels.
-  if (IO::HasParam("training") && max(responses) > 1)
+  if (training && max(responses) > 1)
   {
     // Clean memory if needed.
     if (!IO::HasParam("input_model"))
@@ -309,29 +367,16 @@ static void mlpackMain()
   if (IO::HasParam("training"))
   {
     model->Lambda() = lambda;
-
-    if (optimizerType == "sgd")
-    {
-      ens::SGD<> sgdOpt;
-      sgdOpt.MaxIterations() = maxIterations;
-      sgdOpt.Tolerance() = tolerance;
-      sgdOpt.StepSize() = stepSize;
-      sgdOpt.BatchSize() = batchSize;
-      Log::Info << "Training model with SGD optimizer." << endl;
-
-      // This will train the model.
-      model->Train(regressors, responses, sgdOpt);
-    }
-    else if (optimizerType == "lbfgs")
-    {
-      ens::L_BFGS lbfgsOpt;
-      lbfgsOpt.MaxIterations() = maxIterations;
-      lbfgsOpt.MinGradientNorm() = tolerance;
-      Log::Info << "Training model with L-BFGS optimizer." << endl;
-
-      // This will train the model.
-      model->Train(regressors, responses, lbfgsOpt);
-    }
+    TrainModel(*model, regressors, responses);
+  }
+  else if (IO::HasParam("sparse_training"))
+  {
+    // The parameters learned on sparse data are used as-is by the dense model.
+    LogisticRegression<arma::sp_mat> sparseModel(0, lambda);
+    sparseModel.Parameters() = std::move(model->Parameters());
+    TrainModel(sparseModel, sparseRegressors, responses);
+    model->Parameters() = std::move(sparseModel.Parameters());
+    model->Lambda() = lambda;
   }
 
   if (IO::HasParam("test"))
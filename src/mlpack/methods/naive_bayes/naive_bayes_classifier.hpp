@@ -108,6 +108,10 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * With the incremental algorithm, training on a dataset one chunk at a time
+   * (for instance with a data::ChunkedLoader) gives the same model as training
+   * on the whole dataset at once.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -113,6 +113,19 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     // Fist, de-normalize probabilities.
     probabilities *= trainingPoints;
 
+    // If the model has already been trained, also de-normalize the variances,
+    // so that training on a dataset in several chunks gives the same model as
+    // training on the whole dataset at once.
+    if (trainingPoints > 0)
+    {
+      variances -= epsilon;
+      for (size_t i = 0; i < probabilities.n_elem; ++i)
+      {
+        if (probabilities[i] > 2)
+          variances.col(i) *= (probabilities[i] - 1);
+      }
+    }
+
     for (size_t j = 0; j < data.n_cols; ++j)
     {
       const size_t label = labels[j];
@@ -135,6 +148,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     probabilities.zeros();
     means.zeros();
     variances.zeros();
+    trainingPoints = 0;
 
     // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
     // possible to calculate the means and variances using a faster one-pass
@@ -171,8 +185,8 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   // Add epsilon to prevent log of zero.
   variances += epsilon;
 
-  probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+  probabilities /= trainingPoints;
 }
 
 template<typename ModelMatType>
@@ -188,6 +202,13 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   probabilities *= trainingPoints;
   probabilities[label]++;
 
+  // The variances hold the sample variances plus epsilon, like after the
+  // batch Train(), so that both can be used on the same model.  An untrained
+  // model doesn't have epsilon yet.
+  if (trainingPoints == 0)
+    variances += epsilon;
+  variances.col(label) -= epsilon;
+
   arma::vec delta = point - means.col(label);
   means.col(label) += delta / probabilities[label];
   if (probabilities[label] > 2)
@@ -195,6 +216,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   variances.col(label) += (delta % (point - means.col(label)));
   if (probabilities[label] > 1)
     variances.col(label) /= probabilities[label] - 1;
+  variances.col(label) += epsilon;
 
   trainingPoints++;
   probabilities /= trainingPoints;
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/data/normalize_labels.hpp>
+#include <mlpack/core/data/chunked_loader.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include "naive_bayes_classifier.hpp"
@@ -41,6 +42,12 @@ PROGRAM_INFO("Parametric Naive Bayes Classifier",
     PRINT_PARAM_STRING("labels") + " parameter may be specified to pass a "
     "separate matrix of labels."
     "\n\n"
+    "Datasets too large to fit in memory may instead be given as the name of a "
+    "file with the " + PRINT_PARAM_STRING("streaming_training") + " parameter;"
+    " the file is then read in chunks of " + PRINT_PARAM_STRING("chunk_size") +
+    " points, the labels are the last dimension of each point, and the model "
+    "is trained incrementally on one chunk at a time."
+    "\n\n"
     "If training is not desired, a pre-existing model may be loaded with the " +
     PRINT_PARAM_STRING("input_model") + " parameter."
     "\n\n"
@@ -112,6 +119,11 @@ PARAM_MODEL_OUT(NBCModel, "output_model", "File to save trained "
 PARAM_MATRIX_IN("training", "A matrix containing the training set.", "t");
 PARAM_UROW_IN("labels", "A file containing labels for the training set.",
     "l");
+PARAM_STRING_IN("streaming_training", "File containing a training set with "
+    "labels as the last dimension, to be read one chunk at a time instead of "
+    "the training parameter.", "", "");
+PARAM_INT_IN("chunk_size", "Number of points of the streaming training set "
+    "read at once.", "", 10000);
 PARAM_FLAG("incremental_variance", "The variance of each class will be "
     "calculated incrementally.", "I");
 
@@ -131,9 +143,16 @@ PARAM_MATRIX_OUT("probabilities", "The matrix in which the predicted"
 static void mlpackMain()
 {
   // Check input parameters.
-  RequireOnlyOnePassed({ "training", "input_model" }, true);
+  RequireOnlyOnePassed({ "training", "streaming_training", "input_model" },
+      true);
   ReportIgnoredParam({{ "training", false }}, "labels");
   ReportIgnoredParam({{ "training", false }}, "incremental_variance");
+  ReportIgnoredParam({{ "streaming_training", false }}, "chunk_size");
+  if (IO::HasParam("streaming_training"))
+  {
+    RequireParamValue<int>("chunk_size", [](int x) { return x > 0; }, true,
+        "chunk size must be positive");
+  }
   RequireAtLeastOnePassed({ "output", "predictions", "output_model",
       "output_probs", "probabilities" }, false, "no output will be saved");
   ReportIgnoredParam({{ "test", false }}, "output");
@@ -174,6 +193,54 @@ static void mlpackMain()
         model->mappings.n_elem, incrementalVariance);
     Timer::Stop("nbc_training");
   }
+  else if (IO::HasParam("streaming_training"))
+  {
+    model = new NBCModel();
+    data::ChunkedLoader<> loader(IO::GetParam<string>("streaming_training"),
+        (size_t) IO::GetParam<int>("chunk_size"));
+    if (loader.Dimensionality() < 2)
+    {
+      Log::Fatal << "The streaming training set must have at least one "
+          << "dimension and the labels!" << endl;
+    }
+    const size_t labelRow = loader.Dimensionality() - 1;
+
+    Timer::Start("nbc_training");
+
+    // The first pass over the dataset finds the labels, which are mapped in
+    // the order they are seen, like data::NormalizeLabels() does.
+    mat chunk;
+    unordered_map<size_t, size_t> labelMap;
+    vector<size_t> mappings;
+    while (loader.Next(chunk))
+    {
+      for (size_t i = 0; i < chunk.n_cols; ++i)
+      {
+        const size_t label = (size_t) chunk(labelRow, i);
+        if (labelMap.count(label) == 0)
+        {
+          labelMap[label] = mappings.size();
+          mappings.push_back(label);
+        }
+      }
+    }
+    model->mappings = Col<size_t>(mappings);
+    loader.Reset();
+
+    // The second pass trains the model incrementally.
+    model->nbc = NaiveBayesClassifier<>(labelRow, mappings.size());
+    Row<size_t> labels;
+    while (loader.Next(chunk))
+    {
+      labels.set_size(chunk.n_cols);
+      for (size_t i = 0; i < chunk.n_cols; ++i)
+        labels[i] = labelMap[(size_t) chunk(labelRow, i)];
+      chunk.shed_row(labelRow);
+
+      model->nbc.Train(chunk, labels, mappings.size(), true);
+    }
+    Timer::Stop("nbc_training");
+  }
   else
   {
     // Load the model from file.
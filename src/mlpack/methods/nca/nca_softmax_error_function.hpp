@@ -15,8 +15,6 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
-#include <mlpack/core/math/make_alias.hpp>
-#include <mlpack/core/math/shuffle_data.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -50,6 +48,8 @@ class SoftmaxErrorFunction
    * store, which is set elsewhere.  If no kernel is given, an empty kernel is
    * used; this way, you can call the constructor with no arguments.  A
    * reference to the dataset we will be optimizing over is also required.
+   * Only references to the dataset and the labels are kept, so they must be
+   * lvalues that outlive the function; passing temporaries does not compile.
    *
    * @param dataset Matrix containing the dataset.
    * @param labels Vector of class labels for each point in the dataset.
@@ -59,8 +59,17 @@ class SoftmaxErrorFunction
                        const arma::Row<size_t>& labels,
                        MetricType metric = MetricType());
 
+  // Temporaries would dangle, so they are rejected.
+  SoftmaxErrorFunction(arma::mat&&,
+                       const arma::Row<size_t>&,
+                       MetricType = MetricType()) = delete;
+  SoftmaxErrorFunction(const arma::mat&,
+                       arma::Row<size_t>&&,
+                       MetricType = MetricType()) = delete;
+
   /**
-   * Shuffle the dataset.
+   * Shuffle the order in which the separable functions visit the points of the
+   * dataset.  The dataset itself is not moved.
    */
   void Shuffle();
 
@@ -132,11 +141,12 @@ class SoftmaxErrorFunction
   size_t NumFunctions() const { return dataset.n_cols; }
 
  private:
-  //! The dataset.  This is an alias until Shuffle() is called.
-  arma::mat dataset;
-  //! Labels for each point in the dataset.  This is an alias until Shuffle() is
-  //! called.
-  arma::Row<size_t> labels;
+  //! The dataset.
+  const arma::mat& dataset;
+  //! Labels for each point in the dataset.
+  const arma::Row<size_t>& labels;
+  //! The order in which the separable functions visit the points.
+  arma::uvec visitationOrder;
 
   //! The instantiated metric.
   MetricType metric;
@@ -26,26 +26,19 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     const arma::mat& dataset,
     const arma::Row<size_t>& labels,
     MetricType metric) :
-    dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
-    labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
+    dataset(dataset),
+    labels(labels),
+    visitationOrder(arma::linspace<arma::uvec>(0, dataset.n_cols - 1,
+        dataset.n_cols)),
     metric(metric),
     precalculated(false)
 { /* nothing to do */ }
 
-//! Shuffle the dataset.
+//! Shuffle the order of visitation.
 template<typename MetricType>
 void SoftmaxErrorFunction<MetricType>::Shuffle()
 {
-  arma::mat newDataset;
-  arma::Row<size_t> newLabels;
-
-  math::ShuffleData(dataset, labels, newDataset, newLabels);
-
-  math::ClearAlias(dataset);
-  math::ClearAlias(labels);
-
-  dataset = std::move(newDataset);
-  labels = std::move(newLabels);
+  visitationOrder = arma::shuffle(visitationOrder);
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -74,8 +67,9 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
 
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
+  for (size_t b = begin; b < begin + batchSize; ++b)
   {
+    const size_t i = visitationOrder[b];
     for (size_t k = 0; k < dataset.n_cols; ++k)
     {
       // Don't consider the case where the points are the same.
@@ -174,8 +168,9 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
+  for (size_t b = begin; b < begin + batchSize; ++b)
   {
+    const size_t i = visitationOrder[b];
     numerator = 0;
     denominator = 0;
 
@@ -531,6 +531,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
   }
 
+  Counter::Add("neighbor_search_base_cases", baseCases);
+  Counter::Add("neighbor_search_scores", scores);
   Timer::Stop("computing_neighbors");
 
   // Map points back to original indices, if necessary.
@@ -659,6 +661,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   Log::Info << rules.Scores() << " node combinations were scored.\n";
   Log::Info << rules.BaseCases() << " base cases were calculated.\n";
 
+  Counter::Add("neighbor_search_base_cases", baseCases);
+  Counter::Add("neighbor_search_scores", scores);
   Timer::Stop("computing_neighbors");
 
   // Do we need to map indices?
@@ -839,6 +843,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   rules.GetResults(*neighborPtr, *distancePtr);
 
+  Counter::Add("neighbor_search_base_cases", baseCases);
+  Counter::Add("neighbor_search_scores", scores);
   Timer::Stop("computing_neighbors");
 
   // Do we need to map the reference indices?
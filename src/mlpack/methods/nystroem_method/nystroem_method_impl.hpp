@@ -43,7 +43,8 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
 
   // Construct semi-kernel matrix with interactions between selected data and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     for (size_t j = 0; j < rank; ++j)
       semiKernel(i, j) = kernel.Evaluate(data.col(i),
                                          selectedData->col(j));
@@ -69,7 +70,8 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
 
   // Construct semi-kernel matrix with interactions between selected points and
   // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     for (size_t j = 0; j < rank; ++j)
       semiKernel(i, j) = kernel.Evaluate(data.col(i),
                                          data.col(selectedPoints(j)));
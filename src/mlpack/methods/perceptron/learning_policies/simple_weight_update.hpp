@@ -52,7 +52,9 @@ class SimpleWeightUpdate
                      arma::vec& biases,
                      const size_t incorrectClass,
                      const size_t correctClass,
-                     const double instanceWeight = 1.0)
+                     const double instanceWeight = 1.0,
+                     const std::enable_if_t<
+                         !arma::is_arma_sparse_type<VecType>::value>* = 0)
   {
     weights.col(incorrectClass) -= instanceWeight * trainingPoint;
     biases(incorrectClass) -= instanceWeight;
@@ -60,6 +62,43 @@ class SimpleWeightUpdate
     weights.col(correctClass) += instanceWeight * trainingPoint;
     biases(correctClass) += instanceWeight;
   }
+
+  /**
+   * Update the weightVectors matrix for a sparse point.  Only the weights of
+   * the nonzero dimensions of the point are touched, so the cost of an update
+   * depends on the number of nonzeros and not on the dimensionality.
+   *
+   * @tparam Type of sparse vector (like arma::sp_vec or a column of an
+   *      arma::sp_mat).
+   * @param trainingPoint Point that was misclassified.
+   * @param weights Matrix of weights.
+   * @param biases Vector of biases.
+   * @param incorrectClass Index of class that the point was incorrectly
+   *      classified as.
+   * @param correctClass Index of the true class of the point.
+   * @param instanceWeight Weight to be given to this particular point during
+   *      training (this is useful for boosting).
+   */
+  template<typename VecType>
+  void UpdateWeights(const VecType& trainingPoint,
+                     arma::mat& weights,
+                     arma::vec& biases,
+                     const size_t incorrectClass,
+                     const size_t correctClass,
+                     const double instanceWeight = 1.0,
+                     const std::enable_if_t<
+                         arma::is_arma_sparse_type<VecType>::value>* = 0)
+  {
+    for (typename VecType::const_iterator it = trainingPoint.begin();
+         it != trainingPoint.end(); ++it)
+    {
+      weights(it.row(), incorrectClass) -= instanceWeight * (*it);
+      weights(it.row(), correctClass) += instanceWeight * (*it);
+    }
+
+    biases(incorrectClass) -= instanceWeight;
+    biases(correctClass) += instanceWeight;
+  }
 };
 
 } // namespace perceptron
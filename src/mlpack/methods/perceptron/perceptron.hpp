@@ -114,7 +114,7 @@ class Perceptron
    * @param predictedLabels Vector to store the predicted classes after
    *     classifying test.
    */
-  void Classify(const MatType& test, arma::Row<size_t>& predictedLabels);
+  void Classify(const MatType& test, arma::Row<size_t>& predictedLabels) const;
 
   /**
    * Serialize the perceptron.
@@ -104,17 +104,27 @@ template<
 >
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
-    arma::Row<size_t>& predictedLabels)
+    arma::Row<size_t>& predictedLabels) const
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
+  predictedLabels.set_size(test.n_cols);
 
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
+  // Score the points in blocks with one matrix product per block; the blocks
+  // are independent, so they are classified in parallel.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (test.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
   {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(0, i) = maxIndex;
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) test.n_cols);
+
+    arma::mat scores = weights.t() * test.cols(begin, end - 1);
+    scores.each_col() += biases;
+
+    const arma::urowvec maxIndices = arma::index_max(scores, 0);
+    for (size_t i = begin; i < end; ++i)
+      predictedLabels[i] = maxIndices[i - begin];
   }
 }
 
@@ -138,8 +148,9 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     const size_t numClasses,
     const arma::rowvec& instanceWeights)
 {
-  // Do we need to resize the weights?
-  if (weights.n_elem != numClasses)
+  // Do we need to resize the weights?  If the model already has the right
+  // size, training continues from it, so it can be trained one chunk at a time.
+  if (weights.n_rows != data.n_rows || weights.n_cols != numClasses)
   {
     WeightInitializationPolicy wip;
     wip.Initialize(weights, biases, data.n_rows, numClasses);
@@ -65,6 +65,13 @@ PROGRAM_INFO("Perceptron",
     "the " + PRINT_PARAM_STRING("labels") + " parameter may be used to specify "
     "a separate matrix of labels."
     "\n\n"
+    "For very high-dimensional sparse data, the training set may instead be "
+    "given as the name of a file holding a sparse matrix (for instance, in "
+    "coordinate list format) with the " + PRINT_PARAM_STRING("sparse_training")
+    + " parameter; only the weights of the nonzero dimensions of each point "
+    "are then updated during training, and the labels must be given with " +
+    PRINT_PARAM_STRING("labels") + "."
+    "\n\n"
     "All these options make it easy to train a perceptron, and then re-use that"
     " perceptron for later classification.  The invocation below trains a "
     "perceptron on " + PRINT_DATASET("training_data") + " with labels " +
@@ -124,6 +131,8 @@ class PerceptronModel
 PARAM_MATRIX_IN("training", "A matrix containing the training set.", "t");
 PARAM_UROW_IN("labels", "A matrix containing labels for the training set.",
     "l");
+PARAM_STRING_IN("sparse_training", "File containing a sparse training set, to "
+    "be used instead of the training parameter.", "", "");
 PARAM_INT_IN("max_iterations", "The maximum number of iterations the "
     "perceptron is to be run", "n", 1000);
 
@@ -146,7 +155,17 @@ static void mlpackMain()
   const size_t maxIterations = (size_t) IO::GetParam<int>("max_iterations");
 
   // We must either load a model or train a model.
-  RequireAtLeastOnePassed({ "input_model", "training" }, true);
+  RequireAtLeastOnePassed({ "input_model", "training", "sparse_training" },
+      true);
+
+  // A sparse training set replaces the dense one, and its labels must be given
+  // separately.
+  if (IO::HasParam("sparse_training"))
+  {
+    RequireOnlyOnePassed({ "training", "sparse_training" }, true);
+    RequireAtLeastOnePassed({ "labels" }, true, "labels must be given with a "
+        "sparse training set");
+  }
 
   // If the user isn't going to save the output model or any predictions, we
   // should issue a warning.
@@ -279,6 +298,70 @@ static void mlpackMain()
       Timer::Stop("training");
     }
   }
+  else if (IO::HasParam("sparse_training"))
+  {
+    Log::Info << "Training perceptron on sparse dataset '"
+        << IO::GetParam<string>("sparse_training") << "' with labels in '"
+        << IO::GetPrintableParam<Row<size_t>>("labels") << "' for a maximum of "
+        << maxIterations << " iterations." << endl;
+
+    sp_mat trainingData;
+    data::Load(IO::GetParam<string>("sparse_training"), trainingData, true);
+
+    Row<size_t> labelsIn = std::move(IO::GetParam<Row<size_t>>("labels"));
+    if (labelsIn.n_cols != trainingData.n_cols)
+    {
+      // Clean memory if needed.
+      if (!IO::HasParam("input_model"))
+        delete p;
+
+      Log::Fatal << "The responses must have the same number of columns "
+          "as the training set." << endl;
+    }
+
+    // Normalize the labels.
+    Row<size_t> labels;
+    data::NormalizeLabels(labelsIn, labels, p->Map());
+    const size_t numClasses = p->Map().n_elem;
+
+    // The sparse perceptron starts from the loaded model, if there is one, and
+    // the dense model then takes over the weights it learned.
+    Perceptron<SimpleWeightUpdate, ZeroInitialization, sp_mat> perceptron(
+        numClasses, trainingData.n_rows, maxIterations);
+    if (IO::HasParam("input_model"))
+    {
+      // Check dimensionality.
+      if (p->P().Weights().n_rows != trainingData.n_rows)
+      {
+        Log::Fatal << "Perceptron from '"
+            << IO::GetPrintableParam<PerceptronModel*>("input_model")
+            << "' is built on data with " << p->P().Weights().n_rows
+            << " dimensions, but data in '"
+            << IO::GetParam<string>("sparse_training") << "' has "
+            << trainingData.n_rows << "dimensions!" << endl;
+      }
+
+      // Check the number of labels.
+      if (numClasses > p->P().Weights().n_cols)
+      {
+        Log::Fatal << "Perceptron from '"
+            << IO::GetPrintableParam<PerceptronModel*>("input_model") << "' "
+            << "has " << p->P().Weights().n_cols << " classes, but the training"
+            << " data has " << numClasses + 1 << " classes!" << endl;
+      }
+
+      perceptron.Weights() = std::move(p->P().Weights());
+      perceptron.Biases() = std::move(p->P().Biases());
+    }
+
+    Timer::Start("training");
+    perceptron.Train(trainingData, labels, numClasses);
+    Timer::Stop("training");
+
+    p->P().MaxIterations() = maxIterations;
+    p->P().Weights() = std::move(perceptron.Weights());
+    p->P().Biases() = std::move(perceptron.Biases());
+  }
 
   // Now, the training procedure is complete.  Do we have any test data?
   if (IO::HasParam("test"))
@@ -47,6 +47,18 @@ void Bootstrap(const MatType& dataset,
   }
 }
 
+/**
+ * Draw a bootstrap sample of the given number of points as a sorted list of
+ * point indices, so that the dataset does not need to be copied.
+ */
+inline void BootstrapIndices(const size_t numPoints, arma::uvec& indices)
+{
+  // Random sampling with replacement.  Sorting the indices makes the accesses
+  // to the dataset sequential.
+  indices = arma::sort(arma::randi<arma::uvec>(numPoints,
+      arma::distr_param(0, numPoints - 1)));
+}
+
 } // namespace tree
 } // namespace mlpack
 
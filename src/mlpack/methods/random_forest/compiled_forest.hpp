@@ -0,0 +1,202 @@
+/**
+ * @file methods/random_forest/compiled_forest.hpp
+ *
+ * Definition of the CompiledForest class, which stores trained decision trees
+ * in flat arrays for fast classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_COMPILED_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_COMPILED_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/map_policies/datatype.hpp>
+
+namespace mlpack {
+namespace tree {
+
+// Forward declarations of the split types that can be compiled.
+template<typename FitnessFunction>
+class BestBinaryNumericSplit;
+template<typename FitnessFunction>
+class AllCategoricalSplit;
+
+/**
+ * The CompiledForest is an inference-only representation of a trained
+ * RandomForest (or of any set of trained DecisionTrees).  The nodes of all the
+ * trees are stored in flat arrays (the split dimension, the split threshold
+ * and the offset of the first child of every node), with the children of each
+ * node next to each other, so a point is classified without following any
+ * pointers or calling the split types.
+ *
+ * Points are classified in blocks: each tree is evaluated for every point of a
+ * block level by level, and every leaf points back to itself, so the
+ * traversal of a tree takes exactly as many steps as the depth of the tree
+ * and has no data-dependent branches.  Blocks are classified in parallel.
+ *
+ * The predictions and probabilities are the same as the ones given by
+ * RandomForest::Classify().  Since a CompiledForest can be serialized on its
+ * own, a program that only classifies points does not need the decision tree
+ * code at all.
+ *
+ * The trees must use the BestBinaryNumericSplit for numeric dimensions and the
+ * AllCategoricalSplit for categorical dimensions.
+ *
+ * @code
+ * RandomForest<> rf(dataset, labels, numClasses, 300);
+ * CompiledForest<> forest(rf);
+ * forest.Classify(testData, predictions, probabilities);
+ * @endcode
+ *
+ * @tparam ElemType Type of the split thresholds.
+ */
+template<typename ElemType = double>
+class CompiledForest
+{
+ public:
+  /**
+   * Create an empty forest.  Classify() will throw an exception until a tree
+   * is added.
+   */
+  CompiledForest() : numClasses(0), minimumDimensionality(0) { }
+
+  /**
+   * Compile all the trees of the given forest.  The ForestType must provide
+   * NumTrees() and Tree(i), like RandomForest.
+   *
+   * @param forest Trained forest to compile.
+   */
+  template<typename ForestType>
+  explicit CompiledForest(const ForestType& forest);
+
+  /**
+   * Compile the given trained tree and add it to the forest.  The class
+   * probabilities of the forest are the average of the class probabilities of
+   * its trees.  The TreeType must provide the accessors of DecisionTree.
+   *
+   * @param tree Trained tree to add.
+   */
+  template<typename TreeType>
+  void AddTree(const TreeType& tree);
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities for each class.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning the
+   * predicted class probabilities for each point.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return roots.size(); }
+  //! Get the total number of nodes in the forest.
+  size_t NumNodes() const { return children.size(); }
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  /**
+   * Serialize the forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The number of points classified at once by each thread.
+  static const size_t blockSize = 256;
+
+  //! Return true if the split type can be compiled.
+  template<typename SplitType>
+  struct IsNumericThresholdSplit : std::false_type { };
+  template<typename FitnessFunction>
+  struct IsNumericThresholdSplit<BestBinaryNumericSplit<FitnessFunction>> :
+      std::true_type { };
+
+  //! Return true if the split type can be compiled.
+  template<typename SplitType>
+  struct IsCategoricalIndexSplit : std::false_type { };
+  template<typename FitnessFunction>
+  struct IsCategoricalIndexSplit<AllCategoricalSplit<FitnessFunction>> :
+      std::true_type { };
+
+  /**
+   * Add the class probabilities of every tree for the given block of points
+   * to the given columns of the probabilities matrix.
+   */
+  template<typename MatType>
+  void ClassifyBlock(const MatType& data,
+                     const size_t begin,
+                     const size_t end,
+                     arma::mat& probabilities) const;
+
+  //! The dimension each node splits on (0 for leaves).
+  std::vector<size_t> dimensions;
+  //! The threshold of each numeric node; points not larger go to the first
+  //! child.
+  std::vector<ElemType> thresholds;
+  //! The index of the first child of each node (the node itself for leaves).
+  std::vector<size_t> children;
+  //! The direction mask of each node: all ones for non-leaves and zero for
+  //! leaves, so that a leaf always points back to itself.
+  std::vector<size_t> masks;
+  //! Whether each node splits on a categorical dimension.
+  std::vector<char> categorical;
+  //! The column of leafProbabilities of each leaf.
+  std::vector<size_t> leaves;
+  //! The index of the root of each tree.
+  std::vector<size_t> roots;
+  //! The depth of each tree.
+  std::vector<size_t> depths;
+  //! The class probabilities of every leaf, one column per leaf.
+  arma::mat leafProbabilities;
+  //! The number of classes.
+  size_t numClasses;
+  //! The smallest dimensionality of the points that can be classified.
+  size_t minimumDimensionality;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "compiled_forest_impl.hpp"
+
+#endif
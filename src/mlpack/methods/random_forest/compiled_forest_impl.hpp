@@ -0,0 +1,269 @@
+/**
+ * @file methods/random_forest/compiled_forest_impl.hpp
+ *
+ * Implementation of the CompiledForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_COMPILED_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_COMPILED_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compiled_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename ElemType>
+template<typename ForestType>
+CompiledForest<ElemType>::CompiledForest(const ForestType& forest) :
+    numClasses(0),
+    minimumDimensionality(0)
+{
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    AddTree(forest.Tree(i));
+}
+
+template<typename ElemType>
+template<typename TreeType>
+void CompiledForest<ElemType>::AddTree(const TreeType& tree)
+{
+  static_assert(IsNumericThresholdSplit<typename TreeType::NumericSplit>::value,
+      "CompiledForest::AddTree(): only trees using the BestBinaryNumericSplit "
+      "can be compiled!");
+  static_assert(
+      IsCategoricalIndexSplit<typename TreeType::CategoricalSplit>::value,
+      "CompiledForest::AddTree(): only trees using the AllCategoricalSplit can "
+      "be compiled!");
+
+  if (roots.empty())
+  {
+    numClasses = tree.NumClasses();
+  }
+  else if (tree.NumClasses() != numClasses)
+  {
+    std::ostringstream oss;
+    oss << "CompiledForest::AddTree(): the tree has " << tree.NumClasses()
+        << " classes, but the forest has " << numClasses << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Lay out the nodes in breadth-first order, so that the children of every
+  // node are next to each other.
+  const size_t root = children.size();
+  std::vector<const TreeType*> nodes(1, &tree);
+  std::vector<size_t> nodeDepths(1, 0);
+  std::vector<const TreeType*> treeLeaves;
+  size_t depth = 0;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const TreeType& node = *nodes[i];
+    if (node.NumChildren() == 0)
+    {
+      // The point stays in the leaf for the remaining steps.
+      dimensions.push_back(0);
+      thresholds.push_back(ElemType(0));
+      children.push_back(root + i);
+      masks.push_back(0);
+      categorical.push_back(0);
+      leaves.push_back(leafProbabilities.n_cols + treeLeaves.size());
+      treeLeaves.push_back(&node);
+      depth = std::max(depth, nodeDepths[i]);
+      continue;
+    }
+
+    const bool isCategorical =
+        (node.SplitDimensionType() == data::Datatype::categorical);
+    dimensions.push_back(node.SplitDimension());
+    thresholds.push_back(isCategorical ? ElemType(0) :
+        (ElemType) node.ClassProbabilities()[0]);
+    children.push_back(root + nodes.size());
+    masks.push_back(~size_t(0));
+    categorical.push_back(isCategorical ? 1 : 0);
+    leaves.push_back(0);
+    minimumDimensionality = std::max(minimumDimensionality,
+        node.SplitDimension() + 1);
+
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+    {
+      nodes.push_back(&node.Child(c));
+      nodeDepths.push_back(nodeDepths[i] + 1);
+    }
+  }
+
+  const size_t firstLeaf = leafProbabilities.n_cols;
+  leafProbabilities.resize(numClasses, firstLeaf + treeLeaves.size());
+  for (size_t i = 0; i < treeLeaves.size(); ++i)
+    leafProbabilities.col(firstLeaf + i) = treeLeaves[i]->ClassProbabilities();
+
+  roots.push_back(root);
+  depths.push_back(depth);
+}
+
+template<typename ElemType>
+template<typename VecType>
+size_t CompiledForest<ElemType>::Classify(const VecType& point) const
+{
+  // Pass off to another Classify() overload.
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+
+  return prediction;
+}
+
+template<typename ElemType>
+template<typename VecType>
+void CompiledForest<ElemType>::Classify(const VecType& point,
+                                        size_t& prediction,
+                                        arma::vec& probabilities) const
+{
+  if (roots.empty())
+  {
+    throw std::invalid_argument("CompiledForest::Classify(): no trees in the "
+        "forest!");
+  }
+
+  if (point.n_rows < minimumDimensionality)
+  {
+    std::ostringstream oss;
+    oss << "CompiledForest::Classify(): the point has " << point.n_rows
+        << " dimensions, but the forest needs at least "
+        << minimumDimensionality << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The point is a block of one point.
+  probabilities.zeros(numClasses);
+  ClassifyBlock(point, 0, 1, probabilities);
+
+  probabilities /= roots.size();
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+template<typename ElemType>
+template<typename MatType>
+void CompiledForest<ElemType>::Classify(const MatType& data,
+                                        arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename ElemType>
+template<typename MatType>
+void CompiledForest<ElemType>::Classify(const MatType& data,
+                                        arma::Row<size_t>& predictions,
+                                        arma::mat& probabilities) const
+{
+  if (roots.empty())
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("CompiledForest::Classify(): no trees in the "
+        "forest!");
+  }
+
+  if (data.n_rows < minimumDimensionality)
+  {
+    std::ostringstream oss;
+    oss << "CompiledForest::Classify(): the data has " << data.n_rows
+        << " dimensions, but the forest needs at least "
+        << minimumDimensionality << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  probabilities.zeros(numClasses, data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+    ClassifyBlock(data, begin, end, probabilities);
+
+    arma::uword maxIndex = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= roots.size();
+      probabilities.unsafe_col(i).max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
+  }
+}
+
+template<typename ElemType>
+template<typename MatType>
+void CompiledForest<ElemType>::ClassifyBlock(const MatType& data,
+                                             const size_t begin,
+                                             const size_t end,
+                                             arma::mat& probabilities) const
+{
+  typedef typename MatType::elem_type DataElemType;
+
+  const size_t* nodeDimensions = dimensions.data();
+  const ElemType* nodeThresholds = thresholds.data();
+  const size_t* nodeChildren = children.data();
+  const size_t* nodeMasks = masks.data();
+  const char* nodeCategorical = categorical.data();
+
+  std::vector<size_t> nodes(end - begin);
+  for (size_t t = 0; t < roots.size(); ++t)
+  {
+    std::fill(nodes.begin(), nodes.end(), roots[t]);
+
+    // Move every point of the block down one level at a time.  Points that
+    // have already reached a leaf stay there, since the mask of a leaf is zero.
+    for (size_t d = 0; d < depths[t]; ++d)
+    {
+      for (size_t i = 0; i < nodes.size(); ++i)
+      {
+        const size_t node = nodes[i];
+        const DataElemType value = data.at(nodeDimensions[node], begin + i);
+        const size_t direction = nodeCategorical[node] ? (size_t) value :
+            (size_t) !(value <= nodeThresholds[node]);
+        nodes[i] = nodeChildren[node] + (direction & nodeMasks[node]);
+      }
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      const double* leaf = leafProbabilities.colptr(leaves[nodes[i]]);
+      double* output = probabilities.colptr(begin + i);
+      for (size_t c = 0; c < numClasses; ++c)
+        output[c] += leaf[c];
+    }
+  }
+}
+
+template<typename ElemType>
+template<typename Archive>
+void CompiledForest<ElemType>::serialize(Archive& ar,
+                                         const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(dimensions);
+  ar & BOOST_SERIALIZATION_NVP(thresholds);
+  ar & BOOST_SERIALIZATION_NVP(children);
+  ar & BOOST_SERIALIZATION_NVP(masks);
+  ar & BOOST_SERIALIZATION_NVP(categorical);
+  ar & BOOST_SERIALIZATION_NVP(leaves);
+  ar & BOOST_SERIALIZATION_NVP(roots);
+  ar & BOOST_SERIALIZATION_NVP(depths);
+  ar & BOOST_SERIALIZATION_NVP(leafProbabilities);
+  ar & BOOST_SERIALIZATION_NVP(numClasses);
+  ar & BOOST_SERIALIZATION_NVP(minimumDimensionality);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -276,6 +276,63 @@ class RandomForest
                DimensionSelectionType dimensionSelector =
                    DimensionSelectionType());
 
+  /**
+   * Train the random forest on the given binned dataset with the given number
+   * of trees.  Every tree is trained on a bootstrap sample of the indices of
+   * the points, with splits found from histograms of the bins, so neither the
+   * dataset nor its bootstrap samples are copied.  The binned dataset can be
+   * reused to train several forests.  The minimumLeafSize and
+   * minimumGainSplit parameters are given to each individual decision tree
+   * during tree building.  Optionally, you may specify a
+   * DimensionSelectionType to set parameters for the strategy used to choose
+   * dimensions.
+   *
+   * @param data Binned dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  double Train(const BinnedDataset<ElemType>& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numTrees = 20,
+               const size_t minimumLeafSize = 1,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
+  /**
+   * Train the random forest on the given weighted binned dataset with the
+   * given number of trees.  See the unweighted overload for details.
+   *
+   * @param data Binned dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param weights Weights (importances) of each point in the dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  double Train(const BinnedDataset<ElemType>& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               const size_t numTrees = 20,
+               const size_t minimumLeafSize = 1,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
   /**
    * Predict the class of the given point.  If the random forest has not been
    * trained, this will throw an exception.
@@ -371,6 +428,34 @@ class RandomForest
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
 
+  /**
+   * Perform the training of the decision trees on a binned dataset.  The
+   * template bool parameter controls whether or not the weights argument
+   * should be ignored.
+   *
+   * @param data Binned dataset to train on.
+   * @param labels Labels for the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point in the dataset (may be ignored).
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @tparam UseWeights Whether or not to use the weights parameter.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  template<bool UseWeights>
+  double Train(const BinnedDataset<ElemType>& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               const size_t numTrees,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector);
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 };
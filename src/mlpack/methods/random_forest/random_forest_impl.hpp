@@ -263,6 +263,62 @@ double RandomForest<
       dimensionSelector);
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::Train(const BinnedDataset<ElemType>& dataset,
+         const arma::Row<size_t>& labels,
+         const size_t numClasses,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType dimensionSelector)
+{
+  // Pass off to Train().
+  arma::rowvec weights; // Ignored by Train().
+  return Train<false>(dataset, labels, numClasses, weights, numTrees,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::Train(const BinnedDataset<ElemType>& dataset,
+         const arma::Row<size_t>& labels,
+         const size_t numClasses,
+         const arma::rowvec& weights,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType dimensionSelector)
+{
+  // Pass off to Train().
+  return Train<true>(dataset, labels, numClasses, weights, numTrees,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -514,6 +570,62 @@ double RandomForest<
   return avgGain / numTrees;
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+template<bool UseWeights>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::Train(const BinnedDataset<ElemType>& dataset,
+         const arma::Row<size_t>& labels,
+         const size_t numClasses,
+         const arma::rowvec& weights,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         DimensionSelectionType& dimensionSelector)
+{
+  // Train each tree individually.
+  trees.resize(numTrees); // This will fill the vector with untrained trees.
+  double avgGain = 0.0;
+
+  #pragma omp parallel for reduction( + : avgGain)
+  for (omp_size_t i = 0; i < (omp_size_t) numTrees; ++i)
+  {
+    // The bootstrap sample only holds the indices of the points.
+    Timer::Start("bootstrap");
+    arma::uvec indices;
+    BootstrapIndices(dataset.NumPoints(), indices);
+    Timer::Stop("bootstrap");
+
+    // Now build the decision tree.
+    Timer::Start("train_tree");
+    if (UseWeights)
+    {
+      avgGain += trees[i].Train(dataset, labels, numClasses, weights,
+          std::move(indices), minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector);
+    }
+    else
+    {
+      avgGain += trees[i].Train(dataset, labels, numClasses,
+          std::move(indices), minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector);
+    }
+    Timer::Stop("train_tree");
+  }
+  return avgGain / numTrees;
+}
+
 } // namespace tree
 } // namespace mlpack
 
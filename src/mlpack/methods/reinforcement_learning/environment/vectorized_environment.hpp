@@ -0,0 +1,169 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ *
+ * Wrapper that steps several copies of an RL environment in batch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Interface for stepping several independent copies of an environment (such
+ * as CartPole or Acrobot) at once.  Every copy keeps its own current state;
+ * the states of all copies can be encoded into one matrix, so an agent can
+ * select the actions of all copies with a single batched forward pass of its
+ * network.  A copy that reaches a terminal state is restarted automatically.
+ *
+ * The copies are stepped one after the other: stochastic environments (such
+ * as Acrobot) draw from the global random number generator, which can't be
+ * shared between threads, and stepping them in order keeps the trajectories
+ * reproducible for a given random seed.
+ *
+ * @tparam EnvironmentType A type of Environment that is being wrapped.
+ */
+template <typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Create the given number of copies of the given environment, and sample an
+   * initial state for each of them.
+   *
+   * @param numEnvironments Number of copies of the environment.
+   * @param environment An instance of the environment to copy.
+   */
+  VectorizedEnvironment(
+      const size_t numEnvironments,
+      const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvironments, environment),
+      states(numEnvironments),
+      steps(numEnvironments, 0),
+      returns(numEnvironments, arma::fill::zeros)
+  {
+    Reset();
+  }
+
+  /**
+   * Restart every copy of the environment from a new initial state.
+   */
+  void Reset()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+      states[i] = environments[i].InitialSample();
+    std::fill(steps.begin(), steps.end(), 0);
+    returns.zeros();
+    episodeReturns.clear();
+  }
+
+  /**
+   * Advance every copy of the environment by one step.  Copies that reach a
+   * terminal state or the given step limit are restarted, and the return of
+   * their finished episode is recorded (see EpisodeReturns()).
+   *
+   * @param actions The action to take in each copy.
+   * @param nextStates The state each copy advanced to (before a possible
+   *     restart), so that the transitions can be stored for replay.
+   * @param rewards The reward of each copy.
+   * @param isTerminal Whether each copy reached a terminal state or the step
+   *     limit.
+   * @param stepLimit Maximum number of steps of an episode (0 means no limit).
+   */
+  void Step(const std::vector<Action>& actions,
+            std::vector<State>& nextStates,
+            arma::rowvec& rewards,
+            arma::irowvec& isTerminal,
+            const size_t stepLimit = 0)
+  {
+    nextStates.resize(environments.size());
+    rewards.set_size(environments.size());
+    isTerminal.set_size(environments.size());
+
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards[i] = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      isTerminal[i] = environments[i].IsTerminal(nextStates[i]) ||
+          (stepLimit > 0 && steps[i] + 1 >= stepLimit);
+
+      // Record the finished episode and restart the copy.
+      returns[i] += rewards[i];
+      if (isTerminal[i])
+      {
+        episodeReturns.push_back(returns[i]);
+        returns[i] = 0.0;
+        steps[i] = 0;
+        states[i] = environments[i].InitialSample();
+      }
+      else
+      {
+        ++steps[i];
+        states[i] = nextStates[i];
+      }
+    }
+  }
+
+  /**
+   * Encode the current states of all copies into one matrix, with one column
+   * per copy.
+   */
+  arma::mat Encode() const
+  {
+    arma::mat encoded(State::dimension, states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+      encoded.col(i) = states[i].Encode();
+    return encoded;
+  }
+
+  //! Get the number of copies of the environment.
+  size_t NumEnvironments() const { return environments.size(); }
+
+  //! Get the current state of every copy.
+  const std::vector<State>& States() const { return states; }
+
+  //! Get the given copy of the environment.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+  //! Modify the given copy of the environment.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the returns of all episodes finished so far, in order.
+  const std::vector<double>& EpisodeReturns() const { return episodeReturns; }
+  //! Modify the returns of all episodes finished so far.
+  std::vector<double>& EpisodeReturns() { return episodeReturns; }
+
+ private:
+  //! Locally-stored copies of the environment.
+  std::vector<EnvironmentType> environments;
+
+  //! Locally-stored current state of every copy.
+  std::vector<State> states;
+
+  //! Locally-stored number of steps of the running episode of every copy.
+  std::vector<size_t> steps;
+
+  //! Locally-stored return of the running episode of every copy.
+  arma::rowvec returns;
+
+  //! Locally-stored returns of all finished episodes.
+  std::vector<double> episodeReturns;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,8 @@
 
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
+#include "replay/sharded_replay.hpp"
+#include "environment/vectorized_environment.hpp"
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -110,6 +112,20 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Advance every copy of the given vectorized environment by one step.  The
+   * actions of all copies are selected with one batched forward pass of the
+   * learning network, the transitions are stored for replay, and (after the
+   * exploration steps) the agent is trained once.  Episodes are cut off after
+   * the step limit of the training configuration.  With a ShardedReplay, the
+   * transitions of each copy are stored in their own shard.  Only one-step
+   * replay is supported.
+   *
+   * @param environments The copies of the environment to step.
+   * @return Total reward collected by all copies.
+   */
+  double Step(VectorizedEnvironment<EnvironmentType>& environments);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -173,6 +189,9 @@ class QLearning
   //! Total steps from the beginning of the task.
   size_t totalSteps;
 
+  //! Total steps at the last update of the target network.
+  size_t lastSyncStep;
+
   //! Locally-stored current state of the agent.
   StateType state;
 
@@ -46,6 +46,7 @@ QLearning<
     #endif
     environment(std::move(environment)),
     totalSteps(0),
+    lastSyncStep(0),
     deterministic(false)
 {
   // To copy over the network structure.
@@ -194,9 +195,15 @@ void QLearning<
     learningNetwork.ResetNoise();
     targetNetwork.ResetNoise();
   }
-  // Update target network.
-  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+  // Update target network.  Step() advances the total steps by more than one
+  // at a time, so the network is updated whenever a multiple of the interval
+  // was passed since the last update.
+  if (totalSteps / config.TargetNetworkSyncInterval() !=
+      lastSyncStep / config.TargetNetworkSyncInterval())
+  {
     targetNetwork.Parameters() = learningNetwork.Parameters();
+    lastSyncStep = totalSteps;
+  }
 
   if (totalSteps > config.ExplorationSteps())
     policy.Anneal();
@@ -305,9 +312,15 @@ void QLearning<
     learningNetwork.ResetNoise();
     targetNetwork.ResetNoise();
   }
-  // Update target network.
-  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+  // Update target network.  Step() advances the total steps by more than one
+  // at a time, so the network is updated whenever a multiple of the interval
+  // was passed since the last update.
+  if (totalSteps / config.TargetNetworkSyncInterval() !=
+      lastSyncStep / config.TargetNetworkSyncInterval())
+  {
     targetNetwork.Parameters() = learningNetwork.Parameters();
+    lastSyncStep = totalSteps;
+  }
 
   if (totalSteps > config.ExplorationSteps())
     policy.Anneal();
@@ -385,6 +398,105 @@ double QLearning<
   return totalReturn;
 }
 
+/**
+ * Store the transition of the given copy of a vectorized environment.  Replay
+ * methods without shards hold the transitions of all copies together.
+ */
+template<typename ReplayType, typename StateType, typename ActionType>
+void StoreTransition(ReplayType& replayMethod,
+                     const size_t /* environment */,
+                     const StateType& state,
+                     const ActionType& action,
+                     const double reward,
+                     const StateType& nextState,
+                     const bool isEnd,
+                     const double discount)
+{
+  replayMethod.Store(state, action, reward, nextState, isEnd, discount);
+}
+
+/**
+ * Store the transition of the given copy of a vectorized environment in the
+ * shard of that copy, so that the transitions of the copies are spread over
+ * all shards.
+ */
+template<typename EnvironmentType>
+void StoreTransition(ShardedReplay<EnvironmentType>& replayMethod,
+                     const size_t environment,
+                     const typename EnvironmentType::State& state,
+                     const typename EnvironmentType::Action& action,
+                     const double reward,
+                     const typename EnvironmentType::State& nextState,
+                     const bool isEnd,
+                     const double discount)
+{
+  replayMethod.Store(environment % replayMethod.NumShards(), state, action,
+      reward, nextState, isEnd, discount);
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Step(VectorizedEnvironment<EnvironmentType>& environments)
+{
+  if (replayMethod.NSteps() > 1)
+  {
+    throw std::invalid_argument("QLearning::Step(): n-step replay is not "
+        "supported with vectorized environments!");
+  }
+
+  // Get the action values of all environments with one forward pass.
+  arma::mat actionValues;
+  learningNetwork.Predict(environments.Encode(), actionValues);
+
+  // Select an action for each environment according to the behavior policy.
+  std::vector<ActionType> actions(environments.NumEnvironments());
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    actions[i] = policy.Sample(actionValues.col(i), deterministic,
+        config.NoisyQLearning());
+  }
+
+  // Interact with all environments to advance to their next states.
+  const std::vector<StateType> states = environments.States();
+  std::vector<StateType> nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  environments.Step(actions, nextStates, rewards, isTerminal,
+      config.StepLimit());
+
+  // Store the transitions for replay.
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    StoreTransition(replayMethod, i, states[i], actions[i], rewards[i],
+        nextStates[i], isTerminal[i], config.Discount());
+  }
+
+  totalSteps += actions.size();
+  action = actions.back();
+  state = environments.States().back();
+
+  if (!deterministic && totalSteps >= config.ExplorationSteps())
+  {
+    if (config.IsCategorical())
+      TrainCategoricalAgent();
+    else
+      TrainAgent();
+  }
+
+  return arma::accu(rewards);
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -0,0 +1,163 @@
+/**
+ * @file methods/reinforcement_learning/replay/atomic_sumtree.hpp
+ *
+ * This file is an implementation of a lock-free sumtree, which can be updated
+ * and queried by several threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ATOMIC_SUMTREE_HPP
+#define MLPACK_METHODS_RL_ATOMIC_SUMTREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of a lock-free SumTree.
+ *
+ * The tree has the same layout as SumTree, but every node is an atomic value.
+ * Setting a leaf exchanges its value and adds the difference to all of its
+ * ancestors with atomic compare-and-swap loops, so any number of threads can
+ * call Set() concurrently, and readers never block.  While updates are in
+ * flight, the sums seen by a reader may lag behind the leaves; callers of
+ * FindPrefixSum() should therefore be prepared to receive the index of a leaf
+ * with zero value.  Since the sums are maintained incrementally, they can
+ * accumulate rounding errors over many updates; Rebuild() recomputes them
+ * exactly when no other thread is using the tree.
+ *
+ * @tparam T The array's element type.
+ */
+template<typename T>
+class AtomicSumTree
+{
+ public:
+  /**
+   * Default constructor.
+   */
+  AtomicSumTree() : capacity(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of AtomicSumTree class.  The capacity should be a
+   * power of two.
+   *
+   * @param capacity Size of data.
+   */
+  AtomicSumTree(const size_t capacity) :
+      capacity(capacity),
+      element(2 * capacity)
+  {
+    for (std::atomic<T>& e : element)
+      e.store(T(0), std::memory_order_relaxed);
+  }
+
+  /**
+   * Set the data array with idx.  This can be called concurrently from several
+   * threads.
+   *
+   * @param idx The array idx to be changed.
+   * @param value The data that array with idx to be.
+   */
+  void Set(size_t idx, const T value)
+  {
+    idx += capacity;
+    const T delta = value - element[idx].exchange(value,
+        std::memory_order_relaxed);
+    for (idx /= 2; idx >= 1; idx /= 2)
+      AtomicAdd(element[idx], delta);
+  }
+
+  /**
+   * Get the data array with idx.
+   *
+   * @param idx The array idx to get data.
+   */
+  T Get(const size_t idx) const
+  {
+    return element[idx + capacity].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Get the sum of the whole array.
+   */
+  T Sum() const
+  {
+    return element[1].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Find the highest index `idx` in the array such that
+   * sum(arr[0] + arr[1] + ... + arr[idx]) <= mass.
+   *
+   * @param mass The upper bound of segment array sum.
+   */
+  size_t FindPrefixSum(T mass) const
+  {
+    size_t idx = 1;
+    while (idx < capacity)
+    {
+      const T left = element[2 * idx].load(std::memory_order_relaxed);
+      if (left > mass)
+      {
+        idx = 2 * idx;
+      }
+      else
+      {
+        mass -= left;
+        idx = 2 * idx + 1;
+      }
+    }
+    return idx - capacity;
+  }
+
+  /**
+   * Recompute all inner nodes from the leaves.  This is not thread-safe and
+   * removes the rounding errors accumulated by the incremental updates.
+   */
+  void Rebuild()
+  {
+    for (size_t i = capacity - 1; i > 0; --i)
+    {
+      element[i].store(element[2 * i].load(std::memory_order_relaxed) +
+          element[2 * i + 1].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+  }
+
+  //! Get the capacity of the data array.
+  size_t Capacity() const { return capacity; }
+
+ private:
+  /**
+   * Atomically add the given value to the given node.
+   *
+   * @param node The node to be changed.
+   * @param delta The value to add.
+   */
+  static void AtomicAdd(std::atomic<T>& node, const T delta)
+  {
+    T current = node.load(std::memory_order_relaxed);
+    while (!node.compare_exchange_weak(current, current + delta,
+        std::memory_order_relaxed))
+    {
+      // compare_exchange_weak() reloaded the current value; try again.
+    }
+  }
+
+  //! The capacity of the data array.
+  size_t capacity;
+
+  //! Double size of capacity, maintain the segment sum of data.
+  std::vector<std::atomic<T>> element;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
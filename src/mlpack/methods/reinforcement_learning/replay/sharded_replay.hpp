@@ -0,0 +1,480 @@
+/**
+ * @file methods/reinforcement_learning/replay/sharded_replay.hpp
+ *
+ * This file is an implementation of a sharded experience replay that can be
+ * filled by several threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_SHARDED_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_SHARDED_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include "atomic_sumtree.hpp"
+#include <atomic>
+#include <cassert>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of a sharded, concurrent experience replay.
+ *
+ * The memory is split into a number of shards, each of them a
+ * First-In-First-Out ring buffer with its own n-step buffer.  Every shard is
+ * meant to be filled by one writer (an environment, or a worker thread), so
+ * different shards can be filled concurrently without any lock: a transition
+ * is published by advancing the atomic counter of its shard, and every slot
+ * carries a sequence number that lets a reader detect (and retry) a slot that
+ * is overwritten while it is being copied.
+ *
+ * Sampling is either uniform over all stored transitions (alpha = 0), or
+ * proportional to the priority of the transitions as in PrioritizedReplay
+ * (alpha > 0).  The priorities of all shards are kept in an AtomicSumTree, so
+ * writers can insert new transitions while the learner samples and updates
+ * priorities.  Sample() and Update() themselves are meant to be called by a
+ * single learner thread.
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class ShardedReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
+  /**
+   * Construct an instance of sharded experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param numShards Number of shards (independent writers).
+   * @param alpha How much prioritization is used (0 for uniform sampling).
+   * @param nSteps Number of steps to look in the future.
+   * @param dimension The dimension of an encoded state.
+   */
+  ShardedReplay(const size_t batchSize,
+                const size_t capacity,
+                const size_t numShards = 1,
+                const double alpha = 0.0,
+                const size_t nSteps = 1,
+                const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      shardCapacity((capacity + numShards - 1) / numShards),
+      alpha(alpha),
+      maxPriority(1.0),
+      initialBeta(0.6),
+      beta(0.6),
+      replayBetaIters(10000),
+      nSteps(nSteps)
+  {
+    shards.reserve(numShards);
+    for (size_t i = 0; i < numShards; ++i)
+      shards.emplace_back(new Shard(shardCapacity, dimension));
+
+    if (alpha > 0)
+    {
+      size_t size = 1;
+      while (size < numShards * shardCapacity)
+        size *= 2;
+
+      idxSum = AtomicSumTree<double>(size);
+    }
+  }
+
+  /**
+   * Store the given experience in the first shard.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    Store(0, std::move(state), std::move(action), reward,
+        std::move(nextState), isEnd, discount);
+  }
+
+  /**
+   * Store the given experience in the given shard.  Different shards can be
+   * filled concurrently, but each shard must only be filled by one thread at
+   * a time.
+   *
+   * @param shard Index of the shard to store the experience in.
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(const size_t shard,
+             StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    Shard& s = *shards[shard];
+    s.nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+    // Single step transition is not ready.
+    if (s.nStepBuffer.size() < nSteps)
+      return;
+
+    // To keep the queue size fixed to nSteps.
+    if (s.nStepBuffer.size() > nSteps)
+      s.nStepBuffer.pop_front();
+
+    assert(s.nStepBuffer.size() == nSteps);
+
+    // Make a n-step transition.
+    GetNStepInfo(s.nStepBuffer, reward, nextState, isEnd, discount);
+
+    state = s.nStepBuffer.front().state;
+    action = s.nStepBuffer.front().action;
+
+    const size_t stored = s.stored.load(std::memory_order_relaxed);
+    const size_t slot = stored % shardCapacity;
+
+    // An odd sequence number marks the slot as being written.
+    const size_t version = s.version[slot].load(std::memory_order_relaxed);
+    s.version[slot].store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s.states.col(slot) = state.Encode();
+    s.actions[slot] = action;
+    s.rewards(slot) = reward;
+    s.nextStates.col(slot) = nextState.Encode();
+    s.isTerminal(slot) = isEnd;
+
+    s.version[slot].store(version + 2, std::memory_order_release);
+    s.stored.store(stored + 1, std::memory_order_release);
+
+    if (alpha > 0)
+    {
+      idxSum.Set(shard * shardCapacity + slot, std::pow(
+          maxPriority.load(std::memory_order_relaxed), alpha));
+    }
+  }
+
+  /**
+   * Get the reward, next state and terminal boolean for nth step.
+   *
+   * @param nStepBuffer Buffer of the last n steps of a shard.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void GetNStepInfo(const std::deque<Transition>& nStepBuffer,
+                    double& reward,
+                    StateType& nextState,
+                    bool& isEnd,
+                    const double& discount)
+  {
+    reward = nStepBuffer.back().reward;
+    nextState = nStepBuffer.back().nextState;
+    isEnd = nStepBuffer.back().isEnd;
+
+    // Should start from the second last transition in buffer.
+    for (int i = nStepBuffer.size() - 2; i >= 0; i--)
+    {
+      bool iE = nStepBuffer[i].isEnd;
+      reward = nStepBuffer[i].reward + discount * reward * (1 - iE);
+      if (iE)
+      {
+        nextState = nStepBuffer[i].nextState;
+        isEnd = iE;
+      }
+    }
+  }
+
+  /**
+   * Sample some experiences, either uniformly or according to their
+   * priorities.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    sampledActions.clear();
+
+    // Take a snapshot of the number of transitions in every shard; anything
+    // stored afterwards is ignored by this sample.
+    arma::uvec shardSizes(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+      shardSizes[i] = std::min(shardCapacity,
+          shards[i]->stored.load(std::memory_order_acquire));
+    }
+    const size_t size = arma::accu(shardSizes);
+
+    const size_t dimension = shards.front()->states.n_rows;
+    sampledStates.set_size(dimension, batchSize);
+    sampledNextStates.set_size(dimension, batchSize);
+    sampledRewards.set_size(batchSize);
+    isTerminal.set_size(batchSize);
+    sampledIndices.set_size(batchSize);
+
+    const double totalSum = (alpha > 0) ? idxSum.Sum() : 0.0;
+    for (size_t bt = 0; bt < batchSize; ++bt)
+    {
+      size_t shard = shards.size();
+      size_t slot = 0;
+      if (totalSum > 0)
+      {
+        // Stratified sampling according to the priorities.
+        const double sumPerRange = totalSum / batchSize;
+        const double mass = math::Random() * sumPerRange + bt * sumPerRange;
+        const size_t idx = std::min(idxSum.FindPrefixSum(mass),
+            shards.size() * shardCapacity - 1);
+        shard = idx / shardCapacity;
+        slot = idx % shardCapacity;
+      }
+
+      // Sample uniformly if there are no priorities, or if the sum tree
+      // pointed to a slot that was not filled yet when the sampling started.
+      if (shard == shards.size() || slot >= shardSizes[shard])
+      {
+        size_t offset = math::RandInt(size);
+        for (shard = 0; offset >= shardSizes[shard]; ++shard)
+          offset -= shardSizes[shard];
+        slot = offset;
+      }
+
+      sampledIndices[bt] = shard * shardCapacity + slot;
+      Read(*shards[shard], slot, bt, sampledStates, sampledActions,
+          sampledRewards, sampledNextStates, isTerminal);
+    }
+
+    if (alpha > 0)
+    {
+      BetaAnneal();
+
+      // Calculate the weights of sampled transitions.
+      weights.set_size(batchSize);
+      for (size_t i = 0; i < batchSize; ++i)
+      {
+        const double pSample = idxSum.Get(sampledIndices[i]) / totalSum;
+        weights[i] = (pSample > 0) ? std::pow(size * pSample, -beta) : 1.0;
+      }
+      weights /= weights.max();
+    }
+  }
+
+  /**
+   * Update the priorities of the last sampled transitions and scale the
+   * gradients by their importance weights.  This does nothing for uniform
+   * sampling.
+   *
+   * @param target The learned value.
+   * @param sampledActions Agent's sampled action.
+   * @param nextActionValues Agent's next action.
+   * @param gradients The model's gradients.
+   */
+  void Update(arma::mat target,
+              std::vector<ActionType> sampledActions,
+              arma::mat nextActionValues,
+              arma::mat& gradients)
+  {
+    if (alpha == 0)
+      return;
+
+    double newMaxPriority = maxPriority.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < target.n_cols; ++i)
+    {
+      const double priority = std::abs(nextActionValues(
+          sampledActions[i].action, i) - target(sampledActions[i].action, i));
+      newMaxPriority = std::max(newMaxPriority, priority);
+      idxSum.Set(sampledIndices[i], std::pow(priority, alpha));
+    }
+    maxPriority.store(newMaxPriority, std::memory_order_relaxed);
+
+    // Update the gradient.
+    gradients = arma::mean(weights) * gradients;
+  }
+
+  /**
+   * Annealing the beta.
+   */
+  void BetaAnneal()
+  {
+    beta = std::min(1.0, beta + (1 - initialBeta) * 1.0 / replayBetaIters);
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size.
+   */
+  size_t Size() const
+  {
+    size_t size = 0;
+    for (const std::unique_ptr<Shard>& shard : shards)
+    {
+      size += std::min(shardCapacity,
+          shard->stored.load(std::memory_order_acquire));
+    }
+    return size;
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+  //! Get the number of shards.
+  size_t NumShards() const { return shards.size(); }
+
+ private:
+  //! A FIFO ring buffer that is filled by a single writer.
+  struct Shard
+  {
+    Shard(const size_t capacity, const size_t dimension) :
+        states(dimension, capacity),
+        actions(capacity),
+        rewards(capacity),
+        nextStates(dimension, capacity),
+        isTerminal(capacity),
+        version(capacity),
+        stored(0)
+    {
+      for (std::atomic<size_t>& v : version)
+        v.store(0, std::memory_order_relaxed);
+    }
+
+    //! Encoded previous states.
+    arma::mat states;
+
+    //! Previous actions.
+    std::vector<ActionType> actions;
+
+    //! Previous rewards.
+    arma::rowvec rewards;
+
+    //! Encoded previous next states.
+    arma::mat nextStates;
+
+    //! Termination information of previous experience.
+    arma::irowvec isTerminal;
+
+    //! Sequence number of every slot; odd while the slot is being written.
+    std::vector<std::atomic<size_t>> version;
+
+    //! Total number of transitions ever stored in the shard.
+    std::atomic<size_t> stored;
+
+    //! Buffer containing n consecutive steps.
+    std::deque<Transition> nStepBuffer;
+  };
+
+  /**
+   * Copy the transition in the given slot of a shard to the given column of
+   * the output, retrying if the slot is overwritten meanwhile.
+   */
+  void Read(const Shard& shard,
+            const size_t slot,
+            const size_t col,
+            arma::mat& sampledStates,
+            std::vector<ActionType>& sampledActions,
+            arma::rowvec& sampledRewards,
+            arma::mat& sampledNextStates,
+            arma::irowvec& isTerminal) const
+  {
+    ActionType action;
+    while (true)
+    {
+      const size_t version = shard.version[slot].load(
+          std::memory_order_acquire);
+      if (version % 2 == 1)
+        continue;
+
+      sampledStates.col(col) = shard.states.col(slot);
+      action = shard.actions[slot];
+      sampledRewards[col] = shard.rewards[slot];
+      sampledNextStates.col(col) = shard.nextStates.col(slot);
+      isTerminal[col] = shard.isTerminal[slot];
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (shard.version[slot].load(std::memory_order_relaxed) == version)
+        break;
+    }
+    sampledActions.push_back(action);
+  }
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored memory limit of each shard.
+  size_t shardCapacity;
+
+  //! How much prioritization is used.
+  //! (0 - no prioritization, 1 - full prioritization)
+  double alpha;
+
+  //! Locally-stored the max priority.
+  std::atomic<double> maxPriority;
+
+  //! Initial value of beta for prioritized replay buffer.
+  double initialBeta;
+
+  //! The value of beta for current sample.
+  double beta;
+
+  //! How many iteration for replay beta to decay.
+  size_t replayBetaIters;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! Locally-stored shards.
+  std::vector<std::unique_ptr<Shard>> shards;
+
+  //! Locally-stored the prefix sum of prioritization over all shards.
+  AtomicSumTree<double> idxSum;
+
+  //! Locally-stored the indices of sampled transitions.
+  arma::uvec sampledIndices;
+
+  //! Locally-stored the weights of sampled transitions.
+  arma::rowvec weights;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * @file methods/rp_forest/rp_forest.hpp
+ *
+ * Approximate nearest neighbor search with a forest of random projection trees,
+ * in the spirit of Annoy:
+ *
+ * @code
+ * @inproceedings{dasgupta2008random,
+ *   title={Random projection trees and low dimensional manifolds},
+ *   author={Dasgupta, Sanjoy and Freund, Yoav},
+ *   booktitle={Proceedings of the Fortieth Annual ACM Symposium on Theory of
+ *       Computing (STOC '08)},
+ *   pages={537--546},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RP_FOREST_RP_FOREST_HPP
+#define MLPACK_METHODS_RP_FOREST_RP_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+#include <tuple>
+
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The RPForest class builds several randomized trees (random projection trees
+ * by default) on the same reference set, and uses all of them to answer
+ * approximate k-nearest-neighbor queries.
+ *
+ * For each query, the nodes of all trees are visited best-first from a single
+ * priority queue ordered by the distance between the query and the bound of
+ * each node, and the points of each visited leaf become candidates.  The search
+ * stops once a given number of candidate points has been examined (searchK);
+ * this is the knob trading recall for latency.  A larger number of trees
+ * improves recall at the same searchK, because the trees make different
+ * mistakes.  Subtrees that cannot hold a better neighbor than the current k
+ * candidates are pruned, so with an unlimited searchK the search is exact.
+ *
+ * As in Annoy, the forest holds a single copy of the reference set: each tree
+ * only keeps its bounds and the mapping from its points to the reference set,
+ * and the trees do not hold a dataset once they are built.
+ *
+ * The recall of the results can be measured against exact results with
+ * NeighborSearch::Recall().
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType Type of matrix to use to store the data.
+ * @tparam TreeType The randomized tree type to use; it must rearrange the
+ *     dataset, take a maximum leaf size, and give access to its dataset, like
+ *     tree::RPTree and tree::MaxRPTree do.
+ */
+template<
+    typename SortPolicy = NearestNeighborSort,
+    typename MetricType = metric::EuclideanDistance,
+    typename MatType = arma::mat,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType = tree::RPTree
+>
+class RPForest
+{
+ public:
+  //! Convenience typedef.
+  typedef TreeType<MetricType, tree::EmptyStatistic, MatType> Tree;
+
+  /**
+   * Build the forest on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numTrees Number of trees to build.
+   * @param leafSize Maximum number of points in a leaf of each tree.
+   * @param metric Instantiated metric.
+   */
+  RPForest(const MatType& referenceSet,
+           const size_t numTrees = 10,
+           const size_t leafSize = 20,
+           const MetricType metric = MetricType());
+
+  /**
+   * Create an empty forest.  Be sure to call Train() before calling Search().
+   */
+  RPForest(const MetricType metric = MetricType());
+
+  //! Copy the given forest.
+  RPForest(const RPForest& other);
+
+  //! Take ownership of the given forest.
+  RPForest(RPForest&& other);
+
+  //! Copy the given forest.
+  RPForest& operator=(const RPForest& other);
+
+  //! Take ownership of the given forest.
+  RPForest& operator=(RPForest&& other);
+
+  //! Delete the trees.
+  ~RPForest();
+
+  /**
+   * Build the forest on the given reference set, replacing any existing trees.
+   * The trees are built one after the other, since their splits draw from the
+   * global random number generator (see math::RandomSeed()); each tree is
+   * built on the points as they were rearranged by the previous one, so the
+   * reference set is copied only once.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numTrees Number of trees to build.
+   * @param leafSize Maximum number of points in a leaf of each tree.
+   */
+  void Train(const MatType& referenceSet,
+             const size_t numTrees = 10,
+             const size_t leafSize = 20);
+
+  /**
+   * Compute the approximate k nearest neighbors of each point in the query set
+   * and store them in the given matrices, which will have k rows and one
+   * column per query point.  If fewer than k candidates were found for a
+   * query, the remaining neighbors are SIZE_MAX and their distances
+   * SortPolicy::WorstDistance().  The queries are processed in parallel when
+   * OpenMP is available.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the neighbors of each query point.
+   * @param distances Matrix storing the distances to the neighbors of each
+   *     query point.
+   * @param searchK Maximum number of candidate points to examine for each
+   *     query; larger values give better recall and slower queries.  If 0 (the
+   *     default), k times the number of trees is used.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              const size_t searchK = 0) const;
+
+  /**
+   * Compute the approximate k nearest neighbors of each point in the reference
+   * set, excluding the point itself.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the neighbors of each point.
+   * @param distances Matrix storing the distances to the neighbors of each
+   *     point.
+   * @param searchK Maximum number of candidate points to examine for each
+   *     point; if 0 (the default), k times the number of trees is used.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              const size_t searchK = 0) const;
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return trees.size(); }
+  //! Get the given tree.  Its dataset is empty; use ReferenceSet() and
+  //! OldFromNew() to get its points.
+  const Tree& GetTree(const size_t i) const { return *trees[i]; }
+  //! Get the mapping from the points of the given tree to the reference set.
+  const std::vector<size_t>& OldFromNew(const size_t i) const
+  { return oldFromNew[i]; }
+  //! Get the reference set, which is shared by all trees.
+  const MatType& ReferenceSet() const { return referenceSet; }
+  //! Get the maximum leaf size of the trees.
+  size_t LeafSize() const { return leafSize; }
+  //! Get the number of points in the reference set.
+  size_t NumReferencePoints() const { return numReferencePoints; }
+
+  //! Serialize the forest.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Compare two candidates based on the distance.
+  struct CandidateCmp {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    };
+  };
+
+  //! Use a priority queue to represent the list of candidate neighbors.
+  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+      CandidateList;
+
+  //! A node to visit: its score, the node itself, and the index of its tree.
+  typedef std::tuple<double, const Tree*, size_t> NodeCandidate;
+
+  //! Compare two nodes so that the node with the best score is visited first.
+  struct NodeCandidateCmp {
+    bool operator()(const NodeCandidate& n1, const NodeCandidate& n2)
+    {
+      return SortPolicy::IsBetter(std::get<0>(n2), std::get<0>(n1));
+    };
+  };
+
+  //! The queue of nodes to visit, shared by all trees.
+  typedef std::priority_queue<NodeCandidate, std::vector<NodeCandidate>,
+      NodeCandidateCmp> NodeQueue;
+
+  /**
+   * Search the forest for the k best neighbors of a single point.
+   *
+   * @param query Query point.
+   * @param k Number of neighbors to search for.
+   * @param searchK Maximum number of candidate points to examine.
+   * @param skip Index of a reference point to ignore (or SIZE_MAX).
+   * @param metric Metric to use for this search.
+   * @param seen Marks of the reference points that were already examined.
+   * @param mark Mark of the current query in seen.
+   * @param neighbors Column to store the neighbors in.
+   * @param distances Column to store the distances in.
+   */
+  template<typename VecType>
+  void SearchPoint(const VecType& query,
+                   const size_t k,
+                   const size_t searchK,
+                   const size_t skip,
+                   MetricType& metric,
+                   std::vector<size_t>& seen,
+                   const size_t mark,
+                   size_t* neighbors,
+                   double* distances) const;
+
+  //! Delete all trees.
+  void Clear();
+
+  //! The trees of the forest.
+  std::vector<Tree*> trees;
+  //! The mapping from the points of each tree to the reference set.
+  std::vector<std::vector<size_t>> oldFromNew;
+  //! The reference set, shared by all trees.
+  MatType referenceSet;
+  //! The maximum leaf size of the trees.
+  size_t leafSize;
+  //! The number of points in the reference set.
+  size_t numReferencePoints;
+  //! The instantiated metric.
+  MetricType metric;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "rp_forest_impl.hpp"
+
+#endif
@@ -0,0 +1,428 @@
+/**
+ * @file methods/rp_forest/rp_forest_impl.hpp
+ *
+ * Implementation of the RPForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RP_FOREST_RP_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RP_FOREST_RP_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "rp_forest.hpp"
+
+#include <boost/serialization/vector.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>::RPForest(
+    const MatType& referenceSet,
+    const size_t numTrees,
+    const size_t leafSize,
+    const MetricType metric) :
+    leafSize(leafSize),
+    numReferencePoints(0),
+    metric(metric)
+{
+  Train(referenceSet, numTrees, leafSize);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>::RPForest(
+    const MetricType metric) :
+    leafSize(20),
+    numReferencePoints(0),
+    metric(metric)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>::RPForest(
+    const RPForest& other) :
+    oldFromNew(other.oldFromNew),
+    referenceSet(other.referenceSet),
+    leafSize(other.leafSize),
+    numReferencePoints(other.numReferencePoints),
+    metric(other.metric)
+{
+  trees.reserve(other.trees.size());
+  for (size_t i = 0; i < other.trees.size(); ++i)
+    trees.push_back(new Tree(*other.trees[i]));
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>::RPForest(
+    RPForest&& other) :
+    trees(std::move(other.trees)),
+    oldFromNew(std::move(other.oldFromNew)),
+    referenceSet(std::move(other.referenceSet)),
+    leafSize(other.leafSize),
+    numReferencePoints(other.numReferencePoints),
+    metric(std::move(other.metric))
+{
+  // Reset the other forest to an empty forest.
+  other.trees.clear();
+  other.oldFromNew.clear();
+  other.leafSize = 20;
+  other.numReferencePoints = 0;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>&
+RPForest<SortPolicy, MetricType, MatType, TreeType>::operator=(
+    const RPForest& other)
+{
+  if (this != &other)
+  {
+    Clear();
+    trees.reserve(other.trees.size());
+    for (size_t i = 0; i < other.trees.size(); ++i)
+      trees.push_back(new Tree(*other.trees[i]));
+
+    oldFromNew = other.oldFromNew;
+    referenceSet = other.referenceSet;
+    leafSize = other.leafSize;
+    numReferencePoints = other.numReferencePoints;
+    metric = other.metric;
+  }
+
+  return *this;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>&
+RPForest<SortPolicy, MetricType, MatType, TreeType>::operator=(
+    RPForest&& other)
+{
+  if (this != &other)
+  {
+    Clear();
+    trees = std::move(other.trees);
+    oldFromNew = std::move(other.oldFromNew);
+    referenceSet = std::move(other.referenceSet);
+    leafSize = other.leafSize;
+    numReferencePoints = other.numReferencePoints;
+    metric = std::move(other.metric);
+
+    // Reset the other forest to an empty forest.
+    other.trees.clear();
+    other.oldFromNew.clear();
+    other.leafSize = 20;
+    other.numReferencePoints = 0;
+  }
+
+  return *this;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+RPForest<SortPolicy, MetricType, MatType, TreeType>::~RPForest()
+{
+  Clear();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::Train(
+    const MatType& referenceSet,
+    const size_t numTrees,
+    const size_t leafSize)
+{
+  static_assert(tree::TreeTraits<Tree>::RearrangesDataset,
+      "RPForest requires a tree type that rearranges the dataset.");
+
+  if (numTrees == 0)
+    throw std::invalid_argument("RPForest::Train(): numTrees must be positive");
+  if (leafSize == 0)
+    throw std::invalid_argument("RPForest::Train(): leafSize must be positive");
+
+  // The splits of the trees draw from the global random number generator, so
+  // the trees can't be built concurrently.  Instead, each tree is built on the
+  // points as the previous tree left them, and gives them back once it is
+  // built; order holds the index in the reference set of each of the points.
+  // (The points are copied first, in case the given reference set is ours.)
+  MatType points(referenceSet);
+
+  Clear();
+  this->leafSize = leafSize;
+  numReferencePoints = points.n_cols;
+  this->referenceSet = points;
+
+  std::vector<size_t> order(numReferencePoints);
+  for (size_t i = 0; i < numReferencePoints; ++i)
+    order[i] = i;
+
+  trees.reserve(numTrees);
+  oldFromNew.resize(numTrees);
+  for (size_t t = 0; t < numTrees; ++t)
+  {
+    std::vector<size_t> treeOldFromNew;
+    trees.push_back(new Tree(std::move(points), treeOldFromNew, leafSize));
+    points = std::move(trees[t]->Dataset());
+    trees[t]->Dataset().reset();
+
+    oldFromNew[t].resize(numReferencePoints);
+    for (size_t i = 0; i < numReferencePoints; ++i)
+      oldFromNew[t][i] = order[treeOldFromNew[i]];
+    order = oldFromNew[t];
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    const size_t searchK) const
+{
+  if (trees.empty())
+    throw std::invalid_argument("RPForest::Search(): forest is not trained");
+
+  if (k > numReferencePoints)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << numReferencePoints << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "RPForest::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") is not equal to the dimensionality of the "
+        << "reference set (" << referenceSet.n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  const size_t maxCandidates = std::max(k,
+      (searchK == 0) ? k * trees.size() : searchK);
+
+  #pragma omp parallel
+  {
+    // Each query marks the reference points it has examined with its own
+    // index, so the marks never need to be cleared.  Each thread also gets its
+    // own copy of the metric, since Evaluate() may not be const.
+    std::vector<size_t> seen(numReferencePoints, 0);
+    MetricType threadMetric(metric);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      SearchPoint(querySet.unsafe_col(i), k, maxCandidates, SIZE_MAX,
+          threadMetric, seen, i + 1, neighbors.colptr(i),
+          distances.colptr(i));
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    const size_t searchK) const
+{
+  if (trees.empty())
+    throw std::invalid_argument("RPForest::Search(): forest is not trained");
+
+  // The point itself is not one of its neighbors.
+  if (numReferencePoints == 0 || k > numReferencePoints - 1)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set minus one ("
+        << ((numReferencePoints == 0) ? 0 : numReferencePoints - 1) << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, numReferencePoints);
+  distances.set_size(k, numReferencePoints);
+
+  const size_t maxCandidates = std::max(k,
+      (searchK == 0) ? k * trees.size() : searchK);
+
+  // The points are visited in the order of the first tree, so that
+  // consecutive queries visit the same nodes.
+  #pragma omp parallel
+  {
+    std::vector<size_t> seen(numReferencePoints, 0);
+    MetricType threadMetric(metric);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) numReferencePoints; ++i)
+    {
+      const size_t index = oldFromNew[0][i];
+      SearchPoint(referenceSet.unsafe_col(index), k, maxCandidates, index,
+          threadMetric, seen, i + 1, neighbors.colptr(index),
+          distances.colptr(index));
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+template<typename VecType>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::SearchPoint(
+    const VecType& query,
+    const size_t k,
+    const size_t searchK,
+    const size_t skip,
+    MetricType& metric,
+    std::vector<size_t>& seen,
+    const size_t mark,
+    size_t* neighbors,
+    double* distances) const
+{
+  CandidateList candidates;
+  NodeQueue queue;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    queue.push(NodeCandidate(
+        SortPolicy::BestPointToNodeDistance(query, trees[t]), trees[t], t));
+  }
+
+  size_t examined = 0;
+  while (!queue.empty() && examined < searchK)
+  {
+    const double score = std::get<0>(queue.top());
+    const Tree* node = std::get<1>(queue.top());
+    const size_t t = std::get<2>(queue.top());
+    queue.pop();
+
+    // The nodes are visited best-first, so if this one can't hold a better
+    // neighbor, none of the remaining nodes can.
+    if (candidates.size() == k &&
+        !SortPolicy::IsBetter(score, candidates.top().first))
+      break;
+
+    if (node->IsLeaf())
+    {
+      for (size_t i = node->Begin(); i < node->Begin() + node->Count(); ++i)
+      {
+        const size_t index = oldFromNew[t][i];
+        if (index == skip || seen[index] == mark)
+          continue;
+
+        seen[index] = mark;
+        ++examined;
+
+        const double distance = metric.Evaluate(query,
+            referenceSet.col(index));
+        if (candidates.size() < k)
+        {
+          candidates.push(Candidate(distance, index));
+        }
+        else if (SortPolicy::IsBetter(distance, candidates.top().first))
+        {
+          candidates.pop();
+          candidates.push(Candidate(distance, index));
+        }
+      }
+    }
+    else
+    {
+      for (size_t c = 0; c < node->NumChildren(); ++c)
+      {
+        const Tree* child = &node->Child(c);
+        queue.push(NodeCandidate(
+            SortPolicy::BestPointToNodeDistance(query, child), child, t));
+      }
+    }
+  }
+
+  // Unfilled slots get the worst possible distance.
+  for (size_t j = candidates.size(); j < k; ++j)
+  {
+    neighbors[j] = SIZE_MAX;
+    distances[j] = SortPolicy::WorstDistance();
+  }
+
+  // The worst candidate is at the top of the queue.
+  for (size_t j = candidates.size(); j > 0; --j)
+  {
+    neighbors[j - 1] = candidates.top().second;
+    distances[j - 1] = candidates.top().first;
+    candidates.pop();
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::Clear()
+{
+  for (size_t i = 0; i < trees.size(); ++i)
+    delete trees[i];
+
+  trees.clear();
+  oldFromNew.clear();
+  referenceSet.reset();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename, typename, typename> class TreeType>
+template<typename Archive>
+void RPForest<SortPolicy, MetricType, MatType, TreeType>::serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  // Delete the current trees, if necessary and if we are loading.
+  if (Archive::is_loading::value)
+    Clear();
+
+  ar & BOOST_SERIALIZATION_NVP(trees);
+  ar & BOOST_SERIALIZATION_NVP(oldFromNew);
+  ar & BOOST_SERIALIZATION_NVP(referenceSet);
+  ar & BOOST_SERIALIZATION_NVP(leafSize);
+  ar & BOOST_SERIALIZATION_NVP(numReferencePoints);
+  ar & BOOST_SERIALIZATION_NVP(metric);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
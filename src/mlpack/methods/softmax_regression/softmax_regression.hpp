@@ -55,6 +55,9 @@ namespace regression {
  * // Obtain predictions from both the learned models.
  * regressor.Classify(testData, predictions);
  * @endcode
+ *
+ * The training and test data may also be sparse (arma::sp_mat); the model is
+ * then trained and evaluated without densifying the data.
  */
 class SoftmaxRegression
 {
@@ -78,6 +81,7 @@ class SoftmaxRegression
    * function. By default, the model takes a small value.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @param data Input training features. Each column associate with one sample
    * @param labels Labels associated with the feature data.
    * @param numClasses Number of classes for classification.
@@ -85,8 +89,8 @@ class SoftmaxRegression
    * @param lambda L2-regularization constant.
    * @param fitIntercept add intercept term or not.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda = 0.0001,
@@ -99,6 +103,7 @@ class SoftmaxRegression
    * function. By default, the model takes a small value.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input training features. Each column associate with one sample
    * @param labels Labels associated with the feature data.
@@ -109,8 +114,10 @@ class SoftmaxRegression
    * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
    *        See https://www.ensmallen.org/docs.html#callback-documentation.
    */
-  template<typename OptimizerType, typename... CallbackTypes>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType,
+           typename MatType,
+           typename... CallbackTypes>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda,
@@ -125,7 +132,8 @@ class SoftmaxRegression
    * @param dataset Set of points to classify.
    * @param labels Predicted labels for each point.
    */
-  void Classify(const arma::mat& dataset, arma::Row<size_t>& labels) const;
+  template<typename MatType>
+  void Classify(const MatType& dataset, arma::Row<size_t>& labels) const;
   /**
    * Classify the given point. The predicted class label is returned.
    * The function calculates the probabilites for every class, given the point.
@@ -147,7 +155,8 @@ class SoftmaxRegression
    * @param labels Predicted labels for each point.
    * @param probabilities Class probabilities for each point.
    */
-  void Classify(const arma::mat& dataset,
+  template<typename MatType>
+  void Classify(const MatType& dataset,
                 arma::Row<size_t>& labels,
                 arma::mat& probabilities) const;
 
@@ -157,7 +166,8 @@ class SoftmaxRegression
    * @param dataset Matrix of data points to be classified.
    * @param probabilities Class probabilities for each point.
    */
-  void Classify(const arma::mat& dataset,
+  template<typename MatType>
+  void Classify(const MatType& dataset,
                 arma::mat& probabilities) const;
 
   /**
@@ -168,20 +178,22 @@ class SoftmaxRegression
    * @param testData Matrix of data points using which predictions are made.
    * @param labels Vector of labels associated with the data.
    */
-  double ComputeAccuracy(const arma::mat& testData,
+  template<typename MatType>
+  double ComputeAccuracy(const MatType& testData,
                          const arma::Row<size_t>& labels) const;
   /**
    * Train the softmax regression with the given training data.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @param data Input data with each column as one example.
    * @param labels Labels associated with the feature data.
    * @param numClasses Number of classes for classification.
    * @param optimizer Desired optimizer.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer = OptimizerType());
@@ -189,6 +201,7 @@ class SoftmaxRegression
    * Train the softmax regression with the given training data.
    *
    * @tparam OptimizerType Desired optimizer type.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input data with each column as one example.
    * @param labels Labels associated with the feature data.
@@ -198,8 +211,10 @@ class SoftmaxRegression
    *      See https://www.ensmallen.org/docs.html#callback-documentation.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS,
+           typename MatType = arma::mat,
+           typename... CallbackTypes>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer,
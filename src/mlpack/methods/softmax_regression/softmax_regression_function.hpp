@@ -14,16 +14,30 @@
 #define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/gather_columns.hpp>
 
 namespace mlpack {
 namespace regression {
 
+/**
+ * The objective function of softmax regression, to be optimized by any
+ * ensmallen optimizer.
+ *
+ * The data may be dense or sparse; with sparse data (arma::sp_mat), the class
+ * scores are computed with sparse-dense products and the data is never
+ * densified.
+ *
+ * @tparam MatType Type of the training data (arma::mat or arma::sp_mat).
+ */
+template<typename MatType = arma::mat>
 class SoftmaxRegressionFunction
 {
  public:
   /**
    * Construct the Softmax Regression objective function with the given
-   * parameters.
+   * parameters.  Only references to the data and the labels are kept, so they
+   * must be lvalues that outlive the function; passing temporaries does not
+   * compile.
    *
    * @param data Input training data, each column associate with one sample
    * @param labels Labels associated with the feature data.
@@ -31,17 +45,30 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
+  SoftmaxRegressionFunction(const MatType& data,
                             const arma::Row<size_t>& labels,
                             const size_t numClasses,
                             const double lambda = 0.0001,
                             const bool fitIntercept = false);
 
+  // Temporaries would dangle, so they are rejected.
+  SoftmaxRegressionFunction(MatType&&,
+                            const arma::Row<size_t>&,
+                            const size_t,
+                            const double = 0.0001,
+                            const bool = false) = delete;
+  SoftmaxRegressionFunction(const MatType&,
+                            arma::Row<size_t>&&,
+                            const size_t,
+                            const double = 0.0001,
+                            const bool = false) = delete;
+
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
 
   /**
-   * Shuffle the dataset.
+   * Shuffle the order in which the points of the dataset are visited.  The
+   * data itself is not moved.
    */
   void Shuffle();
 
@@ -79,7 +106,7 @@ class SoftmaxRegressionFunction
    * @param groundTruth Pointer to arma::mat which stores the computed matrix.
    */
   void GetGroundTruthMatrix(const arma::Row<size_t>& labels,
-                            arma::sp_mat& groundTruth);
+                            arma::sp_mat& groundTruth) const;
 
   /**
    * Evaluate the probabilities matrix with the passed parameters.
@@ -89,7 +116,7 @@ class SoftmaxRegressionFunction
    *
    * @param parameters Current values of the model parameters.
    * @param probabilities Pointer to arma::mat which stores the probabilities.
-   * @param start Index of point to start at.
+   * @param start Index of point to start at (in the order of visitation).
    * @param batchSize Number of points to calculate probabilities for.
    */
   void GetProbabilitiesMatrix(const arma::mat& parameters,
@@ -188,10 +215,18 @@ class SoftmaxRegressionFunction
   bool FitIntercept() const { return fitIntercept; }
 
  private:
-  //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  //! Training data matrix.
+  const MatType& data;
+  //! Labels of the training data.
+  const arma::Row<size_t>& labels;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
+  //! The order in which the points are visited by the separable functions.
+  arma::uvec visitationOrder;
+  //! The points of the last minibatch.
+  mutable MatType batchData;
+  //! The label matrix of the last minibatch.
+  mutable arma::sp_mat batchGroundTruth;
   //! Initial parameter point.
   arma::mat initialPoint;
   //! Number of classes.
@@ -200,9 +235,25 @@ class SoftmaxRegressionFunction
   double lambda;
   //! Intercept term flag.
   bool fitIntercept;
+
+  /**
+   * Gather the points with visitation indices [start, start + batchSize) into
+   * batchData, and their label matrix into batchGroundTruth.
+   */
+  void GatherBatch(const size_t start, const size_t batchSize) const;
+
+  /**
+   * Evaluate the probabilities matrix of the given points.
+   */
+  void GetProbabilitiesMatrix(const arma::mat& parameters,
+                              const MatType& points,
+                              arma::mat& probabilities) const;
 };
 
 } // namespace regression
 } // namespace mlpack
 
+// Include implementation.
+#include "softmax_regression_function_impl.hpp"
+
 #endif
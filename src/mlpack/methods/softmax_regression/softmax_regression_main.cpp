@@ -48,6 +48,11 @@ PROGRAM_INFO("Softmax Regression",
     " parameter and if an intercept term is not desired in the model, the " +
     PRINT_PARAM_STRING("no_intercept") + " parameter can be specified."
     "\n\n"
+    "For very high-dimensional sparse data, the training set may instead be "
+    "given as the name of a file holding a sparse matrix (for instance, in "
+    "coordinate list format) with the " + PRINT_PARAM_STRING("sparse_training")
+    + " parameter; the model is then trained without ever densifying the data."
+    "\n\n"
     "The trained model can be saved with the " +
     PRINT_PARAM_STRING("output_model") + " output parameter. If training is not"
     " desired, but only testing is, a model can be loaded with the " +
@@ -92,6 +97,8 @@ PARAM_MATRIX_IN("training", "A matrix containing the training set (the matrix "
     "of predictors, X).", "t");
 PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
     "in the training set (y). The labels must order as a row.", "l");
+PARAM_STRING_IN("sparse_training", "File containing a sparse training set, to "
+    "be used instead of the training parameter.", "", "");
 
 // Model loading/saving.
 PARAM_MODEL_IN(SoftmaxRegression, "input_model", "File containing existing "
@@ -129,22 +136,29 @@ void TestClassifyAcc(const size_t numClasses, const Model& model);
 template<typename Model>
 Model* TrainSoftmax(const size_t maxIterations);
 
+// Build the softmax model on the given dense or sparse training set.
+template<typename Model, typename MatType>
+Model* TrainSoftmax(const MatType& trainData, const size_t maxIterations);
+
 static void mlpackMain()
 {
   const int maxIterations = IO::GetParam<int>("max_iterations");
 
   // One of inputFile and modelFile must be specified.
-  RequireOnlyOnePassed({ "input_model", "training" }, true);
-  if (IO::HasParam("training"))
+  RequireOnlyOnePassed({ "input_model", "training", "sparse_training" }, true);
+  if (IO::HasParam("training") || IO::HasParam("sparse_training"))
   {
     RequireAtLeastOnePassed({ "labels" }, true, "if training data is specified,"
         " labels must also be specified");
   }
-  ReportIgnoredParam({{ "training", false }}, "labels");
-  ReportIgnoredParam({{ "training", false }}, "max_iterations");
-  ReportIgnoredParam({{ "training", false }}, "number_of_classes");
-  ReportIgnoredParam({{ "training", false }}, "lambda");
-  ReportIgnoredParam({{ "training", false }}, "no_intercept");
+  else
+  {
+    ReportIgnoredParam({{ "training", false }}, "labels");
+    ReportIgnoredParam({{ "training", false }}, "max_iterations");
+    ReportIgnoredParam({{ "training", false }}, "number_of_classes");
+    ReportIgnoredParam({{ "training", false }}, "lambda");
+    ReportIgnoredParam({{ "training", false }}, "no_intercept");
+  }
 
   RequireParamValue<int>("max_iterations", [](int x) { return x >= 0; }, true,
       "maximum number of iterations must be greater than or equal to 0");
@@ -248,30 +262,39 @@ Model* TrainSoftmax(const size_t maxIterations)
 {
   using namespace mlpack;
 
-  Model* sm;
   if (IO::HasParam("input_model"))
+    return IO::GetParam<Model*>("input_model");
+
+  if (IO::HasParam("sparse_training"))
   {
-    sm = IO::GetParam<Model*>("input_model");
+    arma::sp_mat trainData;
+    data::Load(IO::GetParam<string>("sparse_training"), trainData, true);
+    return TrainSoftmax<Model>(trainData, maxIterations);
   }
-  else
-  {
-    arma::mat trainData = std::move(IO::GetParam<arma::mat>("training"));
-    arma::Row<size_t> trainLabels =
-        std::move(IO::GetParam<arma::Row<size_t>>("labels"));
 
-    if (trainData.n_cols != trainLabels.n_elem)
-      Log::Fatal << "Samples of input_data should same as the size of "
-          << "input_label." << endl;
+  arma::mat trainData = std::move(IO::GetParam<arma::mat>("training"));
+  return TrainSoftmax<Model>(trainData, maxIterations);
+}
 
-    const size_t numClasses = CalculateNumberOfClasses(
-        (size_t) IO::GetParam<int>("number_of_classes"), trainLabels);
+template<typename Model, typename MatType>
+Model* TrainSoftmax(const MatType& trainData, const size_t maxIterations)
+{
+  using namespace mlpack;
 
-    const bool intercept = IO::HasParam("no_intercept") ? false : true;
+  arma::Row<size_t> trainLabels =
+      std::move(IO::GetParam<arma::Row<size_t>>("labels"));
 
-    const size_t numBasis = 5;
-    ens::L_BFGS optimizer(numBasis, maxIterations);
-    sm = new Model(trainData, trainLabels, numClasses,
-        IO::GetParam<double>("lambda"), intercept, std::move(optimizer));
-  }
-  return sm;
+  if (trainData.n_cols != trainLabels.n_elem)
+    Log::Fatal << "Samples of input_data should same as the size of "
+        << "input_label." << endl;
+
+  const size_t numClasses = CalculateNumberOfClasses(
+      (size_t) IO::GetParam<int>("number_of_classes"), trainLabels);
+
+  const bool intercept = IO::HasParam("no_intercept") ? false : true;
+
+  const size_t numBasis = 5;
+  ens::L_BFGS optimizer(numBasis, maxIterations);
+  return new Model(trainData, trainLabels, numClasses,
+      IO::GetParam<double>("lambda"), intercept, std::move(optimizer));
 }
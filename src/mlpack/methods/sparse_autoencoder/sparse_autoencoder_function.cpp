@@ -98,21 +98,20 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
 
   arma::mat hiddenLayer, outputLayer;
 
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
+  // Compute activations of the hidden and output layers.  The biases are added
+  // to each column in place, so no replicated bias matrix is formed.
+  hiddenLayer = parameters.submat(0, 0, l1 - 1, l2 - 1) * data;
+  hiddenLayer.each_col() += parameters.submat(0, l2, l1 - 1, l2);
+  Sigmoid(hiddenLayer, hiddenLayer);
 
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  outputLayer = parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer;
+  outputLayer.each_col() += parameters.submat(l3, 0, l3, l2 - 1).t();
+  Sigmoid(outputLayer, outputLayer);
 
-  arma::mat rhoCap, diff;
+  arma::mat rhoCap;
 
   // Average activations of the hidden layer.
   rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
 
   double wL2SquaredNorm;
 
@@ -128,7 +127,8 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
   // of the weights w1 and w2. 'klDivergence' is the cost of the hidden layer
   // activations not being low. It is given by the following formula:
   // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
-  sumOfSquaresError = 0.5 * arma::accu(diff % diff) / data.n_cols;
+  sumOfSquaresError = 0.5 * arma::accu(arma::square(outputLayer - data)) /
+      data.n_cols;
   weightDecay = 0.5 * lambda * wL2SquaredNorm;
   klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) + (1 - rho) *
       arma::log((1 - rho) / (1 - rhoCap)));
@@ -165,35 +165,35 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
 
   arma::mat hiddenLayer, outputLayer;
 
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
+  // Compute activations of the hidden and output layers.  The biases are added
+  // to each column in place, so no replicated bias matrix is formed.
+  hiddenLayer = parameters.submat(0, 0, l1 - 1, l2 - 1) * data;
+  hiddenLayer.each_col() += parameters.submat(0, l2, l1 - 1, l2);
+  Sigmoid(hiddenLayer, hiddenLayer);
 
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  outputLayer = parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer;
+  outputLayer.each_col() += parameters.submat(l3, 0, l3, l2 - 1).t();
+  Sigmoid(outputLayer, outputLayer);
 
-  arma::mat rhoCap, diff;
+  arma::mat rhoCap;
 
   // Average activations of the hidden layer.
   rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
 
   arma::mat klDivGrad, delOut, delHid;
 
-  // The delta vector for the output layer is given by diff * f'(z), where z is
-  // the preactivation and f is the activation function. The derivative of the
-  // sigmoid function turns out to be f(z) * (1 - f(z)). For every other layer
-  // in the neural network which comes before the output layer, the delta values
-  // are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost function also
-  // includes the KL divergence term, we adjust for that in the formula below.
+  // The delta vector for the output layer is given by (output - data) * f'(z),
+  // where z is the preactivation and f is the activation function. The
+  // derivative of the sigmoid function turns out to be f(z) * (1 - f(z)). For
+  // every other layer in the neural network which comes before the output
+  // layer, the delta values are given del_n = w_n' * del_(n+1) * f'(z_n).
+  // Since our cost function also includes the KL divergence term, we adjust
+  // for that in the formula below.
   klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
-  delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      arma::repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
+  delOut = (outputLayer - data) % outputLayer % (1 - outputLayer);
+  delHid = parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut;
+  delHid.each_col() += klDivGrad;
+  delHid %= hiddenLayer % (1 - hiddenLayer);
 
   gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
 
@@ -33,28 +33,35 @@ SparseCoding::SparseCoding(
   // Nothing to do.
 }
 
-void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
+void SparseCoding::Encode(const arma::mat& data, arma::mat& codes) const
 {
   // When using the Cholesky version of LARS, this is correct even if
   // lambda2 > 0.
-  arma::mat matGram = trans(dictionary) * dictionary;
+  const arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
 
-    bool useCholesky = true;
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  // The points are encoded independently.  Every thread keeps one LARS object
+  // (and with it the active set buffers) and one response vector, and reuses
+  // them for all of its points.
+  #pragma omp parallel
+  {
+    const bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
+    arma::rowvec responses(data.n_rows);
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      responses = data.col(i).t();
+      lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
@@ -187,12 +187,14 @@ class SparseCoding
 
   /**
    * Sparse code each point in the given dataset via LARS, using the current
-   * dictionary and store the encoded data in the codes matrix.
+   * dictionary and store the encoded data in the codes matrix.  The points are
+   * encoded in parallel if OpenMP is available, and the model is not modified,
+   * so a trained model can encode new batches of data from several threads.
    *
    * @param data Input data matrix to be encoded.
    * @param codes Output codes matrix.
    */
-  void Encode(const arma::mat& data, arma::mat& codes);
+  void Encode(const arma::mat& data, arma::mat& codes) const;
 
   /**
    * Learn dictionary via Newton method based on Lagrange dual.
@@ -891,3 +891,45 @@ TEST_CASE("ID3DecisionStumpSerializationTest", "[AdaBoostTest]")
             abBinary.WeakLearner(i).SplitDimension());
   }
 }
+
+/**
+ * Make sure that classifying a dataset that spans several blocks gives the
+ * same results as adding up the votes of the weak learners one by one.
+ */
+TEST_CASE("ClassifyBlocksTest", "[AdaBoostTest]")
+{
+  mat data = randu<mat>(4, 2500);
+  Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) + data(2, i) > 1.0) ? 1 : 0;
+
+  Perceptron<> p(data, labels, 2, 400);
+  AdaBoost<Perceptron<>> a(data, labels, 2, p, 20, 1e-10);
+
+  Row<size_t> predictedLabels;
+  mat probabilities;
+  a.Classify(data, predictedLabels, probabilities);
+
+  REQUIRE(predictedLabels.n_elem == data.n_cols);
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == data.n_cols);
+
+  // Add up the votes of every weak learner on the whole dataset.
+  mat votes(2, data.n_cols, fill::zeros);
+  Row<size_t> weakLabels;
+  for (size_t i = 0; i < a.WeakLearners(); ++i)
+  {
+    a.WeakLearner(i).Classify(data, weakLabels);
+    for (size_t j = 0; j < data.n_cols; ++j)
+      votes(weakLabels[j], j) += a.Alpha(i);
+  }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    votes.col(i) /= accu(votes.col(i));
+    REQUIRE(accu(probabilities.col(i)) == Approx(1.0).epsilon(1e-7));
+    REQUIRE(probabilities(0, i) == Approx(votes(0, i)).epsilon(1e-7));
+    REQUIRE(probabilities(1, i) == Approx(votes(1, i)).epsilon(1e-7));
+    REQUIRE(predictedLabels[i] == probabilities.col(i).index_max());
+  }
+}
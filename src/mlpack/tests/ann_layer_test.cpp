@@ -1259,6 +1259,126 @@ TEST_CASE("WriteCellStateParamLSTMLayerTest", "[ANNLayerTest]")
   }
 }
 
+/**
+ * Make sure the LSTM layer computes the expected output and cell state when
+ * every weight of every gate is different.
+ */
+TEST_CASE("RandomWeightsForwardLSTMLayerTest", "[ANNLayerTest]")
+{
+  const size_t rho = 4, inputSize = 3, outputSize = 2, batchSize = 5;
+
+  arma::cube input = arma::randu(inputSize, batchSize, rho);
+
+  LSTM<> lstm(inputSize, outputSize, rho);
+  lstm.Reset();
+  lstm.Parameters().randn();
+  lstm.Parameters() *= 0.5;
+
+  // Extract the weights of each gate from the parameter layout.
+  const arma::mat& p = lstm.Parameters();
+  size_t offset = 0;
+  arma::mat inW[4], inB[4], outW[4], cellW[3];
+  for (size_t i = 0; i < 4; ++i)
+  {
+    inW[i] = arma::reshape(p.rows(offset, offset + outputSize * inputSize - 1),
+        outputSize, inputSize);
+    offset += outputSize * inputSize;
+    inB[i] = p.rows(offset, offset + outputSize - 1);
+    offset += outputSize;
+  }
+  for (size_t i = 0; i < 4; ++i)
+  {
+    outW[i] = arma::reshape(p.rows(offset,
+        offset + outputSize * outputSize - 1), outputSize, outputSize);
+    offset += outputSize * outputSize;
+  }
+  for (size_t i = 0; i < 3; ++i)
+  {
+    cellW[i] = p.rows(offset, offset + outputSize - 1);
+    offset += outputSize;
+  }
+  REQUIRE(offset == p.n_elem);
+
+  // The order of the gates is output, forget, input, hidden.
+  arma::mat cellCalc = arma::zeros(outputSize, batchSize);
+  arma::mat outCalc = arma::zeros(outputSize, batchSize);
+  arma::mat outLstm, cellLstm;
+  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  {
+    arma::mat stepData(input.slice(seqNum).memptr(),
+        input.n_rows, input.n_cols, false, true);
+    lstm.Forward(stepData, outLstm, cellLstm, false);
+
+    arma::mat inputGate = inW[2] * stepData + outW[2] * outCalc;
+    inputGate.each_col() += inB[2];
+    arma::mat forgetGate = inW[1] * stepData + outW[1] * outCalc;
+    forgetGate.each_col() += inB[1];
+    arma::mat hidden = inW[3] * stepData + outW[3] * outCalc;
+    hidden.each_col() += inB[3];
+    if (seqNum > 0)
+    {
+      inputGate += cellCalc.each_col() % cellW[2];
+      forgetGate += cellCalc.each_col() % cellW[1];
+    }
+
+    inputGate = 1.0 / (1 + arma::exp(-inputGate));
+    forgetGate = 1.0 / (1 + arma::exp(-forgetGate));
+    hidden = arma::tanh(hidden);
+    cellCalc = forgetGate % cellCalc + inputGate % hidden;
+
+    arma::mat outputGate = inW[0] * stepData + outW[0] * outCalc;
+    outputGate.each_col() += inB[0];
+    outputGate += cellCalc.each_col() % cellW[0];
+    outputGate = 1.0 / (1 + arma::exp(-outputGate));
+    outCalc = outputGate % arma::tanh(cellCalc);
+
+    CheckMatrices(outLstm, outCalc, 1e-10);
+    CheckMatrices(cellLstm, cellCalc, 1e-10);
+  }
+}
+
+/**
+ * Make sure the LSTM layer computes the same gradient for a batch that is
+ * smaller than the previous one as a freshly created layer does.
+ */
+TEST_CASE("ShrinkingBatchLSTMLayerTest", "[ANNLayerTest]")
+{
+  const size_t rho = 5;
+  arma::cube input = arma::randu(1, 6, rho);
+  arma::cube target = arma::ones(1, 6, rho);
+
+  RNN<NegativeLogLikelihood<> > modelA(rho);
+  modelA.Predictors() = input;
+  modelA.Responses() = target;
+  modelA.Add<IdentityLayer<> >();
+  modelA.Add<Linear<> >(1, 10);
+  modelA.Add<LSTM<> >(10, 3, rho);
+  modelA.Add<LogSoftMax<> >();
+
+  RNN<NegativeLogLikelihood<> > modelB(rho);
+  modelB.Predictors() = input;
+  modelB.Responses() = target;
+  modelB.Add<IdentityLayer<> >();
+  modelB.Add<Linear<> >(1, 10);
+  modelB.Add<LSTM<> >(10, 3, rho);
+  modelB.Add<LogSoftMax<> >();
+
+  // Run the first model on a large batch, and then on a smaller one.
+  arma::mat gradientA, gradientB;
+  modelA.Gradient(modelA.Parameters(), 0, gradientA, 6);
+  const double errorA = modelA.EvaluateWithGradient(modelA.Parameters(), 0,
+      gradientA, 2);
+
+  // The second model only ever sees the smaller batch.
+  modelB.Gradient(modelB.Parameters(), 0, gradientB, 2);
+  modelB.Parameters() = modelA.Parameters();
+  const double errorB = modelB.EvaluateWithGradient(modelB.Parameters(), 0,
+      gradientB, 2);
+
+  REQUIRE(errorA == Approx(errorB).epsilon(1e-7));
+  CheckMatrices(gradientA, gradientB, 1e-7);
+}
+
 /**
  * Test that the functions that can modify and access the parameters of the
  * GRU layer work.
@@ -3653,6 +3773,58 @@ TEST_CASE("MaxPoolingTestCase", "[ANNLayerTest]")
   REQUIRE(output.n_cols == 1);
 }
 
+/**
+ * Make sure that the Max Pooling layer keeps the indices of every forward pass
+ * until the matching backward pass, so that several forward passes can be
+ * followed by their backward passes in reverse order.
+ */
+TEST_CASE("MaxPoolingForwardStackTest", "[ANNLayerTest]")
+{
+  // Two channels of size 4 x 4, and a batch of three points.
+  arma::mat input1(32, 3, arma::fill::randu);
+  arma::mat input2(32, 3, arma::fill::randu);
+  arma::mat error1(8, 3, arma::fill::randu);
+  arma::mat error2(8, 3, arma::fill::randu);
+
+  MaxPooling<> module(2, 2, 2, 2);
+  module.InputWidth() = 4;
+  module.InputHeight() = 4;
+
+  // Reference results, with one forward pass per backward pass.
+  arma::mat output1, output2, delta1, delta2;
+  module.Forward(input1, output1);
+  module.Backward(input1, error1, delta1);
+  module.Forward(input2, output2);
+  module.Backward(input2, error2, delta2);
+
+  REQUIRE(output1.n_rows == 8);
+  REQUIRE(output1.n_cols == 3);
+  REQUIRE(delta1.n_rows == 32);
+  REQUIRE(delta1.n_cols == 3);
+
+  // Every error value is routed to the maximum of its window.
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(arma::accu(delta1.col(i)) == Approx(arma::accu(error1.col(i))));
+
+  // Stacked forward passes.
+  arma::mat stackedOutput1, stackedOutput2, stackedDelta1, stackedDelta2;
+  module.Forward(input1, stackedOutput1);
+  module.Forward(input2, stackedOutput2);
+  module.Backward(input2, error2, stackedDelta2);
+  module.Backward(input1, error1, stackedDelta1);
+
+  CheckMatrices(output1, stackedOutput1);
+  CheckMatrices(output2, stackedOutput2);
+  CheckMatrices(delta1, stackedDelta1);
+  CheckMatrices(delta2, stackedDelta2);
+
+  // A deterministic pass gives the same output.
+  arma::mat deterministicOutput;
+  module.Deterministic() = true;
+  module.Forward(input1, deterministicOutput);
+  CheckMatrices(output1, deterministicOutput);
+}
+
 /**
  * Test that the functions that can modify and access the parameters of the
  * Glimpse layer work.
@@ -0,0 +1,143 @@
+/**
+ * @file tests/counter_test.cpp
+ *
+ * Tests for the performance counters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+BOOST_AUTO_TEST_SUITE(CounterTest);
+
+/**
+ * Counters should accumulate everything that is added to them.
+ */
+BOOST_AUTO_TEST_CASE(AccumulateCounterTest)
+{
+  Counter::ResetAll();
+  Counter::EnableCounting();
+
+  Counter::Add("test_counter");
+  Counter::Add("test_counter", 2.5);
+  Counter::Add("test_counter", 4);
+
+  // Names given as strings go to the same counter as string literals.
+  const std::string name = "test_counter";
+  Counter::Add(name, 0.5);
+
+  BOOST_REQUIRE_CLOSE(Counter::Get("test_counter"), 8.0, 1e-5);
+  BOOST_REQUIRE_EQUAL(Counter::Get("unknown_counter"), 0.0);
+
+  Counter::ResetAll();
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 0.0);
+  Counter::DisableCounting();
+}
+
+/**
+ * Nothing should be counted while counting is disabled.
+ */
+BOOST_AUTO_TEST_CASE(DisabledCountingTest)
+{
+  // It should be disabled by default but let's be paranoid.
+  Counter::DisableCounting();
+  Counter::ResetAll();
+
+  Counter::Add("test_counter", 3);
+  Counter::Record("test_series", 1.0);
+
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 0.0);
+  BOOST_REQUIRE_EQUAL(Counter::GetSeries("test_series").size(), 0);
+}
+
+/**
+ * Counters added to from several threads should hold the sum of all threads.
+ */
+BOOST_AUTO_TEST_CASE(MultithreadCounterTest)
+{
+  Counter::ResetAll();
+  Counter::EnableCounting();
+
+  std::thread threads[4];
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads[i] = std::thread([]()
+        {
+          for (size_t j = 0; j < 1000; ++j)
+            Counter::Add("thread_counter");
+        });
+  }
+
+  for (size_t i = 0; i < 4; ++i)
+    threads[i].join();
+
+  BOOST_REQUIRE_EQUAL(Counter::Get("thread_counter"), 4000.0);
+  Counter::DisableCounting();
+}
+
+/**
+ * Series should keep the recorded values in order, and show up in the JSON
+ * dump along with the counters.
+ */
+BOOST_AUTO_TEST_CASE(SeriesJSONTest)
+{
+  Counter::ResetAll();
+  Counter::EnableCounting();
+
+  for (size_t i = 0; i < 5; ++i)
+    Counter::Record("test_series", double(i) / 2);
+  Counter::Add("test_counter", 12);
+
+  const std::vector<double> series = Counter::GetSeries("test_series");
+  BOOST_REQUIRE_EQUAL(series.size(), 5);
+  for (size_t i = 0; i < 5; ++i)
+    BOOST_REQUIRE_EQUAL(series[i], double(i) / 2);
+
+  const std::string json = Counter::ToJSON();
+  BOOST_REQUIRE_NE(json.find("\"timers\""), std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"test_counter\": 12"), std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"test_series\": [0, 0.5, 1, 1.5, 2]"),
+      std::string::npos);
+  BOOST_REQUIRE_NE(json.find("\"threads\""), std::string::npos);
+
+  Counter::ResetAll();
+  Counter::DisableCounting();
+}
+
+/**
+ * A dual-tree search should publish its base cases and the statistics of its
+ * traversal.
+ */
+BOOST_AUTO_TEST_CASE(NeighborSearchCounterTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 500);
+
+  Counter::ResetAll();
+  Counter::EnableCounting();
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(5, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(Counter::Get("neighbor_search_base_cases"),
+      (double) knn.BaseCases());
+  BOOST_REQUIRE_EQUAL(Counter::Get("neighbor_search_scores"),
+      (double) knn.Scores());
+  BOOST_REQUIRE_GT(Counter::Get("dual_tree_visited"), 0.0);
+  BOOST_REQUIRE_GT(Counter::Get("tree_nodes_allocated"), 0.0);
+
+  Counter::ResetAll();
+  Counter::DisableCounting();
+}
+
+BOOST_AUTO_TEST_SUITE_END();
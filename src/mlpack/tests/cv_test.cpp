@@ -720,6 +720,47 @@ BOOST_AUTO_TEST_CASE(KFoldCVWithDTTestUnevenBinsWeighted)
   BOOST_REQUIRE_GT(accuracy, 0.7);
 }
 
+/**
+ * Test that training the folds in parallel gives the same result as training
+ * them one after another, and that a copy of a KFoldCV object evaluates the
+ * same way.
+ */
+BOOST_AUTO_TEST_CASE(KFoldCVParallelTest)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  data::DatasetInfo datasetInfo;
+  MockCategoricalData(data, labels, datasetInfo);
+  arma::rowvec weights(data.n_cols, arma::fill::randu);
+
+  size_t numClasses = 5;
+  size_t minimumLeafSize = 8;
+
+  KFoldCV<DecisionTree<InformationGain>, Accuracy> cv(7, data, datasetInfo,
+      labels, numClasses, weights, false);
+  const double serialAccuracy = cv.Evaluate(minimumLeafSize);
+  arma::Row<size_t> serialPredictions;
+  cv.Model().Classify(data, serialPredictions);
+
+  cv.NumThreads() = 4;
+  BOOST_REQUIRE_CLOSE(cv.Evaluate(minimumLeafSize), serialAccuracy, 1e-5);
+
+  // The model of the last fold should be kept.
+  arma::Row<size_t> parallelPredictions;
+  cv.Model().Classify(data, parallelPredictions);
+  BOOST_REQUIRE_EQUAL(arma::accu(serialPredictions != parallelPredictions),
+      0);
+
+  KFoldCV<DecisionTree<InformationGain>, Accuracy> cvCopy(cv);
+  BOOST_REQUIRE_EQUAL(cvCopy.NumThreads(), 4);
+  BOOST_REQUIRE_THROW(cvCopy.Model(), std::logic_error);
+  BOOST_REQUIRE_CLOSE(cvCopy.Evaluate(minimumLeafSize), serialAccuracy, 1e-5);
+
+  // Using the default number of OpenMP threads should work too.
+  cvCopy.NumThreads() = 0;
+  BOOST_REQUIRE_CLOSE(cvCopy.Evaluate(minimumLeafSize), serialAccuracy, 1e-5);
+}
+
 /**
  * Test Silhouette Score
  */
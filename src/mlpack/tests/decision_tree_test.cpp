@@ -1251,3 +1251,167 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * The dimensions of large nodes are searched in parallel; make sure that the
+ * best dimension is chosen, and that the first one wins when several
+ * dimensions give the same gain.
+ */
+TEST_CASE("ParallelDimensionSearchTest", "[DecisionTreeTest]")
+{
+  // The node is large enough to be searched in parallel.
+  arma::mat dataset(4, 5000, arma::fill::randu);
+  // The second and the fourth dimensions separate the classes perfectly.
+  dataset.row(3) = dataset.row(1);
+  arma::Row<size_t> labels(5000);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (dataset(1, i) > 0.5) ? 1 : 0;
+
+  ID3DecisionStump stump(dataset, labels, 2, 1);
+  REQUIRE(stump.NumChildren() == 2);
+  REQUIRE(stump.SplitDimension() == 1);
+
+  arma::Row<size_t> predictions;
+  stump.Classify(dataset, predictions);
+  REQUIRE(arma::accu(predictions == labels) == labels.n_elem);
+
+  // The same holds with categorical information.
+  data::DatasetInfo info(4);
+  DecisionTree<> tree(dataset, info, labels, 2, 1);
+  REQUIRE(tree.SplitDimension() == 1);
+}
+
+/**
+ * When a later dimension improves on an earlier one by less than
+ * minimumGainSplit, the earlier dimension is kept, both when training on the
+ * original dataset and on a binned dataset.
+ */
+TEST_CASE("MinimumGainSplitTieTest", "[DecisionTreeTest]")
+{
+  // The second dimension splits the classes at 4.5, with the points of
+  // label 1 that have value 0 on the wrong side.  The first dimension is the
+  // same, except for one more point on the wrong side, so its split is only
+  // slightly worse.
+  arma::mat data(2, 5000);
+  arma::Row<size_t> labels(5000);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    data(1, i) = i % 10;
+    labels[i] = (i % 10 >= 5 || i % 100 == 0) ? 1 : 0;
+  }
+  data.row(0) = data.row(1);
+  data(0, 1) = 9;
+
+  BinnedDataset<> binned(data);
+  arma::uvec indices = arma::regspace<arma::uvec>(0, data.n_cols - 1);
+
+  // Without a minimum gain, the better dimension wins.
+  DecisionTree<> d(data, labels, 2, 1, 0.0, 2);
+  DecisionTree<> binnedTree;
+  binnedTree.Train(binned, labels, 2, indices, 1, 0.0, 2);
+  REQUIRE(d.SplitDimension() == 1);
+  REQUIRE(binnedTree.SplitDimension() == 1);
+
+  // With a minimum gain that is larger than the difference, the first
+  // dimension is kept.
+  DecisionTree<> d2(data, labels, 2, 1, 0.01, 2);
+  DecisionTree<> binnedTree2;
+  binnedTree2.Train(binned, labels, 2, indices, 1, 0.01, 2);
+  REQUIRE(d2.SplitDimension() == 0);
+  REQUIRE(binnedTree2.SplitDimension() == 0);
+  REQUIRE(d2.ClassProbabilities()[0] == Approx(4.5));
+  REQUIRE(binnedTree2.ClassProbabilities()[0] == Approx(4.5));
+}
+
+/**
+ * Make sure that the bins of a BinnedDataset are consistent with its split
+ * points.
+ */
+TEST_CASE("BinnedDatasetTest", "[DecisionTreeTest]")
+{
+  arma::mat data(3, 5000, arma::fill::randu);
+  // The second dimension only has four distinct values.
+  data.row(1) = arma::floor(4 * data.row(1));
+
+  BinnedDataset<> binned(data, 32);
+
+  REQUIRE(binned.Dimensionality() == 3);
+  REQUIRE(binned.NumPoints() == 5000);
+  REQUIRE(binned.NumBins(0) <= 32);
+  REQUIRE(binned.NumBins(0) > 16);
+  REQUIRE(binned.NumBins(1) == 4);
+  REQUIRE(binned.MaximumBins() <= 32);
+
+  // The split points are halfway between the values of neighboring bins.
+  REQUIRE(binned.SplitPoint(1, 0) == Approx(0.5));
+  REQUIRE(binned.SplitPoint(1, 1) == Approx(1.5));
+  REQUIRE(binned.SplitPoint(1, 2) == Approx(2.5));
+
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const size_t bin = binned.Bin(d, i);
+      REQUIRE(bin < binned.NumBins(d));
+      if (bin + 1 < binned.NumBins(d))
+        REQUIRE(data(d, i) <= binned.SplitPoint(d, bin));
+      if (bin > 0)
+        REQUIRE(data(d, i) > binned.SplitPoint(d, bin - 1));
+    }
+  }
+
+  REQUIRE_THROWS_AS(BinnedDataset<>(data, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(BinnedDataset<>(data, 257), std::invalid_argument);
+}
+
+/**
+ * When every distinct value has its own bin, a tree trained on the binned
+ * dataset should split the training points like a tree trained on the
+ * original dataset.
+ */
+TEST_CASE("BinnedTrainingTest", "[DecisionTreeTest]")
+{
+  arma::mat data = arma::floor(20 * arma::randu<arma::mat>(4, 1000));
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) + data(2, i) > 20) ? 1 : (data(1, i) > 15) ? 2 : 0;
+
+  BinnedDataset<> binned(data);
+  arma::uvec indices = arma::regspace<arma::uvec>(0, data.n_cols - 1);
+
+  DecisionTree<> d(data, labels, 3, 5);
+  DecisionTree<> binnedTree;
+  binnedTree.Train(binned, labels, 3, indices, 5);
+
+  // The root is split at the same threshold, halfway between two values.
+  REQUIRE(binnedTree.SplitDimension() == d.SplitDimension());
+  REQUIRE(binnedTree.ClassProbabilities()[0] ==
+      Approx(d.ClassProbabilities()[0]));
+
+  arma::Row<size_t> predictions, binnedPredictions;
+  arma::mat probabilities, binnedProbabilities;
+  d.Classify(data, predictions, probabilities);
+  binnedTree.Classify(data, binnedPredictions, binnedProbabilities);
+
+  REQUIRE(arma::accu(predictions != binnedPredictions) == 0);
+  REQUIRE(arma::approx_equal(probabilities, binnedProbabilities, "absdiff",
+      1e-10));
+
+  // A point that appears twice in the indices counts twice.
+  arma::uvec doubledIndices = arma::join_cols(indices, indices);
+  DecisionTree<> doubledTree;
+  doubledTree.Train(binned, labels, 3, doubledIndices, 10);
+  doubledTree.Classify(data, binnedPredictions, binnedProbabilities);
+
+  REQUIRE(arma::accu(predictions != binnedPredictions) == 0);
+  REQUIRE(arma::approx_equal(probabilities, binnedProbabilities, "absdiff",
+      1e-10));
+
+  // Invalid indices are rejected.
+  arma::uvec badIndices = indices;
+  badIndices[0] = data.n_cols;
+  REQUIRE_THROWS_AS(binnedTree.Train(binned, labels, 3, badIndices, 5),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(binnedTree.Train(binned, labels, 3, arma::uvec(), 5),
+      std::invalid_argument);
+}
@@ -131,6 +131,38 @@ BOOST_AUTO_TEST_CASE(VanillaNetworkTest)
   TestNetwork<>(model1, dataset, labels, dataset, labels, 10, 0.2);
 }
 
+/**
+ * Train a network working in single precision, as given by its output layer.
+ */
+BOOST_AUTO_TEST_CASE(FloatNetworkTest)
+{
+  arma::fmat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::fmat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::fmat testData;
+  data::Load("thyroid_test.csv", testData, true);
+
+  arma::fmat testLabels = testData.row(testData.n_rows - 1);
+  testData.shed_row(testData.n_rows - 1);
+
+  typedef FFN<NegativeLogLikelihood<arma::fmat, arma::fmat> > FloatFFN;
+  BOOST_REQUIRE((std::is_same<FloatFFN::MatType, arma::fmat>::value));
+
+  FloatFFN model;
+  model.Add<Linear<arma::fmat, arma::fmat> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<LogisticFunction, arma::fmat, arma::fmat> >();
+  model.Add<Linear<arma::fmat, arma::fmat> >(8, 3);
+  model.Add<LogSoftMax<arma::fmat, arma::fmat> >();
+
+  TestNetwork<arma::fmat>(model, trainData, trainLabels, testData, testLabels,
+      10, 0.1);
+  BOOST_REQUIRE_EQUAL(model.Parameters().n_elem,
+      (trainData.n_rows + 1) * 8 + (8 + 1) * 3);
+}
+
 BOOST_AUTO_TEST_CASE(ForwardBackwardTest)
 {
   arma::mat dataset;
@@ -207,6 +239,106 @@ BOOST_AUTO_TEST_CASE(ForwardBackwardTest)
   BOOST_REQUIRE(converged);
 }
 
+/**
+ * Make sure the gradient computed with the bound layer calls matches a
+ * numerical estimate, and that copies and later changes of the network are
+ * picked up.
+ */
+BOOST_AUTO_TEST_CASE(LayerCallGradientTest)
+{
+  arma::mat input(6, 4, arma::fill::randu);
+  arma::mat target("1 2 3 1");
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(6, 5);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(5, 3);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  // The first pass sets up the layers; the next ones use the bound calls.
+  arma::mat output, gradient, tmp;
+  model.Forward(input, output);
+  model.Forward(input, output);
+  model.Backward(input, target, gradient);
+
+  const double eps = 1e-6;
+  for (size_t i = 0; i < model.Parameters().n_elem; ++i)
+  {
+    const double old = model.Parameters()(i);
+    model.Parameters()(i) = old + eps;
+    model.Forward(input, tmp);
+    const double plus = model.Backward(input, target, tmp);
+    model.Parameters()(i) = old - eps;
+    model.Forward(input, tmp);
+    const double minus = model.Backward(input, target, tmp);
+    model.Parameters()(i) = old;
+
+    BOOST_REQUIRE_SMALL((plus - minus) / (2 * eps) - gradient(i), 1e-5);
+  }
+
+  // A copy of the network binds its own layers.
+  FFN<NegativeLogLikelihood<> > copy(model);
+  arma::mat copyOutput, copyGradient;
+  copy.Forward(input, copyOutput);
+  copy.Backward(input, target, copyGradient);
+  CheckMatrices(output, copyOutput);
+  CheckMatrices(gradient, copyGradient);
+
+  // A layer added after the first pass is called too.
+  model.Add<MultiplyConstant<> >(2.0);
+  model.ResetParameters();
+  model.Forward(input, tmp);
+  BOOST_REQUIRE_EQUAL(tmp.n_rows, 3);
+  model.Parameters() = copy.Parameters();
+  model.Forward(input, tmp);
+  CheckMatrices(tmp, arma::mat(2 * output));
+}
+
+/**
+ * Make sure that splitting the batches over several threads gives the same
+ * objective and gradient, and that training is repeatable for a given number
+ * of threads.
+ */
+BOOST_AUTO_TEST_CASE(ParallelGradientTest)
+{
+  arma::mat input(6, 50, arma::fill::randu);
+  arma::mat target(2, 50, arma::fill::randu);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(6, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.ResetParameters();
+
+  arma::mat gradient, parallelGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 50);
+
+  // The number of threads doesn't have to divide the batch size.
+  const size_t numThreads[] = { 2, 3, 7 };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    model.NumThreads() = numThreads[i];
+    const double parallelObjective = model.EvaluateWithGradient(
+        model.Parameters(), 0, parallelGradient, 50);
+
+    BOOST_REQUIRE_CLOSE(objective, parallelObjective, 1e-5);
+    CheckMatrices(gradient, parallelGradient, 1e-5);
+  }
+
+  // Training twice with the same number of threads gives the same model.
+  FFN<MeanSquaredError<> > copy(model);
+  ens::StandardSGD opt(0.1, 10, 5 * input.n_cols, -100, false);
+  model.Train(input, target, opt);
+  copy.Train(input, target, opt);
+
+  BOOST_REQUIRE_EQUAL(copy.NumThreads(), 7);
+  CheckMatrices(model.Parameters(), copy.Parameters());
+}
+
 /**
  * Train the dropout network on a larger dataset.
  */
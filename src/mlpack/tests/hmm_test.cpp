@@ -107,6 +107,44 @@ BOOST_AUTO_TEST_CASE(BorodovskyHMMTestViterbi)
   BOOST_REQUIRE_EQUAL(states[8], 2);
 }
 
+/**
+ * Make sure that decoding many sequences at once gives the same results as
+ * decoding each sequence individually.
+ */
+BOOST_AUTO_TEST_CASE(DiscreteHMMBatchViterbiTest)
+{
+  arma::vec initial("0.6 0.4");
+  arma::mat transition("0.7 0.3; 0.3 0.7");
+  std::vector<DiscreteDistribution> emission(2);
+  emission[0] = DiscreteDistribution(std::vector<arma::vec>{"0.9 0.1"});
+  emission[1] = DiscreteDistribution(std::vector<arma::vec>{"0.2 0.8"});
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate a bunch of sequences of different lengths.
+  std::vector<arma::mat> observations(50);
+  std::vector<arma::Row<size_t> > trueStates(50);
+  for (size_t i = 0; i < observations.size(); ++i)
+    hmm.Generate(10 + 3 * i, observations[i], trueStates[i]);
+
+  std::vector<arma::Row<size_t> > states;
+  arma::vec logLikelihoods;
+  hmm.Predict(observations, states, logLikelihoods);
+
+  BOOST_REQUIRE_EQUAL(states.size(), observations.size());
+  BOOST_REQUIRE_EQUAL(logLikelihoods.n_elem, observations.size());
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> singleStates;
+    const double logLikelihood = hmm.Predict(observations[i], singleStates);
+
+    BOOST_REQUIRE_CLOSE(logLikelihoods[i], logLikelihood, 1e-5);
+    BOOST_REQUIRE_EQUAL(states[i].n_elem, singleStates.n_elem);
+    for (size_t j = 0; j < singleStates.n_elem; ++j)
+      BOOST_REQUIRE_EQUAL(states[i][j], singleStates[j]);
+  }
+}
+
 /**
  * Ensure that the forward-backward algorithm is correct.
  */
@@ -530,6 +568,74 @@ BOOST_AUTO_TEST_CASE(DiscreteHMMLogLikelihoodTest)
       -24.51556128368, 1e-5);
 }
 
+/**
+ * Make sure that a left-to-right HMM (with many impossible transitions) gives
+ * the same log-likelihood and most probable path as enumerating every possible
+ * state sequence.
+ */
+BOOST_AUTO_TEST_CASE(DiscreteHMMLeftToRightTest)
+{
+  arma::vec initial("0.8 0.2 0.0");
+  arma::mat transition("0.6 0.0 0.0;"
+                       "0.4 0.7 0.0;"
+                       "0.0 0.3 1.0");
+  std::vector<DiscreteDistribution> emission(3);
+  emission[0].Probabilities() = "0.7 0.2 0.1";
+  emission[1].Probabilities() = "0.1 0.7 0.2";
+  emission[2].Probabilities() = "0.2 0.1 0.7";
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  arma::mat observation("0 1 1 2 2");
+
+  // Enumerate all 3^5 state sequences.
+  double likelihood = 0.0;
+  double bestProb = 0.0;
+  arma::Row<size_t> bestPath(5);
+  arma::Row<size_t> path(5);
+  for (size_t code = 0; code < 243; ++code)
+  {
+    size_t c = code;
+    for (size_t t = 0; t < 5; ++t)
+    {
+      path[t] = c % 3;
+      c /= 3;
+    }
+
+    double prob = initial[path[0]] *
+        emission[path[0]].Probability(observation.col(0));
+    for (size_t t = 1; t < 5; ++t)
+    {
+      prob *= transition(path[t], path[t - 1]) *
+          emission[path[t]].Probability(observation.col(t));
+    }
+
+    likelihood += prob;
+    if (prob > bestProb)
+    {
+      bestProb = prob;
+      bestPath = path;
+    }
+  }
+
+  BOOST_REQUIRE_CLOSE(hmm.LogLikelihood(observation), std::log(likelihood),
+      1e-5);
+
+  arma::Row<size_t> states;
+  const double logProb = hmm.Predict(observation, states);
+  BOOST_REQUIRE_CLOSE(logProb, std::log(bestProb), 1e-5);
+  for (size_t t = 0; t < 5; ++t)
+    BOOST_REQUIRE_EQUAL(states[t], bestPath[t]);
+
+  // The state probabilities of each time step should sum to one, and a state
+  // that cannot be reached yet must have zero probability.
+  arma::mat stateProb;
+  hmm.Estimate(observation, stateProb);
+  for (size_t t = 0; t < 5; ++t)
+    BOOST_REQUIRE_CLOSE(arma::accu(stateProb.col(t)), 1.0, 1e-5);
+  BOOST_REQUIRE_SMALL(stateProb(2, 0), 1e-10);
+}
+
 /**
  * A simple test to make sure HMMs with Gaussian output distributions work.
  */
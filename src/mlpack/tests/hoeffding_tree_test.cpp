@@ -1052,6 +1052,108 @@ BOOST_AUTO_TEST_CASE(BatchTrainingTest)
   BOOST_REQUIRE_GE(batchCorrect, streamCorrect);
 }
 
+/**
+ * Make sure that training on mini-batches of a single point gives the same tree
+ * as training on the points one at a time.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingTreeMiniBatchSinglePointTest)
+{
+  // Generate data.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3); // All features are numeric.
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  typedef HoeffdingTree<GiniImpurity, HoeffdingDoubleNumericSplit> TreeType;
+  TreeType streamTree(info, 3);
+  TreeType miniBatchTree(info, 3);
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    streamTree.Train(dataset.col(i), labels[i]);
+
+    const arma::mat point = dataset.col(i);
+    const arma::Row<size_t> label = labels.subvec(i, i);
+    miniBatchTree.TrainMiniBatch(point, label);
+  }
+
+  BOOST_REQUIRE_GT(streamTree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(miniBatchTree.NumChildren(), streamTree.NumChildren());
+  BOOST_REQUIRE_EQUAL(miniBatchTree.NumDescendants(),
+      streamTree.NumDescendants());
+  BOOST_REQUIRE_EQUAL(miniBatchTree.SplitDimension(),
+      streamTree.SplitDimension());
+
+  arma::Row<size_t> streamLabels, miniBatchLabels;
+  streamTree.Classify(dataset, streamLabels);
+  miniBatchTree.Classify(dataset, miniBatchLabels);
+  for (size_t i = 0; i < 9000; ++i)
+    BOOST_REQUIRE_EQUAL(miniBatchLabels[i], streamLabels[i]);
+}
+
+/**
+ * Train a tree on larger mini-batches and make sure it splits and classifies
+ * the data about as well as a tree trained one point at a time.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingTreeMiniBatchTrainingTest)
+{
+  // Generate data.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3); // All features are numeric.
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  typedef HoeffdingTree<GiniImpurity, HoeffdingDoubleNumericSplit> TreeType;
+  TreeType miniBatchTree(info, 3);
+  for (size_t i = 0; i < 9000; i += 150)
+  {
+    const arma::mat batch = dataset.cols(i, i + 149);
+    const arma::Row<size_t> batchLabels = labels.subvec(i, i + 149);
+    miniBatchTree.TrainMiniBatch(batch, batchLabels);
+  }
+
+  BOOST_REQUIRE_GT(miniBatchTree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(miniBatchTree.SplitDimension(), 1);
+
+  arma::Row<size_t> predictions;
+  miniBatchTree.Classify(dataset, predictions);
+  const size_t correct = arma::accu(predictions == labels);
+
+  // 66% accuracy shouldn't be too much to ask...
+  BOOST_REQUIRE_GT(correct, 6000);
+}
+
 // Make sure that changing the confidence properly propagates to all leaves.
 BOOST_AUTO_TEST_CASE(ConfidenceChangeTest)
 {
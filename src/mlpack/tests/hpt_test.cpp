@@ -12,6 +12,7 @@
 #include <mlpack/core/cv/metrics/mse.hpp>
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/simple_cv.hpp>
+#include <mlpack/core/cv/k_fold_cv.hpp>
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
@@ -120,10 +121,12 @@ class QuadraticFunction
                     double xMin = 0.0,
                     double yMin = 0.0,
                     double zMin = 0.0) :
-      a(a), b(b), c(c), d(d), xMin(xMin), yMin(yMin), zMin(zMin) {}
+      a(a), b(b), c(c), d(d), xMin(xMin), yMin(yMin), zMin(zMin),
+      numEvaluations(0) {}
 
   double Evaluate(double x, double y, double z)
   {
+    ++numEvaluations;
     return a * pow(x - xMin, 2)  + b * pow(y - yMin, 2) + c * pow(z - zMin, 2)
         + d;
   }
@@ -135,8 +138,12 @@ class QuadraticFunction
     return MLAlgorithm();
   }
 
+  // The number of times Evaluate() has been called.
+  size_t NumEvaluations() const { return numEvaluations; }
+
  private:
   double a, b, c, d, xMin, yMin, zMin;
+  size_t numEvaluations;
 };
 
 /**
@@ -179,6 +186,34 @@ BOOST_AUTO_TEST_CASE(CVFunctionGradientTest)
   BOOST_REQUIRE_CLOSE(gradient(2), aproximateZPartialDerivative, 1e-5);
 }
 
+/**
+ * Test CVFunction does not run cross-validation again for parameters it has
+ * already evaluated.
+ */
+BOOST_AUTO_TEST_CASE(CVFunctionCacheTest)
+{
+  QuadraticFunction<LARS> lf(1.0, -1.5, 2.5, 3.0);
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 3);
+
+  CVFunction<decltype(lf), LARS, 3> cvFun(lf, datasetInfo, 0.01, 0.001);
+
+  const arma::vec parameters("0.0 -1.0 2.0");
+  const double objective = cvFun.Evaluate(parameters);
+  BOOST_REQUIRE_EQUAL(lf.NumEvaluations(), 1);
+
+  // The gradient needs one more evaluation per dimension; the objective at
+  // the given parameters is already known.
+  arma::mat gradient;
+  cvFun.Gradient(parameters, gradient);
+  BOOST_REQUIRE_EQUAL(lf.NumEvaluations(), 4);
+  BOOST_REQUIRE_EQUAL(cvFun.NumEvaluations(), 4);
+
+  BOOST_REQUIRE_CLOSE(cvFun.Evaluate(parameters), objective, 1e-5);
+  cvFun.Gradient(parameters, gradient);
+  BOOST_REQUIRE_EQUAL(lf.NumEvaluations(), 4);
+}
 
 void InitProneToOverfittingData(arma::mat& xs,
                                 arma::rowvec& ys,
@@ -326,6 +361,45 @@ BOOST_AUTO_TEST_CASE(HPTTest)
   BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
 }
 
+/**
+ * Test HyperParameterTuner finds the same hyper-parameters and model when the
+ * candidates of the grid and the folds are evaluated concurrently.
+ */
+BOOST_AUTO_TEST_CASE(HPTParallelGridSearchTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  const size_t k = 5;
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2;
+  HyperParameterTuner<LARS, MSE, KFoldCV, GridSearch>
+      serialHPT(k, xs, ys, false);
+  std::tie(expectedLambda1, expectedLambda2) = serialHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, KFoldCV, GridSearch> hpt(k, xs, ys, false);
+  hpt.NumThreads() = 4;
+  hpt.CV().NumThreads() = 2;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_CLOSE(serialHPT.BestObjective(), hpt.BestObjective(), 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+
+  // The best models should be the same too.
+  BOOST_REQUIRE_CLOSE(MSE::Evaluate(serialHPT.BestModel(), xs, ys),
+      MSE::Evaluate(hpt.BestModel(), xs, ys), 1e-5);
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
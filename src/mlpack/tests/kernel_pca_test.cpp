@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/random_fourier_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -150,4 +151,57 @@ BOOST_AUTO_TEST_CASE(CircleTransformationTestNystroem)
   BOOST_REQUIRE_EQUAL(ranges[1].Contains(ranges[2]), false);
 }
 
+/**
+ * With enough random Fourier features, the leading eigenvalues should be close
+ * to the ones of the exact kernel matrix.
+ */
+BOOST_AUTO_TEST_CASE(RandomFourierEigenvaluesTest)
+{
+  // Give every dimension a different scale so the eigenvalues are distinct.
+  arma::mat dataset(3, 300, arma::fill::randn);
+  dataset.row(0) *= 4.0;
+  dataset.row(1) *= 1.5;
+  dataset.row(2) *= 0.5;
+  GaussianKernel kernel(2.0);
+
+  arma::mat transformed, eigvec;
+  arma::vec eigval;
+  KernelPCA<GaussianKernel> exact(kernel);
+  exact.Apply(dataset, transformed, eigval, eigvec);
+
+  KernelPCA<GaussianKernel, RandomFourierKernelRule<GaussianKernel> >
+      approximate(kernel, false, RandomFourierKernelRule<GaussianKernel>(2000));
+
+  arma::mat approximateTransformed, approximateEigvec;
+  arma::vec approximateEigval;
+  approximate.Apply(dataset, approximateTransformed, approximateEigval,
+      approximateEigvec, 3);
+
+  BOOST_REQUIRE_EQUAL(approximateEigval.n_elem, 3);
+  BOOST_REQUIRE_EQUAL(approximateTransformed.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(approximateTransformed.n_cols, 300);
+  for (size_t i = 0; i < 3; ++i)
+    BOOST_REQUIRE_CLOSE(approximateEigval[i], eigval[i], 15.0);
+
+  // The squared norm of every component is its eigenvalue.
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(arma::accu(arma::square(approximateTransformed.row(i))),
+        approximateEigval[i], 1e-5);
+  }
+
+  // Computing all the components gives the same leading eigenvalues.
+  approximate.Rule().NumFeatures() = 10;
+  approximate.Apply(dataset, approximateTransformed, approximateEigval);
+  BOOST_REQUIRE_EQUAL(approximateEigval.n_elem, 10);
+  BOOST_REQUIRE_EQUAL(approximateTransformed.n_rows, 10);
+  for (size_t i = 1; i < 10; ++i)
+    BOOST_REQUIRE_LE(approximateEigval[i], approximateEigval[i - 1]);
+
+  // Kernels that aren't shift-invariant can't be used.
+  KernelPCA<LinearKernel, RandomFourierKernelRule<LinearKernel> > linear;
+  BOOST_REQUIRE_THROW(linear.Apply(dataset, approximateTransformed,
+      approximateEigval), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
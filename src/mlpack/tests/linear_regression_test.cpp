@@ -10,6 +10,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/linear_regression/linear_regression.hpp>
+#include <mlpack/core/data/chunked_loader.hpp>
 
 #include "serialization_catch.hpp"
 #include "test_catch_tools.hpp"
@@ -266,3 +267,38 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * Make sure that training on a dataset read in chunks gives the same model and
+ * error as training on the whole dataset, with and without an intercept.
+ */
+TEST_CASE("LinearRegressionChunkedTrainTest", "[LinearRegressionTest]")
+{
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  dataset.row(3) = 2.0 + 0.5 * dataset.row(0) - 3.0 * dataset.row(1) +
+      dataset.row(2) + 0.1 * arma::randn<arma::rowvec>(1000);
+  REQUIRE(data::Save("lr_chunked.bin", dataset));
+
+  // The same precision as the loader is needed.
+  arma::mat loaded;
+  REQUIRE(data::Load("lr_chunked.bin", loaded));
+  const arma::mat predictors = loaded.rows(0, 2);
+  const arma::rowvec responses = loaded.row(3);
+
+  data::ChunkedLoader<> loader("lr_chunked.bin", 128);
+  for (const bool intercept : { true, false })
+  {
+    LinearRegression lr(predictors, responses, 0.1, intercept);
+
+    LinearRegression chunkedLr;
+    chunkedLr.Lambda() = 0.1;
+    const double error = chunkedLr.Train(loader, intercept);
+
+    REQUIRE(chunkedLr.Intercept() == intercept);
+    CheckMatrices(lr.Parameters(), chunkedLr.Parameters());
+    REQUIRE(error == Approx(lr.ComputeError(predictors, responses)).epsilon(
+        1e-5));
+  }
+
+  remove("lr_chunked.bin");
+}
@@ -466,6 +466,96 @@ BOOST_AUTO_TEST_CASE(LinearSVMFunctionSeparableGradient)
   }
 }
 
+/**
+ * Make sure that the sparse separable gradient computed on sparse data matches
+ * the dense gradient on every feature that occurs in the batch, plus the
+ * regularization that feature missed since it last occurred (or since the last
+ * Shuffle()), and leaves all other features untouched.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMFunctionSparseGradient)
+{
+  const size_t points = 200;
+  const size_t inputSize = 50;
+  const size_t numClasses = 3;
+
+  arma::sp_mat data;
+  data.sprandu(inputSize, points, 0.05);
+  const arma::mat denseData(data);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  LinearSVMFunction<arma::sp_mat> svmf(data, labels, numClasses, 0.5, 1.0,
+      true);
+  LinearSVMFunction<> denseSvmf(denseData, labels, numClasses, 0.5, 1.0,
+      true);
+  const arma::mat parameters = arma::randu<arma::mat>(inputSize + 1,
+      numClasses);
+
+  // One more than the index of the batch in which each feature last occurred,
+  // or 0 if it hasn't yet.
+  arma::Col<size_t> lastCall(inputSize, arma::fill::zeros);
+  for (size_t i = 0; i < points; i += 10)
+  {
+    arma::sp_mat gradient;
+    arma::mat denseGradient;
+    svmf.Gradient(parameters, i, gradient, 10);
+    denseSvmf.Gradient(parameters, i, denseGradient, 10);
+
+    BOOST_REQUIRE_EQUAL(gradient.n_rows, parameters.n_rows);
+    BOOST_REQUIRE_EQUAL(gradient.n_cols, parameters.n_cols);
+
+    const arma::sp_mat batch = data.cols(i, i + 9);
+    for (size_t j = 0; j < inputSize; ++j)
+    {
+      const bool occurs = arma::accu(arma::abs(batch.row(j))) > 0.0;
+
+      // The dense gradient holds the regularization of this batch only,
+      // which is all that a feature occurring for the first time receives.
+      const double missed = (lastCall[j] == 0) ? 0.0 :
+          (i / 10 - lastCall[j]) * 0.5;
+      for (size_t k = 0; k < numClasses; ++k)
+      {
+        if (occurs)
+        {
+          BOOST_REQUIRE_CLOSE(gradient(j, k), denseGradient(j, k) + missed *
+              parameters(j, k), 1e-5);
+        }
+        else
+        {
+          BOOST_REQUIRE_EQUAL(gradient(j, k), 0.0);
+        }
+      }
+
+      if (occurs)
+        lastCall[j] = i / 10 + 1;
+    }
+
+    // The intercept row is always part of the gradient.
+    for (size_t k = 0; k < numClasses; ++k)
+    {
+      BOOST_REQUIRE_CLOSE(gradient(inputSize, k),
+          denseGradient(inputSize, k), 1e-5);
+    }
+  }
+
+  // After Shuffle(), every feature occurs for the first time again, so the
+  // gradient over all the points matches the dense gradient.
+  svmf.Shuffle();
+  arma::sp_mat gradient;
+  arma::mat denseGradient;
+  svmf.Gradient(parameters, 0, gradient, points);
+  denseSvmf.Gradient(parameters, 0, denseGradient, points);
+  for (size_t j = 0; j < inputSize; ++j)
+  {
+    if (arma::accu(arma::abs(data.row(j))) > 0.0)
+    {
+      for (size_t k = 0; k < numClasses; ++k)
+        BOOST_REQUIRE_CLOSE(gradient(j, k), denseGradient(j, k), 1e-5);
+    }
+  }
+}
+
 /**
  * Test training of linear svm on a simple dataset using
  * L-BFGS optimizer
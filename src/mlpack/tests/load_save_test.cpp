@@ -11,8 +11,14 @@
  */
 #include <sstream>
 
+#ifndef _WIN32
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/chunked_loader.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -2388,3 +2394,127 @@ TEST_CASE("DatasetMapperNonUniqueTest", "[LoadSaveTest]")
   REQUIRE(dm.UnmapString(nan, 0, 1) == "goodbye");
   REQUIRE(dm.UnmapString(nan, 0, 2) == "cheese");
 }
+
+/**
+ * Make sure the ChunkedLoader reads the same points as data::Load(), for every
+ * supported format, and that it can read the file again after Reset().
+ */
+TEST_CASE("ChunkedLoaderTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 103, arma::fill::randu);
+  const std::vector<std::string> filenames = { "test_chunked.csv",
+      "test_chunked.bin" };
+
+  for (const std::string& filename : filenames)
+  {
+    REQUIRE(data::Save(filename, dataset));
+    arma::mat loaded;
+    REQUIRE(data::Load(filename, loaded));
+
+    ChunkedLoader<> loader(filename, 25);
+    REQUIRE(loader.Dimensionality() == 4);
+
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+      arma::mat chunk, points;
+      size_t chunks = 0;
+      while (loader.Next(chunk))
+      {
+        REQUIRE(chunk.n_rows == 4);
+        REQUIRE(chunk.n_cols <= 25);
+        points = arma::join_rows(points, chunk);
+        ++chunks;
+      }
+
+      REQUIRE(chunks == 5);
+      CheckMatrices(points, loaded);
+      loader.Reset();
+    }
+
+    remove(filename.c_str());
+  }
+
+  REQUIRE_THROWS_AS(ChunkedLoader<>("test_chunked.xyz"), std::runtime_error);
+  REQUIRE_THROWS_AS(ChunkedLoader<>("nonexistentfile_______________.csv"),
+      std::runtime_error);
+}
+
+/**
+ * Make sure the ChunkedLoader parses the separators and special values of text
+ * files, and rejects invalid values and truncated binary files.
+ */
+TEST_CASE("ChunkedLoaderParseTest", "[LoadSaveTest]")
+{
+  std::fstream f;
+  f.open("test_chunked_parse.csv", std::fstream::out | std::fstream::binary);
+  f << "1, 2,3\r\n";
+  f << "\n";
+  f << "4 5\t-6e-1\n";
+  f << "nan,inf,-inf";
+  f.close();
+
+  ChunkedLoader<> loader("test_chunked_parse.csv", 10);
+  REQUIRE(loader.Dimensionality() == 3);
+
+  arma::mat chunk;
+  REQUIRE(loader.Next(chunk));
+  REQUIRE(chunk.n_cols == 3);
+  REQUIRE(chunk(0, 0) == 1.0);
+  REQUIRE(chunk(2, 0) == 3.0);
+  REQUIRE(chunk(1, 1) == 5.0);
+  REQUIRE(chunk(2, 1) == Approx(-0.6));
+  REQUIRE(std::isnan(chunk(0, 2)));
+  REQUIRE(chunk(1, 2) == std::numeric_limits<double>::infinity());
+  REQUIRE(chunk(2, 2) == -std::numeric_limits<double>::infinity());
+  REQUIRE(!loader.Next(chunk));
+
+  f.open("test_chunked_parse.csv", std::fstream::out);
+  f << "1,2,3" << std::endl;
+  f << "4,5x,6" << std::endl;
+  f.close();
+
+  ChunkedLoader<> badLoader("test_chunked_parse.csv", 10);
+  REQUIRE_THROWS_AS(badLoader.Next(chunk), std::runtime_error);
+  remove("test_chunked_parse.csv");
+
+  // A binary file that is shorter than its header says is rejected.
+  arma::mat dataset(3, 20, arma::fill::randu);
+  REQUIRE(data::Save("test_chunked_parse.bin", dataset));
+  f.open("test_chunked_parse.bin", std::fstream::in | std::fstream::binary);
+  std::string contents((std::istreambuf_iterator<char>(f)),
+      std::istreambuf_iterator<char>());
+  f.close();
+  f.open("test_chunked_parse.bin", std::fstream::out | std::fstream::binary |
+      std::fstream::trunc);
+  f << contents.substr(0, contents.size() - 8);
+  f.close();
+
+  REQUIRE_THROWS_AS(ChunkedLoader<>("test_chunked_parse.bin"),
+      std::runtime_error);
+  remove("test_chunked_parse.bin");
+}
+
+#ifndef _WIN32
+/**
+ * A file that can be opened but not mapped (here a directory) must be
+ * reported as an error, and not read as an empty dataset.
+ */
+TEST_CASE("ChunkedLoaderUnmappableFileTest", "[LoadSaveTest]")
+{
+  REQUIRE(mkdir("test_chunked_unmappable.csv", 0700) == 0);
+  REQUIRE_THROWS_AS(ChunkedLoader<>("test_chunked_unmappable.csv"),
+      std::runtime_error);
+  rmdir("test_chunked_unmappable.csv");
+
+  // An empty file is an empty dataset.
+  std::fstream f;
+  f.open("test_chunked_empty.csv", std::fstream::out);
+  f.close();
+
+  ChunkedLoader<> loader("test_chunked_empty.csv");
+  arma::mat chunk;
+  REQUIRE(loader.Dimensionality() == 0);
+  REQUIRE(!loader.Next(chunk));
+  remove("test_chunked_empty.csv");
+}
+#endif
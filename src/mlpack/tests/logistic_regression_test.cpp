@@ -354,6 +354,113 @@ BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionSeparableGradient)
   BOOST_REQUIRE_SMALL(gradient[2], 1e-15);
 }
 
+/**
+ * Make sure that shuffling the LogisticRegressionFunction only changes the
+ * order in which the points are visited, and does not copy the dataset.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionShuffleTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 100);
+  arma::Row<size_t> responses =
+      arma::conv_to<arma::Row<size_t>>::from(data.row(0) > 0.5);
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+  const arma::rowvec parameters = arma::randn<arma::rowvec>(6);
+
+  const double objective = lrf.Evaluate(parameters);
+  arma::rowvec gradient;
+  lrf.Gradient(parameters, gradient);
+
+  lrf.Shuffle();
+
+  // The predictors must still be the user's data.
+  BOOST_REQUIRE_EQUAL(lrf.Predictors().memptr(), data.memptr());
+
+  // Summing over all minibatches must give the full objective and gradient.
+  double batchObjective = 0.0;
+  arma::rowvec batchGradient(parameters.n_elem, arma::fill::zeros);
+  for (size_t i = 0; i < lrf.NumFunctions(); i += 7)
+  {
+    const size_t batchSize = std::min((size_t) 7, lrf.NumFunctions() - i);
+    arma::rowvec g;
+    batchObjective += lrf.EvaluateWithGradient(parameters, i, g, batchSize);
+    batchGradient += g;
+  }
+
+  BOOST_REQUIRE_CLOSE(batchObjective, objective, 1e-5);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+}
+
+/**
+ * Make sure that the sparse separable gradient computed on sparse data matches
+ * the dense gradient on every feature that occurs in the batch, plus the
+ * regularization that feature missed since it last occurred (or since the last
+ * Shuffle()), and leaves all other features untouched.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionSparseGradientTest)
+{
+  arma::sp_mat data;
+  data.sprandu(50, 200, 0.05);
+  const arma::mat denseData(data);
+  arma::Row<size_t> responses(200);
+  for (size_t i = 0; i < 200; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, responses, 0.5);
+  LogisticRegressionFunction<> denseLrf(denseData, responses, 0.5);
+  const arma::rowvec parameters = arma::randn<arma::rowvec>(51);
+
+  // The number of visited points when each feature last occurred, or 0 if it
+  // hasn't yet.
+  arma::Col<size_t> lastVisit(50, arma::fill::zeros);
+  for (size_t i = 0; i < 200; i += 10)
+  {
+    arma::sp_mat gradient;
+    arma::rowvec denseGradient;
+    lrf.Gradient(parameters, i, gradient, 10);
+    denseLrf.Gradient(parameters, i, denseGradient, 10);
+
+    BOOST_REQUIRE_EQUAL(gradient.n_rows, 1);
+    BOOST_REQUIRE_EQUAL(gradient.n_cols, 51);
+
+    // The intercept is always part of the gradient.
+    BOOST_REQUIRE_CLOSE(gradient(0, 0), denseGradient[0], 1e-5);
+
+    const arma::sp_mat batch = data.cols(i, i + 9);
+    for (size_t j = 1; j < 51; ++j)
+    {
+      if (arma::accu(arma::abs(batch.row(j - 1))) > 0.0)
+      {
+        // The dense gradient holds the regularization of this batch only,
+        // which is all that a feature occurring for the first time receives.
+        const double missed = (lastVisit[j - 1] == 0) ? 0.0 :
+            (i - lastVisit[j - 1]) * 0.5 / 200;
+        BOOST_REQUIRE_CLOSE(gradient(0, j), denseGradient[j] + missed *
+            parameters[j], 1e-5);
+        lastVisit[j - 1] = i + 10;
+      }
+      else
+      {
+        BOOST_REQUIRE_EQUAL(gradient(0, j), 0.0);
+      }
+    }
+  }
+
+  // After Shuffle(), every feature occurs for the first time again, so the
+  // gradient over all the points matches the dense gradient.
+  lrf.Shuffle();
+  arma::sp_mat gradient;
+  arma::rowvec denseGradient;
+  lrf.Gradient(parameters, 0, gradient, 200);
+  denseLrf.Gradient(parameters, 0, denseGradient, 200);
+  for (size_t j = 1; j < 51; ++j)
+  {
+    if (arma::accu(arma::abs(data.row(j - 1))) > 0.0)
+      BOOST_REQUIRE_CLOSE(gradient(0, j), denseGradient[j], 1e-5);
+  }
+}
+
 /**
  * Test Gradient() function when regularization is used.
  */
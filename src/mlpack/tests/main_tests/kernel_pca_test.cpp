@@ -353,4 +353,45 @@ BOOST_AUTO_TEST_CASE(KernelPCASamplingSchemeTest)
   BOOST_REQUIRE(arma::any(arma::vectorise(output1 != output3)));
 }
 
+/**
+ * Make sure that random Fourier features give the requested dimension, and
+ * are only accepted for shift-invariant kernels.
+ */
+BOOST_AUTO_TEST_CASE(KernelPCARandomFourierFeaturesTest)
+{
+  arma::mat x = arma::randu<arma::mat>(5, 100);
+
+  SetInputParam("input", x);
+  SetInputParam("new_dimensionality", (int) 3);
+  SetInputParam("kernel", (std::string) "gaussian");
+  SetInputParam("random_fourier_features", true);
+  SetInputParam("num_features", (int) 50);
+
+  mlpackMain();
+
+  BOOST_REQUIRE_EQUAL(IO::GetParam<arma::mat>("output").n_rows, 3);
+  BOOST_REQUIRE_EQUAL(IO::GetParam<arma::mat>("output").n_cols, 100);
+
+  ResetSettings();
+
+  SetInputParam("input", x);
+  SetInputParam("kernel", (std::string) "polynomial");
+  SetInputParam("random_fourier_features", true);
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  ResetSettings();
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("kernel", (std::string) "gaussian");
+  SetInputParam("random_fourier_features", true);
+  SetInputParam("nystroem_method", true);
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
 BOOST_AUTO_TEST_SUITE_END();
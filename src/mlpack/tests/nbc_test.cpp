@@ -355,4 +355,79 @@ BOOST_AUTO_TEST_CASE(NaiveBayesClassifierHighDimensionsTest)
     BOOST_REQUIRE_EQUAL(calcVec(i), testLabels(i));
 }
 
+/**
+ * Make sure that training incrementally on a dataset one chunk at a time gives
+ * the same model as training on the whole dataset at once.
+ */
+BOOST_AUTO_TEST_CASE(NaiveBayesClassifierChunkedTrainTest)
+{
+  const size_t classes = 3;
+  arma::mat trainData(5, 500, arma::fill::randn);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = math::RandInt(classes);
+    trainData.col(i) += labels[i];
+  }
+
+  NaiveBayesClassifier<> nbc(trainData.n_rows, classes);
+  nbc.Train(trainData, labels, classes, true);
+
+  NaiveBayesClassifier<> chunkedNbc(trainData.n_rows, classes);
+  for (size_t begin = 0; begin < trainData.n_cols; begin += 64)
+  {
+    const size_t end = std::min(begin + 64, (size_t) trainData.n_cols);
+    const arma::mat chunk = trainData.cols(begin, end - 1);
+    const arma::Row<size_t> chunkLabels = labels.cols(begin, end - 1);
+    chunkedNbc.Train(chunk, chunkLabels, classes, true);
+  }
+
+  CheckMatrices(nbc.Means(), chunkedNbc.Means());
+  CheckMatrices(nbc.Variances(), chunkedNbc.Variances());
+  CheckMatrices(nbc.Probabilities(), chunkedNbc.Probabilities());
+}
+
+/**
+ * Make sure that training on some points one at a time and then on the rest
+ * in a batch (and the other way around) gives the same model as training on
+ * the whole dataset at once.
+ */
+BOOST_AUTO_TEST_CASE(NaiveBayesClassifierMixedTrainTest)
+{
+  const size_t classes = 3;
+  arma::mat trainData(5, 300, arma::fill::randn);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = math::RandInt(classes);
+    trainData.col(i) += labels[i];
+  }
+
+  NaiveBayesClassifier<> nbc(trainData.n_rows, classes);
+  nbc.Train(trainData, labels, classes, true);
+
+  // Points first, then a batch.
+  NaiveBayesClassifier<> pointsFirstNbc(trainData.n_rows, classes);
+  for (size_t i = 0; i < 100; ++i)
+    pointsFirstNbc.Train(trainData.col(i), labels[i]);
+  const arma::mat rest = trainData.cols(100, 299);
+  const arma::Row<size_t> restLabels = labels.cols(100, 299);
+  pointsFirstNbc.Train(rest, restLabels, classes, true);
+
+  // A batch first, then points.
+  NaiveBayesClassifier<> batchFirstNbc(trainData.n_rows, classes);
+  const arma::mat first = trainData.cols(0, 199);
+  const arma::Row<size_t> firstLabels = labels.cols(0, 199);
+  batchFirstNbc.Train(first, firstLabels, classes, true);
+  for (size_t i = 200; i < 300; ++i)
+    batchFirstNbc.Train(trainData.col(i), labels[i]);
+
+  CheckMatrices(nbc.Means(), pointsFirstNbc.Means());
+  CheckMatrices(nbc.Variances(), pointsFirstNbc.Variances());
+  CheckMatrices(nbc.Probabilities(), pointsFirstNbc.Probabilities());
+  CheckMatrices(nbc.Means(), batchFirstNbc.Means());
+  CheckMatrices(nbc.Variances(), batchFirstNbc.Variances());
+  CheckMatrices(nbc.Probabilities(), batchFirstNbc.Probabilities());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
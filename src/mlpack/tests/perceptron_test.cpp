@@ -107,6 +107,46 @@ BOOST_AUTO_TEST_CASE(SimpleWeightUpdateInstanceWeight)
   BOOST_CHECK_EQUAL(biases(2), 10);
 }
 
+/**
+ * This test tests whether the SimpleWeightUpdate updates only the weights of
+ * the nonzero dimensions of a sparse point.
+ */
+BOOST_AUTO_TEST_CASE(SimpleWeightUpdateSparsePoint)
+{
+  SimpleWeightUpdate wip;
+
+  sp_vec trainingPoint(5);
+  trainingPoint(1) = 2;
+  trainingPoint(4) = 5;
+  mat weights("0 1 6;"
+              "2 3 6;"
+              "4 5 6;"
+              "6 7 6;"
+              "8 9 6");
+  vec biases("2 5 7");
+  size_t incorrectClass = 0;
+  size_t correctClass = 2;
+  double instanceWeight = 3.0;
+
+  wip.UpdateWeights(trainingPoint, weights, biases, incorrectClass,
+                    correctClass, instanceWeight);
+
+  BOOST_CHECK_EQUAL(weights(0, 0), 0);
+  BOOST_CHECK_EQUAL(weights(1, 0), -4);
+  BOOST_CHECK_EQUAL(weights(2, 0), 4);
+  BOOST_CHECK_EQUAL(weights(3, 0), 6);
+  BOOST_CHECK_EQUAL(weights(4, 0), -7);
+
+  BOOST_CHECK_EQUAL(weights(0, 2), 6);
+  BOOST_CHECK_EQUAL(weights(1, 2), 12);
+  BOOST_CHECK_EQUAL(weights(2, 2), 6);
+  BOOST_CHECK_EQUAL(weights(3, 2), 6);
+  BOOST_CHECK_EQUAL(weights(4, 2), 21);
+
+  BOOST_CHECK_EQUAL(biases(0), -1);
+  BOOST_CHECK_EQUAL(biases(2), 10);
+}
+
 /**
  * This test tests whether the perceptron converges for the AND gate classifier.
  */
@@ -148,6 +148,49 @@ BOOST_AUTO_TEST_CASE(CartPoleWithDQNPrioritizedReplay)
   BOOST_REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task with several environments stepped at once and
+//! a sharded prioritized replay.
+BOOST_AUTO_TEST_CASE(CartPoleWithVectorizedDQN)
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  ShardedReplay<CartPole> replayMethod(10, 10000, 4, 0.6);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy),
+      decltype(replayMethod)>
+      agent(config, network, policy, replayMethod);
+
+  VectorizedEnvironment<CartPole> environments(4);
+
+  bool converged = false;
+  for (size_t step = 0; step < 100000 && !converged; ++step)
+  {
+    agent.Step(environments);
+
+    const std::vector<double>& returns = environments.EpisodeReturns();
+    if (returns.size() >= 50)
+    {
+      const double averageReturn = std::accumulate(returns.end() - 50,
+          returns.end(), 0.0) / 50;
+      converged = (averageReturn > 40);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(agent.TotalSteps() % 4, 0);
+  BOOST_REQUIRE(converged);
+}
+
 //! Test Double DQN in Cart Pole task.
 BOOST_AUTO_TEST_CASE(CartPoleWithDoubleDQN)
 {
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/compiled_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -152,6 +153,55 @@ BOOST_AUTO_TEST_CASE(UnweightedNumericLearningTest)
   BOOST_REQUIRE_GE(rfCorrect, size_t(0.7 * testDataset.n_cols));
 }
 
+/**
+ * Test learning on a binned dataset, making sure that we get performance
+ * similar to a forest trained on the original dataset.
+ */
+BOOST_AUTO_TEST_CASE(BinnedNumericLearningTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  // Build a random forest on the original and on the binned dataset.
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  BinnedDataset<> binned(dataset, 64);
+  RandomForest<> binnedRf;
+  const double entropy = binnedRf.Train(binned, labels, 3, 20, 1, 1e-7);
+
+  BOOST_REQUIRE_EQUAL(std::isfinite(entropy), true);
+  BOOST_REQUIRE_EQUAL(binnedRf.NumTrees(), 20);
+
+  // Get performance statistics on test data.
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> rfPredictions;
+  arma::Row<size_t> binnedPredictions;
+
+  rf.Classify(testDataset, rfPredictions);
+  binnedRf.Classify(testDataset, binnedPredictions);
+
+  // Calculate the number of correct points.
+  size_t rfCorrect = arma::accu(rfPredictions == testLabels);
+  size_t binnedCorrect = arma::accu(binnedPredictions == testLabels);
+
+  BOOST_REQUIRE_GE(binnedCorrect, rfCorrect * 0.9);
+  BOOST_REQUIRE_GE(binnedCorrect, size_t(0.7 * testDataset.n_cols));
+
+  // Weighted training should work too.
+  arma::rowvec weights(labels.n_elem, arma::fill::ones);
+  binnedRf.Train(binned, labels, 3, weights, 20, 1, 1e-7);
+  binnedRf.Classify(testDataset, binnedPredictions);
+  binnedCorrect = arma::accu(binnedPredictions == testLabels);
+
+  BOOST_REQUIRE_GE(binnedCorrect, size_t(0.7 * testDataset.n_cols));
+}
+
 /**
  * Test weighted numeric learning, making sure that we get better performance
  * than a single decision tree.
@@ -487,4 +537,151 @@ BOOST_AUTO_TEST_CASE(DifferentTreesTest)
   BOOST_REQUIRE_EQUAL(success, true);
 }
 
+/**
+ * Make sure that a compiled forest gives the same predictions and
+ * probabilities as the forest it was compiled from.
+ */
+BOOST_AUTO_TEST_CASE(CompiledForestNumericTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1);
+  CompiledForest<> forest(rf);
+
+  BOOST_REQUIRE_EQUAL(forest.NumTrees(), rf.NumTrees());
+  BOOST_REQUIRE_EQUAL(forest.NumClasses(), 3);
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  rf.Classify(dataset, predictions, probabilities);
+  forest.Classify(dataset, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  // Check the single-point overloads too.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    forest.Classify(dataset.col(i), prediction, pointProbabilities);
+
+    BOOST_REQUIRE_EQUAL(prediction, predictions[i]);
+    BOOST_REQUIRE_EQUAL(forest.Classify(dataset.col(i)), predictions[i]);
+    for (size_t j = 0; j < pointProbabilities.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(pointProbabilities[j], probabilities(j, i), 1e-5);
+  }
+}
+
+/**
+ * Make sure that a compiled forest handles categorical splits, and that a
+ * single decision tree can be compiled.
+ */
+BOOST_AUTO_TEST_CASE(CompiledForestCategoricalTest)
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  RandomForest<> rf(d, di, l, 5, 10 /* 10 trees */, 1, 1e-7, 0,
+      MultipleRandomDimensionSelect(4));
+  CompiledForest<> forest(rf);
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  rf.Classify(d, predictions, probabilities);
+  forest.Classify(d, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  DecisionTree<> dt(d, di, l, 5, 5);
+  CompiledForest<> treeForest;
+  treeForest.AddTree(dt);
+
+  dt.Classify(d, predictions, probabilities);
+  treeForest.Classify(d, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  // A tree with a different number of classes can't be added.
+  arma::Row<size_t> binaryLabels = arma::conv_to<arma::Row<size_t>>::from(
+      l > 2);
+  DecisionTree<> binaryTree(d, di, binaryLabels, 2, 5);
+  BOOST_REQUIRE_THROW(treeForest.AddTree(binaryTree), std::invalid_argument);
+}
+
+/**
+ * Make sure an empty compiled forest cannot predict, and that points with too
+ * few dimensions are rejected.
+ */
+BOOST_AUTO_TEST_CASE(CompiledForestInvalidTest)
+{
+  CompiledForest<> emptyForest;
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  BOOST_REQUIRE_THROW(emptyForest.Classify(points, predictions),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(emptyForest.Classify(points.col(0)),
+      std::invalid_argument);
+
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < 100; ++i)
+    labels[i] = (points(9, i) > 0.5) ? 1 : 0;
+
+  RandomForest<> rf(points, labels, 2, 5, 1);
+  CompiledForest<> forest(rf);
+
+  arma::mat smallPoints(3, 10, arma::fill::randu);
+  BOOST_REQUIRE_THROW(forest.Classify(smallPoints, predictions, probabilities),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized compiled forest gives the same results.
+ */
+BOOST_AUTO_TEST_CASE(CompiledForestSerializationTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+  CompiledForest<> forest(rf);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  forest.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  RandomForest<> otherRf(dataset, labels, 3, 3, 5);
+  CompiledForest<> xmlForest, textForest, binaryForest(otherRf);
+  SerializeObjectAll(forest, xmlForest, textForest, binaryForest);
+
+  BOOST_REQUIRE_EQUAL(xmlForest.NumNodes(), forest.NumNodes());
+  BOOST_REQUIRE_EQUAL(textForest.NumNodes(), forest.NumNodes());
+  BOOST_REQUIRE_EQUAL(binaryForest.NumNodes(), forest.NumNodes());
+
+  arma::Row<size_t> xmlPredictions, textPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, textProbabilities, binaryProbabilities;
+
+  xmlForest.Classify(dataset, xmlPredictions, xmlProbabilities);
+  textForest.Classify(dataset, textPredictions, textProbabilities);
+  binaryForest.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
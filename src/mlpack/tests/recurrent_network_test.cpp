@@ -1374,6 +1374,51 @@ BOOST_AUTO_TEST_CASE(RNNTrainReturnObjective)
   BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
 }
 
+/**
+ * Test that an RNN with a single precision output layer works with single
+ * precision sequences.
+ */
+BOOST_AUTO_TEST_CASE(FloatRNNTest)
+{
+  const size_t rho = 10;
+
+  arma::cube input;
+  arma::mat labelsTemp;
+  GenerateNoisySines(input, labelsTemp, rho, 6);
+
+  arma::fcube floatInput(input.n_rows, input.n_cols, input.n_slices);
+  for (size_t i = 0; i < input.n_slices; ++i)
+    floatInput.slice(i) = arma::conv_to<arma::fmat>::from(input.slice(i));
+
+  arma::fcube labels = arma::zeros<arma::fcube>(1, labelsTemp.n_cols, rho);
+  for (size_t i = 0; i < labelsTemp.n_cols; ++i)
+  {
+    const int value = arma::as_scalar(arma::find(
+        arma::max(labelsTemp.col(i)) == labelsTemp.col(i), 1)) + 1;
+    labels.tube(0, i).fill(value);
+  }
+
+  typedef RNN<NegativeLogLikelihood<arma::fmat, arma::fmat> > FloatRNN;
+  BOOST_REQUIRE((std::is_same<FloatRNN::MatType, arma::fmat>::value));
+
+  FloatRNN model(rho);
+  model.Add<IdentityLayer<IdentityFunction, arma::fmat, arma::fmat> >();
+  model.Add<LSTM<arma::fmat, arma::fmat> >(1, 4, rho);
+  model.Add<Linear<arma::fmat, arma::fmat> >(4, 10);
+  model.Add<LogSoftMax<arma::fmat, arma::fmat> >();
+
+  StandardSGD opt(0.1, 1, input.n_cols /* 1 epoch */, -100);
+  const double objVal = model.Train(floatInput, labels, opt);
+  BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
+
+  arma::fcube prediction;
+  model.Predict(floatInput, prediction);
+  BOOST_REQUIRE_EQUAL(prediction.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(prediction.n_cols, floatInput.n_cols);
+  BOOST_REQUIRE_EQUAL(prediction.n_slices, rho);
+  BOOST_REQUIRE(prediction.is_finite());
+}
+
 /**
  * Test that BRNN::Train() returns finite objective value.
  */
@@ -1476,4 +1521,102 @@ BOOST_AUTO_TEST_CASE(LargeRhoValueRnnTest)
   BOOST_TEST_CHECKPOINT("Training over");
 }
 
+/**
+ * Make sure that variable-length sequences only take their valid time steps
+ * into account: the objective, the gradient and the predictions of a padded
+ * batch have to match the sequences processed one by one.
+ */
+BOOST_AUTO_TEST_CASE(VariableLengthSequenceTest)
+{
+  const size_t maxRho = 6;
+  const size_t inputSize = 3;
+  const size_t classes = 4;
+  const arma::urowvec lengths = { 2, 3, 3, 5, 6 };
+
+  // The padded responses are left at zero, which is an invalid class for the
+  // NegativeLogLikelihood output layer and must never be read.
+  arma::cube input(inputSize, lengths.n_elem, maxRho, arma::fill::randu);
+  arma::cube labels(1, lengths.n_elem, maxRho, arma::fill::zeros);
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+  {
+    for (size_t t = 0; t < lengths[i]; ++t)
+      labels(0, i, t) = math::RandInt(1, classes + 1);
+  }
+
+  RNN<> model(maxRho);
+  model.Add<IdentityLayer<> >();
+  model.Add<LSTM<> >(inputSize, 5, maxRho);
+  model.Add<Linear<> >(5, classes);
+  model.Add<LogSoftMax<> >();
+  model.Reset();
+  const arma::mat parameters = model.Parameters();
+
+  model.Predictors() = input;
+  model.Responses() = labels;
+  model.SequenceLengths() = lengths;
+  arma::mat gradient;
+  const double objective = model.EvaluateWithGradient(parameters, 0,
+      gradient, lengths.n_elem);
+
+  double sequenceObjective = 0;
+  arma::mat sequenceGradient = arma::zeros(arma::size(parameters));
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+  {
+    model.Rho() = lengths[i];
+    model.Predictors() = input.subcube(0, i, 0, inputSize - 1, i,
+        lengths[i] - 1);
+    model.Responses() = labels.subcube(0, i, 0, 0, i, lengths[i] - 1);
+    model.SequenceLengths().reset();
+
+    arma::mat g;
+    sequenceObjective += model.EvaluateWithGradient(parameters, 0, g, 1);
+    sequenceGradient += g;
+  }
+
+  BOOST_REQUIRE_CLOSE(objective, sequenceObjective, 1e-5);
+  CheckMatrices(gradient, sequenceGradient);
+
+  // The predictions past the end of a sequence are zero.
+  arma::cube results;
+  model.Rho() = maxRho;
+  model.Predict(input, results, lengths, 2);
+  BOOST_REQUIRE_EQUAL(results.n_slices, maxRho);
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+  {
+    arma::cube sequenceResults;
+    model.Rho() = lengths[i];
+    model.Predict(input.subcube(0, i, 0, inputSize - 1, i, lengths[i] - 1),
+        sequenceResults);
+
+    for (size_t t = 0; t < maxRho; ++t)
+    {
+      if (t < lengths[i])
+        CheckMatrices(results.slice(t).col(i), sequenceResults.slice(t));
+      else
+        BOOST_REQUIRE_EQUAL(arma::accu(arma::abs(results.slice(t).col(i))),
+            0.0);
+    }
+  }
+
+  // Training on the unsorted sequences has to work too.
+  const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+      lengths.n_elem - 1, lengths.n_elem));
+  arma::cube shuffledInput(arma::size(input));
+  arma::cube shuffledLabels(arma::size(labels));
+  for (size_t t = 0; t < maxRho; ++t)
+  {
+    shuffledInput.slice(t) = input.slice(t).cols(order);
+    shuffledLabels.slice(t) = labels.slice(t).cols(order);
+  }
+  const arma::urowvec shuffledLengths = lengths.cols(order);
+
+  model.Rho() = maxRho;
+  StandardSGD opt(0.01, 2, 10 * lengths.n_elem, -100);
+  const double objVal = model.Train(shuffledInput, shuffledLabels,
+      shuffledLengths, opt);
+
+  BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
+  BOOST_REQUIRE_EQUAL(model.SequenceLengths().is_sorted(), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
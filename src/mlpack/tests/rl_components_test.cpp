@@ -20,7 +20,9 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vectorized_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/sharded_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -273,6 +275,198 @@ BOOST_AUTO_TEST_CASE(RandomReplayTest)
   }
 }
 
+/**
+ * Fill a sharded replay from several threads at once and check that every
+ * sampled transition is consistent.
+ */
+BOOST_AUTO_TEST_CASE(ShardedReplayTest)
+{
+  const size_t numShards = 4;
+  for (const double alpha : { 0.0, 0.6 })
+  {
+    ShardedReplay<MountainCar> replay(16, 400, numShards, alpha);
+    BOOST_REQUIRE_EQUAL(replay.NumShards(), numShards);
+
+    // Every thread fills its own shard with 150 transitions, so each shard
+    // wraps around.  The reward and the next state are derived from the state.
+    #pragma omp parallel for num_threads(numShards)
+    for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+    {
+      for (size_t i = 0; i < 150; ++i)
+      {
+        const double value = shard * 1000 + i;
+        MountainCar::State state(arma::colvec({ value, -value }));
+        MountainCar::State nextState(arma::colvec({ value + 1, -value - 1 }));
+        MountainCar::Action action;
+        action.action = (i % 2 == 0) ? MountainCar::Action::actions::forward :
+            MountainCar::Action::actions::backward;
+        replay.Store(shard, state, action, value, nextState, i % 3 == 0, 0.9);
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL(replay.Size(), 400);
+
+    // The outputs are reused, so every sample has to overwrite them.
+    arma::mat sampledState;
+    std::vector<MountainCar::Action> sampledAction;
+    arma::rowvec sampledReward;
+    arma::mat sampledNextState;
+    arma::irowvec sampledTerminal;
+    for (size_t trial = 0; trial < 10; ++trial)
+    {
+      replay.Sample(sampledState, sampledAction, sampledReward,
+          sampledNextState, sampledTerminal);
+
+      BOOST_REQUIRE_EQUAL(sampledAction.size(), 16);
+      for (size_t j = 0; j < 16; ++j)
+      {
+        const size_t i = size_t(sampledReward[j]) % 1000;
+
+        // Only the last 100 transitions of each shard are kept.
+        BOOST_REQUIRE_GE(i, 50);
+        BOOST_REQUIRE_CLOSE(sampledState(0, j), sampledReward[j], 1e-5);
+        BOOST_REQUIRE_CLOSE(sampledState(1, j), -sampledReward[j], 1e-5);
+        BOOST_REQUIRE_CLOSE(sampledNextState(0, j), sampledReward[j] + 1,
+            1e-5);
+        BOOST_REQUIRE_EQUAL(sampledTerminal[j], (i % 3 == 0) ? 1 : 0);
+        BOOST_REQUIRE_EQUAL(sampledAction[j].action, (i % 2 == 0) ?
+            MountainCar::Action::actions::forward :
+            MountainCar::Action::actions::backward);
+      }
+    }
+  }
+}
+
+/**
+ * Step several copies of an environment at once and make sure they behave
+ * like independent environments.
+ */
+BOOST_AUTO_TEST_CASE(VectorizedEnvironmentTest)
+{
+  VectorizedEnvironment<CartPole> environments(5, CartPole(10));
+  BOOST_REQUIRE_EQUAL(environments.NumEnvironments(), 5);
+
+  std::vector<CartPole::Action> actions(5);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    actions[i].action = (i % 2 == 0) ? CartPole::Action::actions::forward :
+        CartPole::Action::actions::backward;
+  }
+
+  std::vector<CartPole::State> nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  for (size_t step = 0; step < 10; ++step)
+  {
+    // The next states have to match a single step of each copy.
+    const arma::mat encoded = environments.Encode();
+    BOOST_REQUIRE_EQUAL(encoded.n_rows, CartPole::State::dimension);
+    BOOST_REQUIRE_EQUAL(encoded.n_cols, 5);
+
+    std::vector<CartPole::State> expectedStates(5);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      CartPole task(10);
+      task.Sample(environments.States()[i], actions[i], expectedStates[i]);
+    }
+
+    environments.Step(actions, nextStates, rewards, isTerminal);
+    for (size_t i = 0; i < 5; ++i)
+      CheckMatrices(expectedStates[i].Encode(), nextStates[i].Encode());
+  }
+
+  // Every copy is capped at 10 steps, so each one has finished an episode.
+  BOOST_REQUIRE_GE(environments.EpisodeReturns().size(), 5);
+  for (const double episodeReturn : environments.EpisodeReturns())
+    BOOST_REQUIRE_LE(episodeReturn, 10.0);
+}
+
+/**
+ * Make sure the copies of a vectorized environment are restarted when they
+ * reach the step limit.
+ */
+BOOST_AUTO_TEST_CASE(VectorizedEnvironmentStepLimitTest)
+{
+  VectorizedEnvironment<CartPole> environments(5);
+
+  std::vector<CartPole::Action> actions(5);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    actions[i].action = (i % 2 == 0) ? CartPole::Action::actions::forward :
+        CartPole::Action::actions::backward;
+  }
+
+  std::vector<CartPole::State> nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  for (size_t step = 0; step < 6; ++step)
+  {
+    environments.Step(actions, nextStates, rewards, isTerminal, 3);
+
+    // The pole can't fall within three steps, so the episodes only end at the
+    // step limit.
+    for (size_t i = 0; i < 5; ++i)
+      BOOST_REQUIRE_EQUAL(isTerminal[i], (step % 3 == 2) ? 1 : 0);
+  }
+
+  BOOST_REQUIRE_EQUAL(environments.EpisodeReturns().size(), 10);
+  for (const double episodeReturn : environments.EpisodeReturns())
+    BOOST_REQUIRE_CLOSE(episodeReturn, 3.0, 1e-5);
+}
+
+/**
+ * Step copies of a stochastic environment and make sure that the trajectories
+ * are the same as when the copies are stepped one by one with the same random
+ * seed.
+ */
+BOOST_AUTO_TEST_CASE(VectorizedStochasticEnvironmentTest)
+{
+  std::vector<Acrobot::Action> actions(8);
+  for (size_t i = 0; i < 8; ++i)
+    actions[i].action = (Acrobot::Action::actions) (i % 3);
+
+  math::RandomSeed(7);
+  VectorizedEnvironment<Acrobot> environments(8, Acrobot(20));
+
+  std::vector<Acrobot::State> nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  std::vector<arma::mat> trajectories;
+  for (size_t step = 0; step < 30; ++step)
+  {
+    environments.Step(actions, nextStates, rewards, isTerminal, 20);
+    trajectories.push_back(environments.Encode());
+  }
+
+  // Now step the same copies by hand.
+  math::RandomSeed(7);
+  std::vector<Acrobot> tasks(8, Acrobot(20));
+  std::vector<Acrobot::State> states(8);
+  std::vector<size_t> steps(8, 0);
+  for (size_t i = 0; i < 8; ++i)
+    states[i] = tasks[i].InitialSample();
+
+  for (size_t step = 0; step < 30; ++step)
+  {
+    for (size_t i = 0; i < 8; ++i)
+    {
+      Acrobot::State nextState;
+      tasks[i].Sample(states[i], actions[i], nextState);
+      if (tasks[i].IsTerminal(nextState) || ++steps[i] >= 20)
+      {
+        steps[i] = 0;
+        states[i] = tasks[i].InitialSample();
+      }
+      else
+      {
+        states[i] = nextState;
+      }
+
+      CheckMatrices(states[i].Encode(), arma::mat(trajectories[step].col(i)));
+    }
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
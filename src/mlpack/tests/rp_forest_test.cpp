@@ -0,0 +1,239 @@
+/**
+ * @file tests/rp_forest_test.cpp
+ *
+ * Tests for the RPForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/rp_forest/rp_forest.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+BOOST_AUTO_TEST_SUITE(RPForestTest);
+
+/**
+ * Make sure that the recall of the forest with the default search parameters
+ * is reasonable.
+ */
+BOOST_AUTO_TEST_CASE(RPForestRecallTest)
+{
+  arma::mat referenceData(5, 2000, arma::fill::randu);
+  arma::mat queryData(5, 200, arma::fill::randu);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 10, trueNeighbors, trueDistances);
+
+  RPForest<> forest(referenceData, 10, 20);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  forest.Search(queryData, 10, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 200);
+  BOOST_REQUIRE_EQUAL(distances.n_rows, 10);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, 200);
+
+  BOOST_REQUIRE_GT(KNN::Recall(neighbors, trueNeighbors), 0.5);
+
+  // The distances must be sorted and correct.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      BOOST_REQUIRE_LT(neighbors(j, i), referenceData.n_cols);
+      BOOST_REQUIRE_CLOSE(distances(j, i), arma::norm(queryData.col(i) -
+          referenceData.col(neighbors(j, i))), 1e-5);
+      if (j > 0)
+        BOOST_REQUIRE_LE(distances(j - 1, i), distances(j, i));
+    }
+  }
+}
+
+/**
+ * Make sure that the recall does not decrease when more candidates are
+ * examined.
+ */
+BOOST_AUTO_TEST_CASE(RPForestSearchKTest)
+{
+  arma::mat referenceData(4, 1500, arma::fill::randu);
+  arma::mat queryData(4, 100, arma::fill::randu);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  RPForest<> forest(referenceData, 5, 10);
+
+  const size_t searchKs[] = { 5, 20, 100, 500 };
+  double lastRecall = 0.0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    forest.Search(queryData, 5, neighbors, distances, searchKs[i]);
+
+    const double recall = KNN::Recall(neighbors, trueNeighbors);
+    BOOST_REQUIRE_GE(recall, lastRecall);
+    lastRecall = recall;
+  }
+}
+
+/**
+ * With a search budget as large as the dataset, the search is exact.
+ */
+BOOST_AUTO_TEST_CASE(RPForestExactTest)
+{
+  arma::mat referenceData(3, 1000, arma::fill::randu);
+  arma::mat queryData(3, 100, arma::fill::randu);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  RPForest<> forest(referenceData, 3, 15);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  forest.Search(queryData, 5, neighbors, distances, referenceData.n_cols);
+
+  CheckMatrices(neighbors, trueNeighbors);
+  CheckMatrices(distances, trueDistances);
+}
+
+/**
+ * Make sure monochromatic search excludes the query point, and is exact with a
+ * large enough search budget.
+ */
+BOOST_AUTO_TEST_CASE(RPForestMonochromaticTest)
+{
+  arma::mat referenceData(3, 800, arma::fill::randu);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(4, trueNeighbors, trueDistances);
+
+  RPForest<> forest(referenceData, 4, 20);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  forest.Search(4, neighbors, distances, referenceData.n_cols);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, referenceData.n_cols);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      BOOST_REQUIRE_NE(neighbors(j, i), i);
+
+  CheckMatrices(neighbors, trueNeighbors);
+  CheckMatrices(distances, trueDistances);
+
+  // The default search budget should still give a reasonable recall.
+  forest.Search(4, neighbors, distances);
+  BOOST_REQUIRE_GT(KNN::Recall(neighbors, trueNeighbors), 0.5);
+}
+
+/**
+ * Make sure that the trees share the reference set of the forest, and that
+ * forests built with the same random seed are the same.
+ */
+BOOST_AUTO_TEST_CASE(RPForestSharedDatasetTest)
+{
+  arma::mat referenceData(4, 1000, arma::fill::randu);
+  arma::mat queryData(4, 50, arma::fill::randu);
+
+  math::RandomSeed(42);
+  RPForest<> forest(referenceData, 6, 10);
+  math::RandomSeed(42);
+  RPForest<> otherForest(referenceData, 6, 10);
+
+  CheckMatrices(forest.ReferenceSet(), referenceData);
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    BOOST_REQUIRE_EQUAL(forest.GetTree(t).Dataset().n_elem, 0);
+
+    // Each mapping must be a permutation of the reference set.
+    std::vector<size_t> sorted = forest.OldFromNew(t);
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i)
+      BOOST_REQUIRE_EQUAL(sorted[i], i);
+
+    BOOST_REQUIRE(forest.OldFromNew(t) == otherForest.OldFromNew(t));
+  }
+
+  arma::Mat<size_t> neighbors, otherNeighbors;
+  arma::mat distances, otherDistances;
+  forest.Search(queryData, 5, neighbors, distances);
+  otherForest.Search(queryData, 5, otherNeighbors, otherDistances);
+
+  CheckMatrices(neighbors, otherNeighbors);
+  CheckMatrices(distances, otherDistances);
+}
+
+/**
+ * Make sure that invalid parameters are caught.
+ */
+BOOST_AUTO_TEST_CASE(RPForestInvalidTest)
+{
+  arma::mat referenceData(3, 100, arma::fill::randu);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  RPForest<> emptyForest;
+  BOOST_REQUIRE_THROW(emptyForest.Search(referenceData, 1, neighbors,
+      distances), std::invalid_argument);
+  BOOST_REQUIRE_THROW(emptyForest.Train(referenceData, 0),
+      std::invalid_argument);
+
+  RPForest<> forest(referenceData, 2);
+  BOOST_REQUIRE_THROW(forest.Search(referenceData, 101, neighbors, distances),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(forest.Search(100, neighbors, distances),
+      std::invalid_argument);
+
+  arma::mat queryData(4, 10, arma::fill::randu);
+  BOOST_REQUIRE_THROW(forest.Search(queryData, 1, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized forest gives the same results.
+ */
+BOOST_AUTO_TEST_CASE(RPForestSerializationTest)
+{
+  arma::mat referenceData(4, 500, arma::fill::randu);
+  arma::mat queryData(4, 50, arma::fill::randu);
+
+  RPForest<> forest(referenceData, 4, 10);
+  RPForest<> xmlForest, textForest, binaryForest;
+  xmlForest.Train(arma::mat(4, 20, arma::fill::randu), 2);
+
+  SerializeObjectAll(forest, xmlForest, textForest, binaryForest);
+
+  BOOST_REQUIRE_EQUAL(xmlForest.NumTrees(), forest.NumTrees());
+  BOOST_REQUIRE_EQUAL(textForest.NumTrees(), forest.NumTrees());
+  BOOST_REQUIRE_EQUAL(binaryForest.NumTrees(), forest.NumTrees());
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, textNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, textDistances, binaryDistances;
+  forest.Search(queryData, 3, neighbors, distances);
+  xmlForest.Search(queryData, 3, xmlNeighbors, xmlDistances);
+  textForest.Search(queryData, 3, textNeighbors, textDistances);
+  binaryForest.Search(queryData, 3, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, textNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, textDistances, binaryDistances);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -111,6 +111,8 @@ void TestAllArmadilloSerialization(arma::Cube<CubeType>& x)
       boost::archive::text_oarchive>(x);
   TestArmadilloSerialization<CubeType, boost::archive::binary_iarchive,
       boost::archive::binary_oarchive>(x);
+  TestArmadilloSerialization<CubeType, data::FlatInputArchive,
+      data::FlatOutputArchive>(x);
 }
 
 // Test function for loading and saving Armadillo objects.
@@ -185,6 +187,8 @@ void TestAllArmadilloSerialization(MatType& x)
       boost::archive::text_oarchive>(x);
   TestArmadilloSerialization<MatType, boost::archive::binary_iarchive,
       boost::archive::binary_oarchive>(x);
+  TestArmadilloSerialization<MatType, data::FlatInputArchive,
+      data::FlatOutputArchive>(x);
 }
 
 // Save and load an mlpack object.
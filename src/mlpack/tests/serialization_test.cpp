@@ -657,6 +657,107 @@ BOOST_AUTO_TEST_CASE(KNNTest)
   CheckMatrices(neighbors, xmlNeighbors, textNeighbors, binaryNeighbors);
 }
 
+/**
+ * Make sure a kd-tree based KNN model survives the flat binary format, and that
+ * its dataset is only stored once even though every node points to it.
+ */
+BOOST_AUTO_TEST_CASE(KNNFlatTest)
+{
+  using neighbor::KNN;
+  arma::mat dataset = arma::randu<arma::mat>(5, 2000);
+
+  KNN knn(dataset, DUAL_TREE_MODE);
+  KNN knnFlat;
+
+  SerializeObject<KNN, data::FlatInputArchive, data::FlatOutputArchive>(knn,
+      knnFlat);
+
+  BOOST_REQUIRE_EQUAL(knnFlat.ReferenceSet().n_cols, 2000);
+  BOOST_REQUIRE_EQUAL(&knnFlat.ReferenceSet(),
+      &knnFlat.ReferenceTree().Left()->Dataset());
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 1000);
+
+  arma::mat distances, flatDistances;
+  arma::Mat<size_t> neighbors, flatNeighbors;
+
+  knn.Search(querySet, 5, neighbors, distances);
+  knnFlat.Search(querySet, 5, flatNeighbors, flatDistances);
+
+  CheckMatrices(distances, flatDistances);
+  CheckMatrices(neighbors, flatNeighbors);
+}
+
+/**
+ * Load a model from a memory-mapped file, and make sure its matrices use the
+ * mapped memory and can still be modified.
+ */
+BOOST_AUTO_TEST_CASE(LoadMappedTest)
+{
+  using neighbor::KNN;
+  arma::mat dataset = arma::randu<arma::mat>(5, 2000);
+
+  KNN knn(dataset, DUAL_TREE_MODE);
+  BOOST_REQUIRE(data::Save("knn_mapped_test.flat", "knn", knn));
+
+  // The mapping must outlive the model, so it is declared first.
+  data::MappedFile mapping;
+  KNN knnMapped;
+  BOOST_REQUIRE(data::LoadMapped("knn_mapped_test.flat", "knn", knnMapped,
+      mapping));
+  BOOST_REQUIRE(mapping.Data() != NULL);
+
+  // The mapped memory is not owned by the matrix.
+  BOOST_REQUIRE_EQUAL(knnMapped.ReferenceSet().mem_state, 1);
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 1000);
+
+  arma::mat distances, mappedDistances;
+  arma::Mat<size_t> neighbors, mappedNeighbors;
+
+  knn.Search(querySet, 5, neighbors, distances);
+  knnMapped.Search(querySet, 5, mappedNeighbors, mappedDistances);
+
+  CheckMatrices(distances, mappedDistances);
+  CheckMatrices(neighbors, mappedNeighbors);
+
+  // Modifying and resizing a mapped matrix must work like for any other.
+  arma::mat& mapped = const_cast<arma::mat&>(knnMapped.ReferenceSet());
+  mapped(0, 0) = 3.0;
+  BOOST_REQUIRE_EQUAL(mapped(0, 0), 3.0);
+  mapped.resize(5, 3000);
+  BOOST_REQUIRE_EQUAL(mapped.n_cols, 3000);
+
+  // The file itself is unchanged.
+  KNN knnLoaded;
+  BOOST_REQUIRE(data::Load("knn_mapped_test.flat", "knn", knnLoaded));
+  BOOST_REQUIRE_EQUAL(knnLoaded.ReferenceSet().n_cols, 2000);
+  BOOST_REQUIRE_NE(knnLoaded.ReferenceSet()(0, 0), 3.0);
+
+  remove("knn_mapped_test.flat");
+}
+
+/**
+ * Loading a file that is not in the flat binary format should fail cleanly.
+ */
+BOOST_AUTO_TEST_CASE(FlatInvalidFileTest)
+{
+  std::ofstream ofs("flat_invalid_test.flat");
+  ofs << "this is not a model, and it is not one either" << std::endl;
+  ofs.close();
+
+  KNN knn;
+  BOOST_REQUIRE(!data::Load("flat_invalid_test.flat", "knn", knn));
+  data::MappedFile mapping;
+  BOOST_REQUIRE(!data::LoadMapped("flat_invalid_test.flat", "knn", knn,
+      mapping));
+
+  // The mapping is released when loading fails.
+  BOOST_REQUIRE(mapping.Data() == NULL);
+
+  remove("flat_invalid_test.flat");
+}
+
 BOOST_AUTO_TEST_CASE(SoftmaxRegressionTest)
 {
   using regression::SoftmaxRegression;
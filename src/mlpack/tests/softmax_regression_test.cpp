@@ -35,7 +35,7 @@ TEST_CASE("SoftmaxRegressionFunctionEvaluate", "[SoftmaxRegressionTest]")
     labels(i) = math::RandInt(0, numClasses);
 
   // Create a SoftmaxRegressionFunction. Regularization term ignored.
-  SoftmaxRegressionFunction srf(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; ++i)
@@ -82,9 +82,9 @@ TEST_CASE("SoftmaxRegressionFunctionRegularizationEvaluate",
     labels(i) = math::RandInt(0, numClasses);
 
   // 3 objects for comparing regularization costs.
-  SoftmaxRegressionFunction srfNoReg(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srfSmallReg(data, labels, numClasses, 1);
-  SoftmaxRegressionFunction srfBigReg(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srfNoReg(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srfSmallReg(data, labels, numClasses, 1);
+  SoftmaxRegressionFunction<> srfBigReg(data, labels, numClasses, 20);
 
   // Run a number of trials.
   for (size_t i = 0; i < trials; ++i)
@@ -125,8 +125,8 @@ TEST_CASE("SoftmaxRegressionFunctionGradient",
 
   // 2 objects for 2 terms in the cost function. Each term contributes towards
   // the gradient and thus need to be checked independently.
-  SoftmaxRegressionFunction srf1(data, labels, numClasses, 0);
-  SoftmaxRegressionFunction srf2(data, labels, numClasses, 20);
+  SoftmaxRegressionFunction<> srf1(data, labels, numClasses, 0);
+  SoftmaxRegressionFunction<> srf2(data, labels, numClasses, 20);
 
   // Create a random set of parameters.
   arma::mat parameters;
@@ -377,6 +377,41 @@ TEST_CASE("SoftmaxRegressionTrainTest", "[SoftmaxRegressionTest]")
   }
 }
 
+TEST_CASE("SoftmaxRegressionSparseTest", "[SoftmaxRegressionTest]")
+{
+  // Sparse and dense training must learn the same model.
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 500, 0.3);
+  const arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 500; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  SoftmaxRegression sr(10, 3);
+  SoftmaxRegression srSparse(10, 3);
+  srSparse.Parameters() = sr.Parameters();
+  sr.Train(denseDataset, labels, 3);
+  srSparse.Train(dataset, labels, 3);
+
+  REQUIRE(sr.Parameters().n_elem == srSparse.Parameters().n_elem);
+  for (size_t i = 0; i < sr.Parameters().n_elem; ++i)
+  {
+    if (std::abs(sr.Parameters()[i]) < 1e-4)
+      REQUIRE(srSparse.Parameters()[i] == Approx(0.0).margin(1e-4));
+    else
+      REQUIRE(srSparse.Parameters()[i] ==
+          Approx(sr.Parameters()[i]).epsilon(1e-3));
+  }
+
+  // Sparse and dense points must be classified the same way.
+  arma::Row<size_t> predictions, sparsePredictions;
+  sr.Classify(denseDataset, predictions);
+  srSparse.Classify(dataset, sparsePredictions);
+  REQUIRE(predictions.n_elem == sparsePredictions.n_elem);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    REQUIRE(predictions[i] == sparsePredictions[i]);
+}
+
 TEST_CASE("SoftmaxRegressionOptimizerTrainTest", "[SoftmaxRegressionTest]")
 {
   // The same as the previous test, just passing in an instantiated optimizer.
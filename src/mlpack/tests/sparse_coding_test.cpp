@@ -213,4 +213,39 @@ BOOST_AUTO_TEST_CASE(SparseCodingTrainReturnObjective)
   BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
 }
 
+/**
+ * Make sure that a trained model encodes a dataset the same way, whether the
+ * points are encoded all at once or in separate batches.
+ */
+BOOST_AUTO_TEST_CASE(SparseCodingEncodeBatchTest)
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1);
+  DataDependentRandomInitializer::Initialize(X, nAtoms, sc.Dictionary());
+  const SparseCoding& model = sc;
+
+  mat Z;
+  model.Encode(X, Z);
+  BOOST_REQUIRE_EQUAL(Z.n_rows, nAtoms);
+  BOOST_REQUIRE_EQUAL(Z.n_cols, X.n_cols);
+
+  for (uword begin = 0; begin < X.n_cols; begin += 64)
+  {
+    const uword end = std::min(begin + 64, X.n_cols) - 1;
+
+    mat batchZ;
+    model.Encode(X.cols(begin, end), batchZ);
+    CheckMatrices(Z.cols(begin, end), batchZ);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -18,6 +18,7 @@
 #include <mlpack/core/data/string_encoding_policies/dictionary_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/bag_of_words_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/tf_idf_encoding_policy.hpp>
+#include <mlpack/core/data/string_encoding_policies/feature_hashing_encoding_policy.hpp>
 #include <boost/test/unit_test.hpp>
 #include <memory>
 #include "test_tools.hpp"
@@ -1395,6 +1396,77 @@ BOOST_AUTO_TEST_CASE(TermFrequencyTfIdfEncodingIndividualCharactersTest)
   CheckMatrices(output, target.t(), 1e-12);
 }
 
+/**
+ * Test the feature hashing encoding algorithm: every token must be counted in
+ * the bucket given by its hash, and no dictionary must be built.
+ */
+BOOST_AUTO_TEST_CASE(FeatureHashingEncodingTest)
+{
+  arma::sp_mat output;
+  FeatureHashingEncoding<SplitByAnyOf::TokenType> encoder(
+      (FeatureHashingEncodingPolicy(64, false)));
+  SplitByAnyOf tokenizer(" ,.");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(encoder.Dictionary().Size(), 0);
+  BOOST_REQUIRE_EQUAL(output.n_rows, 64);
+  BOOST_REQUIRE_EQUAL(output.n_cols, stringEncodingInput.size());
+
+  // Count the tokens of every line by hand.
+  arma::mat expected(64, stringEncodingInput.size(), arma::fill::zeros);
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    boost::string_view strView(stringEncodingInput[i]);
+    boost::string_view token = tokenizer(strView);
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      double sign;
+      const size_t bucket = encoder.EncodingPolicy().Bucket(token, sign);
+      BOOST_REQUIRE_EQUAL(sign, 1.0);
+      expected(bucket, i) += 1;
+
+      token = tokenizer(strView);
+    }
+  }
+
+  CheckMatrices(arma::mat(output), expected);
+}
+
+/**
+ * Make sure that the feature hashing encoding of a corpus is the same as the
+ * concatenation of the encodings of its shards, and that dense and sparse
+ * outputs agree.
+ */
+BOOST_AUTO_TEST_CASE(FeatureHashingEncodingShardsTest)
+{
+  FeatureHashingEncoding<SplitByAnyOf::TokenType> encoder(
+      (FeatureHashingEncodingPolicy(1024)));
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::sp_mat output;
+  arma::mat denseOutput;
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+  encoder.Encode(stringEncodingInput, denseOutput, tokenizer);
+
+  CheckMatrices(arma::mat(output), denseOutput);
+
+  vector<string> firstShard(stringEncodingInput.begin(),
+      stringEncodingInput.begin() + 2);
+  vector<string> secondShard(stringEncodingInput.begin() + 2,
+      stringEncodingInput.end());
+
+  // Use a new encoder for the second shard with the same settings.
+  FeatureHashingEncoding<SplitByAnyOf::TokenType> otherEncoder(
+      (FeatureHashingEncodingPolicy(1024)));
+  arma::sp_mat firstOutput, secondOutput;
+  encoder.Encode(firstShard, firstOutput, tokenizer);
+  otherEncoder.Encode(secondShard, secondOutput, tokenizer);
+
+  CheckMatrices(arma::mat(output),
+      arma::mat(arma::join_rows(firstOutput, secondOutput)));
+}
+
 /**
  * Serialization test for the Tf-Idf encoding algorithm with
  * the SplitByAnyOf tokenizer.
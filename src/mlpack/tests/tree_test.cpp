@@ -1803,6 +1803,74 @@ BOOST_AUTO_TEST_CASE(BinarySpaceTreeMoveConstructorTest)
   BOOST_REQUIRE_EQUAL(tree2.NumChildren(), 2);
 }
 
+// Make sure two binary space trees have the same structure and bounds.
+template<typename TreeType>
+void CheckSameTree(const TreeType& a, const TreeType& b)
+{
+  BOOST_REQUIRE_EQUAL(a.Begin(), b.Begin());
+  BOOST_REQUIRE_EQUAL(a.Count(), b.Count());
+  BOOST_REQUIRE_EQUAL(a.NumChildren(), b.NumChildren());
+  BOOST_REQUIRE_CLOSE(a.ParentDistance() + 1.0, b.ParentDistance() + 1.0,
+      1e-5);
+  BOOST_REQUIRE_CLOSE(a.FurthestDescendantDistance() + 1.0,
+      b.FurthestDescendantDistance() + 1.0, 1e-5);
+
+  arma::vec aCenter, bCenter;
+  a.Center(aCenter);
+  b.Center(bCenter);
+  CheckMatrices(aCenter, bCenter);
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameTree(a.Child(i), b.Child(i));
+}
+
+/**
+ * Make sure that large kd-trees and ball trees, which are built in parallel,
+ * are the same as the trees built on one thread.
+ */
+BOOST_AUTO_TEST_CASE(ParallelBinarySpaceTreeTest)
+{
+  arma::mat dataset(3, 250000, arma::fill::randu);
+
+  #ifdef HAS_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> oldFromNew, newFromOld;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> kdTree(dataset,
+      oldFromNew, newFromOld);
+  BallTree<EuclideanDistance, EmptyStatistic, arma::mat> ballTree(dataset);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(std::max(threads, 4));
+  #endif
+
+  std::vector<size_t> parallelOldFromNew, parallelNewFromOld;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> parallelKdTree(dataset,
+      parallelOldFromNew, parallelNewFromOld);
+  BallTree<EuclideanDistance, EmptyStatistic, arma::mat> parallelBallTree(
+      dataset);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  BOOST_REQUIRE(oldFromNew == parallelOldFromNew);
+  BOOST_REQUIRE(newFromOld == parallelNewFromOld);
+  CheckMatrices(kdTree.Dataset(), parallelKdTree.Dataset());
+  CheckMatrices(ballTree.Dataset(), parallelBallTree.Dataset());
+  CheckSameTree(kdTree, parallelKdTree);
+  CheckSameTree(ballTree, parallelBallTree);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(parallelKdTree.Dataset()(0, i),
+        dataset(0, parallelOldFromNew[i]));
+  }
+  BOOST_REQUIRE(CheckPointBounds(parallelKdTree));
+}
+
 template<typename TreeType>
 void RecurseTreeCountLeaves(const TreeType& node, arma::vec& counts)
 {